@@ -9,6 +9,7 @@
 
 #include "xenia/base/arena.h"
 
+#include <algorithm>
 #include <cstring>
 #include <memory>
 
@@ -31,6 +32,7 @@ Arena::~Arena() {
 }
 
 void Arena::Reset() {
+  high_water_mark_ = std::max(high_water_mark_, CalculateSize());
   active_chunk_ = head_chunk_;
   if (active_chunk_) {
     active_chunk_->offset = 0;
@@ -68,6 +70,10 @@ void* Arena::Alloc(size_t size) {
 
 void Arena::Rewind(size_t size) { active_chunk_->offset -= size; }
 
+size_t Arena::high_water_mark() {
+  return std::max(high_water_mark_, CalculateSize());
+}
+
 size_t Arena::CalculateSize() {
   size_t total_length = 0;
   Chunk* chunk = head_chunk_;
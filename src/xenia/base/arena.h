@@ -31,6 +31,9 @@ class Arena {
   }
   void Rewind(size_t size);
 
+  // Largest number of bytes in use at once since creation.
+  size_t high_water_mark();
+
   void* CloneContents();
   template <typename T>
   void CloneContents(std::vector<T>* buffer) {
@@ -55,6 +58,7 @@ class Arena {
   void CloneContents(void* buffer, size_t buffer_length);
 
   size_t chunk_size_;
+  size_t high_water_mark_ = 0;
   Chunk* head_chunk_;
   Chunk* active_chunk_;
 };
@@ -104,6 +104,16 @@ std::string::size_type find_first_of_case(const std::string& target,
   }
 }
 
+std::string to_lower_ascii(const std::string& source) {
+  std::string result(source);
+  for (auto& c : result) {
+    if (c >= 'A' && c <= 'Z') {
+      c += 'a' - 'A';
+    }
+  }
+  return result;
+}
+
 std::wstring to_absolute_path(const std::wstring& path) {
 #if XE_PLATFORM_WIN32
   wchar_t buffer[kMaxPath];
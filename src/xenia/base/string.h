@@ -44,6 +44,9 @@ inline std::wstring format_string(const wchar_t* format, ...) {
 std::string::size_type find_first_of_case(const std::string& target,
                                           const std::string& search);
 
+// Lowercases ASCII letters only, folding case the same way strcasecmp does.
+std::string to_lower_ascii(const std::string& source);
+
 // Converts the given path to an absolute path based on cwd.
 std::wstring to_absolute_path(const std::wstring& path);
 
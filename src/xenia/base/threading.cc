@@ -9,6 +9,25 @@
 
 #include "xenia/base/threading.h"
 
+#include <gflags/gflags.h>
+
+#include <cinttypes>
+#include <cstdlib>
+#include <sstream>
+
+#include "xenia/base/logging.h"
+
+DEFINE_string(guest_processor_map, "",
+              "Host logical processor to run each of the six guest hardware "
+              "threads on, as a comma-separated list (such as 0,2,4,6,8,10). "
+              "Empty to choose from the host topology.");
+DEFINE_int32(reserved_host_processors, -1,
+             "Number of host logical processors set aside for the emulator's "
+             "own threads (GPU command processor, XMA decoder, ...), which "
+             "guest threads are kept off. Whole cores are reserved, starting "
+             "from the last. -1 reserves the last core if enough are left for "
+             "the guest.");
+
 namespace xe {
 namespace threading {
 
@@ -20,6 +39,168 @@ uint32_t logical_processor_count() {
   return value;
 }
 
+namespace {
+
+uint64_t CoreMask(const std::vector<uint32_t>& core) {
+  uint64_t mask = 0;
+  for (uint32_t processor : core) {
+    mask |= uint64_t(1) << processor;
+  }
+  return mask;
+}
+
+}  // namespace
+
+ProcessorMap BuildProcessorMap(
+    const std::vector<std::vector<uint32_t>>& host_cores) {
+  ProcessorMap map;
+
+  // Masks only go up to 64 processors.
+  std::vector<std::vector<uint32_t>> cores;
+  uint32_t processor_count = 0;
+  for (auto& core : host_cores) {
+    std::vector<uint32_t> usable_core;
+    for (uint32_t processor : core) {
+      if (processor < 64) {
+        usable_core.push_back(processor);
+      }
+    }
+    if (!usable_core.empty()) {
+      processor_count += uint32_t(usable_core.size());
+      cores.push_back(std::move(usable_core));
+    }
+  }
+  if (cores.empty()) {
+    return map;
+  }
+
+  // Set whole cores aside from the end, so that guest threads don't share
+  // them with the emulator's threads through SMT either.
+  uint32_t reserve_count;
+  if (FLAGS_reserved_host_processors >= 0) {
+    reserve_count = uint32_t(FLAGS_reserved_host_processors);
+  } else if (FLAGS_guest_processor_map.empty() &&
+             processor_count - cores.back().size() >=
+                 kGuestHardwareThreadCount) {
+    reserve_count = uint32_t(cores.back().size());
+  } else {
+    reserve_count = 0;
+  }
+  uint32_t reserved_count = 0;
+  while (reserved_count < reserve_count && cores.size() > 1) {
+    map.reserved_mask |= CoreMask(cores.back());
+    reserved_count += uint32_t(cores.back().size());
+    cores.pop_back();
+  }
+
+  if (!FLAGS_guest_processor_map.empty()) {
+    std::vector<uint32_t> processors;
+    std::istringstream stream(FLAGS_guest_processor_map);
+    std::string token;
+    while (std::getline(stream, token, ',')) {
+      uint32_t processor = uint32_t(std::strtoul(token.c_str(), nullptr, 10));
+      if (processor < 64) {
+        processors.push_back(processor);
+      }
+    }
+    if (processors.empty()) {
+      XELOGE("Invalid --guest_processor_map: %s",
+             FLAGS_guest_processor_map.c_str());
+      return ProcessorMap();
+    }
+    for (uint32_t i = 0; i < kGuestHardwareThreadCount; ++i) {
+      map.guest_thread_masks[i] = uint64_t(1)
+                                  << processors[i % processors.size()];
+    }
+    if (FLAGS_reserved_host_processors < 0) {
+      // Whatever isn't mapped is free for the emulator.
+      uint64_t all_mask = 0;
+      for (auto& core : cores) {
+        all_mask |= CoreMask(core);
+      }
+      uint64_t guest_mask = 0;
+      for (uint64_t mask : map.guest_thread_masks) {
+        guest_mask |= mask;
+      }
+      map.reserved_mask = all_mask & ~guest_mask;
+    }
+  } else if (cores.size() >= kGuestHardwareThreadCount) {
+    // A core for every guest hardware thread.
+    for (uint32_t i = 0; i < kGuestHardwareThreadCount; ++i) {
+      map.guest_thread_masks[i] = uint64_t(1) << cores[i][0];
+    }
+  } else if (cores.size() >= kGuestHardwareThreadCount / 2 &&
+             cores[0].size() >= 2 && cores[1].size() >= 2 &&
+             cores[2].size() >= 2) {
+    // Guest cores on host cores, their hardware threads on SMT siblings, as
+    // on the real thing.
+    for (uint32_t i = 0; i < kGuestHardwareThreadCount; ++i) {
+      map.guest_thread_masks[i] = uint64_t(1) << cores[i / 2][i % 2];
+    }
+  } else {
+    // Too few processors; spread the guest hardware threads over distinct
+    // cores first, sharing processors once every one is used.
+    size_t max_core_size = 0;
+    for (auto& core : cores) {
+      max_core_size = std::max(max_core_size, core.size());
+    }
+    std::vector<uint32_t> processors;
+    for (size_t sibling = 0; sibling < max_core_size; ++sibling) {
+      for (auto& core : cores) {
+        if (sibling < core.size()) {
+          processors.push_back(core[sibling]);
+        }
+      }
+    }
+    for (uint32_t i = 0; i < kGuestHardwareThreadCount; ++i) {
+      map.guest_thread_masks[i] = uint64_t(1)
+                                  << processors[i % processors.size()];
+    }
+  }
+
+  if (FLAGS_guest_processor_map.empty()) {
+    // Threads not pinned by the guest may use anything not reserved.
+    for (auto& core : cores) {
+      map.guest_mask |= CoreMask(core);
+    }
+  } else {
+    for (uint64_t mask : map.guest_thread_masks) {
+      map.guest_mask |= mask;
+    }
+  }
+  return map;
+}
+
+namespace {
+
+const ProcessorMap& processor_map() {
+  static ProcessorMap map = [] {
+    auto map = BuildProcessorMap(QueryHostCores());
+    XELOGI("Guest threads on host processor mask %.16" PRIX64 ", %.16" PRIX64
+           " reserved for the emulator",
+           map.guest_mask, map.reserved_mask);
+    return map;
+  }();
+  return map;
+}
+
+}  // namespace
+
+uint64_t GuestAffinityToHostMask(uint32_t guest_affinity) {
+  auto& map = processor_map();
+  uint64_t mask = 0;
+  for (uint32_t i = 0; i < kGuestHardwareThreadCount; ++i) {
+    if (guest_affinity & (1 << i)) {
+      mask |= map.guest_thread_masks[i];
+    }
+  }
+  return mask ? mask : map.guest_mask;
+}
+
+uint64_t reserved_host_processor_mask() {
+  return processor_map().reserved_mask;
+}
+
 thread_local uint32_t current_thread_id_ = UINT_MAX;
 
 uint32_t current_thread_id() {
@@ -55,6 +55,43 @@ uint32_t logical_processor_count();
 // Must be called at startup before attempting to set thread affinity.
 void EnableAffinityConfiguration();
 
+// Returns the logical processors of the host grouped by the physical core
+// they share, in order. Processors without topology information are each
+// reported as a core of their own.
+std::vector<std::vector<uint32_t>> QueryHostCores();
+
+const uint32_t kGuestHardwareThreadCount = 6;
+
+// Host processors the guest hardware threads are mapped onto.
+struct ProcessorMap {
+  // Host processors for each guest hardware thread.
+  uint64_t guest_thread_masks[kGuestHardwareThreadCount] = {0};
+  // Host processors for guest threads that may run anywhere.
+  uint64_t guest_mask = 0;
+  uint64_t reserved_mask = 0;
+};
+
+// Maps the guest hardware threads onto the given host cores (as returned by
+// QueryHostCores), following --guest_processor_map and
+// --reserved_host_processors. Used by GuestAffinityToHostMask; exposed for
+// tests.
+ProcessorMap BuildProcessorMap(
+    const std::vector<std::vector<uint32_t>>& host_cores);
+
+// Returns the host affinity mask for a guest thread asking to run on the given
+// guest hardware threads (bit per hardware thread, 0-5), or the processors
+// not reserved for the emulator if 0. The mapping comes from
+// --guest_processor_map, or from the host topology: the six guest hardware
+// threads go on separate cores if there are enough, otherwise each guest
+// core's pair goes on one host core's SMT siblings.
+// Returns 0 if nothing is known about the host processors.
+uint64_t GuestAffinityToHostMask(uint32_t guest_affinity);
+
+// Returns the host processors set aside for the emulator's own threads (see
+// --reserved_host_processors), which guest threads are kept off, or 0 if there
+// are none.
+uint64_t reserved_host_processor_mask();
+
 // Gets a stable thread-specific ID, but may not be. Use for informative
 // purposes only.
 uint32_t current_thread_system_id();
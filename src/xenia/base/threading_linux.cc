@@ -10,12 +10,67 @@
 #include "xenia/base/threading.h"
 
 #include <pthread.h>
+#include <sched.h>
 #include <time.h>
 
+#include <cstdio>
+#include <map>
+#include <utility>
+
 namespace xe {
 namespace threading {
 
 void MaybeYield() { pthread_yield(); }
 
+namespace {
+// Reads a value from /sys/devices/system/cpu/cpuN/topology, or -1.
+int ReadProcessorTopology(uint32_t processor, const char* name) {
+  char path[128];
+  snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/topology/%s",
+           processor, name);
+  FILE* file = fopen(path, "r");
+  if (!file) {
+    return -1;
+  }
+  int value = -1;
+  if (fscanf(file, "%d", &value) != 1) {
+    value = -1;
+  }
+  fclose(file);
+  return value;
+}
+}  // namespace
+
+std::vector<std::vector<uint32_t>> QueryHostCores() {
+  // Only the processors we are allowed on (taskset, cgroups, ...).
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set)) {
+    return {};
+  }
+  std::vector<std::vector<uint32_t>> cores;
+  std::map<std::pair<int, int>, size_t> core_indices;
+  for (uint32_t processor = 0; processor < CPU_SETSIZE; ++processor) {
+    if (!CPU_ISSET(processor, &cpu_set)) {
+      continue;
+    }
+    int package_id = ReadProcessorTopology(processor, "physical_package_id");
+    int core_id = ReadProcessorTopology(processor, "core_id");
+    if (package_id < 0 || core_id < 0) {
+      cores.push_back({processor});
+      continue;
+    }
+    auto key = std::make_pair(package_id, core_id);
+    auto it = core_indices.find(key);
+    if (it == core_indices.end()) {
+      core_indices.emplace(key, cores.size());
+      cores.push_back({processor});
+    } else {
+      cores[it->second].push_back(processor);
+    }
+  }
+  return cores;
+}
+
 }  // namespace threading
 }  // namespace xe
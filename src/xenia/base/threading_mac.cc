@@ -12,8 +12,11 @@
 #include <mach/mach.h>
 #include <mach/mach_time.h>
 #include <pthread.h>
+#include <sys/sysctl.h>
 #include <time.h>
 
+#include <algorithm>
+
 namespace xe {
 namespace threading {
 
@@ -32,6 +35,28 @@ void set_name(std::thread::native_handle_type handle, const std::string& name) {
 
 void MaybeYield() { pthread_yield_np(); }
 
+std::vector<std::vector<uint32_t>> QueryHostCores() {
+  uint32_t logical_count = logical_processor_count();
+  int physical_count = 0;
+  size_t size = sizeof(physical_count);
+  if (sysctlbyname("hw.physicalcpu", &physical_count, &size, nullptr, 0) ||
+      physical_count <= 0) {
+    physical_count = int(logical_count);
+  }
+  // There is no per-processor topology, but SMT siblings are numbered next to
+  // each other.
+  uint32_t threads_per_core =
+      std::max(1u, logical_count / uint32_t(physical_count));
+  std::vector<std::vector<uint32_t>> cores;
+  for (uint32_t processor = 0; processor < logical_count; ++processor) {
+    if (processor % threads_per_core == 0) {
+      cores.emplace_back();
+    }
+    cores.back().push_back(processor);
+  }
+  return cores;
+}
+
 void Sleep(std::chrono::microseconds duration) {
   timespec rqtp = {duration.count() / 1000000, duration.count() % 1000};
   nanosleep(&rqtp, nullptr);
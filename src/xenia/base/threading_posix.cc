@@ -11,18 +11,26 @@
 
 #include "xenia/base/assert.h"
 #include "xenia/base/logging.h"
+#include "xenia/base/math.h"
+#include "xenia/base/platform.h"
 
 #include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
 #include <sys/syscall.h>
 #include <sys/types.h>
 #include <time.h>
 #include <unistd.h>
 
+#include <cinttypes>
+
 namespace xe {
 namespace threading {
 
 // uint64_t ticks() { return mach_absolute_time(); }
 
+void EnableAffinityConfiguration() {}
+
 uint32_t current_thread_system_id() {
   return static_cast<uint32_t>(syscall(SYS_gettid));
 }
@@ -56,36 +64,87 @@ class PosixHandle : public T {
   pthread_t handle_;
 };
 
+// Shared by a thread object and the thread itself, which fills it in as it
+// starts.
+struct PosixThreadState {
+  std::atomic<uint32_t> system_id = {0};
+  std::atomic<int32_t> priority = {ThreadPriority::kNormal};
+};
+
 class PosixThread : public PosixHandle<Thread> {
  public:
-  explicit PosixThread(pthread_t handle) : PosixHandle(handle) {}
+  PosixThread(pthread_t handle, std::shared_ptr<PosixThreadState> state)
+      : PosixHandle(handle), state_(std::move(state)) {}
   ~PosixThread() = default;
 
   void set_name(std::string name) override {
     // TODO(DrChat)
   }
 
-  uint32_t system_id() const override { return 0; }
+  uint32_t system_id() const override {
+    uint32_t system_id;
+    while (!(system_id = state_->system_id.load())) {
+      // Only until the thread has started.
+      MaybeYield();
+    }
+    return system_id;
+  }
 
-  // TODO(DrChat)
-  uint64_t affinity_mask() override { return 0; }
-  void set_affinity_mask(uint64_t mask) override { assert_always(); }
+  uint64_t affinity_mask() override {
+#if XE_PLATFORM_LINUX
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    if (pthread_getaffinity_np(handle_, sizeof(cpu_set), &cpu_set)) {
+      return 0;
+    }
+    uint64_t mask = 0;
+    for (int i = 0; i < 64; ++i) {
+      if (CPU_ISSET(i, &cpu_set)) {
+        mask |= uint64_t(1) << i;
+      }
+    }
+    return mask;
+#else
+    return 0;
+#endif  // XE_PLATFORM_LINUX
+  }
 
-  int priority() override {
-    int policy;
-    struct sched_param param;
-    int ret = pthread_getschedparam(handle_, &policy, &param);
+  void set_affinity_mask(uint64_t mask) override {
+#if XE_PLATFORM_LINUX
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (int i = 0; i < 64; ++i) {
+      if (mask & (uint64_t(1) << i)) {
+        CPU_SET(i, &cpu_set);
+      }
+    }
+    int ret = pthread_setaffinity_np(handle_, sizeof(cpu_set), &cpu_set);
     if (ret != 0) {
-      return -1;
+      XELOGW("Unable to set thread affinity mask %.16" PRIX64 ": %d", mask,
+             ret);
     }
-
-    return param.sched_priority;
+#endif  // XE_PLATFORM_LINUX
   }
 
-  void set_priority(int new_priority) override {
-    struct sched_param param;
-    param.sched_priority = new_priority;
-    int ret = pthread_setschedparam(handle_, SCHED_FIFO, &param);
+  int32_t priority() override { return state_->priority; }
+
+  void set_priority(int32_t new_priority) override {
+    state_->priority = new_priority;
+#if XE_PLATFORM_LINUX
+    // Real-time policies need privileges and can starve the rest of the
+    // system, so priorities are nice values under the normal policy instead,
+    // which Linux applies per thread. Lowering a thread's nice value at all,
+    // whether to raise it above normal or just to bring it back to normal
+    // after it was lowered, needs CAP_SYS_NICE (or a raised RLIMIT_NICE);
+    // without it the thread keeps its current nice value.
+    static const int kNiceValues[] = {10, 5, 0, -5, -10};
+    int index = std::min(std::max(new_priority - ThreadPriority::kLowest, 0),
+                         int(xe::countof(kNiceValues)) - 1);
+    if (setpriority(PRIO_PROCESS, system_id(), kNiceValues[index]) != 0) {
+      XELOGW("Unable to set thread nice value %d: %d", kNiceValues[index],
+             errno);
+    }
+#endif  // XE_PLATFORM_LINUX
   }
 
   // TODO(DrChat)
@@ -104,18 +163,23 @@ class PosixThread : public PosixHandle<Thread> {
   }
 
   void Terminate(int exit_code) override {}
+
+ private:
+  std::shared_ptr<PosixThreadState> state_;
 };
 
 thread_local std::unique_ptr<PosixThread> current_thread_ = nullptr;
 
 struct ThreadStartData {
   std::function<void()> start_routine;
+  std::shared_ptr<PosixThreadState> state;
 };
 void* ThreadStartRoutine(void* parameter) {
-  current_thread_ =
-      std::unique_ptr<PosixThread>(new PosixThread(::pthread_self()));
-
   auto start_data = reinterpret_cast<ThreadStartData*>(parameter);
+  start_data->state->system_id = current_thread_system_id();
+  current_thread_ = std::unique_ptr<PosixThread>(
+      new PosixThread(::pthread_self(), start_data->state));
+
   start_data->start_routine();
   delete start_data;
   return 0;
@@ -123,7 +187,8 @@ void* ThreadStartRoutine(void* parameter) {
 
 std::unique_ptr<Thread> Thread::Create(CreationParameters params,
                                        std::function<void()> start_routine) {
-  auto start_data = new ThreadStartData({std::move(start_routine)});
+  auto state = std::make_shared<PosixThreadState>();
+  auto start_data = new ThreadStartData({std::move(start_routine), state});
 
   assert_false(params.create_suspended);
   pthread_t handle;
@@ -138,7 +203,7 @@ std::unique_ptr<Thread> Thread::Create(CreationParameters params,
     return nullptr;
   }
 
-  return std::unique_ptr<PosixThread>(new PosixThread(handle));
+  return std::unique_ptr<PosixThread>(new PosixThread(handle, state));
 }
 
 }  // namespace threading
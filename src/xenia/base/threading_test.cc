@@ -0,0 +1,200 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#include "xenia/base/threading.h"
+
+#include <gflags/gflags.h>
+
+#include <string>
+#include <vector>
+
+#include "third_party/catch/include/catch.hpp"
+
+DECLARE_string(guest_processor_map);
+DECLARE_int32(reserved_host_processors);
+
+namespace xe {
+namespace threading {
+namespace test {
+
+using Cores = std::vector<std::vector<uint32_t>>;
+
+// Sets the mapping flags for the duration of a test.
+class ScopedProcessorFlags {
+ public:
+  ScopedProcessorFlags(const std::string& guest_processor_map,
+                       int32_t reserved_host_processors)
+      : old_guest_processor_map_(FLAGS_guest_processor_map),
+        old_reserved_host_processors_(FLAGS_reserved_host_processors) {
+    FLAGS_guest_processor_map = guest_processor_map;
+    FLAGS_reserved_host_processors = reserved_host_processors;
+  }
+  ~ScopedProcessorFlags() {
+    FLAGS_guest_processor_map = old_guest_processor_map_;
+    FLAGS_reserved_host_processors = old_reserved_host_processors_;
+  }
+
+ private:
+  std::string old_guest_processor_map_;
+  int32_t old_reserved_host_processors_;
+};
+
+Cores MakeCores(uint32_t core_count, uint32_t threads_per_core) {
+  Cores cores(core_count);
+  for (uint32_t i = 0; i < core_count; ++i) {
+    for (uint32_t j = 0; j < threads_per_core; ++j) {
+      cores[i].push_back(i * threads_per_core + j);
+    }
+  }
+  return cores;
+}
+
+void RequireThreadProcessors(const ProcessorMap& map,
+                             const std::vector<uint32_t>& processors) {
+  REQUIRE(processors.size() == kGuestHardwareThreadCount);
+  for (uint32_t i = 0; i < kGuestHardwareThreadCount; ++i) {
+    INFO("Guest hardware thread " << i);
+    REQUIRE(map.guest_thread_masks[i] == uint64_t(1) << processors[i]);
+  }
+}
+
+TEST_CASE("processor_map_no_cores", "ProcessorMap") {
+  ScopedProcessorFlags flags("", -1);
+  auto map = BuildProcessorMap(Cores());
+  for (uint64_t mask : map.guest_thread_masks) {
+    REQUIRE(mask == 0);
+  }
+  REQUIRE(map.guest_mask == 0);
+  REQUIRE(map.reserved_mask == 0);
+}
+
+TEST_CASE("processor_map_4_cores", "ProcessorMap") {
+  ScopedProcessorFlags flags("", -1);
+
+  SECTION("Without SMT") {
+    // Too few to reserve one; the guest shares the cores round robin.
+    auto map = BuildProcessorMap(MakeCores(4, 1));
+    RequireThreadProcessors(map, {0, 1, 2, 3, 0, 1});
+    REQUIRE(map.guest_mask == 0xF);
+    REQUIRE(map.reserved_mask == 0);
+  }
+
+  SECTION("With SMT") {
+    // The last core is reserved, and each guest core gets a host core's pair
+    // of SMT siblings.
+    auto map = BuildProcessorMap(MakeCores(4, 2));
+    RequireThreadProcessors(map, {0, 1, 2, 3, 4, 5});
+    REQUIRE(map.guest_mask == 0x3F);
+    REQUIRE(map.reserved_mask == 0xC0);
+  }
+}
+
+TEST_CASE("processor_map_6_cores", "ProcessorMap") {
+  ScopedProcessorFlags flags("", -1);
+
+  SECTION("Without SMT") {
+    auto map = BuildProcessorMap(MakeCores(6, 1));
+    RequireThreadProcessors(map, {0, 1, 2, 3, 4, 5});
+    REQUIRE(map.guest_mask == 0x3F);
+    REQUIRE(map.reserved_mask == 0);
+  }
+
+  SECTION("With SMT") {
+    // Five cores left after the reservation, so SMT pairs again.
+    auto map = BuildProcessorMap(MakeCores(6, 2));
+    RequireThreadProcessors(map, {0, 1, 2, 3, 4, 5});
+    REQUIRE(map.guest_mask == 0x3FF);
+    REQUIRE(map.reserved_mask == 0xC00);
+  }
+}
+
+TEST_CASE("processor_map_8_cores", "ProcessorMap") {
+  ScopedProcessorFlags flags("", -1);
+
+  SECTION("Without SMT") {
+    auto map = BuildProcessorMap(MakeCores(8, 1));
+    RequireThreadProcessors(map, {0, 1, 2, 3, 4, 5});
+    REQUIRE(map.guest_mask == 0x7F);
+    REQUIRE(map.reserved_mask == 0x80);
+  }
+
+  SECTION("With SMT") {
+    // A core of its own for every guest hardware thread.
+    auto map = BuildProcessorMap(MakeCores(8, 2));
+    RequireThreadProcessors(map, {0, 2, 4, 6, 8, 10});
+    REQUIRE(map.guest_mask == 0x3FFF);
+    REQUIRE(map.reserved_mask == 0xC000);
+  }
+
+  SECTION("Nothing reserved") {
+    ScopedProcessorFlags no_reserve_flags("", 0);
+    auto map = BuildProcessorMap(MakeCores(8, 2));
+    RequireThreadProcessors(map, {0, 2, 4, 6, 8, 10});
+    REQUIRE(map.guest_mask == 0xFFFF);
+    REQUIRE(map.reserved_mask == 0);
+  }
+}
+
+TEST_CASE("processor_map_16_cores", "ProcessorMap") {
+  ScopedProcessorFlags flags("", -1);
+
+  SECTION("Without SMT") {
+    auto map = BuildProcessorMap(MakeCores(16, 1));
+    RequireThreadProcessors(map, {0, 1, 2, 3, 4, 5});
+    REQUIRE(map.guest_mask == 0x7FFF);
+    REQUIRE(map.reserved_mask == 0x8000);
+  }
+
+  SECTION("With SMT") {
+    auto map = BuildProcessorMap(MakeCores(16, 2));
+    RequireThreadProcessors(map, {0, 2, 4, 6, 8, 10});
+    REQUIRE(map.guest_mask == 0x3FFFFFFF);
+    REQUIRE(map.reserved_mask == 0xC0000000);
+  }
+}
+
+TEST_CASE("processor_map_ignores_processors_past_64", "ProcessorMap") {
+  ScopedProcessorFlags flags("", -1);
+  auto map = BuildProcessorMap(MakeCores(40, 2));
+  RequireThreadProcessors(map, {0, 2, 4, 6, 8, 10});
+  // Only the first 32 cores fit in a mask; the last of those is reserved.
+  REQUIRE(map.guest_mask == 0x3FFFFFFFFFFFFFFFull);
+  REQUIRE(map.reserved_mask == 0xC000000000000000ull);
+}
+
+TEST_CASE("processor_map_guest_processor_map", "ProcessorMap") {
+  SECTION("Every guest hardware thread mapped") {
+    ScopedProcessorFlags flags("0,2,4,6,8,10", -1);
+    auto map = BuildProcessorMap(MakeCores(8, 2));
+    RequireThreadProcessors(map, {0, 2, 4, 6, 8, 10});
+    REQUIRE(map.guest_mask == 0x555);
+    // Whatever isn't mapped is left to the emulator.
+    REQUIRE(map.reserved_mask == 0xFAAA);
+  }
+
+  SECTION("Short map repeats") {
+    ScopedProcessorFlags flags("3,1", -1);
+    auto map = BuildProcessorMap(MakeCores(4, 1));
+    RequireThreadProcessors(map, {3, 1, 3, 1, 3, 1});
+    REQUIRE(map.guest_mask == 0xA);
+    REQUIRE(map.reserved_mask == 0x5);
+  }
+
+  SECTION("Explicit reservation") {
+    ScopedProcessorFlags flags("0,1,2,3,4,5", 2);
+    auto map = BuildProcessorMap(MakeCores(4, 2));
+    RequireThreadProcessors(map, {0, 1, 2, 3, 4, 5});
+    REQUIRE(map.guest_mask == 0x3F);
+    REQUIRE(map.reserved_mask == 0xC0);
+  }
+}
+
+}  // namespace test
+}  // namespace threading
+}  // namespace xe
@@ -25,6 +25,32 @@ void EnableAffinityConfiguration() {
   SetProcessAffinityMask(process_handle, system_affinity_mask);
 }
 
+std::vector<std::vector<uint32_t>> QueryHostCores() {
+  DWORD buffer_size = 0;
+  GetLogicalProcessorInformation(nullptr, &buffer_size);
+  std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> infos(
+      buffer_size / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+  if (infos.empty() ||
+      !GetLogicalProcessorInformation(infos.data(), &buffer_size)) {
+    return {};
+  }
+  std::vector<std::vector<uint32_t>> cores;
+  for (auto& info : infos) {
+    if (info.Relationship != RelationProcessorCore) {
+      continue;
+    }
+    std::vector<uint32_t> core;
+    for (uint32_t processor = 0; processor < sizeof(ULONG_PTR) * 8;
+         ++processor) {
+      if (info.ProcessorMask & (ULONG_PTR(1) << processor)) {
+        core.push_back(processor);
+      }
+    }
+    cores.push_back(std::move(core));
+  }
+  return cores;
+}
+
 uint32_t current_thread_system_id() {
   return static_cast<uint32_t>(GetCurrentThreadId());
 }
@@ -41,8 +41,13 @@ class Assembler {
                         uint32_t debug_info_flags,
                         std::unique_ptr<FunctionDebugInfo> debug_info) = 0;
 
+  // Host ticks spent placing code into the code cache during the last
+  // Assemble. Included in the total time spent in Assemble.
+  uint64_t place_ticks() const { return place_ticks_; }
+
  protected:
   Backend* backend_;
+  uint64_t place_ticks_ = 0;
 };
 
 }  // namespace backend
@@ -31,6 +31,11 @@ class CodeCache {
   // function).
   virtual GuestFunction* LookupFunction(uint64_t host_pc) = 0;
 
+  // Finds the size of the stack frame allocated by the generated code
+  // containing the given host PC. Returns false if the PC is not within
+  // generated code.
+  virtual bool LookupStackSize(uint64_t host_pc, size_t* out_stack_size) = 0;
+
   // Finds platform-specific function unwind info for the given host PC.
   virtual void* LookupUnwindInfo(uint64_t host_pc) = 0;
 };
@@ -81,6 +81,7 @@ bool X64Assembler::Assemble(GuestFunction* function, HIRBuilder* builder,
                       &machine_code, &code_size, &function->source_map())) {
     return false;
   }
+  place_ticks_ = emitter_->place_ticks();
 
   // Stash generated machine code.
   if (debug_info_flags & DebugInfoFlags::kDebugInfoDisasmMachineCode) {
@@ -162,10 +162,10 @@ void* X64CodeCache::PlaceGuestCode(uint32_t guest_address, void* machine_code,
 
     // Store in map. It is maintained in sorted order of host PC dependent on
     // us also being append-only.
-    generated_code_map_.emplace_back(
-        (uint64_t(code_address - generated_code_base_) << 32) |
-            generated_code_offset_,
-        function_info);
+    generated_code_map_.push_back(
+        {(uint64_t(code_address - generated_code_base_) << 32) |
+             generated_code_offset_,
+         function_info, stack_size});
 
     // TODO(DrChat): The following code doesn't really need to be under the
     // global lock except for PlaceCode (but it depends on the previous code
@@ -192,8 +192,8 @@ void* X64CodeCache::PlaceGuestCode(uint32_t guest_address, void* machine_code,
                 xe::round_up(code_size, 16) - code_size);
 
     // Notify subclasses of placed code.
-    PlaceCode(guest_address, machine_code, code_size, stack_size, code_address,
-              unwind_reservation);
+    PlaceCode(guest_address, machine_code, code_size, stack_size,
+              function_info, code_address, unwind_reservation);
   }
 
 #if ENABLE_VTUNE
@@ -263,31 +263,37 @@ uint32_t X64CodeCache::PlaceData(const void* data, size_t length) {
   return uint32_t(uintptr_t(data_address));
 }
 
-GuestFunction* X64CodeCache::LookupFunction(uint64_t host_pc) {
+const X64CodeCache::CodeRange* X64CodeCache::LookupCodeRange(
+    uint64_t host_pc) {
   uint32_t key = uint32_t(host_pc - kGeneratedCodeBase);
-  void* fn_entry = std::bsearch(
-      &key, generated_code_map_.data(), generated_code_map_.size() + 1,
-      sizeof(std::pair<uint32_t, Function*>),
-      [](const void* key_ptr, const void* element_ptr) {
+  void* entry = std::bsearch(
+      &key, generated_code_map_.data(), generated_code_map_.size(),
+      sizeof(CodeRange), [](const void* key_ptr, const void* element_ptr) {
         auto key = *reinterpret_cast<const uint32_t*>(key_ptr);
-        auto element =
-            reinterpret_cast<const std::pair<uint64_t, GuestFunction*>*>(
-                element_ptr);
-        if (key < (element->first >> 32)) {
+        auto element = reinterpret_cast<const CodeRange*>(element_ptr);
+        if (key < (element->offsets >> 32)) {
           return -1;
-        } else if (key > uint32_t(element->first)) {
+        } else if (key >= uint32_t(element->offsets)) {
           return 1;
         } else {
           return 0;
         }
       });
-  if (fn_entry) {
-    return reinterpret_cast<const std::pair<uint64_t, GuestFunction*>*>(
-               fn_entry)
-        ->second;
-  } else {
-    return nullptr;
+  return reinterpret_cast<const CodeRange*>(entry);
+}
+
+GuestFunction* X64CodeCache::LookupFunction(uint64_t host_pc) {
+  auto code_range = LookupCodeRange(host_pc);
+  return code_range ? code_range->function : nullptr;
+}
+
+bool X64CodeCache::LookupStackSize(uint64_t host_pc, size_t* out_stack_size) {
+  auto code_range = LookupCodeRange(host_pc);
+  if (!code_range) {
+    return false;
   }
+  *out_stack_size = code_range->stack_size;
+  return true;
 }
 
 }  // namespace x64
@@ -55,6 +55,7 @@ class X64CodeCache : public CodeCache {
   uint32_t PlaceData(const void* data, size_t length);
 
   GuestFunction* LookupFunction(uint64_t host_pc) override;
+  bool LookupStackSize(uint64_t host_pc, size_t* out_stack_size) override;
 
  protected:
   // All executable code falls within 0x80000000 to 0x9FFFFFFF, so we can
@@ -85,9 +86,18 @@ class X64CodeCache : public CodeCache {
   }
   virtual void PlaceCode(uint32_t guest_address, void* machine_code,
                          size_t code_size, size_t stack_size,
-                         void* code_address,
+                         GuestFunction* function_info, void* code_address,
                          UnwindReservation unwind_reservation) {}
 
+  struct CodeRange {
+    // [start offset | end offset] from the generated code base.
+    uint64_t offsets;
+    GuestFunction* function;
+    // Size of the stack frame allocated by the code.
+    size_t stack_size;
+  };
+  const CodeRange* LookupCodeRange(uint64_t host_pc);
+
   std::wstring file_name_;
   xe::memory::FileMappingHandle mapping_ = nullptr;
 
@@ -111,8 +121,7 @@ class X64CodeCache : public CodeCache {
   std::atomic<size_t> generated_code_commit_mark_ = {0};
   // Sorted map by host PC base offsets to source function info.
   // This can be used to bsearch on host PC to find the guest function.
-  // The key is [start address | end address].
-  std::vector<std::pair<uint64_t, GuestFunction*>> generated_code_map_;
+  std::vector<CodeRange> generated_code_map_;
 };
 
 }  // namespace x64
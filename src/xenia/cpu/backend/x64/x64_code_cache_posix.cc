@@ -9,6 +9,19 @@
 
 #include "xenia/cpu/backend/x64/x64_code_cache.h"
 
+#include <gflags/gflags.h>
+#include <unistd.h>
+
+#include <cinttypes>
+#include <cstdio>
+
+#include "xenia/base/logging.h"
+#include "xenia/cpu/function.h"
+
+DEFINE_bool(perf_map, false,
+            "Write /tmp/perf-<pid>.map describing generated code so that "
+            "perf can symbolize it.");
+
 namespace xe {
 namespace cpu {
 namespace backend {
@@ -26,14 +39,18 @@ class PosixX64CodeCache : public X64CodeCache {
  private:
   /*
   UnwindReservation RequestUnwindReservation(uint8_t* entry_address) override;
-  void PlaceCode(uint32_t guest_address, void* machine_code, size_t code_size,
-                 size_t stack_size, void* code_address,
-                 UnwindReservation unwind_reservation) override;
 
   void InitializeUnwindEntry(uint8_t* unwind_entry_address,
                              size_t unwind_table_slot, void* code_address,
                              size_t code_size, size_t stack_size);
   */
+  void PlaceCode(uint32_t guest_address, void* machine_code, size_t code_size,
+                 size_t stack_size, GuestFunction* function_info,
+                 void* code_address,
+                 UnwindReservation unwind_reservation) override;
+
+  // Perf map file, if enabled. Written under the global lock.
+  FILE* perf_map_file_ = nullptr;
 };
 
 std::unique_ptr<X64CodeCache> X64CodeCache::Create() {
@@ -41,11 +58,60 @@ std::unique_ptr<X64CodeCache> X64CodeCache::Create() {
 }
 
 PosixX64CodeCache::PosixX64CodeCache() = default;
-PosixX64CodeCache::~PosixX64CodeCache() = default;
 
-bool PosixX64CodeCache::Initialize() { return X64CodeCache::Initialize(); }
+PosixX64CodeCache::~PosixX64CodeCache() {
+  if (perf_map_file_) {
+    fclose(perf_map_file_);
+    perf_map_file_ = nullptr;
+  }
+}
+
+bool PosixX64CodeCache::Initialize() {
+  if (!X64CodeCache::Initialize()) {
+    return false;
+  }
+
+  if (FLAGS_perf_map) {
+    char perf_map_path[64];
+    snprintf(perf_map_path, sizeof(perf_map_path), "/tmp/perf-%d.map",
+             int(getpid()));
+    perf_map_file_ = fopen(perf_map_path, "w");
+    if (!perf_map_file_) {
+      XELOGE("Unable to open %s for writing", perf_map_path);
+    }
+  }
+
+  return true;
+}
+
+void PosixX64CodeCache::PlaceCode(uint32_t guest_address, void* machine_code,
+                                  size_t code_size, size_t stack_size,
+                                  GuestFunction* function_info,
+                                  void* code_address,
+                                  UnwindReservation unwind_reservation) {
+  if (!perf_map_file_) {
+    return;
+  }
+
+  // perf reads the map lazily when reporting, so each entry is flushed as it
+  // is written in case we don't exit cleanly.
+  // <start> <size> <name>, with start and size in hex.
+  if (function_info && !function_info->name().empty()) {
+    fprintf(perf_map_file_, "%" PRIxPTR " %zx %s\n",
+            reinterpret_cast<uintptr_t>(code_address), code_size,
+            function_info->name().c_str());
+  } else if (guest_address) {
+    fprintf(perf_map_file_, "%" PRIxPTR " %zx sub_%.8X\n",
+            reinterpret_cast<uintptr_t>(code_address), code_size,
+            guest_address);
+  } else {
+    fprintf(perf_map_file_, "%" PRIxPTR " %zx xenia_thunk\n",
+            reinterpret_cast<uintptr_t>(code_address), code_size);
+  }
+  fflush(perf_map_file_);
+}
 
 }  // namespace x64
 }  // namespace backend
 }  // namespace cpu
-}  // namespace xe
\ No newline at end of file
+}  // namespace xe
@@ -45,7 +45,8 @@ class Win32X64CodeCache : public X64CodeCache {
  private:
   UnwindReservation RequestUnwindReservation(uint8_t* entry_address) override;
   void PlaceCode(uint32_t guest_address, void* machine_code, size_t code_size,
-                 size_t stack_size, void* code_address,
+                 size_t stack_size, GuestFunction* function_info,
+                 void* code_address,
                  UnwindReservation unwind_reservation) override;
 
   void InitializeUnwindEntry(uint8_t* unwind_entry_address,
@@ -133,6 +134,7 @@ Win32X64CodeCache::RequestUnwindReservation(uint8_t* entry_address) {
 
 void Win32X64CodeCache::PlaceCode(uint32_t guest_address, void* machine_code,
                                   size_t code_size, size_t stack_size,
+                                  GuestFunction* function_info,
                                   void* code_address,
                                   UnwindReservation unwind_reservation) {
   // Add unwind info.
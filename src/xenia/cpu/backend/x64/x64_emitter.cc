@@ -17,6 +17,7 @@
 
 #include "xenia/base/assert.h"
 #include "xenia/base/atomic.h"
+#include "xenia/base/clock.h"
 #include "xenia/base/debugging.h"
 #include "xenia/base/logging.h"
 #include "xenia/base/math.h"
@@ -124,12 +125,14 @@ void* X64Emitter::Emplace(size_t stack_size, GuestFunction* function) {
   // pointer, relocate, then return the original scratch pointer for use.
   uint8_t* old_address = top_;
   void* new_address;
+  uint64_t start_ticks = Clock::QueryHostTickCount();
   if (function) {
     new_address = code_cache_->PlaceGuestCode(function->address(), top_, size_,
                                               stack_size, function);
   } else {
     new_address = code_cache_->PlaceHostCode(0, top_, size_, stack_size);
   }
+  place_ticks_ = Clock::QueryHostTickCount() - start_ticks;
   top_ = reinterpret_cast<uint8_t*>(new_address);
   ready();
   top_ = old_address;
@@ -204,6 +204,9 @@ class X64Emitter : public Xbyak::CodeGenerator {
 
   size_t stack_size() const { return stack_size_; }
 
+  // Host ticks spent placing code into the code cache during the last Emit.
+  uint64_t place_ticks() const { return place_ticks_; }
+
  protected:
   void* Emplace(size_t stack_size, GuestFunction* function = nullptr);
   bool Emit(hir::HIRBuilder* builder, size_t* out_stack_size);
@@ -228,6 +231,7 @@ class X64Emitter : public Xbyak::CodeGenerator {
   Arena source_map_arena_;
 
   size_t stack_size_ = 0;
+  uint64_t place_ticks_ = 0;
 
   static const uint32_t gpr_reg_map_[GPR_COUNT];
   static const uint32_t xmm_reg_map_[XMM_COUNT];
@@ -35,6 +35,7 @@
 #include "xenia/cpu/backend/x64/x64_emitter.h"
 #include "xenia/cpu/backend/x64/x64_tracers.h"
 #include "xenia/cpu/hir/hir_builder.h"
+#include "xenia/cpu/ppc/ppc_context.h"
 #include "xenia/cpu/processor.h"
 
 // For OPCODE_PACK/OPCODE_UNPACK
@@ -5304,30 +5305,56 @@ struct SHL_I64 : Sequence<SHL_I64, I<OPCODE_SHL, I64Op, I64Op, I8Op>> {
     EmitShlXX<SHL_I64, Reg64>(e, i);
   }
 };
-struct SHL_V128 : Sequence<SHL_V128, I<OPCODE_SHL, V128Op, V128Op, I8Op>> {
-  static void Emit(X64Emitter& e, const EmitArgType& i) {
-    // TODO(benvanik): native version (with shift magic).
-    if (i.src2.is_constant) {
-      e.mov(e.r9, i.src2.constant());
+// Shifts the whole 128-bit value (in guest byte order) by [0,7] bits.
+// Guest bytes are big endian within each dword and the dwords are in order,
+// so each dword is shifted and takes the bits shifted out of its neighbor.
+template <typename ARGS>
+void EmitShiftV128(X64Emitter& e, const ARGS& i, bool left) {
+  Xmm src1 = i.src1;
+  if (i.src1.is_constant) {
+    e.LoadConstantXmm(e.xmm2, i.src1.constant());
+    src1 = e.xmm2;
+  }
+  // Neighboring dword, with zeros shifted in at the end.
+  if (left) {
+    e.vpsrldq(e.xmm1, src1, 4);
+  } else {
+    e.vpslldq(e.xmm1, src1, 4);
+  }
+  if (i.src2.is_constant) {
+    uint8_t shamt = i.src2.constant() & 0x7;
+    if (!shamt) {
+      e.vmovdqa(i.dest, src1);
+      return;
+    }
+    if (left) {
+      e.vpslld(e.xmm0, src1, shamt);
+      e.vpsrld(e.xmm1, e.xmm1, 32 - shamt);
     } else {
-      e.mov(e.r9, i.src2);
+      e.vpsrld(e.xmm0, src1, shamt);
+      e.vpslld(e.xmm1, e.xmm1, 32 - shamt);
     }
-    e.lea(e.r8, e.StashXmm(0, i.src1));
-    e.CallNativeSafe(reinterpret_cast<void*>(EmulateShlV128));
-    e.vmovaps(i.dest, e.xmm0);
-  }
-  static __m128i EmulateShlV128(void*, __m128i src1, uint8_t src2) {
-    // Almost all instances are shamt = 1, but non-constant.
-    // shamt is [0,7]
-    uint8_t shamt = src2 & 0x7;
-    alignas(16) vec128_t value;
-    _mm_store_si128(reinterpret_cast<__m128i*>(&value), src1);
-    for (int i = 0; i < 15; ++i) {
-      value.u8[i ^ 0x3] = (value.u8[i ^ 0x3] << shamt) |
-                          (value.u8[(i + 1) ^ 0x3] >> (8 - shamt));
+  } else {
+    e.movzx(e.eax, i.src2);
+    e.and_(e.eax, 0x7);
+    e.vmovd(e.xmm3, e.eax);
+    // A shift of 32 clears the neighbor's bits when shamt is 0.
+    e.neg(e.eax);
+    e.add(e.eax, 32);
+    e.vmovd(e.xmm4, e.eax);
+    if (left) {
+      e.vpslld(e.xmm0, src1, e.xmm3);
+      e.vpsrld(e.xmm1, e.xmm1, e.xmm4);
+    } else {
+      e.vpsrld(e.xmm0, src1, e.xmm3);
+      e.vpslld(e.xmm1, e.xmm1, e.xmm4);
     }
-    value.u8[15 ^ 0x3] = value.u8[15 ^ 0x3] << shamt;
-    return _mm_load_si128(reinterpret_cast<__m128i*>(&value));
+  }
+  e.vpor(i.dest, e.xmm0, e.xmm1);
+}
+struct SHL_V128 : Sequence<SHL_V128, I<OPCODE_SHL, V128Op, V128Op, I8Op>> {
+  static void Emit(X64Emitter& e, const EmitArgType& i) {
+    EmitShiftV128(e, i, true);
   }
 };
 EMITTER_OPCODE_TABLE(OPCODE_SHL, SHL_I8, SHL_I16, SHL_I32, SHL_I64, SHL_V128);
@@ -5384,28 +5411,7 @@ struct SHR_I64 : Sequence<SHR_I64, I<OPCODE_SHR, I64Op, I64Op, I8Op>> {
 };
 struct SHR_V128 : Sequence<SHR_V128, I<OPCODE_SHR, V128Op, V128Op, I8Op>> {
   static void Emit(X64Emitter& e, const EmitArgType& i) {
-    // TODO(benvanik): native version (with shift magic).
-    if (i.src2.is_constant) {
-      e.mov(e.r9, i.src2.constant());
-    } else {
-      e.mov(e.r9, i.src2);
-    }
-    e.lea(e.r8, e.StashXmm(0, i.src1));
-    e.CallNativeSafe(reinterpret_cast<void*>(EmulateShrV128));
-    e.vmovaps(i.dest, e.xmm0);
-  }
-  static __m128i EmulateShrV128(void*, __m128i src1, uint8_t src2) {
-    // Almost all instances are shamt = 1, but non-constant.
-    // shamt is [0,7]
-    uint8_t shamt = src2 & 0x7;
-    alignas(16) vec128_t value;
-    _mm_store_si128(reinterpret_cast<__m128i*>(&value), src1);
-    for (int i = 15; i > 0; --i) {
-      value.u8[i ^ 0x3] = (value.u8[i ^ 0x3] >> shamt) |
-                          (value.u8[(i - 1) ^ 0x3] << (8 - shamt));
-    }
-    value.u8[0 ^ 0x3] = value.u8[0 ^ 0x3] >> shamt;
-    return _mm_load_si128(reinterpret_cast<__m128i*>(&value));
+    EmitShiftV128(e, i, false);
   }
 };
 EMITTER_OPCODE_TABLE(OPCODE_SHR, SHR_I8, SHR_I16, SHR_I32, SHR_I64, SHR_V128);
@@ -5460,6 +5466,97 @@ struct SHA_I64 : Sequence<SHA_I64, I<OPCODE_SHA, I64Op, I64Op, I8Op>> {
 };
 EMITTER_OPCODE_TABLE(OPCODE_SHA, SHA_I8, SHA_I16, SHA_I32, SHA_I64);
 
+// ============================================================================
+// Variable byte/word vector shifts
+// ============================================================================
+// x64 has no per-element variable shifts for bytes or words (until AVX-512),
+// but AVX2 does have them for dwords. Each lane position within a dword is
+// isolated in turn, shifted with vpsllvd/vpsrlvd/vpsravd and merged back.
+enum class VectorLaneShift {
+  kShl,
+  kShr,
+  kSha,
+  kRotateLeft,
+};
+template <typename ARGS>
+void EmitVectorLaneShiftAVX2(X64Emitter& e, const ARGS& i, int lane_bits,
+                             VectorLaneShift op) {
+  assert_true(lane_bits == 8 || lane_bits == 16);
+  Xmm src1 = i.src1;
+  if (i.src1.is_constant) {
+    e.LoadConstantXmm(e.xmm5, i.src1.constant());
+    src1 = e.xmm5;
+  }
+  Xmm src2 = i.src2;
+  if (i.src2.is_constant) {
+    e.LoadConstantXmm(e.xmm2, i.src2.constant());
+    src2 = e.xmm2;
+  }
+  // Only the low bits of each count are used (& 0x7 or & 0xF).
+  int count_bits = lane_bits == 8 ? 3 : 4;
+  for (int lane_shift = 0; lane_shift < 32; lane_shift += lane_bits) {
+    // Results accumulate in xmm0.
+    Xmm result = lane_shift ? e.xmm3 : e.xmm0;
+    // Count for this lane, zero extended to the whole dword.
+    e.vpslld(e.xmm1, src2, 32 - count_bits - lane_shift);
+    e.vpsrld(e.xmm1, e.xmm1, 32 - count_bits);
+    switch (op) {
+      case VectorLaneShift::kShl:
+        // Lane at the bottom of the dword, shift, then drop overflowed bits.
+        if (lane_shift) {
+          e.vpsrld(result, src1, lane_shift);
+          e.vpsllvd(result, result, e.xmm1);
+        } else {
+          e.vpsllvd(result, src1, e.xmm1);
+        }
+        e.vpslld(result, result, 32 - lane_bits);
+        if (lane_shift != 32 - lane_bits) {
+          e.vpsrld(result, result, 32 - lane_bits - lane_shift);
+        }
+        break;
+      case VectorLaneShift::kShr:
+      case VectorLaneShift::kSha:
+        // Lane at the top of the dword so the sign bit is in place, shift,
+        // then drop the bits shifted out below it.
+        if (lane_shift != 32 - lane_bits) {
+          e.vpslld(result, src1, 32 - lane_bits - lane_shift);
+        } else {
+          e.vmovdqa(result, src1);
+        }
+        if (op == VectorLaneShift::kSha) {
+          e.vpsravd(result, result, e.xmm1);
+        } else {
+          e.vpsrlvd(result, result, e.xmm1);
+        }
+        e.vpsrld(result, result, 32 - lane_bits);
+        if (lane_shift) {
+          e.vpslld(result, result, lane_shift);
+        }
+        break;
+      case VectorLaneShift::kRotateLeft:
+        // Lane duplicated into the bottom two lanes, so after the shift the
+        // upper copy holds the rotated value.
+        e.vpslld(result, src1, 32 - lane_bits - lane_shift);
+        e.vpsrld(result, result, 32 - lane_bits);
+        e.vpslld(e.xmm4, result, lane_bits);
+        e.vpor(result, result, e.xmm4);
+        e.vpsllvd(result, result, e.xmm1);
+        if (lane_bits != 16) {
+          e.vpslld(result, result, 32 - lane_bits * 2);
+        }
+        e.vpsrld(result, result, 32 - lane_bits);
+        if (lane_shift) {
+          e.vpslld(result, result, lane_shift);
+        }
+        break;
+    }
+    if (lane_shift) {
+      e.vpor(e.xmm0, e.xmm0, result);
+    }
+  }
+  e.vmovdqa(i.dest, e.xmm0);
+}
+
 // ============================================================================
 // OPCODE_VECTOR_SHL
 // ============================================================================
@@ -5492,7 +5589,10 @@ struct VECTOR_SHL_V128
     return _mm_load_si128(reinterpret_cast<__m128i*>(value));
   }
   static void EmitInt8(X64Emitter& e, const EmitArgType& i) {
-    // TODO(benvanik): native version (with shift magic).
+    if (e.IsFeatureEnabled(kX64EmitAVX2)) {
+      EmitVectorLaneShiftAVX2(e, i, 8, VectorLaneShift::kShl);
+      return;
+    }
     if (i.src2.is_constant) {
       e.LoadConstantXmm(e.xmm0, i.src2.constant());
       e.lea(e.r9, e.StashXmm(1, e.xmm0));
@@ -5550,17 +5650,20 @@ struct VECTOR_SHL_V128
       e.jmp(end);
     }
 
-    // TODO(benvanik): native version (with shift magic).
     e.L(emu);
-    if (i.src2.is_constant) {
-      e.LoadConstantXmm(e.xmm0, i.src2.constant());
-      e.lea(e.r9, e.StashXmm(1, e.xmm0));
+    if (e.IsFeatureEnabled(kX64EmitAVX2)) {
+      EmitVectorLaneShiftAVX2(e, i, 16, VectorLaneShift::kShl);
     } else {
-      e.lea(e.r9, e.StashXmm(1, i.src2));
+      if (i.src2.is_constant) {
+        e.LoadConstantXmm(e.xmm0, i.src2.constant());
+        e.lea(e.r9, e.StashXmm(1, e.xmm0));
+      } else {
+        e.lea(e.r9, e.StashXmm(1, i.src2));
+      }
+      e.lea(e.r8, e.StashXmm(0, i.src1));
+      e.CallNativeSafe(reinterpret_cast<void*>(EmulateVectorShlI16));
+      e.vmovaps(i.dest, e.xmm0);
     }
-    e.lea(e.r8, e.StashXmm(0, i.src1));
-    e.CallNativeSafe(reinterpret_cast<void*>(EmulateVectorShlI16));
-    e.vmovaps(i.dest, e.xmm0);
 
     e.L(end);
   }
@@ -5678,7 +5781,10 @@ struct VECTOR_SHR_V128
     return _mm_load_si128(reinterpret_cast<__m128i*>(value));
   }
   static void EmitInt8(X64Emitter& e, const EmitArgType& i) {
-    // TODO(benvanik): native version (with shift magic).
+    if (e.IsFeatureEnabled(kX64EmitAVX2)) {
+      EmitVectorLaneShiftAVX2(e, i, 8, VectorLaneShift::kShr);
+      return;
+    }
     if (i.src2.is_constant) {
       e.LoadConstantXmm(e.xmm0, i.src2.constant());
       e.lea(e.r9, e.StashXmm(1, e.xmm0));
@@ -5736,17 +5842,20 @@ struct VECTOR_SHR_V128
       e.jmp(end);
     }
 
-    // TODO(benvanik): native version (with shift magic).
     e.L(emu);
-    if (i.src2.is_constant) {
-      e.LoadConstantXmm(e.xmm0, i.src2.constant());
-      e.lea(e.r9, e.StashXmm(1, e.xmm0));
+    if (e.IsFeatureEnabled(kX64EmitAVX2)) {
+      EmitVectorLaneShiftAVX2(e, i, 16, VectorLaneShift::kShr);
     } else {
-      e.lea(e.r9, e.StashXmm(1, i.src2));
+      if (i.src2.is_constant) {
+        e.LoadConstantXmm(e.xmm0, i.src2.constant());
+        e.lea(e.r9, e.StashXmm(1, e.xmm0));
+      } else {
+        e.lea(e.r9, e.StashXmm(1, i.src2));
+      }
+      e.lea(e.r8, e.StashXmm(0, i.src1));
+      e.CallNativeSafe(reinterpret_cast<void*>(EmulateVectorShrI16));
+      e.vmovaps(i.dest, e.xmm0);
     }
-    e.lea(e.r8, e.StashXmm(0, i.src1));
-    e.CallNativeSafe(reinterpret_cast<void*>(EmulateVectorShrI16));
-    e.vmovaps(i.dest, e.xmm0);
 
     e.L(end);
   }
@@ -5849,7 +5958,10 @@ struct VECTOR_SHA_V128
   }
 
   static void EmitInt8(X64Emitter& e, const EmitArgType& i) {
-    // TODO(benvanik): native version (with shift magic).
+    if (e.IsFeatureEnabled(kX64EmitAVX2)) {
+      EmitVectorLaneShiftAVX2(e, i, 8, VectorLaneShift::kSha);
+      return;
+    }
     if (i.src2.is_constant) {
       e.LoadConstantXmm(e.xmm0, i.src2.constant());
       e.lea(e.r9, e.StashXmm(1, e.xmm0));
@@ -5909,17 +6021,20 @@ struct VECTOR_SHA_V128
       e.jmp(end);
     }
 
-    // TODO(benvanik): native version (with shift magic).
     e.L(emu);
-    if (i.src2.is_constant) {
-      e.LoadConstantXmm(e.xmm0, i.src2.constant());
-      e.lea(e.r9, e.StashXmm(1, e.xmm0));
+    if (e.IsFeatureEnabled(kX64EmitAVX2)) {
+      EmitVectorLaneShiftAVX2(e, i, 16, VectorLaneShift::kSha);
     } else {
-      e.lea(e.r9, e.StashXmm(1, i.src2));
+      if (i.src2.is_constant) {
+        e.LoadConstantXmm(e.xmm0, i.src2.constant());
+        e.lea(e.r9, e.StashXmm(1, e.xmm0));
+      } else {
+        e.lea(e.r9, e.StashXmm(1, i.src2));
+      }
+      e.lea(e.r8, e.StashXmm(0, i.src1));
+      e.CallNativeSafe(reinterpret_cast<void*>(EmulateVectorShaI16));
+      e.vmovaps(i.dest, e.xmm0);
     }
-    e.lea(e.r8, e.StashXmm(0, i.src1));
-    e.CallNativeSafe(reinterpret_cast<void*>(EmulateVectorShaI16));
-    e.vmovaps(i.dest, e.xmm0);
 
     e.L(end);
   }
@@ -6116,7 +6231,10 @@ struct VECTOR_ROTATE_LEFT_V128
   static void Emit(X64Emitter& e, const EmitArgType& i) {
     switch (i.instr->flags) {
       case INT8_TYPE:
-        // TODO(benvanik): native version (with shift magic).
+        if (e.IsFeatureEnabled(kX64EmitAVX2)) {
+          EmitVectorLaneShiftAVX2(e, i, 8, VectorLaneShift::kRotateLeft);
+          break;
+        }
         e.lea(e.r8, e.StashXmm(0, i.src1));
         if (i.src2.is_constant) {
           e.LoadConstantXmm(e.xmm0, i.src2.constant());
@@ -6128,7 +6246,10 @@ struct VECTOR_ROTATE_LEFT_V128
         e.vmovaps(i.dest, e.xmm0);
         break;
       case INT16_TYPE:
-        // TODO(benvanik): native version (with shift magic).
+        if (e.IsFeatureEnabled(kX64EmitAVX2)) {
+          EmitVectorLaneShiftAVX2(e, i, 16, VectorLaneShift::kRotateLeft);
+          break;
+        }
         e.lea(e.r8, e.StashXmm(0, i.src1));
         if (i.src2.is_constant) {
           e.LoadConstantXmm(e.xmm0, i.src2.constant());
@@ -6919,7 +7040,7 @@ struct PACK : Sequence<PACK, I<OPCODE_PACK, V128Op, V128Op, V128Op>> {
 
     if (e.IsFeatureEnabled(kX64EmitF16C)) {
       // 0|0|0|0|W|Z|Y|X
-      e.vcvtps2ph(i.dest, i.dest, 0b00000011);
+      e.vcvtps2ph(i.dest, i.src1, 0b00000011);
       // Shuffle to X|Y|0|0|0|0|0|0
       e.vpshufb(i.dest, i.dest, e.GetXmmConstPtr(XMMPackFLOAT16_2));
     } else {
@@ -7025,56 +7146,36 @@ struct PACK : Sequence<PACK, I<OPCODE_PACK, V128Op, V128Op, V128Op>> {
     e.CallNativeSafe(reinterpret_cast<void*>(EmulatePackUINT_2101010));
     e.vmovaps(i.dest, e.xmm0);
   }
-  static __m128i EmulatePack8_IN_16_UN_UN_SAT(void*, __m128i src1,
-                                              __m128i src2) {
-    alignas(16) uint16_t a[8];
-    alignas(16) uint16_t b[8];
-    alignas(16) uint8_t c[16];
-    _mm_store_si128(reinterpret_cast<__m128i*>(a), src1);
-    _mm_store_si128(reinterpret_cast<__m128i*>(b), src2);
-    for (int i = 0; i < 8; ++i) {
-      c[i] = uint8_t(std::max(uint16_t(0), std::min(uint16_t(255), a[i])));
-      c[i + 8] = uint8_t(std::max(uint16_t(0), std::min(uint16_t(255), b[i])));
-    }
-    return _mm_load_si128(reinterpret_cast<__m128i*>(c));
-  }
-  static __m128i EmulatePack8_IN_16_UN_UN(void*, __m128i src1, __m128i src2) {
-    alignas(16) uint8_t a[16];
-    alignas(16) uint8_t b[16];
-    alignas(16) uint8_t c[16];
-    _mm_store_si128(reinterpret_cast<__m128i*>(a), src1);
-    _mm_store_si128(reinterpret_cast<__m128i*>(b), src2);
-    for (int i = 0; i < 8; ++i) {
-      c[i] = a[i * 2];
-      c[i + 8] = b[i * 2];
-    }
-    return _mm_load_si128(reinterpret_cast<__m128i*>(c));
-  }
   static void Emit8_IN_16(X64Emitter& e, const EmitArgType& i, uint32_t flags) {
     // TODO(benvanik): handle src2 (or src1) being constant zero
     if (IsPackInUnsigned(flags)) {
       if (IsPackOutUnsigned(flags)) {
+        Xmm src1 = i.src1;
+        if (i.src1.is_constant) {
+          e.LoadConstantXmm(e.xmm0, i.src1.constant());
+          src1 = e.xmm0;
+        }
+        Xmm src2 = i.src2;
+        if (i.src2.is_constant) {
+          e.LoadConstantXmm(e.xmm2, i.src2.constant());
+          src2 = e.xmm2;
+        }
+        // 0x00FF in each word.
+        e.vpcmpeqw(e.xmm1, e.xmm1, e.xmm1);
+        e.vpsrlw(e.xmm1, e.xmm1, 8);
         if (IsPackOutSaturate(flags)) {
           // unsigned -> unsigned + saturate
-          if (i.src2.is_constant) {
-            e.LoadConstantXmm(e.xmm0, i.src2.constant());
-            e.lea(e.r9, e.StashXmm(1, e.xmm0));
-          } else {
-            e.lea(e.r9, e.StashXmm(1, i.src2));
-          }
-          e.lea(e.r8, e.StashXmm(0, i.src1));
-          e.CallNativeSafe(
-              reinterpret_cast<void*>(EmulatePack8_IN_16_UN_UN_SAT));
-          e.vmovaps(i.dest, e.xmm0);
-          e.vpshufb(i.dest, i.dest, e.GetXmmConstPtr(XMMByteOrderMask));
+          // Clamp to 0xFF first so vpackuswb doesn't see negative words.
+          e.vpminuw(e.xmm0, src1, e.xmm1);
+          e.vpminuw(e.xmm2, src2, e.xmm1);
         } else {
           // unsigned -> unsigned
-          e.lea(e.r9, e.StashXmm(1, i.src2));
-          e.lea(e.r8, e.StashXmm(0, i.src1));
-          e.CallNativeSafe(reinterpret_cast<void*>(EmulatePack8_IN_16_UN_UN));
-          e.vmovaps(i.dest, e.xmm0);
-          e.vpshufb(i.dest, i.dest, e.GetXmmConstPtr(XMMByteOrderMask));
+          // Truncate to the low byte of each word.
+          e.vpand(e.xmm0, src1, e.xmm1);
+          e.vpand(e.xmm2, src2, e.xmm1);
         }
+        e.vpackuswb(i.dest, e.xmm0, e.xmm2);
+        e.vpshufb(i.dest, i.dest, e.GetXmmConstPtr(XMMByteOrderMask));
       } else {
         if (IsPackOutSaturate(flags)) {
           // unsigned -> signed + saturate
@@ -7595,6 +7696,145 @@ struct ATOMIC_COMPARE_EXCHANGE_I64
 EMITTER_OPCODE_TABLE(OPCODE_ATOMIC_COMPARE_EXCHANGE,
                      ATOMIC_COMPARE_EXCHANGE_I32, ATOMIC_COMPARE_EXCHANGE_I64);
 
+// ============================================================================
+// OPCODE_RESERVED_LOAD
+// ============================================================================
+// Reservations are emulated with a table of version counters, one per
+// reservation granule (a 128b line) hashed by address. Every successful
+// reserved store bumps the version of its granule, so it only succeeds if no
+// other reserved store to the granule happened since the reserved load, even
+// if the value was changed back in between. The memory is then compare
+// exchanged against the loaded value to catch plain stores.
+// Versions are always even so that the odd version left in the context after
+// a reserved store never matches.
+const uint32_t kReservationGranuleShift = 7;
+const uint32_t kReservationTableSize = 64 * 1024;
+alignas(64) uint64_t reservation_table[kReservationTableSize] = {0};
+
+// Loads the guest address into ecx and the address of the version of its
+// granule into rdx.
+template <typename T>
+void ComputeReservationAddress(X64Emitter& e, const T& guest) {
+  if (guest.is_constant) {
+    e.mov(e.ecx, static_cast<uint32_t>(guest.constant()));
+  } else {
+    e.mov(e.ecx, guest.reg().cvt32());
+  }
+  e.mov(e.eax, e.ecx);
+  e.shr(e.eax, kReservationGranuleShift);
+  e.and_(e.eax, kReservationTableSize - 1);
+  e.mov(e.rdx, uintptr_t(reservation_table));
+  e.lea(e.rdx, e.ptr[e.rdx + e.rax * 8]);
+}
+// Takes a reservation on the granule, before the value is loaded.
+void EmitReserve(X64Emitter& e) {
+  // The version is read before the value (loads are not reordered), so a
+  // racing reserved store either leaves us with a stale version or with a
+  // value it then fails to compare exchange.
+  e.mov(e.rax, e.qword[e.rdx]);
+  e.mov(e.qword[e.GetContextReg() +
+                offsetof(ppc::PPCContext, reserved_version)],
+        e.rax);
+  e.mov(e.dword[e.GetContextReg() +
+                offsetof(ppc::PPCContext, reserved_address)],
+        e.ecx);
+}
+struct RESERVED_LOAD_I32
+    : Sequence<RESERVED_LOAD_I32, I<OPCODE_RESERVED_LOAD, I32Op, I64Op>> {
+  static void Emit(X64Emitter& e, const EmitArgType& i) {
+    ComputeReservationAddress(e, i.src1);
+    EmitReserve(e);
+    e.mov(i.dest, e.dword[e.GetMembaseReg() + e.rcx]);
+    e.mov(e.dword[e.GetContextReg() + offsetof(ppc::PPCContext, reserved_val)],
+          i.dest);
+  }
+};
+struct RESERVED_LOAD_I64
+    : Sequence<RESERVED_LOAD_I64, I<OPCODE_RESERVED_LOAD, I64Op, I64Op>> {
+  static void Emit(X64Emitter& e, const EmitArgType& i) {
+    ComputeReservationAddress(e, i.src1);
+    EmitReserve(e);
+    e.mov(i.dest, e.qword[e.GetMembaseReg() + e.rcx]);
+    e.mov(e.qword[e.GetContextReg() + offsetof(ppc::PPCContext, reserved_val)],
+          i.dest);
+  }
+};
+EMITTER_OPCODE_TABLE(OPCODE_RESERVED_LOAD, RESERVED_LOAD_I32,
+                     RESERVED_LOAD_I64);
+
+// ============================================================================
+// OPCODE_RESERVED_STORE
+// ============================================================================
+// Claims the reservation by bumping the version of its granule, jumping to
+// fail if it has been lost. Leaves the reserved value in rax.
+void EmitClaimReservation(X64Emitter& e, Xbyak::Label& fail) {
+  e.cmp(e.ecx, e.dword[e.GetContextReg() +
+                       offsetof(ppc::PPCContext, reserved_address)]);
+  e.jne(fail, CodeGenerator::T_NEAR);
+  e.mov(e.rax, e.qword[e.GetContextReg() +
+                       offsetof(ppc::PPCContext, reserved_version)]);
+  e.lea(e.r8, e.ptr[e.rax + 2]);
+  e.lock();
+  e.cmpxchg(e.qword[e.rdx], e.r8);
+  e.jne(fail, CodeGenerator::T_NEAR);
+  e.mov(e.rax,
+        e.qword[e.GetContextReg() + offsetof(ppc::PPCContext, reserved_val)]);
+}
+// Drops the reservation, whether or not the store was performed.
+void EmitReleaseReservation(X64Emitter& e) {
+  e.mov(e.qword[e.GetContextReg() +
+                offsetof(ppc::PPCContext, reserved_version)],
+        1);
+}
+struct RESERVED_STORE_I32
+    : Sequence<RESERVED_STORE_I32,
+               I<OPCODE_RESERVED_STORE, I8Op, I64Op, I32Op>> {
+  static void Emit(X64Emitter& e, const EmitArgType& i) {
+    Xbyak::Label fail, done;
+    ComputeReservationAddress(e, i.src1);
+    EmitClaimReservation(e, fail);
+    if (i.src2.is_constant) {
+      e.mov(e.r8d, static_cast<uint32_t>(i.src2.constant()));
+      e.lock();
+      e.cmpxchg(e.dword[e.GetMembaseReg() + e.rcx], e.r8d);
+    } else {
+      e.lock();
+      e.cmpxchg(e.dword[e.GetMembaseReg() + e.rcx], i.src2);
+    }
+    e.sete(i.dest);
+    e.jmp(done, CodeGenerator::T_NEAR);
+    e.L(fail);
+    e.xor_(i.dest, i.dest);
+    e.L(done);
+    EmitReleaseReservation(e);
+  }
+};
+struct RESERVED_STORE_I64
+    : Sequence<RESERVED_STORE_I64,
+               I<OPCODE_RESERVED_STORE, I8Op, I64Op, I64Op>> {
+  static void Emit(X64Emitter& e, const EmitArgType& i) {
+    Xbyak::Label fail, done;
+    ComputeReservationAddress(e, i.src1);
+    EmitClaimReservation(e, fail);
+    if (i.src2.is_constant) {
+      e.mov(e.r8, i.src2.constant());
+      e.lock();
+      e.cmpxchg(e.qword[e.GetMembaseReg() + e.rcx], e.r8);
+    } else {
+      e.lock();
+      e.cmpxchg(e.qword[e.GetMembaseReg() + e.rcx], i.src2);
+    }
+    e.sete(i.dest);
+    e.jmp(done, CodeGenerator::T_NEAR);
+    e.L(fail);
+    e.xor_(i.dest, i.dest);
+    e.L(done);
+    EmitReleaseReservation(e);
+  }
+};
+EMITTER_OPCODE_TABLE(OPCODE_RESERVED_STORE, RESERVED_STORE_I32,
+                     RESERVED_STORE_I64);
+
 // ============================================================================
 // OPCODE_SET_ROUNDING_MODE
 // ============================================================================
@@ -7732,6 +7972,8 @@ void RegisterSequences() {
   Register_OPCODE_UNPACK();
   Register_OPCODE_ATOMIC_EXCHANGE();
   Register_OPCODE_ATOMIC_COMPARE_EXCHANGE();
+  Register_OPCODE_RESERVED_LOAD();
+  Register_OPCODE_RESERVED_STORE();
   Register_OPCODE_SET_ROUNDING_MODE();
 }
 
@@ -9,8 +9,10 @@
 
 #include "xenia/cpu/compiler/compiler.h"
 
+#include <algorithm>
+
+#include "xenia/base/clock.h"
 #include "xenia/base/profiling.h"
-#include "xenia/cpu/compiler/compiler_pass.h"
 
 namespace xe {
 namespace cpu {
@@ -23,6 +25,7 @@ Compiler::~Compiler() { Reset(); }
 void Compiler::AddPass(std::unique_ptr<CompilerPass> pass) {
   pass->Initialize(this);
   passes_.push_back(std::move(pass));
+  pass_ticks_.push_back(0);
 }
 
 void Compiler::Reset() {}
@@ -30,10 +33,14 @@ void Compiler::Reset() {}
 bool Compiler::Compile(xe::cpu::hir::HIRBuilder* builder) {
   // TODO(benvanik): sophisticated stuff. Run passes in parallel, run until they
   //                 stop changing things, etc.
+  std::fill(pass_ticks_.begin(), pass_ticks_.end(), 0);
   for (size_t i = 0; i < passes_.size(); ++i) {
     auto& pass = passes_[i];
     scratch_arena_.Reset();
-    if (!pass->Run(builder)) {
+    uint64_t start_ticks = Clock::QueryHostTickCount();
+    bool result = pass->Run(builder);
+    pass_ticks_[i] = Clock::QueryHostTickCount() - start_ticks;
+    if (!result) {
       return false;
     }
   }
@@ -14,6 +14,7 @@
 #include <vector>
 
 #include "xenia/base/arena.h"
+#include "xenia/cpu/compiler/compiler_pass.h"
 #include "xenia/cpu/hir/hir_builder.h"
 
 namespace xe {
@@ -26,8 +27,6 @@ namespace xe {
 namespace cpu {
 namespace compiler {
 
-class CompilerPass;
-
 class Compiler {
  public:
   explicit Compiler(Processor* processor);
@@ -42,11 +41,17 @@ class Compiler {
 
   bool Compile(hir::HIRBuilder* builder);
 
+  size_t pass_count() const { return passes_.size(); }
+  const char* pass_name(size_t index) const { return passes_[index]->name(); }
+  // Host ticks spent in each pass during the last Compile.
+  uint64_t pass_ticks(size_t index) const { return pass_ticks_[index]; }
+
  private:
   Processor* processor_;
   Arena scratch_arena_;
 
   std::vector<std::unique_ptr<CompilerPass>> passes_;
+  std::vector<uint64_t> pass_ticks_;
 };
 
 }  // namespace compiler
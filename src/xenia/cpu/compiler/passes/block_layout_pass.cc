@@ -0,0 +1,207 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#include "xenia/cpu/compiler/passes/block_layout_pass.h"
+
+#include <gflags/gflags.h>
+
+#include <algorithm>
+
+#include "xenia/cpu/execution_profile.h"
+#include "xenia/cpu/processor.h"
+
+DEFINE_bool(block_layout, true,
+            "Lay out blocks by the execution counts of the title's execution "
+            "profile, if it has one.");
+
+namespace xe {
+namespace cpu {
+namespace compiler {
+namespace passes {
+
+// TODO(benvanik): remove when enums redefined.
+using namespace xe::cpu::hir;
+
+using xe::cpu::hir::Block;
+using xe::cpu::hir::HIRBuilder;
+using xe::cpu::hir::Instr;
+using xe::cpu::hir::Label;
+
+namespace {
+const uint32_t kInvalidOrdinal = UINT32_MAX;
+}  // namespace
+
+BlockLayoutPass::BlockLayoutPass() : CompilerPass() {}
+
+BlockLayoutPass::~BlockLayoutPass() {}
+
+bool BlockLayoutPass::Run(HIRBuilder* builder) {
+  if (!FLAGS_block_layout || !processor_ ||
+      !processor_->execution_profile() ||
+      processor_->execution_profile()->empty()) {
+    return true;
+  }
+
+  blocks_.clear();
+  for (auto block = builder->first_block(); block; block = block->next) {
+    block->ordinal = uint16_t(blocks_.size());
+    blocks_.push_back(block);
+  }
+  if (blocks_.size() < 2 || !ReadCounts()) {
+    // Nothing to reorder or the function never ran while profiling.
+    return true;
+  }
+
+  BuildGraph();
+  Layout();
+  builder->ReorderBlocks(order_);
+  BiasBranches();
+
+  return true;
+}
+
+bool BlockLayoutPass::ReadCounts() {
+  // A block runs as often as its first guest instruction. Blocks without any
+  // (such as ones made for inlined returns) run as often as the block before.
+  auto profile = processor_->execution_profile();
+  counts_.assign(blocks_.size(), 0);
+  bool any_profiled = false;
+  uint64_t max_count = 0;
+  uint64_t previous_count = 0;
+  for (uint32_t n = 0; n < blocks_.size(); ++n) {
+    uint64_t count = previous_count;
+    for (auto instr = blocks_[n]->instr_head; instr; instr = instr->next) {
+      if (instr->opcode == &OPCODE_SOURCE_OFFSET_info) {
+        if (profile->GetExecutionCount(uint32_t(instr->src1.offset),
+                                       &count)) {
+          any_profiled = true;
+        }
+        break;
+      }
+    }
+    counts_[n] = count;
+    previous_count = count;
+    max_count = std::max(max_count, count);
+  }
+  return any_profiled && max_count;
+}
+
+void BlockLayoutPass::BuildGraph() {
+  // Blocks always end in explicit branches once finalized. The unconditional
+  // branch comes last, so it's the first successor found and wins ties.
+  successors_.assign(blocks_.size(), {});
+  for (uint32_t n = 0; n < blocks_.size(); ++n) {
+    for (auto instr = blocks_[n]->instr_tail;
+         instr && instr->opcode->flags & OPCODE_FLAG_BRANCH;
+         instr = instr->prev) {
+      Label* label = nullptr;
+      if (instr->opcode == &OPCODE_BRANCH_info) {
+        label = instr->src1.label;
+      } else if (instr->opcode == &OPCODE_BRANCH_TRUE_info ||
+                 instr->opcode == &OPCODE_BRANCH_FALSE_info) {
+        label = instr->src2.label;
+      }
+      if (!label || !label->block) {
+        continue;
+      }
+      auto& successors = successors_[n];
+      uint32_t target = label->block->ordinal;
+      if (std::find(successors.begin(), successors.end(), target) ==
+          successors.end()) {
+        successors.push_back(target);
+      }
+    }
+  }
+}
+
+void BlockLayoutPass::Layout() {
+  // Chains start from the entry and then from the hottest unplaced blocks.
+  std::vector<uint32_t> chain_starts;
+  for (uint32_t n = 1; n < blocks_.size(); ++n) {
+    if (counts_[n]) {
+      chain_starts.push_back(n);
+    }
+  }
+  std::stable_sort(chain_starts.begin(), chain_starts.end(),
+                   [this](uint32_t a, uint32_t b) {
+                     return counts_[a] > counts_[b];
+                   });
+
+  // Greedily follow the hottest successor of each placed block, so that it
+  // can be fallen through to.
+  std::vector<bool> placed(blocks_.size(), false);
+  order_.clear();
+  size_t next_chain_start = 0;
+  uint32_t n = 0;
+  while (true) {
+    placed[n] = true;
+    order_.push_back(blocks_[n]);
+    uint32_t next = kInvalidOrdinal;
+    for (auto successor : successors_[n]) {
+      if (!placed[successor] && counts_[successor] &&
+          (next == kInvalidOrdinal || counts_[successor] > counts_[next])) {
+        next = successor;
+      }
+    }
+    if (next == kInvalidOrdinal) {
+      while (next_chain_start < chain_starts.size() &&
+             placed[chain_starts[next_chain_start]]) {
+        ++next_chain_start;
+      }
+      if (next_chain_start == chain_starts.size()) {
+        break;
+      }
+      next = chain_starts[next_chain_start];
+    }
+    n = next;
+  }
+
+  // Blocks that never ran go last, in their original order.
+  for (n = 0; n < blocks_.size(); ++n) {
+    if (!placed[n]) {
+      order_.push_back(blocks_[n]);
+    }
+  }
+}
+
+void BlockLayoutPass::BiasBranches() {
+  // Tails like:
+  //     branch_true v1.i8, loc_hot
+  //     branch loc_cold
+  //   loc_hot:
+  // become:
+  //     branch_false v1.i8, loc_cold
+  //     branch loc_hot
+  //   loc_hot:
+  // and finalization drops the branch to the following block.
+  for (auto block : order_) {
+    auto tail = block->instr_tail;
+    if (!block->next || !tail || tail->opcode != &OPCODE_BRANCH_info) {
+      continue;
+    }
+    auto cond = tail->prev;
+    if (!cond || (cond->opcode != &OPCODE_BRANCH_TRUE_info &&
+                  cond->opcode != &OPCODE_BRANCH_FALSE_info)) {
+      continue;
+    }
+    if (cond->src2.label->block != block->next ||
+        tail->src1.label->block == block->next) {
+      continue;
+    }
+    cond->opcode = cond->opcode == &OPCODE_BRANCH_TRUE_info
+                       ? &OPCODE_BRANCH_FALSE_info
+                       : &OPCODE_BRANCH_TRUE_info;
+    std::swap(cond->src2.label, tail->src1.label);
+  }
+}
+
+}  // namespace passes
+}  // namespace compiler
+}  // namespace cpu
+}  // namespace xe
@@ -0,0 +1,57 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#ifndef XENIA_CPU_COMPILER_PASSES_BLOCK_LAYOUT_PASS_H_
+#define XENIA_CPU_COMPILER_PASSES_BLOCK_LAYOUT_PASS_H_
+
+#include <vector>
+
+#include "xenia/cpu/compiler/compiler_pass.h"
+
+namespace xe {
+namespace cpu {
+namespace compiler {
+namespace passes {
+
+// Orders blocks by the execution counts in the title's execution profile:
+// hot blocks are chained so that the most likely successor falls through,
+// and blocks that never ran (error paths, asserts) are moved to the end of
+// the function, away from the hot code.
+// Conditional branches whose likely target now follows them are inverted so
+// that the likely path is the fall-through.
+class BlockLayoutPass : public CompilerPass {
+ public:
+  BlockLayoutPass();
+  ~BlockLayoutPass() override;
+
+  const char* name() const override { return "block_layout"; }
+
+  bool Run(hir::HIRBuilder* builder) override;
+
+ private:
+  bool ReadCounts();
+  void BuildGraph();
+  void Layout();
+  void BiasBranches();
+
+  // Blocks by original ordinal and their successors.
+  std::vector<hir::Block*> blocks_;
+  std::vector<std::vector<uint32_t>> successors_;
+  // Times each block was entered, by ordinal.
+  std::vector<uint64_t> counts_;
+  // New order of blocks.
+  std::vector<hir::Block*> order_;
+};
+
+}  // namespace passes
+}  // namespace compiler
+}  // namespace cpu
+}  // namespace xe
+
+#endif  // XENIA_CPU_COMPILER_PASSES_BLOCK_LAYOUT_PASS_H_
@@ -38,6 +38,8 @@ class ContextPromotionPass : public CompilerPass {
 
   bool Initialize(Compiler* compiler) override;
 
+  const char* name() const override { return "context_promotion"; }
+
   bool Run(hir::HIRBuilder* builder) override;
 
  private:
@@ -0,0 +1,454 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#include "xenia/cpu/compiler/passes/loop_invariant_code_motion_pass.h"
+
+#include <gflags/gflags.h>
+
+#include <algorithm>
+
+#include "xenia/base/assert.h"
+#include "xenia/base/profiling.h"
+
+DECLARE_bool(debug);
+
+DEFINE_bool(loop_invariant_code_motion, true,
+            "Hoist loop invariant computations out of loops.");
+
+namespace xe {
+namespace cpu {
+namespace compiler {
+namespace passes {
+
+// TODO(benvanik): remove when enums redefined.
+using namespace xe::cpu::hir;
+
+using xe::cpu::hir::Block;
+using xe::cpu::hir::HIRBuilder;
+using xe::cpu::hir::Instr;
+using xe::cpu::hir::Value;
+
+namespace {
+const uint32_t kInvalidOrdinal = UINT32_MAX;
+
+// Branches within the function. Calls and returns are flagged as branches too,
+// but code moved before a call would run before the callee instead of after.
+bool IsLocalBranch(const Instr* i) {
+  return i->opcode == &OPCODE_BRANCH_info ||
+         i->opcode == &OPCODE_BRANCH_TRUE_info ||
+         i->opcode == &OPCODE_BRANCH_FALSE_info;
+}
+}  // namespace
+
+LoopInvariantCodeMotionPass::LoopInvariantCodeMotionPass() : CompilerPass() {}
+
+LoopInvariantCodeMotionPass::~LoopInvariantCodeMotionPass() {}
+
+bool LoopInvariantCodeMotionPass::Run(HIRBuilder* builder) {
+  // Loops like:
+  //   loc_1:
+  //     v1.i64 = load_context +40
+  //     v2.i64 = add v1.i64, 16
+  //     v3.i32 = truncate v2.i64
+  //     ...
+  //     branch_true v9.i8, loc_1
+  // become:
+  //     v1.i64 = load_context +40
+  //     v2.i64 = add v1.i64, 16
+  //     v3.i32 = truncate v2.i64
+  //     store_local l0.i32, v3.i32
+  //   loc_1:
+  //     v10.i32 = load_local l0.i32
+  //     ...
+  //     branch_true v9.i8, loc_1
+  // if nothing in the loop stores +40 or may have it changed (like calls).
+  // Hoisting breaks stepping through the loop in the debugger.
+  if (!FLAGS_loop_invariant_code_motion || FLAGS_debug) {
+    return true;
+  }
+
+  BuildGraph(builder);
+  ComputeDominators();
+  FindLoops();
+  if (loops_.empty()) {
+    return true;
+  }
+
+  invariant_values_.assign(builder->max_value_ordinal() + 1, false);
+  for (auto& loop : loops_) {
+    HoistLoop(builder, loop);
+  }
+
+  return true;
+}
+
+void LoopInvariantCodeMotionPass::BuildGraph(HIRBuilder* builder) {
+  blocks_.clear();
+  for (auto block = builder->first_block(); block; block = block->next) {
+    block->ordinal = uint16_t(blocks_.size());
+    blocks_.push_back(block);
+  }
+  successors_.assign(blocks_.size(), {});
+  predecessors_.assign(blocks_.size(), {});
+
+  // Blocks always end in explicit branches once finalized, so these are all
+  // of the edges.
+  for (uint32_t n = 0; n < blocks_.size(); ++n) {
+    for (auto instr = blocks_[n]->instr_tail;
+         instr && instr->opcode->flags & OPCODE_FLAG_BRANCH;
+         instr = instr->prev) {
+      Label* label = nullptr;
+      if (instr->opcode == &OPCODE_BRANCH_info) {
+        label = instr->src1.label;
+      } else if (instr->opcode == &OPCODE_BRANCH_TRUE_info ||
+                 instr->opcode == &OPCODE_BRANCH_FALSE_info) {
+        label = instr->src2.label;
+      }
+      if (!label || !label->block) {
+        continue;
+      }
+      uint32_t target = label->block->ordinal;
+      auto& successors = successors_[n];
+      if (std::find(successors.begin(), successors.end(), target) ==
+          successors.end()) {
+        successors.push_back(target);
+        predecessors_[target].push_back(n);
+      }
+    }
+  }
+
+  // Reverse postorder from the entry block.
+  rpo_.clear();
+  rpo_index_.assign(blocks_.size(), kInvalidOrdinal);
+  if (blocks_.empty()) {
+    return;
+  }
+  std::vector<bool> visited(blocks_.size(), false);
+  std::vector<std::pair<uint32_t, size_t>> stack;
+  stack.emplace_back(0, 0);
+  visited[0] = true;
+  while (!stack.empty()) {
+    auto& top = stack.back();
+    auto& successors = successors_[top.first];
+    if (top.second < successors.size()) {
+      uint32_t next = successors[top.second++];
+      if (!visited[next]) {
+        visited[next] = true;
+        stack.emplace_back(next, 0);
+      }
+    } else {
+      rpo_.push_back(top.first);
+      stack.pop_back();
+    }
+  }
+  std::reverse(rpo_.begin(), rpo_.end());
+  for (uint32_t n = 0; n < rpo_.size(); ++n) {
+    rpo_index_[rpo_[n]] = n;
+  }
+}
+
+void LoopInvariantCodeMotionPass::ComputeDominators() {
+  // Cooper, Harvey and Kennedy's iterative algorithm.
+  idoms_.assign(blocks_.size(), kInvalidOrdinal);
+  if (rpo_.empty()) {
+    return;
+  }
+  idoms_[rpo_[0]] = rpo_[0];
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (size_t n = 1; n < rpo_.size(); ++n) {
+      uint32_t block = rpo_[n];
+      uint32_t new_idom = kInvalidOrdinal;
+      for (uint32_t pred : predecessors_[block]) {
+        if (idoms_[pred] == kInvalidOrdinal) {
+          // Not yet processed or unreachable.
+          continue;
+        }
+        if (new_idom == kInvalidOrdinal) {
+          new_idom = pred;
+          continue;
+        }
+        uint32_t a = pred;
+        uint32_t b = new_idom;
+        while (a != b) {
+          while (rpo_index_[a] > rpo_index_[b]) {
+            a = idoms_[a];
+          }
+          while (rpo_index_[b] > rpo_index_[a]) {
+            b = idoms_[b];
+          }
+        }
+        new_idom = a;
+      }
+      if (idoms_[block] != new_idom) {
+        idoms_[block] = new_idom;
+        changed = true;
+      }
+    }
+  }
+}
+
+bool LoopInvariantCodeMotionPass::Dominates(uint32_t a, uint32_t b) const {
+  if (idoms_[b] == kInvalidOrdinal) {
+    return false;
+  }
+  while (true) {
+    if (a == b) {
+      return true;
+    }
+    uint32_t idom = idoms_[b];
+    if (idom == b) {
+      // Reached the entry.
+      return false;
+    }
+    b = idom;
+  }
+}
+
+void LoopInvariantCodeMotionPass::FindLoops() {
+  loops_.clear();
+  std::vector<bool> in_loop(blocks_.size());
+  std::vector<uint32_t> worklist;
+  for (uint32_t tail : rpo_) {
+    for (uint32_t header : successors_[tail]) {
+      if (!Dominates(header, tail)) {
+        continue;
+      }
+      // Back edge. Loops sharing a header are treated as one.
+      auto it = std::find_if(loops_.begin(), loops_.end(),
+                             [&](const Loop& l) { return l.header == header; });
+      if (it == loops_.end()) {
+        loops_.push_back({header, {header}});
+        it = loops_.end() - 1;
+      }
+      auto& loop = *it;
+      std::fill(in_loop.begin(), in_loop.end(), false);
+      for (uint32_t block : loop.blocks) {
+        in_loop[block] = true;
+      }
+
+      // The body is everything that reaches the back edge without going
+      // through the header.
+      worklist.clear();
+      if (!in_loop[tail]) {
+        in_loop[tail] = true;
+        loop.blocks.push_back(tail);
+        worklist.push_back(tail);
+      }
+      while (!worklist.empty()) {
+        uint32_t block = worklist.back();
+        worklist.pop_back();
+        for (uint32_t pred : predecessors_[block]) {
+          if (!in_loop[pred] && rpo_index_[pred] != kInvalidOrdinal) {
+            in_loop[pred] = true;
+            loop.blocks.push_back(pred);
+            worklist.push_back(pred);
+          }
+        }
+      }
+    }
+  }
+
+  // Inner loops first, so their invariants get hoisted before their enclosing
+  // loop is looked at.
+  std::sort(loops_.begin(), loops_.end(), [](const Loop& a, const Loop& b) {
+    return a.blocks.size() < b.blocks.size();
+  });
+}
+
+void LoopInvariantCodeMotionPass::HoistLoop(HIRBuilder* builder,
+                                            const Loop& loop) {
+  // Everything is hoisted into the one block entering the loop. As the
+  // hoisted code is pure it doesn't matter if that block can also skip it.
+  uint32_t preheader = kInvalidOrdinal;
+  for (uint32_t pred : predecessors_[loop.header]) {
+    if (rpo_index_[pred] == kInvalidOrdinal ||
+        std::find(loop.blocks.begin(), loop.blocks.end(), pred) !=
+            loop.blocks.end()) {
+      continue;
+    }
+    if (preheader != kInvalidOrdinal) {
+      return;
+    }
+    preheader = pred;
+  }
+  if (preheader == kInvalidOrdinal) {
+    return;
+  }
+
+  // Find what the loop may change.
+  stored_ranges_.clear();
+  for (uint32_t n : loop.blocks) {
+    for (auto i = blocks_[n]->instr_head; i; i = i->next) {
+      if (i->opcode == &OPCODE_STORE_CONTEXT_info) {
+        stored_ranges_.push_back(
+            {size_t(i->src1.offset), GetTypeSize(i->src2.value->type)});
+      } else if (i->opcode == &OPCODE_SET_ROUNDING_MODE_info) {
+        // Floating-point results would change.
+        return;
+      } else if (i->opcode->flags & OPCODE_FLAG_VOLATILE &&
+                 i->opcode != &OPCODE_BRANCH_TRUE_info &&
+                 i->opcode != &OPCODE_BRANCH_FALSE_info &&
+                 i->opcode != &OPCODE_RETURN_info &&
+                 i->opcode != &OPCODE_RETURN_TRUE_info &&
+                 i->opcode != &OPCODE_MEMORY_BARRIER_info &&
+                 i->opcode != &OPCODE_ATOMIC_EXCHANGE_info &&
+                 i->opcode != &OPCODE_ATOMIC_COMPARE_EXCHANGE_info) {
+        // Calls, traps and the like may change any of the context.
+        return;
+      }
+    }
+  }
+
+  for (uint32_t n : loop.blocks) {
+    HoistBlock(builder, blocks_[n], blocks_[preheader]);
+  }
+}
+
+bool LoopInvariantCodeMotionPass::HoistBlock(HIRBuilder* builder, Block* block,
+                                             Block* preheader) {
+  auto is_hoisted = [&](Instr* i) {
+    return i->dest && i->dest->ordinal < invariant_values_.size() &&
+           invariant_values_[i->dest->ordinal];
+  };
+
+  std::vector<Instr*> hoisted;
+  size_t saved_count = 0;
+  for (auto i = block->instr_head; i; i = i->next) {
+    if (IsInvariant(i)) {
+      invariant_values_[i->dest->ordinal] = true;
+      hoisted.push_back(i);
+      if (i->opcode != &OPCODE_ASSIGN_info) {
+        ++saved_count;
+      }
+    }
+  }
+  if (hoisted.empty()) {
+    return false;
+  }
+
+  // Results still used in the loop have to be loaded from locals, so only
+  // hoist if that's less work than recomputing them.
+  std::vector<Value*> live_values;
+  for (auto i : hoisted) {
+    for (auto use = i->dest->use_head; use; use = use->next) {
+      if (!is_hoisted(use->instr)) {
+        live_values.push_back(i->dest);
+        break;
+      }
+    }
+  }
+  // Values never live across blocks, so the marks are only needed here.
+  for (auto i : hoisted) {
+    invariant_values_[i->dest->ordinal] = false;
+  }
+  if (live_values.size() >= saved_count) {
+    return false;
+  }
+
+  // Insert before the branches ending the preheader, but after any call.
+  auto insert_point = preheader->instr_tail;
+  if (!insert_point || !IsLocalBranch(insert_point)) {
+    return false;
+  }
+  while (insert_point->prev && IsLocalBranch(insert_point->prev)) {
+    insert_point = insert_point->prev;
+  }
+  for (auto i : hoisted) {
+    i->MoveBefore(insert_point);
+  }
+
+  std::vector<Instr*> use_instrs;
+  for (auto value : live_values) {
+    Value* slot = builder->AllocLocal(value->type);
+    builder->StoreLocal(slot, value);
+    builder->last_instr()->MoveBefore(insert_point);
+
+    use_instrs.clear();
+    for (auto use = value->use_head; use; use = use->next) {
+      if (use->instr->block == block) {
+        use_instrs.push_back(use->instr);
+      }
+    }
+    Value* local_value = builder->LoadLocal(slot);
+    builder->last_instr()->MoveBefore(block->instr_head);
+    for (auto instr : use_instrs) {
+      uint32_t signature = instr->opcode->signature;
+      if (GET_OPCODE_SIG_TYPE_SRC1(signature) == OPCODE_SIG_TYPE_V &&
+          instr->src1.value == value) {
+        instr->set_src1(local_value);
+      }
+      if (GET_OPCODE_SIG_TYPE_SRC2(signature) == OPCODE_SIG_TYPE_V &&
+          instr->src2.value == value) {
+        instr->set_src2(local_value);
+      }
+      if (GET_OPCODE_SIG_TYPE_SRC3(signature) == OPCODE_SIG_TYPE_V &&
+          instr->src3.value == value) {
+        instr->set_src3(local_value);
+      }
+    }
+  }
+
+  return true;
+}
+
+bool LoopInvariantCodeMotionPass::IsInvariant(Instr* i) const {
+  if (!i->dest || (i->next && i->next->opcode->flags &
+                                  OPCODE_FLAG_PAIRED_PREV)) {
+    return false;
+  }
+
+  if (i->opcode == &OPCODE_LOAD_CONTEXT_info) {
+    size_t offset = size_t(i->src1.offset);
+    size_t length = GetTypeSize(i->dest->type);
+    for (auto& range : stored_ranges_) {
+      if (offset < range.offset + range.length &&
+          range.offset < offset + length) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Only pure instructions, and nothing that may fault when hoisted out from
+  // under a guard (like a divide by zero).
+  if (i->opcode->flags &
+          (OPCODE_FLAG_BRANCH | OPCODE_FLAG_MEMORY | OPCODE_FLAG_VOLATILE |
+           OPCODE_FLAG_IGNORE | OPCODE_FLAG_PAIRED_PREV) ||
+      i->opcode == &OPCODE_LOAD_CLOCK_info ||
+      i->opcode == &OPCODE_LOAD_LOCAL_info ||
+      i->opcode == &OPCODE_DIV_info) {
+    return false;
+  }
+  auto is_invariant_value = [&](Value* value) {
+    return value->IsConstant() ||
+           (value->ordinal < invariant_values_.size() &&
+            invariant_values_[value->ordinal]);
+  };
+  uint32_t signature = i->opcode->signature;
+  if (GET_OPCODE_SIG_TYPE_SRC1(signature) == OPCODE_SIG_TYPE_V &&
+      !is_invariant_value(i->src1.value)) {
+    return false;
+  }
+  if (GET_OPCODE_SIG_TYPE_SRC2(signature) == OPCODE_SIG_TYPE_V &&
+      !is_invariant_value(i->src2.value)) {
+    return false;
+  }
+  if (GET_OPCODE_SIG_TYPE_SRC3(signature) == OPCODE_SIG_TYPE_V &&
+      !is_invariant_value(i->src3.value)) {
+    return false;
+  }
+  return true;
+}
+
+}  // namespace passes
+}  // namespace compiler
+}  // namespace cpu
+}  // namespace xe
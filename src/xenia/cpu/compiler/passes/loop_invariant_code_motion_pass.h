@@ -0,0 +1,78 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#ifndef XENIA_CPU_COMPILER_PASSES_LOOP_INVARIANT_CODE_MOTION_PASS_H_
+#define XENIA_CPU_COMPILER_PASSES_LOOP_INVARIANT_CODE_MOTION_PASS_H_
+
+#include <vector>
+
+#include "xenia/cpu/compiler/compiler_pass.h"
+
+namespace xe {
+namespace cpu {
+namespace compiler {
+namespace passes {
+
+// Finds natural loops using dominators and hoists computations that are the
+// same on every iteration (loads of context fields the loop never stores and
+// pure arithmetic on them) into the block that enters the loop.
+// Values can't live across blocks, so hoisted results are passed into the
+// loop through locals and only chains that save work are hoisted.
+class LoopInvariantCodeMotionPass : public CompilerPass {
+ public:
+  LoopInvariantCodeMotionPass();
+  ~LoopInvariantCodeMotionPass() override;
+
+  const char* name() const override { return "loop_invariant_code_motion"; }
+
+  bool Run(hir::HIRBuilder* builder) override;
+
+ private:
+  struct Loop {
+    uint32_t header;
+    // Ordinals of all blocks in the loop, including the header.
+    std::vector<uint32_t> blocks;
+  };
+  struct ContextRange {
+    size_t offset;
+    size_t length;
+  };
+
+  void BuildGraph(hir::HIRBuilder* builder);
+  void ComputeDominators();
+  bool Dominates(uint32_t a, uint32_t b) const;
+  void FindLoops();
+  void HoistLoop(hir::HIRBuilder* builder, const Loop& loop);
+  bool HoistBlock(hir::HIRBuilder* builder, hir::Block* block,
+                  hir::Block* preheader);
+  bool IsInvariant(hir::Instr* i) const;
+
+  // Blocks by ordinal and their edges.
+  std::vector<hir::Block*> blocks_;
+  std::vector<std::vector<uint32_t>> successors_;
+  std::vector<std::vector<uint32_t>> predecessors_;
+  // Reachable blocks in reverse postorder and each block's index in it.
+  std::vector<uint32_t> rpo_;
+  std::vector<uint32_t> rpo_index_;
+  // Immediate dominator of each block.
+  std::vector<uint32_t> idoms_;
+  std::vector<Loop> loops_;
+
+  // Context ranges stored within the loop being hoisted.
+  std::vector<ContextRange> stored_ranges_;
+  // Values known to be invariant, by ordinal.
+  std::vector<bool> invariant_values_;
+};
+
+}  // namespace passes
+}  // namespace compiler
+}  // namespace cpu
+}  // namespace xe
+
+#endif  // XENIA_CPU_COMPILER_PASSES_LOOP_INVARIANT_CODE_MOTION_PASS_H_
@@ -0,0 +1,257 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#include "xenia/cpu/compiler/passes/value_numbering_pass.h"
+
+#include <gflags/gflags.h>
+
+#include "xenia/base/profiling.h"
+
+DEFINE_bool(value_numbering, true,
+            "Eliminate redundant computations within blocks.");
+
+namespace xe {
+namespace cpu {
+namespace compiler {
+namespace passes {
+
+// TODO(benvanik): remove when enums redefined.
+using namespace xe::cpu::hir;
+
+using xe::cpu::hir::Block;
+using xe::cpu::hir::HIRBuilder;
+using xe::cpu::hir::Instr;
+using xe::cpu::hir::Value;
+
+namespace {
+
+// Skips assignments so that copies of a value number the same as it.
+Value* CanonicalValue(Value* value) {
+  while (value->def && value->def->opcode == &OPCODE_ASSIGN_info) {
+    value = value->def->src1.value;
+  }
+  return value;
+}
+
+uint64_t HashCombine(uint64_t hash, uint64_t value) {
+  return (hash ^ value) * 0x100000001B3ull;
+}
+
+uint64_t HashValue(Value* value) {
+  value = CanonicalValue(value);
+  if (!value->IsConstant()) {
+    return value->ordinal;
+  }
+  // Constants are usually separate values even when equal.
+  uint64_t hash = HashCombine(0xC0, value->type);
+  switch (value->type) {
+    case INT8_TYPE:
+      return HashCombine(hash, value->constant.u8);
+    case INT16_TYPE:
+      return HashCombine(hash, value->constant.u16);
+    case INT32_TYPE:
+    case FLOAT32_TYPE:
+      return HashCombine(hash, value->constant.u32);
+    case VEC128_TYPE:
+      hash = HashCombine(hash, value->constant.v128.low);
+      return HashCombine(hash, value->constant.v128.high);
+    default:
+      return HashCombine(hash, value->constant.u64);
+  }
+}
+
+bool IsSameValue(Value* a, Value* b) {
+  a = CanonicalValue(a);
+  b = CanonicalValue(b);
+  if (a == b) {
+    return true;
+  }
+  if (!a->IsConstant() || !b->IsConstant() || a->type != b->type) {
+    return false;
+  }
+  switch (a->type) {
+    case INT8_TYPE:
+      return a->constant.u8 == b->constant.u8;
+    case INT16_TYPE:
+      return a->constant.u16 == b->constant.u16;
+    case INT32_TYPE:
+    case FLOAT32_TYPE:
+      return a->constant.u32 == b->constant.u32;
+    case VEC128_TYPE:
+      return a->constant.v128 == b->constant.v128;
+    default:
+      return a->constant.u64 == b->constant.u64;
+  }
+}
+
+uint64_t HashOp(uint32_t sig_type, const Instr::Op& op) {
+  switch (sig_type) {
+    case OPCODE_SIG_TYPE_V:
+      return HashValue(op.value);
+    case OPCODE_SIG_TYPE_O:
+      return op.offset;
+    default:
+      return 0;
+  }
+}
+
+bool IsSameOp(uint32_t sig_type, const Instr::Op& a, const Instr::Op& b) {
+  switch (sig_type) {
+    case OPCODE_SIG_TYPE_V:
+      return IsSameValue(a.value, b.value);
+    case OPCODE_SIG_TYPE_O:
+      return a.offset == b.offset;
+    default:
+      return true;
+  }
+}
+
+}  // namespace
+
+ValueNumberingPass::ValueNumberingPass() : CompilerPass() {}
+
+ValueNumberingPass::~ValueNumberingPass() {}
+
+bool ValueNumberingPass::Run(HIRBuilder* builder) {
+  // PPC code recomputes the same effective addresses, byte swaps and CR bits
+  // over and over. Once context promotion has turned reloads of registers
+  // into assignments those become plain duplicates:
+  //   v10.i64 = add v3.i64, 16
+  //   v11.i32 = truncate v10.i64
+  //   ...
+  //   v20.i64 = add v3.i64, 16
+  //   v21.i32 = truncate v20.i64
+  // becomes:
+  //   v20.i64 = v10.i64
+  //   v21.i32 = v11.i32
+  // leaving the duplicates for simplification and DCE to remove.
+  // Values don't live across blocks (the register allocator works per block)
+  // so nothing is reused from dominating blocks.
+  if (!FLAGS_value_numbering) {
+    return true;
+  }
+
+  auto block = builder->first_block();
+  while (block) {
+    NumberBlock(block);
+    block = block->next;
+  }
+
+  return true;
+}
+
+void ValueNumberingPass::NumberBlock(Block* block) {
+  size_t instr_count = 0;
+  for (auto i = block->instr_head; i; i = i->next) {
+    ++instr_count;
+  }
+  size_t table_size = 16;
+  while (table_size < instr_count * 2) {
+    table_size *= 2;
+  }
+  table_.assign(table_size, {0, nullptr});
+  size_t table_mask = table_size - 1;
+
+  for (auto i = block->instr_head; i; i = i->next) {
+    if (i->opcode == &OPCODE_SET_ROUNDING_MODE_info) {
+      // Results of floating-point ops computed before no longer match.
+      table_.assign(table_size, {0, nullptr});
+      continue;
+    }
+    if (!IsNumberable(i)) {
+      continue;
+    }
+
+    uint64_t hash = HashInstr(i);
+    size_t index = size_t(hash) & table_mask;
+    Instr* existing = nullptr;
+    while (table_[index].instr) {
+      if (table_[index].hash == hash && IsEquivalent(table_[index].instr, i)) {
+        existing = table_[index].instr;
+        break;
+      }
+      index = (index + 1) & table_mask;
+    }
+
+    if (!existing) {
+      table_[index] = {hash, i};
+    } else if (!i->next ||
+               !(i->next->opcode->flags & OPCODE_FLAG_PAIRED_PREV)) {
+      // Reuse the earlier result, unless something reads host state this
+      // instruction sets (like the saturation flag).
+      i->Replace(&OPCODE_ASSIGN_info, 0);
+      i->set_src1(existing->dest);
+    }
+  }
+}
+
+bool ValueNumberingPass::IsNumberable(Instr* i) const {
+  if (!i->dest) {
+    return false;
+  }
+  if (i->opcode->flags &
+      (OPCODE_FLAG_BRANCH | OPCODE_FLAG_MEMORY | OPCODE_FLAG_VOLATILE |
+       OPCODE_FLAG_IGNORE | OPCODE_FLAG_PAIRED_PREV)) {
+    return false;
+  }
+  // These read state that may change between two of them.
+  if (i->opcode == &OPCODE_ASSIGN_info ||
+      i->opcode == &OPCODE_LOAD_CLOCK_info ||
+      i->opcode == &OPCODE_LOAD_LOCAL_info ||
+      i->opcode == &OPCODE_LOAD_CONTEXT_info) {
+    return false;
+  }
+  return true;
+}
+
+uint64_t ValueNumberingPass::HashInstr(Instr* i) const {
+  uint32_t signature = i->opcode->signature;
+  uint64_t hash = 0xCBF29CE484222325ull;
+  hash = HashCombine(hash, reinterpret_cast<uintptr_t>(i->opcode));
+  hash = HashCombine(hash, i->flags);
+  hash = HashCombine(hash, i->dest->type);
+  uint64_t src1_hash = HashOp(GET_OPCODE_SIG_TYPE_SRC1(signature), i->src1);
+  uint64_t src2_hash = HashOp(GET_OPCODE_SIG_TYPE_SRC2(signature), i->src2);
+  if (i->opcode->flags & OPCODE_FLAG_COMMUNATIVE) {
+    // Order independent, so a + b matches b + a.
+    hash = HashCombine(hash, src1_hash + src2_hash);
+  } else {
+    hash = HashCombine(hash, src1_hash);
+    hash = HashCombine(hash, src2_hash);
+  }
+  hash = HashCombine(hash,
+                     HashOp(GET_OPCODE_SIG_TYPE_SRC3(signature), i->src3));
+  return hash;
+}
+
+bool ValueNumberingPass::IsEquivalent(Instr* a, Instr* b) const {
+  if (a->opcode != b->opcode || a->flags != b->flags ||
+      a->dest->type != b->dest->type) {
+    return false;
+  }
+  uint32_t signature = a->opcode->signature;
+  uint32_t src1_type = GET_OPCODE_SIG_TYPE_SRC1(signature);
+  uint32_t src2_type = GET_OPCODE_SIG_TYPE_SRC2(signature);
+  uint32_t src3_type = GET_OPCODE_SIG_TYPE_SRC3(signature);
+  if (!IsSameOp(src3_type, a->src3, b->src3)) {
+    return false;
+  }
+  if (IsSameOp(src1_type, a->src1, b->src1) &&
+      IsSameOp(src2_type, a->src2, b->src2)) {
+    return true;
+  }
+  return (a->opcode->flags & OPCODE_FLAG_COMMUNATIVE) &&
+         IsSameOp(src1_type, a->src1, b->src2) &&
+         IsSameOp(src2_type, a->src2, b->src1);
+}
+
+}  // namespace passes
+}  // namespace compiler
+}  // namespace cpu
+}  // namespace xe
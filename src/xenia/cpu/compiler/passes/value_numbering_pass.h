@@ -0,0 +1,55 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#ifndef XENIA_CPU_COMPILER_PASSES_VALUE_NUMBERING_PASS_H_
+#define XENIA_CPU_COMPILER_PASSES_VALUE_NUMBERING_PASS_H_
+
+#include <vector>
+
+#include "xenia/cpu/compiler/compiler_pass.h"
+
+namespace xe {
+namespace cpu {
+namespace compiler {
+namespace passes {
+
+// Common subexpression elimination by value numbering.
+// Side-effect-free instructions that compute the same thing as an earlier one
+// are replaced with an assignment of the earlier result. This is done per
+// block, as values may not live across blocks.
+class ValueNumberingPass : public CompilerPass {
+ public:
+  ValueNumberingPass();
+  ~ValueNumberingPass() override;
+
+  const char* name() const override { return "value_numbering"; }
+
+  bool Run(hir::HIRBuilder* builder) override;
+
+ private:
+  struct Entry {
+    uint64_t hash;
+    hir::Instr* instr;
+  };
+
+  void NumberBlock(hir::Block* block);
+  bool IsNumberable(hir::Instr* i) const;
+  uint64_t HashInstr(hir::Instr* i) const;
+  bool IsEquivalent(hir::Instr* a, hir::Instr* b) const;
+
+  // Open-addressed table of the instructions available so far in the block.
+  std::vector<Entry> table_;
+};
+
+}  // namespace passes
+}  // namespace compiler
+}  // namespace cpu
+}  // namespace xe
+
+#endif  // XENIA_CPU_COMPILER_PASSES_VALUE_NUMBERING_PASS_H_
@@ -0,0 +1,142 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#include "xenia/cpu/execution_profile.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include "xenia/base/filesystem.h"
+#include "xenia/cpu/function_trace_data.h"
+
+namespace xe {
+namespace cpu {
+
+// File format:
+// + 0   4b  magic
+// + 4   4b  version
+// + 8   4b  function count
+// +12       functions:
+//           4b  start_address
+//           4b  end_address
+//           8b+ instruction_execute_count[instruction count]
+const uint32_t kProfileMagic = 'XEPF';
+const uint32_t kProfileVersion = 1;
+// Anything longer is taken to be garbage rather than a function.
+const uint32_t kMaxFunctionInstructionCount = 256 * 1024;
+
+bool ExecutionProfile::GetExecutionCount(uint32_t address,
+                                         uint64_t* out_count) const {
+  auto it = functions_.upper_bound(address);
+  if (it == functions_.begin()) {
+    return false;
+  }
+  --it;
+  if (address > it->second.end_address) {
+    return false;
+  }
+  *out_count = it->second.counts[(address - it->first) / 4];
+  return true;
+}
+
+void ExecutionProfile::Accumulate(const FunctionTraceData& trace_data) {
+  if (!trace_data.is_valid() ||
+      trace_data.header()->data_size <
+          FunctionTraceData::SizeOfHeader() +
+              FunctionTraceData::SizeOfInstructionCounts(
+                  trace_data.start_address(), trace_data.end_address())) {
+    // No coverage recorded.
+    return;
+  }
+  auto& function = functions_[trace_data.start_address()];
+  uint32_t instruction_count = trace_data.instruction_count();
+  if (function.end_address != trace_data.end_address() ||
+      function.counts.size() != instruction_count) {
+    // New, or the function was analyzed differently than when the existing
+    // counts were recorded.
+    function.end_address = trace_data.end_address();
+    function.counts.assign(instruction_count, 0);
+  }
+  auto counts = reinterpret_cast<const uint64_t*>(
+      trace_data.instruction_execute_counts());
+  for (uint32_t i = 0; i < instruction_count; ++i) {
+    function.counts[i] += counts[i];
+  }
+}
+
+bool ExecutionProfile::Load(const std::wstring& path) {
+  functions_.clear();
+  FILE* file = xe::filesystem::OpenFile(path, "rb");
+  if (!file) {
+    return false;
+  }
+  fseek(file, 0, SEEK_END);
+  long file_length = ftell(file);
+  fseek(file, 0, SEEK_SET);
+  bool valid = false;
+  uint32_t header[3];
+  if (fread(header, sizeof(header), 1, file) == 1 &&
+      header[0] == kProfileMagic && header[1] == kProfileVersion) {
+    valid = true;
+    for (uint32_t i = 0; i < header[2]; ++i) {
+      uint32_t range[2];
+      if (fread(range, sizeof(range), 1, file) != 1 || range[1] < range[0]) {
+        valid = false;
+        break;
+      }
+      // Checked against what is left of the file before anything is
+      // allocated for the counts.
+      uint32_t instruction_count = (range[1] - range[0]) / 4 + 1;
+      if (uint64_t(instruction_count) * sizeof(uint64_t) >
+          uint64_t(file_length - ftell(file))) {
+        valid = false;
+        break;
+      }
+      if (instruction_count > kMaxFunctionInstructionCount) {
+        fseek(file, long(instruction_count * sizeof(uint64_t)), SEEK_CUR);
+        continue;
+      }
+      auto& function = functions_[range[0]];
+      function.end_address = range[1];
+      function.counts.resize(instruction_count);
+      if (fread(function.counts.data(), sizeof(uint64_t),
+                function.counts.size(), file) != function.counts.size()) {
+        valid = false;
+        break;
+      }
+    }
+  }
+  fclose(file);
+  if (!valid) {
+    functions_.clear();
+  }
+  return valid;
+}
+
+bool ExecutionProfile::Save(const std::wstring& path) const {
+  FILE* file = xe::filesystem::OpenFile(path, "wb");
+  if (!file) {
+    return false;
+  }
+  uint32_t header[3] = {kProfileMagic, kProfileVersion,
+                        uint32_t(functions_.size())};
+  bool result = fwrite(header, sizeof(header), 1, file) == 1;
+  for (auto it = functions_.begin(); result && it != functions_.end(); ++it) {
+    uint32_t range[2] = {it->first, it->second.end_address};
+    result = fwrite(range, sizeof(range), 1, file) == 1 &&
+             fwrite(it->second.counts.data(), sizeof(uint64_t),
+                    it->second.counts.size(),
+                    file) == it->second.counts.size();
+  }
+  fclose(file);
+  return result;
+}
+
+}  // namespace cpu
+}  // namespace xe
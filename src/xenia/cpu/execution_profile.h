@@ -0,0 +1,56 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#ifndef XENIA_CPU_EXECUTION_PROFILE_H_
+#define XENIA_CPU_EXECUTION_PROFILE_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace xe {
+namespace cpu {
+
+class FunctionTraceData;
+
+// Per-instruction execution counts of guest functions, gathered from function
+// coverage tracing. Profiles are saved per title so that later runs can lay
+// out generated code by how hot it was.
+class ExecutionProfile {
+ public:
+  bool empty() const { return functions_.empty(); }
+  size_t function_count() const { return functions_.size(); }
+
+  // Looks up how many times the instruction at the given guest address was
+  // executed. Returns false if the address is not covered by the profile.
+  bool GetExecutionCount(uint32_t address, uint64_t* out_count) const;
+
+  // Adds the instruction counts recorded in the given trace data.
+  void Accumulate(const FunctionTraceData& trace_data);
+
+  // Replaces the profile with one previously saved to the given path.
+  bool Load(const std::wstring& path);
+  bool Save(const std::wstring& path) const;
+
+ private:
+  struct FunctionCounts {
+    uint32_t end_address;
+    // One per instruction from the start address through the end address.
+    std::vector<uint64_t> counts;
+  };
+
+  // Functions by start address.
+  std::map<uint32_t, FunctionCounts> functions_;
+};
+
+}  // namespace cpu
+}  // namespace xe
+
+#endif  // XENIA_CPU_EXECUTION_PROFILE_H_
@@ -0,0 +1,186 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#include "xenia/cpu/guest_global_lock.h"
+
+#include <chrono>
+
+#include "xenia/base/assert.h"
+#include "xenia/base/clock.h"
+#include "xenia/base/platform.h"
+#include "xenia/base/threading.h"
+
+#if XE_ARCH_AMD64
+#include <emmintrin.h>
+#endif  // XE_ARCH_AMD64
+
+namespace xe {
+namespace cpu {
+
+// Polls of the lock before a waiter parks. Holders usually release it within
+// a few hundred cycles.
+const uint32_t kSpinCount = 2000;
+// Polls between yields of the time slice while spinning.
+const uint32_t kSpinsPerYield = 256;
+// How long the waiter whose turn it is has to take the lock before the others
+// assume it isn't running and skip it. Far longer than a parked waiter takes
+// to wake up.
+const uint32_t kSkipTurnAfterMs = 2;
+
+namespace {
+uint32_t CurrentThreadId() {
+  // Cached, as querying it may be a system call.
+  static thread_local uint32_t thread_id =
+      xe::threading::current_thread_system_id();
+  return thread_id;
+}
+}  // namespace
+
+void GuestGlobalLock::lock() {
+  uint32_t thread_id = CurrentThreadId();
+  if (owner_thread_id(state_.load(std::memory_order_relaxed)) == thread_id) {
+    ++recursion_count_;
+    return;
+  }
+  Acquire(TakeTicket(), thread_id);
+}
+
+uint32_t GuestGlobalLock::TakeTicket() {
+  return next_ticket_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void GuestGlobalLock::Acquire(uint32_t ticket, uint32_t thread_id) {
+  const uint64_t skip_turn_ticks =
+      Clock::host_tick_frequency() * kSkipTurnAfterMs / 1000;
+  uint64_t wait_start_ticks = 0;
+  uint32_t spin = 0;
+  bool parked = false;
+  // The state as last seen and since when, to tell if a turn goes untaken.
+  uint64_t observed_state = UINT64_MAX;
+  uint64_t observed_ticks = 0;
+  while (true) {
+    uint64_t state = state_.load(std::memory_order_acquire);
+    uint32_t serving = now_serving(state);
+    bool is_free = !owner_thread_id(state);
+    if (serving == ticket) {
+      if (is_free &&
+          state_.compare_exchange_weak(state, MakeState(ticket, thread_id),
+                                       std::memory_order_acquire)) {
+        break;
+      }
+      continue;
+    }
+    if (int32_t(serving - ticket) > 0) {
+      // Our turn was skipped while we weren't running. Queue again.
+      ticket = TakeTicket();
+      continue;
+    }
+
+    uint64_t now_ticks = Clock::QueryHostTickCount();
+    if (!wait_start_ticks) {
+      contended_count_.fetch_add(1, std::memory_order_relaxed);
+      wait_start_ticks = now_ticks;
+    }
+    if (state != observed_state) {
+      observed_state = state;
+      observed_ticks = now_ticks;
+    } else if (is_free && now_ticks - observed_ticks >= skip_turn_ticks) {
+      // Nobody took the turn in time; its waiter has most likely been
+      // suspended. Only one of the waiters noticing this gets to skip it.
+      if (state_.compare_exchange_strong(state,
+                                         MakeState(serving + 1, 0))) {
+        skipped_count_.fetch_add(1, std::memory_order_relaxed);
+        WakeParked();
+      }
+      continue;
+    }
+
+    if (spin < kSpinCount) {
+      if (++spin % kSpinsPerYield == 0) {
+        xe::threading::MaybeYield();
+      } else {
+#if XE_ARCH_AMD64
+        _mm_pause();
+#endif  // XE_ARCH_AMD64
+      }
+      continue;
+    }
+
+    // The parked count is published before rechecking the state, and turns
+    // change the state before checking the parked count, so either we see the
+    // change or it sees us (both are sequentially consistent). The wait is
+    // bounded so that a turn that is never taken still gets skipped.
+    if (!parked) {
+      parked = true;
+      total_parked_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+    std::unique_lock<std::mutex> park_lock(park_mutex_);
+    parked_count_.fetch_add(1);
+    if (state_.load() == state) {
+      park_cond_.wait_for(park_lock,
+                          std::chrono::milliseconds(kSkipTurnAfterMs));
+    }
+    parked_count_.fetch_sub(1);
+  }
+
+  if (wait_start_ticks) {
+    wait_ticks_.fetch_add(Clock::QueryHostTickCount() - wait_start_ticks,
+                          std::memory_order_relaxed);
+  }
+  recursion_count_ = 1;
+  acquire_ticks_ = Clock::QueryHostTickCount();
+  acquire_count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void GuestGlobalLock::WakeParked() {
+  if (parked_count_.load()) {
+    // The next ticket may be parked. Only it will proceed.
+    std::lock_guard<std::mutex> park_lock(park_mutex_);
+    park_cond_.notify_all();
+  }
+}
+
+void GuestGlobalLock::unlock() {
+  assert_true(is_held_by_current_thread());
+  if (--recursion_count_) {
+    return;
+  }
+
+  uint64_t held_ticks = Clock::QueryHostTickCount() - acquire_ticks_;
+  held_ticks_.fetch_add(held_ticks, std::memory_order_relaxed);
+  if (held_ticks > max_held_ticks_.load(std::memory_order_relaxed)) {
+    // Only the owner writes this.
+    max_held_ticks_.store(held_ticks, std::memory_order_relaxed);
+  }
+
+  // Only the owner changes the state while the lock is held.
+  uint64_t state = state_.load(std::memory_order_relaxed);
+  state_.store(MakeState(now_serving(state) + 1, 0));
+  WakeParked();
+}
+
+bool GuestGlobalLock::is_held_by_current_thread() const {
+  return owner_thread_id(state_.load(std::memory_order_relaxed)) ==
+         CurrentThreadId();
+}
+
+GuestGlobalLock::Stats GuestGlobalLock::stats() const {
+  Stats stats;
+  stats.acquire_count = acquire_count_.load(std::memory_order_relaxed);
+  stats.contended_count = contended_count_.load(std::memory_order_relaxed);
+  stats.parked_count = total_parked_count_.load(std::memory_order_relaxed);
+  stats.skipped_count = skipped_count_.load(std::memory_order_relaxed);
+  stats.wait_ticks = wait_ticks_.load(std::memory_order_relaxed);
+  stats.held_ticks = held_ticks_.load(std::memory_order_relaxed);
+  stats.max_held_ticks = max_held_ticks_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+}  // namespace cpu
+}  // namespace xe
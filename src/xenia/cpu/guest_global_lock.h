@@ -0,0 +1,102 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#ifndef XENIA_CPU_GUEST_GLOBAL_LOCK_H_
+#define XENIA_CPU_GUEST_GLOBAL_LOCK_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace xe {
+namespace cpu {
+
+// The lock guest code takes when it disables interrupts with mtmsr/mtmsrd.
+// It is separate from the host global critical region, so guest code spinning
+// on it doesn't contend with the JIT, kernel objects or memory heaps.
+//
+// Waiters are served in arrival order (a ticket lock). They spin for a short
+// while, as the lock is usually only held around a few instructions, and then
+// park until their turn. The owning thread may take the lock recursively.
+// A waiter may be suspended by another guest thread while it waits, so if the
+// waiter whose turn it is doesn't take the lock within a few milliseconds the
+// others skip it. A skipped waiter queues again once it runs.
+class GuestGlobalLock {
+ public:
+  struct Stats {
+    // Acquisitions not counting recursive ones.
+    uint64_t acquire_count;
+    // Acquisitions that had to wait, and those of them that parked.
+    uint64_t contended_count;
+    uint64_t parked_count;
+    // Turns skipped because their waiter didn't take the lock in time.
+    uint64_t skipped_count;
+    // Total host ticks spent waiting for and holding the lock.
+    uint64_t wait_ticks;
+    uint64_t held_ticks;
+    uint64_t max_held_ticks;
+  };
+
+  GuestGlobalLock() = default;
+  GuestGlobalLock(const GuestGlobalLock&) = delete;
+  GuestGlobalLock& operator=(const GuestGlobalLock&) = delete;
+
+  void lock();
+  void unlock();
+
+  // True if the calling thread holds the lock.
+  bool is_held_by_current_thread() const;
+
+  Stats stats() const;
+
+ private:
+  friend class GuestGlobalLockTest;
+
+  static uint64_t MakeState(uint32_t now_serving, uint32_t owner_thread_id) {
+    return uint64_t(owner_thread_id) << 32 | now_serving;
+  }
+  static uint32_t now_serving(uint64_t state) { return uint32_t(state); }
+  static uint32_t owner_thread_id(uint64_t state) {
+    return uint32_t(state >> 32);
+  }
+
+  uint32_t TakeTicket();
+  // Waits for the turn of the ticket (or of a new one, if it gets skipped)
+  // and takes the lock.
+  void Acquire(uint32_t ticket, uint32_t thread_id);
+  // Called after the turn has moved on to the next ticket.
+  void WakeParked();
+
+  std::atomic<uint32_t> next_ticket_ = {0};
+  // Ticket whose turn it is and the system ID of the owning thread (or 0),
+  // in one word so that taking a turn and skipping it can't both succeed.
+  std::atomic<uint64_t> state_ = {0};
+  // Only accessed by the owner.
+  uint32_t recursion_count_ = 0;
+  uint64_t acquire_ticks_ = 0;
+
+  // Waiters that gave up spinning sleep here.
+  std::atomic<uint32_t> parked_count_ = {0};
+  std::mutex park_mutex_;
+  std::condition_variable park_cond_;
+
+  std::atomic<uint64_t> acquire_count_ = {0};
+  std::atomic<uint64_t> contended_count_ = {0};
+  std::atomic<uint64_t> total_parked_count_ = {0};
+  std::atomic<uint64_t> skipped_count_ = {0};
+  std::atomic<uint64_t> wait_ticks_ = {0};
+  std::atomic<uint64_t> held_ticks_ = {0};
+  std::atomic<uint64_t> max_held_ticks_ = {0};
+};
+
+}  // namespace cpu
+}  // namespace xe
+
+#endif  // XENIA_CPU_GUEST_GLOBAL_LOCK_H_
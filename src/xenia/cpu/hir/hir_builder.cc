@@ -534,6 +534,18 @@ void HIRBuilder::RemoveBlock(Block* block) {
   block->next = block->prev = nullptr;
 }
 
+void HIRBuilder::ReorderBlocks(const std::vector<Block*>& blocks) {
+  if (blocks.empty()) {
+    return;
+  }
+  for (size_t i = 0; i < blocks.size(); ++i) {
+    blocks[i]->prev = i ? blocks[i - 1] : nullptr;
+    blocks[i]->next = i + 1 < blocks.size() ? blocks[i + 1] : nullptr;
+  }
+  block_head_ = blocks.front();
+  block_tail_ = blocks.back();
+}
+
 void HIRBuilder::MergeAdjacentBlocks(Block* left, Block* right) {
   assert_true(left->next == right && right->prev == left);
   assert_true(!right->incoming_edge_head ||
@@ -2107,6 +2119,25 @@ Value* HIRBuilder::AtomicCompareExchange(Value* address, Value* old_value,
   return i->dest;
 }
 
+Value* HIRBuilder::ReservedLoad(Value* address, TypeName type) {
+  ASSERT_ADDRESS_TYPE(address);
+  Instr* i = AppendInstr(OPCODE_RESERVED_LOAD_info, 0, AllocValue(type));
+  i->set_src1(address);
+  i->src2.value = i->src3.value = NULL;
+  return i->dest;
+}
+
+Value* HIRBuilder::ReservedStore(Value* address, Value* value) {
+  ASSERT_ADDRESS_TYPE(address);
+  ASSERT_INTEGER_TYPE(value);
+  Instr* i =
+      AppendInstr(OPCODE_RESERVED_STORE_info, 0, AllocValue(INT8_TYPE));
+  i->set_src1(address);
+  i->set_src2(value);
+  i->src3.value = NULL;
+  return i->dest;
+}
+
 }  // namespace hir
 }  // namespace cpu
 }  // namespace xe
@@ -64,6 +64,9 @@ class HIRBuilder {
   void RemoveEdge(Edge* edge);
   void RemoveBlock(Block* block);
   void MergeAdjacentBlocks(Block* left, Block* right);
+  // Relinks blocks in the given order, which must contain all of them.
+  // Edges are unchanged.
+  void ReorderBlocks(const std::vector<Block*>& blocks);
 
   // static allocations:
   // Value* AllocStatic(size_t length);
@@ -244,6 +247,12 @@ class HIRBuilder {
   Value* AtomicAdd(Value* address, Value* value);
   Value* AtomicSub(Value* address, Value* value);
 
+  // Loads from memory and takes a reservation on it for the thread.
+  Value* ReservedLoad(Value* address, TypeName type);
+  // Stores to memory only if the thread's reservation on the address is still
+  // held, dropping the reservation. Returns 1 if the store was performed.
+  Value* ReservedStore(Value* address, Value* value);
+
  protected:
   void DumpValue(StringBuffer* str, Value* value);
   void DumpOp(StringBuffer* str, OpcodeSignatureType sig_type, Instr::Op* op);
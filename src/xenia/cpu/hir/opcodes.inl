@@ -650,6 +650,18 @@ DEFINE_OPCODE(
     OPCODE_SIG_V_V_V_V,
     OPCODE_FLAG_VOLATILE)
 
+DEFINE_OPCODE(
+    OPCODE_RESERVED_LOAD,
+    "reserved_load",
+    OPCODE_SIG_V_V,
+    OPCODE_FLAG_MEMORY | OPCODE_FLAG_VOLATILE)
+
+DEFINE_OPCODE(
+    OPCODE_RESERVED_STORE,
+    "reserved_store",
+    OPCODE_SIG_V_V_V,
+    OPCODE_FLAG_MEMORY | OPCODE_FLAG_VOLATILE)
+
 DEFINE_OPCODE(
     OPCODE_SET_ROUNDING_MODE,
     "set_rounding_mode",
@@ -18,6 +18,7 @@
 
 namespace xe {
 namespace cpu {
+class GuestGlobalLock;
 class Processor;
 class ThreadState;
 }  // namespace cpu
@@ -408,8 +409,9 @@ typedef struct PPCContext_s {
   uint32_t thread_id;
 
   // Global interrupt lock, held while interrupts are disabled or interrupts are
-  // executing. This is shared among all threads and comes from the processor.
-  std::recursive_mutex* global_mutex;
+  // executing. This is shared among all threads and comes from the frontend.
+  // When both are needed it is taken before the global critical region.
+  GuestGlobalLock* global_lock;
 
   // Used to shuttle data into externs. Contents volatile.
   uint64_t scratch;
@@ -423,8 +425,14 @@ typedef struct PPCContext_s {
 
   uint8_t* physical_membase;
 
-  // Value of last reserved load
+  // Reservation taken by the last lwarx/ldarx: the raw value loaded, the
+  // version its granule had in the reservation table and its address. Odd
+  // versions never match the table, so they mean no reservation is held.
   uint64_t reserved_val;
+  uint64_t reserved_version;
+  uint32_t reserved_address;
+
+  uint8_t padding[52];
 
   static std::string GetRegisterName(PPCRegister reg);
   std::string GetStringFromValue(PPCRegister reg) const;
@@ -0,0 +1,53 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#include "xenia/cpu/ppc/ppc_decode_cache.h"
+
+#include "xenia/base/byte_order.h"
+#include "xenia/cpu/ppc/ppc_opcode_info.h"
+
+namespace xe {
+namespace cpu {
+namespace ppc {
+
+PPCDecodeCache::PPCDecodeCache(Memory* memory) : memory_(memory) {}
+
+void PPCDecodeCache::Reset(uint32_t start_address) {
+  start_address_ = start_address;
+  entries_.clear();
+}
+
+PPCDecodeCache::Entry PPCDecodeCache::Decode(uint32_t address) {
+  if (address < start_address_) {
+    return DecodeUncached(address);
+  }
+  size_t offset = (address - start_address_) / 4;
+  if (offset < entries_.size()) {
+    return entries_[offset];
+  }
+  if (offset > entries_.size()) {
+    // Not contiguous with what has been decoded.
+    return DecodeUncached(address);
+  }
+  auto entry = DecodeUncached(address);
+  entries_.push_back(entry);
+  return entry;
+}
+
+PPCDecodeCache::Entry PPCDecodeCache::DecodeUncached(uint32_t address) const {
+  Entry entry;
+  entry.code = xe::load_and_swap<uint32_t>(memory_->TranslateVirtual(address));
+  // Zeros are padding between functions rather than instructions.
+  entry.opcode = entry.code ? LookupOpcode(entry.code) : PPCOpcode::kInvalid;
+  return entry;
+}
+
+}  // namespace ppc
+}  // namespace cpu
+}  // namespace xe
@@ -0,0 +1,57 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#ifndef XENIA_CPU_PPC_PPC_DECODE_CACHE_H_
+#define XENIA_CPU_PPC_PPC_DECODE_CACHE_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "xenia/cpu/ppc/ppc_opcode.h"
+#include "xenia/memory.h"
+
+namespace xe {
+namespace cpu {
+namespace ppc {
+
+// Instructions of the function being translated, decoded once as the scanner
+// walks it and then reused by block discovery and HIR building.
+// Only a single contiguous run of instructions from the start address is
+// cached; anything else (such as inlined callees) is decoded on demand.
+class PPCDecodeCache {
+ public:
+  struct Entry {
+    uint32_t code;
+    PPCOpcode opcode;
+  };
+
+  explicit PPCDecodeCache(Memory* memory);
+
+  // Drops all entries and starts caching from the given address.
+  void Reset(uint32_t start_address);
+
+  Entry Decode(uint32_t address);
+
+  // Number of instructions decoded since the last reset.
+  size_t size() const { return entries_.size(); }
+
+ private:
+  Entry DecodeUncached(uint32_t address) const;
+
+  Memory* memory_;
+  uint32_t start_address_ = 0;
+  // Instructions from start_address_ on.
+  std::vector<Entry> entries_;
+};
+
+}  // namespace ppc
+}  // namespace cpu
+}  // namespace xe
+
+#endif  // XENIA_CPU_PPC_PPC_DECODE_CACHE_H_
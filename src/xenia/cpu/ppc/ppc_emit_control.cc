@@ -32,6 +32,33 @@ int InstrEmit_branch(PPCHIRBuilder& f, const char* src, uint64_t cia,
                      bool expect_true = true, bool nia_is_lr = false) {
   uint32_t call_flags = 0;
 
+  if (nia_is_lr && f.inline_return_label()) {
+    // Return from a function being inlined. These never link.
+    assert_false(lk);
+    Label* label = f.inline_return_label();
+    if (cond) {
+      if (expect_true) {
+        f.BranchTrue(cond, label);
+      } else {
+        f.BranchFalse(cond, label);
+      }
+    } else {
+      f.Branch(label);
+    }
+    return 0;
+  }
+
+  if (lk && !cond && nia->IsConstant()) {
+    // Calls to small leaf functions outside of ourself are replaced by the
+    // body of the function.
+    uint32_t nia_value = nia->AsUint64() & 0xFFFFFFFF;
+    if ((nia_value < f.function()->address() ||
+         nia_value > f.function()->end_address()) &&
+        f.InlineCall(nia_value, uint32_t(cia + 4))) {
+      return 0;
+    }
+  }
+
   // TODO(benvanik): this may be wrong and overwrite LRs when not desired!
   // The docs say always, though...
   // Note that we do the update before we branch/call as we need it to
@@ -651,16 +651,12 @@ int InstrEmit_ldarx(PPCHIRBuilder& f, const InstrData& i) {
   // RESERVE_ADDR <- real_addr(EA)
   // RT <- MEM(EA, 8)
 
-  // NOTE: we assume we are within a global lock.
-  // We could assert here that the block (or its parent) has taken a global lock
-  // already, but I haven't see anything but interrupt callbacks (which are
-  // always under a global lock) do that yet.
+  // Reservations don't need the global lock. See OPCODE_RESERVED_LOAD.
   // We issue a memory barrier here to make sure that we get good values.
   f.MemoryBarrier();
 
   Value* ea = CalculateEA_0(f, i.X.RA, i.X.RB);
-  Value* rt = f.ByteSwap(f.Load(ea, INT64_TYPE));
-  f.StoreReserved(rt);
+  Value* rt = f.ByteSwap(f.ReservedLoad(ea, INT64_TYPE));
   f.StoreGPR(i.X.RT, rt);
   return 0;
 }
@@ -676,16 +672,13 @@ int InstrEmit_lwarx(PPCHIRBuilder& f, const InstrData& i) {
   // RESERVE_ADDR <- real_addr(EA)
   // RT <- i32.0 || MEM(EA, 4)
 
-  // NOTE: we assume we are within a global lock.
-  // We could assert here that the block (or its parent) has taken a global lock
-  // already, but I haven't see anything but interrupt callbacks (which are
-  // always under a global lock) do that yet.
+  // Reservations don't need the global lock. See OPCODE_RESERVED_LOAD.
   // We issue a memory barrier here to make sure that we get good values.
   f.MemoryBarrier();
 
   Value* ea = CalculateEA_0(f, i.X.RA, i.X.RB);
-  Value* rt = f.ZeroExtend(f.ByteSwap(f.Load(ea, INT32_TYPE)), INT64_TYPE);
-  f.StoreReserved(rt);
+  Value* rt =
+      f.ZeroExtend(f.ByteSwap(f.ReservedLoad(ea, INT32_TYPE)), INT64_TYPE);
   f.StoreGPR(i.X.RT, rt);
   return 0;
 }
@@ -701,17 +694,12 @@ int InstrEmit_stdcx(PPCHIRBuilder& f, const InstrData& i) {
   // n <- 1 if store performed
   // CR0[LT GT EQ SO] = 0b00 || n || XER[SO]
 
-  // NOTE: we assume we are within a global lock.
-  // As we have been exclusively executing this entire time, we assume that no
-  // one else could have possibly touched the memory and must always succeed.
-  // We use atomic compare exchange here to support reserved load/store without
-  // being under the global lock (flag disable_global_lock - see mtmsr/mtmsrd).
-  // This will always succeed if under the global lock, however.
+  // Fails if another reserved store to the granule or a store changing the
+  // value happened since the reserved load, with or without the global lock.
 
   Value* ea = CalculateEA_0(f, i.X.RA, i.X.RB);
   Value* rt = f.ByteSwap(f.LoadGPR(i.X.RT));
-  Value* res = f.ByteSwap(f.LoadReserved());
-  Value* v = f.AtomicCompareExchange(ea, res, rt);
+  Value* v = f.ReservedStore(ea, rt);
   f.StoreContext(offsetof(PPCContext, cr0.cr0_eq), v);
   f.StoreContext(offsetof(PPCContext, cr0.cr0_lt), f.LoadZeroInt8());
   f.StoreContext(offsetof(PPCContext, cr0.cr0_gt), f.LoadZeroInt8());
@@ -734,17 +722,12 @@ int InstrEmit_stwcx(PPCHIRBuilder& f, const InstrData& i) {
   // n <- 1 if store performed
   // CR0[LT GT EQ SO] = 0b00 || n || XER[SO]
 
-  // NOTE: we assume we are within a global lock.
-  // As we have been exclusively executing this entire time, we assume that no
-  // one else could have possibly touched the memory and must always succeed.
-  // We use atomic compare exchange here to support reserved load/store without
-  // being under the global lock (flag disable_global_lock - see mtmsr/mtmsrd).
-  // This will always succeed if under the global lock, however.
+  // Fails if another reserved store to the granule or a store changing the
+  // value happened since the reserved load, with or without the global lock.
 
   Value* ea = CalculateEA_0(f, i.X.RA, i.X.RB);
   Value* rt = f.ByteSwap(f.Truncate(f.LoadGPR(i.X.RT), INT32_TYPE));
-  Value* res = f.ByteSwap(f.Truncate(f.LoadReserved(), INT32_TYPE));
-  Value* v = f.AtomicCompareExchange(ea, res, rt);
+  Value* v = f.ReservedStore(ea, rt);
   f.StoreContext(offsetof(PPCContext, cr0.cr0_eq), v);
   f.StoreContext(offsetof(PPCContext, cr0.cr0_lt), f.LoadZeroInt8());
   f.StoreContext(offsetof(PPCContext, cr0.cr0_gt), f.LoadZeroInt8());
@@ -9,7 +9,12 @@
 
 #include "xenia/cpu/ppc/ppc_frontend.h"
 
-#include "xenia/base/atomic.h"
+#include <algorithm>
+#include <cinttypes>
+
+#include "xenia/base/assert.h"
+#include "xenia/base/clock.h"
+#include "xenia/base/logging.h"
 #include "xenia/cpu/ppc/ppc_context.h"
 #include "xenia/cpu/ppc/ppc_emit.h"
 #include "xenia/cpu/ppc/ppc_opcode_info.h"
@@ -48,6 +53,19 @@ PPCFrontend::PPCFrontend(Processor* processor) : processor_(processor) {
 PPCFrontend::~PPCFrontend() {
   // Force cleanup now before we deinit.
   translator_pool_.Reset();
+
+  auto lock_stats = global_lock_.stats();
+  if (lock_stats.acquire_count) {
+    const double ticks_per_ms = Clock::host_tick_frequency() / 1000.0;
+    XELOGI("Guest global lock: %" PRIu64 " acquisitions, %" PRIu64
+           " contended (%" PRIu64 " parked, %" PRIu64
+           " turns skipped), %.3fms waiting, %.3fms held (%.3fms max)",
+           lock_stats.acquire_count, lock_stats.contended_count,
+           lock_stats.parked_count, lock_stats.skipped_count,
+           lock_stats.wait_ticks / ticks_per_ms,
+           lock_stats.held_ticks / ticks_per_ms,
+           lock_stats.max_held_ticks / ticks_per_ms);
+  }
 }
 
 Memory* PPCFrontend::memory() const { return processor_->memory(); }
@@ -55,38 +73,30 @@ Memory* PPCFrontend::memory() const { return processor_->memory(); }
 // Checks the state of the global lock and sets scratch to the current MSR
 // value.
 void CheckGlobalLock(PPCContext* ppc_context, void* arg0, void* arg1) {
-  auto global_mutex = reinterpret_cast<std::recursive_mutex*>(arg0);
-  auto global_lock_count = reinterpret_cast<int32_t*>(arg1);
-  std::lock_guard<std::recursive_mutex> lock(*global_mutex);
-  ppc_context->scratch = *global_lock_count ? 0 : 0x8000;
+  auto global_lock = reinterpret_cast<GuestGlobalLock*>(arg0);
+  ppc_context->scratch = global_lock->is_held_by_current_thread() ? 0 : 0x8000;
 }
 
 // Enters the global lock. Safe to recursion.
 void EnterGlobalLock(PPCContext* ppc_context, void* arg0, void* arg1) {
-  auto global_mutex = reinterpret_cast<std::recursive_mutex*>(arg0);
-  auto global_lock_count = reinterpret_cast<int32_t*>(arg1);
-  global_mutex->lock();
-  xe::atomic_inc(global_lock_count);
+  auto global_lock = reinterpret_cast<GuestGlobalLock*>(arg0);
+  global_lock->lock();
 }
 
 // Leaves the global lock. Safe to recursion.
 void LeaveGlobalLock(PPCContext* ppc_context, void* arg0, void* arg1) {
-  auto global_mutex = reinterpret_cast<std::recursive_mutex*>(arg0);
-  auto global_lock_count = reinterpret_cast<int32_t*>(arg1);
-  auto new_lock_count = xe::atomic_dec(global_lock_count);
-  assert_true(new_lock_count >= 0);
-  global_mutex->unlock();
+  auto global_lock = reinterpret_cast<GuestGlobalLock*>(arg0);
+  global_lock->unlock();
 }
 
 bool PPCFrontend::Initialize() {
-  void* arg0 = reinterpret_cast<void*>(&xe::global_critical_region::mutex());
-  void* arg1 = reinterpret_cast<void*>(&builtins_.global_lock_count);
-  builtins_.check_global_lock =
-      processor_->DefineBuiltin("CheckGlobalLock", CheckGlobalLock, arg0, arg1);
-  builtins_.enter_global_lock =
-      processor_->DefineBuiltin("EnterGlobalLock", EnterGlobalLock, arg0, arg1);
-  builtins_.leave_global_lock =
-      processor_->DefineBuiltin("LeaveGlobalLock", LeaveGlobalLock, arg0, arg1);
+  void* arg0 = reinterpret_cast<void*>(&global_lock_);
+  builtins_.check_global_lock = processor_->DefineBuiltin(
+      "CheckGlobalLock", CheckGlobalLock, arg0, nullptr);
+  builtins_.enter_global_lock = processor_->DefineBuiltin(
+      "EnterGlobalLock", EnterGlobalLock, arg0, nullptr);
+  builtins_.leave_global_lock = processor_->DefineBuiltin(
+      "LeaveGlobalLock", LeaveGlobalLock, arg0, nullptr);
   return true;
 }
 
@@ -107,6 +117,47 @@ bool PPCFrontend::DefineFunction(GuestFunction* function,
   return result;
 }
 
+void PPCFrontend::ResetStats() {
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  stats_ = PPCTranslationStats();
+}
+
+PPCTranslationStats PPCFrontend::stats() {
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  return stats_;
+}
+
+void PPCFrontend::AccumulateStats(const PPCTranslationStats& stats) {
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  stats_.Accumulate(stats);
+}
+
+void PPCTranslationStats::Accumulate(const PPCTranslationStats& other) {
+  function_count += other.function_count;
+  failed_count += other.failed_count;
+  guest_instr_count += other.guest_instr_count;
+  hir_instr_count += other.hir_instr_count;
+  machine_code_size += other.machine_code_size;
+  inlined_call_count += other.inlined_call_count;
+  total_ticks += other.total_ticks;
+  scan_ticks += other.scan_ticks;
+  hir_build_ticks += other.hir_build_ticks;
+  if (passes.empty()) {
+    passes = other.passes;
+  } else if (!other.passes.empty()) {
+    assert_true(passes.size() == other.passes.size());
+    for (size_t i = 0; i < other.passes.size(); ++i) {
+      passes[i].ticks += other.passes[i].ticks;
+    }
+  }
+  assemble_ticks += other.assemble_ticks;
+  place_ticks += other.place_ticks;
+  hir_arena_high_water =
+      std::max(hir_arena_high_water, other.hir_arena_high_water);
+  scratch_arena_high_water =
+      std::max(scratch_arena_high_water, other.scratch_arena_high_water);
+}
+
 }  // namespace ppc
 }  // namespace cpu
 }  // namespace xe
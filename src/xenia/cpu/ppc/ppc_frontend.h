@@ -10,10 +10,14 @@
 #ifndef XENIA_CPU_PPC_PPC_FRONTEND_H_
 #define XENIA_CPU_PPC_PPC_FRONTEND_H_
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "xenia/base/type_pool.h"
 #include "xenia/cpu/function.h"
+#include "xenia/cpu/guest_global_lock.h"
 #include "xenia/memory.h"
 
 namespace xe {
@@ -29,12 +33,46 @@ namespace ppc {
 class PPCTranslator;
 
 struct PPCBuiltins {
-  int32_t global_lock_count;
   Function* check_global_lock;
   Function* enter_global_lock;
   Function* leave_global_lock;
 };
 
+// Totals gathered while translating functions, used to find out which stage
+// of the JIT dominates compile time. Times are in host ticks.
+struct PPCTranslationStats {
+  struct PassStats {
+    const char* name;
+    uint64_t ticks;
+  };
+
+  uint64_t function_count = 0;
+  uint64_t failed_count = 0;
+  uint64_t guest_instr_count = 0;
+  // HIR instructions as emitted from guest code, before any passes run.
+  uint64_t hir_instr_count = 0;
+  uint64_t machine_code_size = 0;
+  // Call sites replaced by the body of the function called.
+  uint64_t inlined_call_count = 0;
+
+  uint64_t total_ticks = 0;
+  uint64_t scan_ticks = 0;
+  uint64_t hir_build_ticks = 0;
+  // Compiler passes, in the order they run.
+  std::vector<PassStats> passes;
+  // Lowering to machine code, including place_ticks.
+  uint64_t assemble_ticks = 0;
+  // Copying the machine code into the code cache.
+  uint64_t place_ticks = 0;
+
+  // Largest amount of arena memory used by a single function.
+  size_t hir_arena_high_water = 0;
+  size_t scratch_arena_high_water = 0;
+
+  // Adds other into these totals. Both must come from the same pass list.
+  void Accumulate(const PPCTranslationStats& other);
+};
+
 class PPCFrontend {
  public:
   explicit PPCFrontend(Processor* processor);
@@ -45,14 +83,28 @@ class PPCFrontend {
   Processor* processor() const { return processor_; }
   Memory* memory() const;
   PPCBuiltins* builtins() { return &builtins_; }
+  // Taken by guest code disabling interrupts.
+  GuestGlobalLock* global_lock() { return &global_lock_; }
 
   bool DeclareFunction(GuestFunction* function);
   bool DefineFunction(GuestFunction* function, uint32_t debug_info_flags);
 
+  bool stats_enabled() const { return stats_enabled_; }
+  void set_stats_enabled(bool enabled) { stats_enabled_ = enabled; }
+  void ResetStats();
+  PPCTranslationStats stats();
+  // Adds the stats of a single translation to the totals.
+  void AccumulateStats(const PPCTranslationStats& stats);
+
  private:
   Processor* processor_;
   PPCBuiltins builtins_ = {0};
+  GuestGlobalLock global_lock_;
   TypePool<PPCTranslator, PPCFrontend*> translator_pool_;
+
+  std::atomic<bool> stats_enabled_ = {false};
+  std::mutex stats_mutex_;
+  PPCTranslationStats stats_;
 };
 
 }  // namespace ppc
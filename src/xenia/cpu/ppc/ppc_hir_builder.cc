@@ -9,7 +9,10 @@
 
 #include "xenia/cpu/ppc/ppc_hir_builder.h"
 
+#include <gflags/gflags.h>
 #include <stddef.h>
+
+#include <algorithm>
 #include <cstring>
 
 #include "xenia/base/byte_order.h"
@@ -22,8 +25,13 @@
 #include "xenia/cpu/ppc/ppc_decode_data.h"
 #include "xenia/cpu/ppc/ppc_frontend.h"
 #include "xenia/cpu/ppc/ppc_opcode_info.h"
+#include "xenia/cpu/ppc/ppc_scanner.h"
 #include "xenia/cpu/processor.h"
 
+DEFINE_int32(inline_max_instructions, 16,
+             "Maximum size of leaf functions inlined into their callers, in "
+             "instructions. 0 to disable inlining.");
+
 namespace xe {
 namespace cpu {
 namespace ppc {
@@ -35,6 +43,10 @@ using xe::cpu::hir::Label;
 using xe::cpu::hir::TypeName;
 using xe::cpu::hir::Value;
 
+// Limit on instructions inlined into any one function, so that functions
+// calling many helpers don't grow without bound.
+const uint32_t kMaxInlinedInstrCount = 1024;
+
 // The number of times each opcode has been translated.
 // Accumulated across the entire run.
 uint32_t opcode_translation_counts[static_cast<int>(PPCOpcode::kInvalid)] = {0};
@@ -55,8 +67,11 @@ void DumpAllOpcodeCounts() {
   fflush(stdout);
 }
 
-PPCHIRBuilder::PPCHIRBuilder(PPCFrontend* frontend)
-    : HIRBuilder(), frontend_(frontend), comment_buffer_(4096) {}
+PPCHIRBuilder::PPCHIRBuilder(PPCFrontend* frontend, PPCScanner* scanner)
+    : HIRBuilder(),
+      frontend_(frontend),
+      scanner_(scanner),
+      comment_buffer_(4096) {}
 
 PPCHIRBuilder::~PPCHIRBuilder() = default;
 
@@ -68,20 +83,24 @@ void PPCHIRBuilder::Reset() {
   instr_count_ = 0;
   instr_offset_list_ = NULL;
   label_list_ = NULL;
+  inline_return_label_ = nullptr;
+  inlined_call_count_ = 0;
+  inlined_instr_count_ = 0;
   with_debug_info_ = false;
+  with_inlining_ = false;
   HIRBuilder::Reset();
 }
 
 bool PPCHIRBuilder::Emit(GuestFunction* function, uint32_t flags) {
   SCOPE_profile_cpu_f("cpu");
 
-  Memory* memory = frontend_->memory();
-
   function_ = function;
   start_address_ = function_->address();
   instr_count_ = (function_->end_address() - function_->address()) / 4 + 1;
 
   with_debug_info_ = (flags & EMIT_DEBUG_COMMENTS) == EMIT_DEBUG_COMMENTS;
+  with_inlining_ = (flags & EMIT_INLINE_CALLS) == EMIT_INLINE_CALLS &&
+                   FLAGS_inline_max_instructions > 0;
   if (with_debug_info_) {
     CommentFormat("%s fn %.8X-%.8X %s", function_->module()->name().c_str(),
                   function_->address(), function_->end_address(),
@@ -103,14 +122,26 @@ bool PPCHIRBuilder::Emit(GuestFunction* function, uint32_t flags) {
   // Always mark entry with label.
   label_list_[0] = NewLabel();
 
-  uint32_t start_address = function_->address();
-  uint32_t end_address = function_->end_address();
+  EmitInstructions(function_->address(), function_->end_address());
+
+  if (false) {
+    DumpAllOpcodeCounts();
+  }
+
+  return Finalize();
+}
+
+void PPCHIRBuilder::EmitInstructions(uint32_t start_address,
+                                     uint32_t end_address) {
+  // The scanner has already decoded the function while finding its extents.
+  auto decode_cache = scanner_->decode_cache();
+
   for (uint32_t address = start_address, offset = 0; address <= end_address;
        address += 4, offset++) {
     trace_info_.dest_count = 0;
-    uint32_t code =
-        xe::load_and_swap<uint32_t>(memory->TranslateVirtual(address));
-    auto opcode = LookupOpcode(code);
+    auto decoded = decode_cache->Decode(address);
+    uint32_t code = decoded.code;
+    auto opcode = decoded.opcode;
     auto& opcode_info = GetOpcodeInfo(opcode);
 
     // Mark label, if we were assigned one earlier on in the walk.
@@ -173,12 +204,65 @@ bool PPCHIRBuilder::Emit(GuestFunction* function, uint32_t flags) {
       DebugBreak();
     }
   }
+}
 
-  if (false) {
-    DumpAllOpcodeCounts();
+bool PPCHIRBuilder::InlineCall(uint32_t address, uint32_t return_address) {
+  // Only leaf functions are inlined, so there's never any nesting.
+  if (!with_inlining_ || inline_return_label_ ||
+      address == function_->address()) {
+    return false;
+  }
+  uint32_t max_instr_count = std::min(
+      uint32_t(FLAGS_inline_max_instructions),
+      kMaxInlinedInstrCount - inlined_instr_count_);
+  if (!max_instr_count) {
+    return false;
   }
 
-  return Finalize();
+  // Externs, builtins and the like must always be called.
+  auto callee = LookupFunction(address);
+  if (!callee || callee->behavior() != Function::Behavior::kDefault) {
+    return false;
+  }
+  uint32_t end_address;
+  if (!scanner_->ScanInlineCandidate(address, max_instr_count, &end_address)) {
+    return false;
+  }
+
+  if (with_debug_info_) {
+    CommentFormat("inlined %.8X-%.8X %s", address, end_address,
+                  callee->name().c_str());
+  }
+
+  // The callee may read LR, and it's still set once we return.
+  StoreLR(LoadConstantUint64(return_address));
+
+  // The callee gets its own label space. Its instructions keep their own
+  // source offsets, so the source map attributes them to the callee.
+  auto caller_start_address = start_address_;
+  auto caller_instr_count = instr_count_;
+  auto caller_instr_offset_list = instr_offset_list_;
+  auto caller_label_list = label_list_;
+  start_address_ = address;
+  instr_count_ = (end_address - address) / 4 + 1;
+  size_t list_size = instr_count_ * sizeof(void*);
+  instr_offset_list_ = (Instr**)arena_->Alloc(list_size);
+  label_list_ = (Label**)arena_->Alloc(list_size);
+  std::memset(instr_offset_list_, 0, list_size);
+  std::memset(label_list_, 0, list_size);
+  inline_return_label_ = NewLabel();
+
+  EmitInstructions(address, end_address);
+
+  MarkLabel(inline_return_label_);
+  inline_return_label_ = nullptr;
+  start_address_ = caller_start_address;
+  instr_offset_list_ = caller_instr_offset_list;
+  label_list_ = caller_label_list;
+  inlined_instr_count_ += uint32_t(instr_count_);
+  instr_count_ = caller_instr_count;
+  ++inlined_call_count_;
+  return true;
 }
 
 void PPCHIRBuilder::MaybeBreakOnInstruction(uint32_t address) {
@@ -544,15 +628,6 @@ void PPCHIRBuilder::StoreVR(uint32_t reg, Value* value) {
   trace_reg.value = value;
 }
 
-void PPCHIRBuilder::StoreReserved(Value* val) {
-  assert_true(val->type == INT64_TYPE);
-  StoreContext(offsetof(PPCContext, reserved_val), val);
-}
-
-Value* PPCHIRBuilder::LoadReserved() {
-  return LoadContext(offsetof(PPCContext, reserved_val), INT64_TYPE);
-}
-
 }  // namespace ppc
 }  // namespace cpu
 }  // namespace xe
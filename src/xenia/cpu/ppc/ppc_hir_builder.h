@@ -20,6 +20,7 @@ namespace ppc {
 
 struct PPCBuiltins;
 class PPCFrontend;
+class PPCScanner;
 
 class PPCHIRBuilder : public hir::HIRBuilder {
   using Instr = xe::cpu::hir::Instr;
@@ -27,7 +28,7 @@ class PPCHIRBuilder : public hir::HIRBuilder {
   using Value = xe::cpu::hir::Value;
 
  public:
-  explicit PPCHIRBuilder(PPCFrontend* frontend);
+  PPCHIRBuilder(PPCFrontend* frontend, PPCScanner* scanner);
   ~PPCHIRBuilder() override;
 
   PPCBuiltins* builtins() const;
@@ -37,6 +38,8 @@ class PPCHIRBuilder : public hir::HIRBuilder {
   enum EmitFlags {
     // Emit comment nodes.
     EMIT_DEBUG_COMMENTS = 1 << 0,
+    // Inline calls to small leaf functions.
+    EMIT_INLINE_CALLS = 1 << 1,
   };
   bool Emit(GuestFunction* function, uint32_t flags);
 
@@ -44,6 +47,15 @@ class PPCHIRBuilder : public hir::HIRBuilder {
   Function* LookupFunction(uint32_t address);
   Label* LookupLabel(uint32_t address);
 
+  // Emits the function at the given address in place of a call to it, if it
+  // is a small leaf function, setting LR to the return address as the call
+  // would have. Returns false if nothing was emitted.
+  bool InlineCall(uint32_t address, uint32_t return_address);
+  // Label returns from the function being inlined branch to, if any.
+  Label* inline_return_label() const { return inline_return_label_; }
+  // Number of call sites inlined since the last Reset.
+  uint32_t inlined_call_count() const { return inlined_call_count_; }
+
   Value* LoadLR();
   void StoreLR(Value* value);
   Value* LoadCTR();
@@ -78,25 +90,28 @@ class PPCHIRBuilder : public hir::HIRBuilder {
   Value* LoadVR(uint32_t reg);
   void StoreVR(uint32_t reg, Value* value);
 
-  void StoreReserved(Value* val);
-  Value* LoadReserved();
-
  private:
+  void EmitInstructions(uint32_t start_address, uint32_t end_address);
   void MaybeBreakOnInstruction(uint32_t address);
   void AnnotateLabel(uint32_t address, Label* label);
 
   PPCFrontend* frontend_;
+  PPCScanner* scanner_;
 
   // Reset whenever needed:
   StringBuffer comment_buffer_;
 
   // Reset each Emit:
   bool with_debug_info_;
+  bool with_inlining_;
   GuestFunction* function_;
   uint64_t start_address_;
   uint64_t instr_count_;
   Instr** instr_offset_list_;
   Label** label_list_;
+  Label* inline_return_label_;
+  uint32_t inlined_call_count_;
+  uint32_t inlined_instr_count_;
 
   // Reset each instruction.
   struct {
@@ -144,6 +144,7 @@ struct PPCOpcodeDisasmInfo {
   InstrDisasmFn disasm;
 };
 
+// Returns PPCOpcode::kInvalid if the code is not a known instruction.
 PPCOpcode LookupOpcode(uint32_t code);
 
 const PPCOpcodeInfo& GetOpcodeInfo(PPCOpcode opcode);
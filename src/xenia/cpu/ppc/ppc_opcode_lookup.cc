@@ -3,7 +3,6 @@
 #include <cstdint>
 #include <cstdlib>
 
-#include "xenia/base/assert.h"
 #include "xenia/cpu/ppc/ppc_opcode.h"
 #include "xenia/cpu/ppc/ppc_opcode_info.h"
 
@@ -11,540 +10,805 @@ namespace xe {
 namespace cpu {
 namespace ppc {
 
-constexpr uint32_t ExtractBits(uint32_t v, uint32_t a, uint32_t b) {
-  return (v >> (32 - 1 - b)) & ((1 << (b - a + 1)) - 1);
+namespace {
+
+// Instructions are decoded with two table lookups: the primary opcode
+// selects a span of extended opcode bits, which indexes the opcode in
+// kExtendedTable. The rare encodings that depend on other bits too index a
+// list in kResidualTable instead, matched in order.
+struct PrimaryEntry {
+  uint16_t offset;  // Of the subtable in kExtendedTable.
+  uint16_t mask;  // Of the subtable index, after shifting.
+  uint32_t shift;
+};
+struct ResidualEntry {
+  uint32_t mask;  // 0 for the last entry of a list, which always matches.
+  uint32_t match;
+  uint16_t opcode;
+};
+
+constexpr uint16_t kResidualFlag = 0x8000;
+static_assert(static_cast<uint16_t>(PPCOpcode::kInvalid) < kResidualFlag, "PPC table overflow - too many opcodes");
+
+#define OP(name) static_cast<uint16_t>(PPCOpcode::name)
+#define INV OP(kInvalid)
+#define RES(index) static_cast<uint16_t>(kResidualFlag | index)
+
+const PrimaryEntry kPrimaryTable[64] = {
+  {   0, 0x000,  0},  // 0
+  {   0, 0x000,  0},  // 1
+  {   1, 0x000,  0},  // 2
+  {   2, 0x000,  0},  // 3
+  {   3, 0x7ff,  0},  // 4
+  {2051, 0x03f,  4},  // 5
+  {2115, 0x07f,  4},  // 6
+  {2243, 0x000,  0},  // 7
+  {2244, 0x000,  0},  // 8
+  {   0, 0x000,  0},  // 9
+  {2245, 0x000,  0},  // 10
+  {2246, 0x000,  0},  // 11
+  {2247, 0x000,  0},  // 12
+  {2248, 0x000,  0},  // 13
+  {2249, 0x000,  0},  // 14
+  {2250, 0x000,  0},  // 15
+  {2251, 0x000,  0},  // 16
+  {2252, 0x000,  0},  // 17
+  {2253, 0x000,  0},  // 18
+  {2254, 0x3ff,  1},  // 19
+  {3278, 0x000,  0},  // 20
+  {3279, 0x000,  0},  // 21
+  {   0, 0x000,  0},  // 22
+  {3280, 0x000,  0},  // 23
+  {3281, 0x000,  0},  // 24
+  {3282, 0x000,  0},  // 25
+  {3283, 0x000,  0},  // 26
+  {3284, 0x000,  0},  // 27
+  {3285, 0x000,  0},  // 28
+  {3286, 0x000,  0},  // 29
+  {3287, 0x00f,  1},  // 30
+  {3303, 0x3ff,  1},  // 31
+  {4327, 0x000,  0},  // 32
+  {4328, 0x000,  0},  // 33
+  {4329, 0x000,  0},  // 34
+  {4330, 0x000,  0},  // 35
+  {4331, 0x000,  0},  // 36
+  {4332, 0x000,  0},  // 37
+  {4333, 0x000,  0},  // 38
+  {4334, 0x000,  0},  // 39
+  {4335, 0x000,  0},  // 40
+  {4336, 0x000,  0},  // 41
+  {4337, 0x000,  0},  // 42
+  {4338, 0x000,  0},  // 43
+  {4339, 0x000,  0},  // 44
+  {4340, 0x000,  0},  // 45
+  {4341, 0x000,  0},  // 46
+  {4342, 0x000,  0},  // 47
+  {4343, 0x000,  0},  // 48
+  {4344, 0x000,  0},  // 49
+  {4345, 0x000,  0},  // 50
+  {4346, 0x000,  0},  // 51
+  {4347, 0x000,  0},  // 52
+  {4348, 0x000,  0},  // 53
+  {4349, 0x000,  0},  // 54
+  {4350, 0x000,  0},  // 55
+  {   0, 0x000,  0},  // 56
+  {   0, 0x000,  0},  // 57
+  {4351, 0x003,  0},  // 58
+  {4355, 0x01f,  1},  // 59
+  {   0, 0x000,  0},  // 60
+  {   0, 0x000,  0},  // 61
+  {4387, 0x003,  0},  // 62
+  {4391, 0x3ff,  1},  // 63
+};
+
+const uint16_t kExtendedTable[5415] = {
+  INV,             OP(tdi),         OP(twi),         OP(vaddubm),     INV,             OP(vmaxub),      OP(lvsl128),     OP(vrlb),         // 0
+  INV,             OP(vcmpequb),    OP(lvsl128),     OP(vmuloub),     INV,             OP(vaddfp),      OP(lvsl128),     OP(vmrghb),       // 8
+  INV,             OP(vpkuhum),     OP(lvsl128),     OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 16
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 24
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vmhaddshs),   OP(vmhraddshs),  OP(vmladduhm),   INV,             OP(vmsumubm),     // 32
+  OP(vmsummbm),    OP(vmsumuhm),    OP(vmsumuhs),    OP(vmsumshm),    OP(vmsumshs),    OP(vsel),        OP(vperm),       OP(vsldoi),       // 40
+  INV,             OP(vmaddfp),     OP(vnmsubfp),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 48
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 56
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vadduhm),     INV,             OP(vmaxuh),      OP(lvsr128),     OP(vrlh),         // 64
+  INV,             OP(vcmpequh),    OP(lvsr128),     OP(vmulouh),     INV,             OP(vsubfp),      OP(lvsr128),     OP(vmrghh),       // 72
+  INV,             OP(vpkuwum),     OP(lvsr128),     OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 80
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 88
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vmhaddshs),   OP(vmhraddshs),  OP(vmladduhm),   INV,             OP(vmsumubm),     // 96
+  OP(vmsummbm),    OP(vmsumuhm),    OP(vmsumuhs),    OP(vmsumshm),    OP(vmsumshs),    OP(vsel),        OP(vperm),       OP(vsldoi),       // 104
+  INV,             OP(vmaddfp),     OP(vnmsubfp),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 112
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 120
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vadduwm),     INV,             OP(vmaxuw),      OP(lvewx128),    OP(vrlw),         // 128
+  INV,             OP(vcmpequw),    OP(lvewx128),    INV,             INV,             INV,             OP(lvewx128),    OP(vmrghw),       // 136
+  INV,             OP(vpkuhus),     OP(lvewx128),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 144
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 152
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vmhaddshs),   OP(vmhraddshs),  OP(vmladduhm),   INV,             OP(vmsumubm),     // 160
+  OP(vmsummbm),    OP(vmsumuhm),    OP(vmsumuhs),    OP(vmsumshm),    OP(vmsumshs),    OP(vsel),        OP(vperm),       OP(vsldoi),       // 168
+  INV,             OP(vmaddfp),     OP(vnmsubfp),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 176
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 184
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   INV,             INV,             INV,             OP(lvx128),      INV,              // 192
+  INV,             OP(vcmpeqfp),    OP(lvx128),      INV,             INV,             INV,             OP(lvx128),      INV,              // 200
+  INV,             OP(vpkuwus),     OP(lvx128),      OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 208
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 216
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vmhaddshs),   OP(vmhraddshs),  OP(vmladduhm),   INV,             OP(vmsumubm),     // 224
+  OP(vmsummbm),    OP(vmsumuhm),    OP(vmsumuhs),    OP(vmsumshm),    OP(vmsumshs),    OP(vsel),        OP(vperm),       OP(vsldoi),       // 232
+  INV,             OP(vmaddfp),     OP(vnmsubfp),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 240
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 248
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   INV,             INV,             OP(vmaxsb),      INV,             OP(vslb),         // 256
+  INV,             INV,             INV,             OP(vmulosb),     INV,             OP(vrefp),       INV,             OP(vmrglb),       // 264
+  INV,             OP(vpkshus),     INV,             OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 272
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 280
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vmhaddshs),   OP(vmhraddshs),  OP(vmladduhm),   INV,             OP(vmsumubm),     // 288
+  OP(vmsummbm),    OP(vmsumuhm),    OP(vmsumuhs),    OP(vmsumshm),    OP(vmsumshs),    OP(vsel),        OP(vperm),       OP(vsldoi),       // 296
+  INV,             OP(vmaddfp),     OP(vnmsubfp),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 304
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 312
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   INV,             INV,             OP(vmaxsh),      INV,             OP(vslh),         // 320
+  INV,             INV,             INV,             OP(vmulosh),     INV,             OP(vrsqrtefp),   INV,             OP(vmrglh),       // 328
+  INV,             OP(vpkswus),     INV,             OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 336
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 344
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vmhaddshs),   OP(vmhraddshs),  OP(vmladduhm),   INV,             OP(vmsumubm),     // 352
+  OP(vmsummbm),    OP(vmsumuhm),    OP(vmsumuhs),    OP(vmsumshm),    OP(vmsumshs),    OP(vsel),        OP(vperm),       OP(vsldoi),       // 360
+  INV,             OP(vmaddfp),     OP(vnmsubfp),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 368
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 376
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vaddcuw),     INV,             OP(vmaxsw),      OP(stvewx128),   OP(vslw),         // 384
+  INV,             INV,             OP(stvewx128),   INV,             INV,             OP(vexptefp),    OP(stvewx128),   OP(vmrglw),       // 392
+  INV,             OP(vpkshss),     OP(stvewx128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 400
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 408
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vmhaddshs),   OP(vmhraddshs),  OP(vmladduhm),   INV,             OP(vmsumubm),     // 416
+  OP(vmsummbm),    OP(vmsumuhm),    OP(vmsumuhs),    OP(vmsumshm),    OP(vmsumshs),    OP(vsel),        OP(vperm),       OP(vsldoi),       // 424
+  INV,             OP(vmaddfp),     OP(vnmsubfp),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 432
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 440
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   INV,             INV,             INV,             OP(stvx128),     OP(vsl),          // 448
+  INV,             OP(vcmpgefp),    OP(stvx128),     INV,             INV,             OP(vlogefp),     OP(stvx128),     INV,              // 456
+  INV,             OP(vpkswss),     OP(stvx128),     OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 464
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 472
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vmhaddshs),   OP(vmhraddshs),  OP(vmladduhm),   INV,             OP(vmsumubm),     // 480
+  OP(vmsummbm),    OP(vmsumuhm),    OP(vmsumuhs),    OP(vmsumshm),    OP(vmsumshs),    OP(vsel),        OP(vperm),       OP(vsldoi),       // 488
+  INV,             OP(vmaddfp),     OP(vnmsubfp),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 496
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 504
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vaddubs),     INV,             OP(vminub),      INV,             OP(vsrb),         // 512
+  INV,             OP(vcmpgtub),    INV,             OP(vmuleub),     INV,             OP(vrfin),       INV,             OP(vspltb),       // 520
+  INV,             OP(vupkhsb),     INV,             OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 528
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 536
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vmhaddshs),   OP(vmhraddshs),  OP(vmladduhm),   INV,             OP(vmsumubm),     // 544
+  OP(vmsummbm),    OP(vmsumuhm),    OP(vmsumuhs),    OP(vmsumshm),    OP(vmsumshs),    OP(vsel),        OP(vperm),       OP(vsldoi),       // 552
+  INV,             OP(vmaddfp),     OP(vnmsubfp),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 560
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 568
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vadduhs),     INV,             OP(vminuh),      INV,             OP(vsrh),         // 576
+  INV,             OP(vcmpgtuh),    INV,             OP(vmuleuh),     INV,             OP(vrfiz),       INV,             OP(vsplth),       // 584
+  INV,             OP(vupkhsh),     INV,             OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 592
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 600
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vmhaddshs),   OP(vmhraddshs),  OP(vmladduhm),   INV,             OP(vmsumubm),     // 608
+  OP(vmsummbm),    OP(vmsumuhm),    OP(vmsumuhs),    OP(vmsumshm),    OP(vmsumshs),    OP(vsel),        OP(vperm),       OP(vsldoi),       // 616
+  INV,             OP(vmaddfp),     OP(vnmsubfp),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 624
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 632
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vadduws),     INV,             OP(vminuw),      INV,             OP(vsrw),         // 640
+  INV,             OP(vcmpgtuw),    INV,             INV,             INV,             OP(vrfip),       INV,             OP(vspltw),       // 648
+  INV,             OP(vupklsb),     INV,             OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 656
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 664
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vmhaddshs),   OP(vmhraddshs),  OP(vmladduhm),   INV,             OP(vmsumubm),     // 672
+  OP(vmsummbm),    OP(vmsumuhm),    OP(vmsumuhs),    OP(vmsumshm),    OP(vmsumshs),    OP(vsel),        OP(vperm),       OP(vsldoi),       // 680
+  INV,             OP(vmaddfp),     OP(vnmsubfp),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 688
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 696
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   INV,             INV,             INV,             OP(lvxl128),     OP(vsr),          // 704
+  INV,             OP(vcmpgtfp),    OP(lvxl128),     INV,             INV,             OP(vrfim),       OP(lvxl128),     INV,              // 712
+  INV,             OP(vupklsh),     OP(lvxl128),     OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 720
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 728
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vmhaddshs),   OP(vmhraddshs),  OP(vmladduhm),   INV,             OP(vmsumubm),     // 736
+  OP(vmsummbm),    OP(vmsumuhm),    OP(vmsumuhs),    OP(vmsumshm),    OP(vmsumshs),    OP(vsel),        OP(vperm),       OP(vsldoi),       // 744
+  INV,             OP(vmaddfp),     OP(vnmsubfp),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 752
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 760
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vaddsbs),     INV,             OP(vminsb),      INV,             OP(vsrab),        // 768
+  INV,             OP(vcmpgtsb),    INV,             OP(vmulesb),     INV,             OP(vcfux),       INV,             OP(vspltisb),     // 776
+  INV,             OP(vpkpx),       INV,             OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 784
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 792
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vmhaddshs),   OP(vmhraddshs),  OP(vmladduhm),   INV,             OP(vmsumubm),     // 800
+  OP(vmsummbm),    OP(vmsumuhm),    OP(vmsumuhs),    OP(vmsumshm),    OP(vmsumshs),    OP(vsel),        OP(vperm),       OP(vsldoi),       // 808
+  INV,             OP(vmaddfp),     OP(vnmsubfp),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 816
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 824
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vaddshs),     INV,             OP(vminsh),      INV,             OP(vsrah),        // 832
+  INV,             OP(vcmpgtsh),    INV,             OP(vmulesh),     INV,             OP(vcfsx),       INV,             OP(vspltish),     // 840
+  INV,             OP(vupkhpx),     INV,             OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 848
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 856
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vmhaddshs),   OP(vmhraddshs),  OP(vmladduhm),   INV,             OP(vmsumubm),     // 864
+  OP(vmsummbm),    OP(vmsumuhm),    OP(vmsumuhs),    OP(vmsumshm),    OP(vmsumshs),    OP(vsel),        OP(vperm),       OP(vsldoi),       // 872
+  INV,             OP(vmaddfp),     OP(vnmsubfp),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 880
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 888
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vaddsws),     INV,             OP(vminsw),      INV,             OP(vsraw),        // 896
+  INV,             OP(vcmpgtsw),    INV,             INV,             INV,             OP(vctuxs),      INV,             OP(vspltisw),     // 904
+  INV,             INV,             INV,             OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 912
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 920
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vmhaddshs),   OP(vmhraddshs),  OP(vmladduhm),   INV,             OP(vmsumubm),     // 928
+  OP(vmsummbm),    OP(vmsumuhm),    OP(vmsumuhs),    OP(vmsumshm),    OP(vmsumshs),    OP(vsel),        OP(vperm),       OP(vsldoi),       // 936
+  INV,             OP(vmaddfp),     OP(vnmsubfp),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 944
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 952
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   INV,             INV,             INV,             OP(stvxl128),    INV,              // 960
+  INV,             OP(vcmpbfp),     OP(stvxl128),    INV,             INV,             OP(vctsxs),      OP(stvxl128),    INV,              // 968
+  INV,             OP(vupklpx),     OP(stvxl128),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 976
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 984
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vmhaddshs),   OP(vmhraddshs),  OP(vmladduhm),   INV,             OP(vmsumubm),     // 992
+  OP(vmsummbm),    OP(vmsumuhm),    OP(vmsumuhs),    OP(vmsumshm),    OP(vmsumshs),    OP(vsel),        OP(vperm),       OP(vsldoi),       // 1000
+  INV,             OP(vmaddfp),     OP(vnmsubfp),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1008
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1016
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsububm),     INV,             OP(vavgub),      OP(lvlx128),     OP(vand),         // 1024
+  INV,             OP(vcmpequb),    OP(lvlx128),     INV,             INV,             OP(vmaxfp),      OP(lvlx128),     OP(vslo),         // 1032
+  INV,             INV,             OP(lvlx128),     OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1040
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1048
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vmhaddshs),   OP(vmhraddshs),  OP(vmladduhm),   INV,             OP(vmsumubm),     // 1056
+  OP(vmsummbm),    OP(vmsumuhm),    OP(vmsumuhs),    OP(vmsumshm),    OP(vmsumshs),    OP(vsel),        OP(vperm),       OP(vsldoi),       // 1064
+  INV,             OP(vmaddfp),     OP(vnmsubfp),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1072
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1080
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsubuhm),     INV,             OP(vavguh),      OP(lvrx128),     OP(vandc),        // 1088
+  INV,             OP(vcmpequh),    OP(lvrx128),     INV,             INV,             OP(vminfp),      OP(lvrx128),     OP(vsro),         // 1096
+  INV,             INV,             OP(lvrx128),     OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1104
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1112
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vmhaddshs),   OP(vmhraddshs),  OP(vmladduhm),   INV,             OP(vmsumubm),     // 1120
+  OP(vmsummbm),    OP(vmsumuhm),    OP(vmsumuhs),    OP(vmsumshm),    OP(vmsumshs),    OP(vsel),        OP(vperm),       OP(vsldoi),       // 1128
+  INV,             OP(vmaddfp),     OP(vnmsubfp),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1136
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1144
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsubuwm),     INV,             OP(vavguw),      INV,             OP(vor),          // 1152
+  INV,             OP(vcmpequw),    INV,             INV,             INV,             INV,             INV,             INV,              // 1160
+  INV,             INV,             INV,             OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1168
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1176
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vmhaddshs),   OP(vmhraddshs),  OP(vmladduhm),   INV,             OP(vmsumubm),     // 1184
+  OP(vmsummbm),    OP(vmsumuhm),    OP(vmsumuhs),    OP(vmsumshm),    OP(vmsumshs),    OP(vsel),        OP(vperm),       OP(vsldoi),       // 1192
+  INV,             OP(vmaddfp),     OP(vnmsubfp),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1200
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1208
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   INV,             INV,             INV,             INV,             OP(vxor),         // 1216
+  INV,             OP(vcmpeqfp),    INV,             INV,             INV,             INV,             INV,             INV,              // 1224
+  INV,             INV,             INV,             OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1232
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1240
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vmhaddshs),   OP(vmhraddshs),  OP(vmladduhm),   INV,             OP(vmsumubm),     // 1248
+  OP(vmsummbm),    OP(vmsumuhm),    OP(vmsumuhs),    OP(vmsumshm),    OP(vmsumshs),    OP(vsel),        OP(vperm),       OP(vsldoi),       // 1256
+  INV,             OP(vmaddfp),     OP(vnmsubfp),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1264
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1272
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   INV,             INV,             OP(vavgsb),      OP(stvlx128),    OP(vnor),         // 1280
+  INV,             INV,             OP(stvlx128),    INV,             INV,             INV,             OP(stvlx128),    INV,              // 1288
+  INV,             INV,             OP(stvlx128),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1296
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1304
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vmhaddshs),   OP(vmhraddshs),  OP(vmladduhm),   INV,             OP(vmsumubm),     // 1312
+  OP(vmsummbm),    OP(vmsumuhm),    OP(vmsumuhs),    OP(vmsumshm),    OP(vmsumshs),    OP(vsel),        OP(vperm),       OP(vsldoi),       // 1320
+  INV,             OP(vmaddfp),     OP(vnmsubfp),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1328
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1336
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   INV,             INV,             OP(vavgsh),      OP(stvrx128),    INV,              // 1344
+  INV,             INV,             OP(stvrx128),    INV,             INV,             INV,             OP(stvrx128),    INV,              // 1352
+  INV,             INV,             OP(stvrx128),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1360
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1368
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vmhaddshs),   OP(vmhraddshs),  OP(vmladduhm),   INV,             OP(vmsumubm),     // 1376
+  OP(vmsummbm),    OP(vmsumuhm),    OP(vmsumuhs),    OP(vmsumshm),    OP(vmsumshs),    OP(vsel),        OP(vperm),       OP(vsldoi),       // 1384
+  INV,             OP(vmaddfp),     OP(vnmsubfp),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1392
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1400
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsubcuw),     INV,             OP(vavgsw),      INV,             INV,              // 1408
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 1416
+  INV,             INV,             INV,             OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1424
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1432
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vmhaddshs),   OP(vmhraddshs),  OP(vmladduhm),   INV,             OP(vmsumubm),     // 1440
+  OP(vmsummbm),    OP(vmsumuhm),    OP(vmsumuhs),    OP(vmsumshm),    OP(vmsumshs),    OP(vsel),        OP(vperm),       OP(vsldoi),       // 1448
+  INV,             OP(vmaddfp),     OP(vnmsubfp),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1456
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1464
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   INV,             INV,             INV,             INV,             INV,              // 1472
+  INV,             OP(vcmpgefp),    INV,             INV,             INV,             INV,             INV,             INV,              // 1480
+  INV,             INV,             INV,             OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1488
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1496
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vmhaddshs),   OP(vmhraddshs),  OP(vmladduhm),   INV,             OP(vmsumubm),     // 1504
+  OP(vmsummbm),    OP(vmsumuhm),    OP(vmsumuhs),    OP(vmsumshm),    OP(vmsumshs),    OP(vsel),        OP(vperm),       OP(vsldoi),       // 1512
+  INV,             OP(vmaddfp),     OP(vnmsubfp),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1520
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1528
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsububs),     INV,             INV,             OP(lvlxl128),    OP(mfvscr),       // 1536
+  INV,             OP(vcmpgtub),    OP(lvlxl128),    OP(vsum4ubs),    INV,             INV,             OP(lvlxl128),    INV,              // 1544
+  INV,             INV,             OP(lvlxl128),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1552
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1560
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vmhaddshs),   OP(vmhraddshs),  OP(vmladduhm),   INV,             OP(vmsumubm),     // 1568
+  OP(vmsummbm),    OP(vmsumuhm),    OP(vmsumuhs),    OP(vmsumshm),    OP(vmsumshs),    OP(vsel),        OP(vperm),       OP(vsldoi),       // 1576
+  INV,             OP(vmaddfp),     OP(vnmsubfp),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1584
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1592
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsubuhs),     INV,             INV,             OP(lvrxl128),    OP(mtvscr),       // 1600
+  INV,             OP(vcmpgtuh),    OP(lvrxl128),    OP(vsum4shs),    INV,             INV,             OP(lvrxl128),    INV,              // 1608
+  INV,             INV,             OP(lvrxl128),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1616
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1624
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vmhaddshs),   OP(vmhraddshs),  OP(vmladduhm),   INV,             OP(vmsumubm),     // 1632
+  OP(vmsummbm),    OP(vmsumuhm),    OP(vmsumuhs),    OP(vmsumshm),    OP(vmsumshs),    OP(vsel),        OP(vperm),       OP(vsldoi),       // 1640
+  INV,             OP(vmaddfp),     OP(vnmsubfp),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1648
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1656
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsubuws),     INV,             INV,             INV,             INV,              // 1664
+  INV,             OP(vcmpgtuw),    INV,             OP(vsum2sws),    INV,             INV,             INV,             INV,              // 1672
+  INV,             INV,             INV,             OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1680
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1688
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vmhaddshs),   OP(vmhraddshs),  OP(vmladduhm),   INV,             OP(vmsumubm),     // 1696
+  OP(vmsummbm),    OP(vmsumuhm),    OP(vmsumuhs),    OP(vmsumshm),    OP(vmsumshs),    OP(vsel),        OP(vperm),       OP(vsldoi),       // 1704
+  INV,             OP(vmaddfp),     OP(vnmsubfp),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1712
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1720
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   INV,             INV,             INV,             INV,             INV,              // 1728
+  INV,             OP(vcmpgtfp),    INV,             INV,             INV,             INV,             INV,             INV,              // 1736
+  INV,             INV,             INV,             OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1744
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1752
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vmhaddshs),   OP(vmhraddshs),  OP(vmladduhm),   INV,             OP(vmsumubm),     // 1760
+  OP(vmsummbm),    OP(vmsumuhm),    OP(vmsumuhs),    OP(vmsumshm),    OP(vmsumshs),    OP(vsel),        OP(vperm),       OP(vsldoi),       // 1768
+  INV,             OP(vmaddfp),     OP(vnmsubfp),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1776
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1784
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsubsbs),     INV,             INV,             OP(stvlxl128),   INV,              // 1792
+  INV,             OP(vcmpgtsb),    OP(stvlxl128),   OP(vsum4sbs),    INV,             INV,             OP(stvlxl128),   INV,              // 1800
+  INV,             INV,             OP(stvlxl128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1808
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1816
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vmhaddshs),   OP(vmhraddshs),  OP(vmladduhm),   INV,             OP(vmsumubm),     // 1824
+  OP(vmsummbm),    OP(vmsumuhm),    OP(vmsumuhs),    OP(vmsumshm),    OP(vmsumshs),    OP(vsel),        OP(vperm),       OP(vsldoi),       // 1832
+  INV,             OP(vmaddfp),     OP(vnmsubfp),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1840
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1848
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsubshs),     INV,             INV,             OP(stvrxl128),   INV,              // 1856
+  INV,             OP(vcmpgtsh),    OP(stvrxl128),   INV,             INV,             INV,             OP(stvrxl128),   INV,              // 1864
+  INV,             INV,             OP(stvrxl128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1872
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1880
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vmhaddshs),   OP(vmhraddshs),  OP(vmladduhm),   INV,             OP(vmsumubm),     // 1888
+  OP(vmsummbm),    OP(vmsumuhm),    OP(vmsumuhs),    OP(vmsumshm),    OP(vmsumshs),    OP(vsel),        OP(vperm),       OP(vsldoi),       // 1896
+  INV,             OP(vmaddfp),     OP(vnmsubfp),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1904
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1912
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsubsws),     INV,             INV,             INV,             INV,              // 1920
+  INV,             OP(vcmpgtsw),    INV,             OP(vsumsws),     INV,             INV,             INV,             INV,              // 1928
+  INV,             INV,             INV,             OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1936
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1944
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vmhaddshs),   OP(vmhraddshs),  OP(vmladduhm),   INV,             OP(vmsumubm),     // 1952
+  OP(vmsummbm),    OP(vmsumuhm),    OP(vmsumuhs),    OP(vmsumshm),    OP(vmsumshs),    OP(vsel),        OP(vperm),       OP(vsldoi),       // 1960
+  INV,             OP(vmaddfp),     OP(vnmsubfp),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1968
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 1976
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   INV,             INV,             INV,             INV,             INV,              // 1984
+  INV,             OP(vcmpbfp),     INV,             INV,             INV,             INV,             INV,             INV,              // 1992
+  INV,             INV,             INV,             OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 2000
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 2008
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vmhaddshs),   OP(vmhraddshs),  OP(vmladduhm),   INV,             OP(vmsumubm),     // 2016
+  OP(vmsummbm),    OP(vmsumuhm),    OP(vmsumuhs),    OP(vmsumshm),    OP(vmsumshs),    OP(vsel),        OP(vperm),       OP(vsldoi),       // 2024
+  INV,             OP(vmaddfp),     OP(vnmsubfp),    OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 2032
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),    // 2040
+  OP(vsldoi128),   OP(vsldoi128),   OP(vsldoi128),   OP(vperm128),    OP(vaddfp128),   OP(vperm128),    OP(vaddfp128),   OP(vperm128),     // 2048
+  OP(vsubfp128),   OP(vperm128),    OP(vsubfp128),   OP(vperm128),    OP(vmulfp128),   OP(vperm128),    OP(vmulfp128),   OP(vperm128),     // 2056
+  OP(vmaddfp128),  OP(vperm128),    OP(vmaddfp128),  OP(vperm128),    OP(vmaddcfp128), OP(vperm128),    OP(vmaddcfp128), OP(vperm128),     // 2064
+  OP(vnmsubfp128), OP(vperm128),    OP(vnmsubfp128), OP(vperm128),    OP(vmsum3fp128), OP(vperm128),    OP(vmsum3fp128), OP(vperm128),     // 2072
+  OP(vmsum4fp128), OP(vperm128),    OP(vmsum4fp128), OP(vpkshss128),  OP(vand128),     OP(vpkshss128),  OP(vand128),     OP(vpkshus128),   // 2080
+  OP(vandc128),    OP(vpkshus128),  OP(vandc128),    OP(vpkswss128),  OP(vnor128),     OP(vpkswss128),  OP(vnor128),     OP(vpkswus128),   // 2088
+  OP(vor128),      OP(vpkswus128),  OP(vor128),      OP(vpkuhum128),  OP(vxor128),     OP(vpkuhum128),  OP(vxor128),     OP(vpkuhus128),   // 2096
+  OP(vsel128),     OP(vpkuhus128),  OP(vsel128),     OP(vpkuwum128),  OP(vslo128),     OP(vpkuwum128),  OP(vslo128),     OP(vpkuwus128),   // 2104
+  OP(vsro128),     OP(vpkuwus128),  OP(vsro128),     OP(vcmpeqfp128), INV,             OP(vcmpeqfp128), INV,             OP(vcmpeqfp128),  // 2112
+  OP(vrlw128),     OP(vcmpeqfp128), OP(vrlw128),     OP(vcmpgefp128), INV,             OP(vcmpgefp128), INV,             OP(vcmpgefp128),  // 2120
+  OP(vslw128),     OP(vcmpgefp128), OP(vslw128),     OP(vcmpgtfp128), INV,             OP(vcmpgtfp128), INV,             OP(vcmpgtfp128),  // 2128
+  OP(vsraw128),    OP(vcmpgtfp128), OP(vsraw128),    OP(vcmpbfp128),  INV,             OP(vcmpbfp128),  INV,             OP(vcmpbfp128),   // 2136
+  OP(vsrw128),     OP(vcmpbfp128),  OP(vsrw128),     OP(vcmpequw128), OP(vpermwi128),  OP(vcmpequw128), OP(vcfpsxws128), OP(vcmpequw128),  // 2144
+  OP(vpermwi128),  OP(vcmpequw128), OP(vcfpuxws128), OP(vmaxfp128),   OP(vpermwi128),  OP(vmaxfp128),   OP(vcsxwfp128),  OP(vminfp128),    // 2152
+  OP(vpermwi128),  OP(vminfp128),   OP(vcuxwfp128),  OP(vmrghw128),   OP(vpermwi128),  OP(vmrghw128),   OP(vrfim128),    OP(vmrglw128),    // 2160
+  OP(vpermwi128),  OP(vmrglw128),   OP(vrfin128),    OP(vupkhsb128),  OP(vpermwi128),  OP(vupkhsb128),  OP(vrfip128),    OP(vupklsb128),   // 2168
+  OP(vpermwi128),  OP(vupklsb128),  OP(vrfiz128),    OP(vcmpeqfp128), INV,             OP(vcmpeqfp128), INV,             OP(vcmpeqfp128),  // 2176
+  OP(vrlw128),     OP(vcmpeqfp128), OP(vrlw128),     OP(vcmpgefp128), INV,             OP(vcmpgefp128), INV,             OP(vcmpgefp128),  // 2184
+  OP(vslw128),     OP(vcmpgefp128), OP(vslw128),     OP(vcmpgtfp128), INV,             OP(vcmpgtfp128), INV,             OP(vcmpgtfp128),  // 2192
+  OP(vsraw128),    OP(vcmpgtfp128), OP(vsraw128),    OP(vcmpbfp128),  INV,             OP(vcmpbfp128),  INV,             OP(vcmpbfp128),   // 2200
+  OP(vsrw128),     OP(vcmpbfp128),  OP(vsrw128),     OP(vcmpequw128), OP(vpkd3d128),   OP(vcmpequw128), OP(vrefp128),    OP(vcmpequw128),  // 2208
+  OP(vpkd3d128),   OP(vcmpequw128), OP(vrsqrtefp128),OP(vmaxfp128),   OP(vpkd3d128),   OP(vmaxfp128),   OP(vexptefp128), OP(vminfp128),    // 2216
+  OP(vpkd3d128),   OP(vminfp128),   OP(vlogefp128),  OP(vmrghw128),   OP(vrlimi128),   OP(vmrghw128),   OP(vspltw128),   OP(vmrglw128),    // 2224
+  OP(vrlimi128),   OP(vmrglw128),   OP(vspltisw128), OP(vupkhsb128),  OP(vrlimi128),   OP(vupkhsb128),  INV,             OP(vupklsb128),   // 2232
+  OP(vrlimi128),   OP(vupklsb128),  OP(vupkd3d128),  OP(mulli),       OP(subficx),     OP(cmpli),       OP(cmpi),        OP(addic),        // 2240
+  OP(addicx),      OP(addi),        OP(addis),       OP(bcx),         OP(sc),          OP(bx),          OP(mcrf),        INV,              // 2248
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2256
+  INV,             INV,             INV,             INV,             INV,             INV,             OP(bclrx),       INV,              // 2264
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2272
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             OP(crnor),        // 2280
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2288
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2296
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2304
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2312
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2320
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2328
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2336
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2344
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2352
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2360
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2368
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             OP(crandc),       // 2376
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2384
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2392
+  INV,             INV,             INV,             INV,             OP(isync),       INV,             INV,             INV,              // 2400
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2408
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2416
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2424
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2432
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             OP(crxor),        // 2440
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2448
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2456
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2464
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             OP(crnand),       // 2472
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2480
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2488
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2496
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             OP(crand),        // 2504
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2512
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2520
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2528
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             OP(creqv),        // 2536
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2544
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2552
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2560
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2568
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2576
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2584
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2592
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2600
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2608
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2616
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2624
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2632
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2640
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2648
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2656
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             OP(crorc),        // 2664
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2672
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2680
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2688
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             OP(cror),         // 2696
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2704
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2712
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2720
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2728
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2736
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2744
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2752
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2760
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2768
+  INV,             INV,             INV,             INV,             INV,             INV,             OP(bcctrx),      INV,              // 2776
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2784
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2792
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2800
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2808
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2816
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2824
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2832
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2840
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2848
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2856
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2864
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2872
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2880
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2888
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2896
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2904
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2912
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2920
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2928
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2936
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2944
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2952
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2960
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2968
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2976
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2984
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 2992
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3000
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3008
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3016
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3024
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3032
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3040
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3048
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3056
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3064
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3072
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3080
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3088
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3096
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3104
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3112
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3120
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3128
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3136
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3144
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3152
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3160
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3168
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3176
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3184
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3192
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3200
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3208
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3216
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3224
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3232
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3240
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3248
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3256
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3264
+  INV,             INV,             INV,             INV,             INV,             INV,             OP(rlwimix),     OP(rlwinmx),      // 3272
+  OP(rlwnmx),      OP(ori),         OP(oris),        OP(xori),        OP(xoris),       OP(andix),       OP(andisx),      OP(rldiclx),      // 3280
+  OP(rldiclx),     OP(rldicrx),     OP(rldicrx),     OP(rldicx),      OP(rldicx),      OP(rldimix),     OP(rldimix),     OP(rldclx),       // 3288
+  OP(rldcrx),      INV,             INV,             INV,             INV,             INV,             INV,             OP(cmp),          // 3296
+  INV,             INV,             INV,             OP(tw),          INV,             OP(lvsl),        OP(lvebx),       OP(subfcx),       // 3304
+  OP(mulhdux),     OP(addcx),       OP(mulhwux),     INV,             INV,             INV,             INV,             INV,              // 3312
+  INV,             INV,             OP(mfcr),        OP(lwarx),       OP(ldx),         INV,             OP(lwzx),        OP(slwx),         // 3320
+  INV,             OP(cntlzwx),     OP(sldx),        OP(andx),        INV,             INV,             INV,             OP(cmpl),         // 3328
+  INV,             INV,             INV,             INV,             INV,             OP(lvsr),        OP(lvehx),       OP(subfx),        // 3336
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3344
+  INV,             INV,             INV,             INV,             OP(ldux),        OP(dcbst),       OP(lwzux),       INV,              // 3352
+  INV,             OP(cntlzdx),     INV,             OP(andcx),       INV,             INV,             INV,             INV,              // 3360
+  INV,             INV,             INV,             OP(td),          INV,             INV,             OP(lvewx),       INV,              // 3368
+  OP(mulhdx),      INV,             OP(mulhwx),      INV,             INV,             INV,             INV,             INV,              // 3376
+  INV,             INV,             OP(mfmsr),       OP(ldarx),       INV,             OP(dcbf),        OP(lbzx),        INV,              // 3384
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3392
+  INV,             INV,             INV,             INV,             INV,             INV,             OP(lvx),         OP(negx),         // 3400
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3408
+  INV,             INV,             INV,             INV,             INV,             INV,             OP(lbzux),       INV,              // 3416
+  INV,             INV,             INV,             OP(norx),        INV,             INV,             INV,             INV,              // 3424
+  INV,             INV,             INV,             INV,             INV,             INV,             OP(stvebx),      OP(subfex),       // 3432
+  INV,             OP(addex),       INV,             INV,             INV,             INV,             INV,             OP(mtcrf),        // 3440
+  INV,             OP(mtmsr),       INV,             INV,             OP(stdx),        OP(stwcx),       OP(stwx),        INV,              // 3448
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3456
+  INV,             INV,             INV,             INV,             INV,             INV,             OP(stvehx),      INV,              // 3464
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3472
+  INV,             OP(mtmsrd),      INV,             INV,             OP(stdux),       INV,             OP(stwux),       INV,              // 3480
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3488
+  INV,             INV,             INV,             INV,             INV,             INV,             OP(stvewx),      OP(subfzex),      // 3496
+  INV,             OP(addzex),      INV,             INV,             INV,             INV,             INV,             INV,              // 3504
+  INV,             INV,             INV,             INV,             INV,             OP(stdcx),       OP(stbx),        INV,              // 3512
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3520
+  INV,             INV,             INV,             INV,             INV,             INV,             OP(stvx),        OP(subfmex),      // 3528
+  OP(mulldx),      OP(addmex),      OP(mullwx),      INV,             INV,             INV,             INV,             INV,              // 3536
+  INV,             INV,             INV,             INV,             INV,             OP(dcbtst),      OP(stbux),       INV,              // 3544
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3552
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3560
+  INV,             OP(addx),        INV,             INV,             INV,             INV,             INV,             INV,              // 3568
+  INV,             INV,             INV,             INV,             INV,             OP(dcbt),        OP(lhzx),        INV,              // 3576
+  INV,             INV,             INV,             OP(eqvx),        INV,             INV,             INV,             INV,              // 3584
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3592
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3600
+  INV,             INV,             INV,             INV,             INV,             INV,             OP(lhzux),       INV,              // 3608
+  INV,             INV,             INV,             OP(xorx),        INV,             INV,             INV,             INV,              // 3616
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3624
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3632
+  INV,             INV,             OP(mfspr),       INV,             OP(lwax),        INV,             OP(lhax),        INV,              // 3640
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3648
+  INV,             INV,             INV,             INV,             INV,             INV,             OP(lvxl),        INV,              // 3656
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3664
+  INV,             INV,             OP(mftb),        INV,             OP(lwaux),       INV,             OP(lhaux),       INV,              // 3672
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3680
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3688
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3696
+  INV,             INV,             INV,             INV,             INV,             INV,             OP(sthx),        INV,              // 3704
+  INV,             INV,             INV,             OP(orcx),        INV,             INV,             INV,             INV,              // 3712
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3720
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3728
+  INV,             INV,             INV,             INV,             INV,             INV,             OP(sthux),       INV,              // 3736
+  INV,             INV,             INV,             OP(orx),         INV,             INV,             INV,             INV,              // 3744
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3752
+  OP(divdux),      INV,             OP(divwux),      INV,             INV,             INV,             INV,             INV,              // 3760
+  INV,             INV,             OP(mtspr),       INV,             INV,             OP(dcbi),        INV,             INV,              // 3768
+  INV,             INV,             INV,             OP(nandx),       INV,             INV,             INV,             INV,              // 3776
+  INV,             INV,             INV,             INV,             INV,             INV,             OP(stvxl),       INV,              // 3784
+  OP(divdx),       INV,             OP(divwx),       INV,             INV,             INV,             INV,             INV,              // 3792
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3800
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             OP(mcrxr),        // 3808
+  INV,             INV,             INV,             INV,             INV,             INV,             OP(lvlx),        OP(subfcx),       // 3816
+  OP(mulhdux),     OP(addcx),       OP(mulhwux),     INV,             INV,             INV,             INV,             INV,              // 3824
+  INV,             INV,             INV,             OP(ldbrx),       OP(lswx),        OP(lwbrx),       OP(lfsx),        OP(srwx),         // 3832
+  INV,             INV,             OP(srdx),        INV,             INV,             INV,             INV,             INV,              // 3840
+  INV,             INV,             INV,             INV,             INV,             INV,             OP(lvrx),        OP(subfx),        // 3848
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3856
+  INV,             INV,             INV,             INV,             INV,             INV,             OP(lfsux),       INV,              // 3864
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3872
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3880
+  OP(mulhdx),      INV,             OP(mulhwx),      INV,             INV,             INV,             INV,             INV,              // 3888
+  INV,             INV,             INV,             INV,             OP(lswi),        OP(sync),        OP(lfdx),        INV,              // 3896
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3904
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             OP(negx),         // 3912
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3920
+  INV,             INV,             INV,             INV,             INV,             INV,             OP(lfdux),       INV,              // 3928
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3936
+  INV,             INV,             INV,             INV,             INV,             INV,             OP(stvlx),       OP(subfex),       // 3944
+  INV,             OP(addex),       INV,             INV,             INV,             INV,             INV,             INV,              // 3952
+  INV,             INV,             INV,             OP(stdbrx),      OP(stswx),       OP(stwbrx),      OP(stfsx),       INV,              // 3960
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3968
+  INV,             INV,             INV,             INV,             INV,             INV,             OP(stvrx),       INV,              // 3976
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 3984
+  INV,             INV,             INV,             INV,             INV,             INV,             OP(stfsux),      INV,              // 3992
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4000
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             OP(subfzex),      // 4008
+  INV,             OP(addzex),      INV,             INV,             INV,             INV,             INV,             INV,              // 4016
+  INV,             INV,             INV,             INV,             OP(stswi),       INV,             OP(stfdx),       INV,              // 4024
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4032
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             OP(subfmex),      // 4040
+  OP(mulldx),      OP(addmex),      OP(mullwx),      INV,             INV,             INV,             INV,             INV,              // 4048
+  INV,             INV,             INV,             INV,             INV,             INV,             OP(stfdux),      INV,              // 4056
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4064
+  INV,             INV,             INV,             INV,             INV,             INV,             OP(lvlxl),       INV,              // 4072
+  INV,             OP(addx),        INV,             INV,             INV,             INV,             INV,             INV,              // 4080
+  INV,             INV,             INV,             INV,             INV,             OP(lhbrx),       INV,             OP(srawx),        // 4088
+  INV,             OP(sradx),       INV,             INV,             INV,             INV,             INV,             INV,              // 4096
+  INV,             INV,             INV,             INV,             INV,             INV,             OP(lvrxl),       INV,              // 4104
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4112
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             OP(srawix),       // 4120
+  INV,             OP(sradix),      OP(sradix),      INV,             INV,             INV,             INV,             INV,              // 4128
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4136
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4144
+  INV,             INV,             INV,             INV,             INV,             OP(eieio),       INV,             INV,              // 4152
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4160
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4168
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4176
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4184
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4192
+  INV,             INV,             INV,             INV,             INV,             INV,             OP(stvlxl),      INV,              // 4200
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4208
+  INV,             INV,             INV,             INV,             INV,             OP(sthbrx),      INV,             INV,              // 4216
+  INV,             OP(extshx),      INV,             INV,             INV,             INV,             INV,             INV,              // 4224
+  INV,             INV,             INV,             INV,             INV,             INV,             OP(stvrxl),      INV,              // 4232
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4240
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4248
+  INV,             OP(extsbx),      INV,             INV,             INV,             INV,             INV,             INV,              // 4256
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4264
+  OP(divdux),      INV,             OP(divwux),      INV,             INV,             INV,             INV,             INV,              // 4272
+  INV,             INV,             INV,             INV,             INV,             OP(icbi),        OP(stfiwx),      INV,              // 4280
+  INV,             OP(extswx),      INV,             INV,             INV,             INV,             INV,             INV,              // 4288
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4296
+  OP(divdx),       INV,             OP(divwx),       INV,             INV,             INV,             INV,             INV,              // 4304
+  INV,             INV,             INV,             INV,             INV,             RES(0),          INV,             INV,              // 4312
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             OP(lwz),          // 4320
+  OP(lwzu),        OP(lbz),         OP(lbzu),        OP(stw),         OP(stwu),        OP(stb),         OP(stbu),        OP(lhz),          // 4328
+  OP(lhzu),        OP(lha),         OP(lhau),        OP(sth),         OP(sthu),        OP(lmw),         OP(stmw),        OP(lfs),          // 4336
+  OP(lfsu),        OP(lfd),         OP(lfdu),        OP(stfs),        OP(stfsu),       OP(stfd),        OP(stfdu),       OP(ld),           // 4344
+  OP(ldu),         OP(lwa),         INV,             INV,             INV,             INV,             INV,             INV,              // 4352
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4360
+  INV,             INV,             INV,             INV,             INV,             OP(fdivsx),      INV,             OP(fsubsx),       // 4368
+  OP(faddsx),      OP(fsqrtsx),     INV,             OP(fresx),       OP(fmulsx),      INV,             INV,             OP(fmsubsx),      // 4376
+  OP(fmaddsx),     OP(fnmsubsx),    OP(fnmaddsx),    OP(std),         OP(stdu),        INV,             INV,             OP(fcmpu),        // 4384
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4392
+  INV,             INV,             INV,             OP(frspx),       INV,             OP(fctiwx),      OP(fctiwzx),     INV,              // 4400
+  INV,             OP(fdivx),       INV,             OP(fsubx),       OP(faddx),       OP(fsqrtx),      OP(fselx),       INV,              // 4408
+  OP(fmulx),       OP(frsqrtex),    INV,             OP(fmsubx),      OP(fmaddx),      OP(fnmsubx),     OP(fnmaddx),     OP(fcmpo),        // 4416
+  INV,             INV,             INV,             INV,             INV,             OP(mtfsb1x),     INV,             OP(fnegx),        // 4424
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4432
+  INV,             OP(fdivx),       INV,             OP(fsubx),       OP(faddx),       OP(fsqrtx),      OP(fselx),       INV,              // 4440
+  OP(fmulx),       OP(frsqrtex),    INV,             OP(fmsubx),      OP(fmaddx),      OP(fnmsubx),     OP(fnmaddx),     OP(mcrfs),        // 4448
+  INV,             INV,             INV,             INV,             INV,             OP(mtfsb0x),     INV,             OP(fmrx),         // 4456
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4464
+  INV,             OP(fdivx),       INV,             OP(fsubx),       OP(faddx),       OP(fsqrtx),      OP(fselx),       INV,              // 4472
+  OP(fmulx),       OP(frsqrtex),    INV,             OP(fmsubx),      OP(fmaddx),      OP(fnmsubx),     OP(fnmaddx),     INV,              // 4480
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4488
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4496
+  INV,             OP(fdivx),       INV,             OP(fsubx),       OP(faddx),       OP(fsqrtx),      OP(fselx),       INV,              // 4504
+  OP(fmulx),       OP(frsqrtex),    INV,             OP(fmsubx),      OP(fmaddx),      OP(fnmsubx),     OP(fnmaddx),     INV,              // 4512
+  INV,             INV,             INV,             INV,             INV,             OP(mtfsfix),     INV,             OP(fnabsx),       // 4520
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4528
+  INV,             OP(fdivx),       INV,             OP(fsubx),       OP(faddx),       OP(fsqrtx),      OP(fselx),       INV,              // 4536
+  OP(fmulx),       OP(frsqrtex),    INV,             OP(fmsubx),      OP(fmaddx),      OP(fnmsubx),     OP(fnmaddx),     INV,              // 4544
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4552
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4560
+  INV,             OP(fdivx),       INV,             OP(fsubx),       OP(faddx),       OP(fsqrtx),      OP(fselx),       INV,              // 4568
+  OP(fmulx),       OP(frsqrtex),    INV,             OP(fmsubx),      OP(fmaddx),      OP(fnmsubx),     OP(fnmaddx),     INV,              // 4576
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4584
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4592
+  INV,             OP(fdivx),       INV,             OP(fsubx),       OP(faddx),       OP(fsqrtx),      OP(fselx),       INV,              // 4600
+  OP(fmulx),       OP(frsqrtex),    INV,             OP(fmsubx),      OP(fmaddx),      OP(fnmsubx),     OP(fnmaddx),     INV,              // 4608
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4616
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4624
+  INV,             OP(fdivx),       INV,             OP(fsubx),       OP(faddx),       OP(fsqrtx),      OP(fselx),       INV,              // 4632
+  OP(fmulx),       OP(frsqrtex),    INV,             OP(fmsubx),      OP(fmaddx),      OP(fnmsubx),     OP(fnmaddx),     INV,              // 4640
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             OP(fabsx),        // 4648
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4656
+  INV,             OP(fdivx),       INV,             OP(fsubx),       OP(faddx),       OP(fsqrtx),      OP(fselx),       INV,              // 4664
+  OP(fmulx),       OP(frsqrtex),    INV,             OP(fmsubx),      OP(fmaddx),      OP(fnmsubx),     OP(fnmaddx),     INV,              // 4672
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4680
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4688
+  INV,             OP(fdivx),       INV,             OP(fsubx),       OP(faddx),       OP(fsqrtx),      OP(fselx),       INV,              // 4696
+  OP(fmulx),       OP(frsqrtex),    INV,             OP(fmsubx),      OP(fmaddx),      OP(fnmsubx),     OP(fnmaddx),     INV,              // 4704
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4712
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4720
+  INV,             OP(fdivx),       INV,             OP(fsubx),       OP(faddx),       OP(fsqrtx),      OP(fselx),       INV,              // 4728
+  OP(fmulx),       OP(frsqrtex),    INV,             OP(fmsubx),      OP(fmaddx),      OP(fnmsubx),     OP(fnmaddx),     INV,              // 4736
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4744
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4752
+  INV,             OP(fdivx),       INV,             OP(fsubx),       OP(faddx),       OP(fsqrtx),      OP(fselx),       INV,              // 4760
+  OP(fmulx),       OP(frsqrtex),    INV,             OP(fmsubx),      OP(fmaddx),      OP(fnmsubx),     OP(fnmaddx),     INV,              // 4768
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4776
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4784
+  INV,             OP(fdivx),       INV,             OP(fsubx),       OP(faddx),       OP(fsqrtx),      OP(fselx),       INV,              // 4792
+  OP(fmulx),       OP(frsqrtex),    INV,             OP(fmsubx),      OP(fmaddx),      OP(fnmsubx),     OP(fnmaddx),     INV,              // 4800
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4808
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4816
+  INV,             OP(fdivx),       INV,             OP(fsubx),       OP(faddx),       OP(fsqrtx),      OP(fselx),       INV,              // 4824
+  OP(fmulx),       OP(frsqrtex),    INV,             OP(fmsubx),      OP(fmaddx),      OP(fnmsubx),     OP(fnmaddx),     INV,              // 4832
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4840
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4848
+  INV,             OP(fdivx),       INV,             OP(fsubx),       OP(faddx),       OP(fsqrtx),      OP(fselx),       INV,              // 4856
+  OP(fmulx),       OP(frsqrtex),    INV,             OP(fmsubx),      OP(fmaddx),      OP(fnmsubx),     OP(fnmaddx),     INV,              // 4864
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4872
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4880
+  INV,             OP(fdivx),       INV,             OP(fsubx),       OP(faddx),       OP(fsqrtx),      OP(fselx),       INV,              // 4888
+  OP(fmulx),       OP(frsqrtex),    INV,             OP(fmsubx),      OP(fmaddx),      OP(fnmsubx),     OP(fnmaddx),     INV,              // 4896
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4904
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4912
+  INV,             OP(fdivx),       INV,             OP(fsubx),       OP(faddx),       OP(fsqrtx),      OP(fselx),       INV,              // 4920
+  OP(fmulx),       OP(frsqrtex),    INV,             OP(fmsubx),      OP(fmaddx),      OP(fnmsubx),     OP(fnmaddx),     INV,              // 4928
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4936
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4944
+  INV,             OP(fdivx),       INV,             OP(fsubx),       OP(faddx),       OP(fsqrtx),      OP(fselx),       INV,              // 4952
+  OP(fmulx),       OP(frsqrtex),    INV,             OP(fmsubx),      OP(fmaddx),      OP(fnmsubx),     OP(fnmaddx),     INV,              // 4960
+  INV,             INV,             INV,             INV,             INV,             INV,             OP(mffsx),       INV,              // 4968
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 4976
+  INV,             OP(fdivx),       INV,             OP(fsubx),       OP(faddx),       OP(fsqrtx),      OP(fselx),       INV,              // 4984
+  OP(fmulx),       OP(frsqrtex),    INV,             OP(fmsubx),      OP(fmaddx),      OP(fnmsubx),     OP(fnmaddx),     INV,              // 4992
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 5000
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 5008
+  INV,             OP(fdivx),       INV,             OP(fsubx),       OP(faddx),       OP(fsqrtx),      OP(fselx),       INV,              // 5016
+  OP(fmulx),       OP(frsqrtex),    INV,             OP(fmsubx),      OP(fmaddx),      OP(fnmsubx),     OP(fnmaddx),     INV,              // 5024
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 5032
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 5040
+  INV,             OP(fdivx),       INV,             OP(fsubx),       OP(faddx),       OP(fsqrtx),      OP(fselx),       INV,              // 5048
+  OP(fmulx),       OP(frsqrtex),    INV,             OP(fmsubx),      OP(fmaddx),      OP(fnmsubx),     OP(fnmaddx),     INV,              // 5056
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 5064
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 5072
+  INV,             OP(fdivx),       INV,             OP(fsubx),       OP(faddx),       OP(fsqrtx),      OP(fselx),       INV,              // 5080
+  OP(fmulx),       OP(frsqrtex),    INV,             OP(fmsubx),      OP(fmaddx),      OP(fnmsubx),     OP(fnmaddx),     INV,              // 5088
+  INV,             INV,             INV,             INV,             INV,             INV,             OP(mtfsfx),      INV,              // 5096
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 5104
+  INV,             OP(fdivx),       INV,             OP(fsubx),       OP(faddx),       OP(fsqrtx),      OP(fselx),       INV,              // 5112
+  OP(fmulx),       OP(frsqrtex),    INV,             OP(fmsubx),      OP(fmaddx),      OP(fnmsubx),     OP(fnmaddx),     INV,              // 5120
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 5128
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 5136
+  INV,             OP(fdivx),       INV,             OP(fsubx),       OP(faddx),       OP(fsqrtx),      OP(fselx),       INV,              // 5144
+  OP(fmulx),       OP(frsqrtex),    INV,             OP(fmsubx),      OP(fmaddx),      OP(fnmsubx),     OP(fnmaddx),     INV,              // 5152
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 5160
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 5168
+  INV,             OP(fdivx),       INV,             OP(fsubx),       OP(faddx),       OP(fsqrtx),      OP(fselx),       INV,              // 5176
+  OP(fmulx),       OP(frsqrtex),    INV,             OP(fmsubx),      OP(fmaddx),      OP(fnmsubx),     OP(fnmaddx),     INV,              // 5184
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 5192
+  INV,             INV,             INV,             INV,             INV,             OP(fctidx),      OP(fctidzx),     INV,              // 5200
+  INV,             OP(fdivx),       INV,             OP(fsubx),       OP(faddx),       OP(fsqrtx),      OP(fselx),       INV,              // 5208
+  OP(fmulx),       OP(frsqrtex),    INV,             OP(fmsubx),      OP(fmaddx),      OP(fnmsubx),     OP(fnmaddx),     INV,              // 5216
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 5224
+  INV,             INV,             INV,             INV,             INV,             OP(fcfidx),      INV,             INV,              // 5232
+  INV,             OP(fdivx),       INV,             OP(fsubx),       OP(faddx),       OP(fsqrtx),      OP(fselx),       INV,              // 5240
+  OP(fmulx),       OP(frsqrtex),    INV,             OP(fmsubx),      OP(fmaddx),      OP(fnmsubx),     OP(fnmaddx),     INV,              // 5248
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 5256
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 5264
+  INV,             OP(fdivx),       INV,             OP(fsubx),       OP(faddx),       OP(fsqrtx),      OP(fselx),       INV,              // 5272
+  OP(fmulx),       OP(frsqrtex),    INV,             OP(fmsubx),      OP(fmaddx),      OP(fnmsubx),     OP(fnmaddx),     INV,              // 5280
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 5288
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 5296
+  INV,             OP(fdivx),       INV,             OP(fsubx),       OP(faddx),       OP(fsqrtx),      OP(fselx),       INV,              // 5304
+  OP(fmulx),       OP(frsqrtex),    INV,             OP(fmsubx),      OP(fmaddx),      OP(fnmsubx),     OP(fnmaddx),     INV,              // 5312
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 5320
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 5328
+  INV,             OP(fdivx),       INV,             OP(fsubx),       OP(faddx),       OP(fsqrtx),      OP(fselx),       INV,              // 5336
+  OP(fmulx),       OP(frsqrtex),    INV,             OP(fmsubx),      OP(fmaddx),      OP(fnmsubx),     OP(fnmaddx),     INV,              // 5344
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 5352
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 5360
+  INV,             OP(fdivx),       INV,             OP(fsubx),       OP(faddx),       OP(fsqrtx),      OP(fselx),       INV,              // 5368
+  OP(fmulx),       OP(frsqrtex),    INV,             OP(fmsubx),      OP(fmaddx),      OP(fnmsubx),     OP(fnmaddx),     INV,              // 5376
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 5384
+  INV,             INV,             INV,             INV,             INV,             INV,             INV,             INV,              // 5392
+  INV,             OP(fdivx),       INV,             OP(fsubx),       OP(faddx),       OP(fsqrtx),      OP(fselx),       INV,              // 5400
+  OP(fmulx),       OP(frsqrtex),    INV,             OP(fmsubx),      OP(fmaddx),      OP(fnmsubx),     OP(fnmaddx),      // 5408
+};
+
+const ResidualEntry kResidualTable[3] = {
+  {0xffe007fe, 0x7c0007ec, OP(dcbz)},
+  {0xffe007fe, 0x7c2007ec, OP(dcbz128)},
+  {0x00000000, 0x00000000, INV},
+};
+
+#undef OP
+#undef INV
+#undef RES
+
+uint16_t LookupResidual(uint32_t code, uint16_t index) {
+  for (auto entry = &kResidualTable[index];; ++entry) {
+    if ((code & entry->mask) == entry->match) {
+      return entry->opcode;
+    }
+  }
 }
 
-#define PPC_DECODER_MISS assert_always(); return PPCOpcode::kInvalid
-#define PPC_DECODER_HIT(name) return PPCOpcode::name;
+}  // namespace
 
 PPCOpcode LookupOpcode(uint32_t code) {
-  switch (ExtractBits(code, 0, 5)) {
-  case 2: PPC_DECODER_HIT(tdi);
-  case 3: PPC_DECODER_HIT(twi);
-  case 4:
-    switch ((ExtractBits(code, 21, 27) << 4)|(ExtractBits(code, 30, 31) << 0)) {
-      case 0b00000000011: PPC_DECODER_HIT(lvsl128);
-      case 0b00001000011: PPC_DECODER_HIT(lvsr128);
-      case 0b00010000011: PPC_DECODER_HIT(lvewx128);
-      case 0b00011000011: PPC_DECODER_HIT(lvx128);
-      case 0b00110000011: PPC_DECODER_HIT(stvewx128);
-      case 0b00111000011: PPC_DECODER_HIT(stvx128);
-      case 0b01011000011: PPC_DECODER_HIT(lvxl128);
-      case 0b01111000011: PPC_DECODER_HIT(stvxl128);
-      case 0b10000000011: PPC_DECODER_HIT(lvlx128);
-      case 0b10001000011: PPC_DECODER_HIT(lvrx128);
-      case 0b10100000011: PPC_DECODER_HIT(stvlx128);
-      case 0b10101000011: PPC_DECODER_HIT(stvrx128);
-      case 0b11000000011: PPC_DECODER_HIT(lvlxl128);
-      case 0b11001000011: PPC_DECODER_HIT(lvrxl128);
-      case 0b11100000011: PPC_DECODER_HIT(stvlxl128);
-      case 0b11101000011: PPC_DECODER_HIT(stvrxl128);
-    }
-    switch ((ExtractBits(code, 21, 31) << 0)) {
-      case 0b00000000000: PPC_DECODER_HIT(vaddubm);
-      case 0b00000000010: PPC_DECODER_HIT(vmaxub);
-      case 0b00000000100: PPC_DECODER_HIT(vrlb);
-      case 0b00000001000: PPC_DECODER_HIT(vmuloub);
-      case 0b00000001010: PPC_DECODER_HIT(vaddfp);
-      case 0b00000001100: PPC_DECODER_HIT(vmrghb);
-      case 0b00000001110: PPC_DECODER_HIT(vpkuhum);
-      case 0b00001000000: PPC_DECODER_HIT(vadduhm);
-      case 0b00001000010: PPC_DECODER_HIT(vmaxuh);
-      case 0b00001000100: PPC_DECODER_HIT(vrlh);
-      case 0b00001001000: PPC_DECODER_HIT(vmulouh);
-      case 0b00001001010: PPC_DECODER_HIT(vsubfp);
-      case 0b00001001100: PPC_DECODER_HIT(vmrghh);
-      case 0b00001001110: PPC_DECODER_HIT(vpkuwum);
-      case 0b00010000000: PPC_DECODER_HIT(vadduwm);
-      case 0b00010000010: PPC_DECODER_HIT(vmaxuw);
-      case 0b00010000100: PPC_DECODER_HIT(vrlw);
-      case 0b00010001100: PPC_DECODER_HIT(vmrghw);
-      case 0b00010001110: PPC_DECODER_HIT(vpkuhus);
-      case 0b00011001110: PPC_DECODER_HIT(vpkuwus);
-      case 0b00100000010: PPC_DECODER_HIT(vmaxsb);
-      case 0b00100000100: PPC_DECODER_HIT(vslb);
-      case 0b00100001000: PPC_DECODER_HIT(vmulosb);
-      case 0b00100001010: PPC_DECODER_HIT(vrefp);
-      case 0b00100001100: PPC_DECODER_HIT(vmrglb);
-      case 0b00100001110: PPC_DECODER_HIT(vpkshus);
-      case 0b00101000010: PPC_DECODER_HIT(vmaxsh);
-      case 0b00101000100: PPC_DECODER_HIT(vslh);
-      case 0b00101001000: PPC_DECODER_HIT(vmulosh);
-      case 0b00101001010: PPC_DECODER_HIT(vrsqrtefp);
-      case 0b00101001100: PPC_DECODER_HIT(vmrglh);
-      case 0b00101001110: PPC_DECODER_HIT(vpkswus);
-      case 0b00110000000: PPC_DECODER_HIT(vaddcuw);
-      case 0b00110000010: PPC_DECODER_HIT(vmaxsw);
-      case 0b00110000100: PPC_DECODER_HIT(vslw);
-      case 0b00110001010: PPC_DECODER_HIT(vexptefp);
-      case 0b00110001100: PPC_DECODER_HIT(vmrglw);
-      case 0b00110001110: PPC_DECODER_HIT(vpkshss);
-      case 0b00111000100: PPC_DECODER_HIT(vsl);
-      case 0b00111001010: PPC_DECODER_HIT(vlogefp);
-      case 0b00111001110: PPC_DECODER_HIT(vpkswss);
-      case 0b01000000000: PPC_DECODER_HIT(vaddubs);
-      case 0b01000000010: PPC_DECODER_HIT(vminub);
-      case 0b01000000100: PPC_DECODER_HIT(vsrb);
-      case 0b01000001000: PPC_DECODER_HIT(vmuleub);
-      case 0b01000001010: PPC_DECODER_HIT(vrfin);
-      case 0b01000001100: PPC_DECODER_HIT(vspltb);
-      case 0b01000001110: PPC_DECODER_HIT(vupkhsb);
-      case 0b01001000000: PPC_DECODER_HIT(vadduhs);
-      case 0b01001000010: PPC_DECODER_HIT(vminuh);
-      case 0b01001000100: PPC_DECODER_HIT(vsrh);
-      case 0b01001001000: PPC_DECODER_HIT(vmuleuh);
-      case 0b01001001010: PPC_DECODER_HIT(vrfiz);
-      case 0b01001001100: PPC_DECODER_HIT(vsplth);
-      case 0b01001001110: PPC_DECODER_HIT(vupkhsh);
-      case 0b01010000000: PPC_DECODER_HIT(vadduws);
-      case 0b01010000010: PPC_DECODER_HIT(vminuw);
-      case 0b01010000100: PPC_DECODER_HIT(vsrw);
-      case 0b01010001010: PPC_DECODER_HIT(vrfip);
-      case 0b01010001100: PPC_DECODER_HIT(vspltw);
-      case 0b01010001110: PPC_DECODER_HIT(vupklsb);
-      case 0b01011000100: PPC_DECODER_HIT(vsr);
-      case 0b01011001010: PPC_DECODER_HIT(vrfim);
-      case 0b01011001110: PPC_DECODER_HIT(vupklsh);
-      case 0b01100000000: PPC_DECODER_HIT(vaddsbs);
-      case 0b01100000010: PPC_DECODER_HIT(vminsb);
-      case 0b01100000100: PPC_DECODER_HIT(vsrab);
-      case 0b01100001000: PPC_DECODER_HIT(vmulesb);
-      case 0b01100001010: PPC_DECODER_HIT(vcfux);
-      case 0b01100001100: PPC_DECODER_HIT(vspltisb);
-      case 0b01100001110: PPC_DECODER_HIT(vpkpx);
-      case 0b01101000000: PPC_DECODER_HIT(vaddshs);
-      case 0b01101000010: PPC_DECODER_HIT(vminsh);
-      case 0b01101000100: PPC_DECODER_HIT(vsrah);
-      case 0b01101001000: PPC_DECODER_HIT(vmulesh);
-      case 0b01101001010: PPC_DECODER_HIT(vcfsx);
-      case 0b01101001100: PPC_DECODER_HIT(vspltish);
-      case 0b01101001110: PPC_DECODER_HIT(vupkhpx);
-      case 0b01110000000: PPC_DECODER_HIT(vaddsws);
-      case 0b01110000010: PPC_DECODER_HIT(vminsw);
-      case 0b01110000100: PPC_DECODER_HIT(vsraw);
-      case 0b01110001010: PPC_DECODER_HIT(vctuxs);
-      case 0b01110001100: PPC_DECODER_HIT(vspltisw);
-      case 0b01111001010: PPC_DECODER_HIT(vctsxs);
-      case 0b01111001110: PPC_DECODER_HIT(vupklpx);
-      case 0b10000000000: PPC_DECODER_HIT(vsububm);
-      case 0b10000000010: PPC_DECODER_HIT(vavgub);
-      case 0b10000000100: PPC_DECODER_HIT(vand);
-      case 0b10000001010: PPC_DECODER_HIT(vmaxfp);
-      case 0b10000001100: PPC_DECODER_HIT(vslo);
-      case 0b10001000000: PPC_DECODER_HIT(vsubuhm);
-      case 0b10001000010: PPC_DECODER_HIT(vavguh);
-      case 0b10001000100: PPC_DECODER_HIT(vandc);
-      case 0b10001001010: PPC_DECODER_HIT(vminfp);
-      case 0b10001001100: PPC_DECODER_HIT(vsro);
-      case 0b10010000000: PPC_DECODER_HIT(vsubuwm);
-      case 0b10010000010: PPC_DECODER_HIT(vavguw);
-      case 0b10010000100: PPC_DECODER_HIT(vor);
-      case 0b10011000100: PPC_DECODER_HIT(vxor);
-      case 0b10100000010: PPC_DECODER_HIT(vavgsb);
-      case 0b10100000100: PPC_DECODER_HIT(vnor);
-      case 0b10101000010: PPC_DECODER_HIT(vavgsh);
-      case 0b10110000000: PPC_DECODER_HIT(vsubcuw);
-      case 0b10110000010: PPC_DECODER_HIT(vavgsw);
-      case 0b11000000000: PPC_DECODER_HIT(vsububs);
-      case 0b11000000100: PPC_DECODER_HIT(mfvscr);
-      case 0b11000001000: PPC_DECODER_HIT(vsum4ubs);
-      case 0b11001000000: PPC_DECODER_HIT(vsubuhs);
-      case 0b11001000100: PPC_DECODER_HIT(mtvscr);
-      case 0b11001001000: PPC_DECODER_HIT(vsum4shs);
-      case 0b11010000000: PPC_DECODER_HIT(vsubuws);
-      case 0b11010001000: PPC_DECODER_HIT(vsum2sws);
-      case 0b11100000000: PPC_DECODER_HIT(vsubsbs);
-      case 0b11100001000: PPC_DECODER_HIT(vsum4sbs);
-      case 0b11101000000: PPC_DECODER_HIT(vsubshs);
-      case 0b11110000000: PPC_DECODER_HIT(vsubsws);
-      case 0b11110001000: PPC_DECODER_HIT(vsumsws);
-    }
-    switch ((ExtractBits(code, 22, 31) << 0)) {
-      case 0b0000000110: PPC_DECODER_HIT(vcmpequb);
-      case 0b0001000110: PPC_DECODER_HIT(vcmpequh);
-      case 0b0010000110: PPC_DECODER_HIT(vcmpequw);
-      case 0b0011000110: PPC_DECODER_HIT(vcmpeqfp);
-      case 0b0111000110: PPC_DECODER_HIT(vcmpgefp);
-      case 0b1000000110: PPC_DECODER_HIT(vcmpgtub);
-      case 0b1001000110: PPC_DECODER_HIT(vcmpgtuh);
-      case 0b1010000110: PPC_DECODER_HIT(vcmpgtuw);
-      case 0b1011000110: PPC_DECODER_HIT(vcmpgtfp);
-      case 0b1100000110: PPC_DECODER_HIT(vcmpgtsb);
-      case 0b1101000110: PPC_DECODER_HIT(vcmpgtsh);
-      case 0b1110000110: PPC_DECODER_HIT(vcmpgtsw);
-      case 0b1111000110: PPC_DECODER_HIT(vcmpbfp);
-    }
-    switch ((ExtractBits(code, 26, 31) << 0)) {
-      case 0b100000: PPC_DECODER_HIT(vmhaddshs);
-      case 0b100001: PPC_DECODER_HIT(vmhraddshs);
-      case 0b100010: PPC_DECODER_HIT(vmladduhm);
-      case 0b100100: PPC_DECODER_HIT(vmsumubm);
-      case 0b100101: PPC_DECODER_HIT(vmsummbm);
-      case 0b100110: PPC_DECODER_HIT(vmsumuhm);
-      case 0b100111: PPC_DECODER_HIT(vmsumuhs);
-      case 0b101000: PPC_DECODER_HIT(vmsumshm);
-      case 0b101001: PPC_DECODER_HIT(vmsumshs);
-      case 0b101010: PPC_DECODER_HIT(vsel);
-      case 0b101011: PPC_DECODER_HIT(vperm);
-      case 0b101100: PPC_DECODER_HIT(vsldoi);
-      case 0b101110: PPC_DECODER_HIT(vmaddfp);
-      case 0b101111: PPC_DECODER_HIT(vnmsubfp);
-    }
-    switch ((ExtractBits(code, 27, 27) << 0)) {
-      case 0b1: PPC_DECODER_HIT(vsldoi128);
-    }
-    PPC_DECODER_MISS;
-  case 5:
-    switch ((ExtractBits(code, 22, 22) << 5)|(ExtractBits(code, 27, 27) << 0)) {
-      case 0b000000: PPC_DECODER_HIT(vperm128);
-    }
-    switch ((ExtractBits(code, 22, 25) << 2)|(ExtractBits(code, 27, 27) << 0)) {
-      case 0b000001: PPC_DECODER_HIT(vaddfp128);
-      case 0b000101: PPC_DECODER_HIT(vsubfp128);
-      case 0b001001: PPC_DECODER_HIT(vmulfp128);
-      case 0b001101: PPC_DECODER_HIT(vmaddfp128);
-      case 0b010001: PPC_DECODER_HIT(vmaddcfp128);
-      case 0b010101: PPC_DECODER_HIT(vnmsubfp128);
-      case 0b011001: PPC_DECODER_HIT(vmsum3fp128);
-      case 0b011101: PPC_DECODER_HIT(vmsum4fp128);
-      case 0b100000: PPC_DECODER_HIT(vpkshss128);
-      case 0b100001: PPC_DECODER_HIT(vand128);
-      case 0b100100: PPC_DECODER_HIT(vpkshus128);
-      case 0b100101: PPC_DECODER_HIT(vandc128);
-      case 0b101000: PPC_DECODER_HIT(vpkswss128);
-      case 0b101001: PPC_DECODER_HIT(vnor128);
-      case 0b101100: PPC_DECODER_HIT(vpkswus128);
-      case 0b101101: PPC_DECODER_HIT(vor128);
-      case 0b110000: PPC_DECODER_HIT(vpkuhum128);
-      case 0b110001: PPC_DECODER_HIT(vxor128);
-      case 0b110100: PPC_DECODER_HIT(vpkuhus128);
-      case 0b110101: PPC_DECODER_HIT(vsel128);
-      case 0b111000: PPC_DECODER_HIT(vpkuwum128);
-      case 0b111001: PPC_DECODER_HIT(vslo128);
-      case 0b111100: PPC_DECODER_HIT(vpkuwus128);
-      case 0b111101: PPC_DECODER_HIT(vsro128);
-    }
-    PPC_DECODER_MISS;
-  case 6:
-    switch ((ExtractBits(code, 21, 22) << 5)|(ExtractBits(code, 26, 27) << 0)) {
-      case 0b0100001: PPC_DECODER_HIT(vpermwi128);
-    }
-    switch ((ExtractBits(code, 21, 23) << 4)|(ExtractBits(code, 26, 27) << 0)) {
-      case 0b1100001: PPC_DECODER_HIT(vpkd3d128);
-      case 0b1110001: PPC_DECODER_HIT(vrlimi128);
-    }
-    switch ((ExtractBits(code, 21, 27) << 0)) {
-      case 0b0100011: PPC_DECODER_HIT(vcfpsxws128);
-      case 0b0100111: PPC_DECODER_HIT(vcfpuxws128);
-      case 0b0101011: PPC_DECODER_HIT(vcsxwfp128);
-      case 0b0101111: PPC_DECODER_HIT(vcuxwfp128);
-      case 0b0110011: PPC_DECODER_HIT(vrfim128);
-      case 0b0110111: PPC_DECODER_HIT(vrfin128);
-      case 0b0111011: PPC_DECODER_HIT(vrfip128);
-      case 0b0111111: PPC_DECODER_HIT(vrfiz128);
-      case 0b1100011: PPC_DECODER_HIT(vrefp128);
-      case 0b1100111: PPC_DECODER_HIT(vrsqrtefp128);
-      case 0b1101011: PPC_DECODER_HIT(vexptefp128);
-      case 0b1101111: PPC_DECODER_HIT(vlogefp128);
-      case 0b1110011: PPC_DECODER_HIT(vspltw128);
-      case 0b1110111: PPC_DECODER_HIT(vspltisw128);
-      case 0b1111111: PPC_DECODER_HIT(vupkd3d128);
-    }
-    switch ((ExtractBits(code, 22, 24) << 3)|(ExtractBits(code, 27, 27) << 0)) {
-      case 0b000000: PPC_DECODER_HIT(vcmpeqfp128);
-      case 0b001000: PPC_DECODER_HIT(vcmpgefp128);
-      case 0b010000: PPC_DECODER_HIT(vcmpgtfp128);
-      case 0b011000: PPC_DECODER_HIT(vcmpbfp128);
-      case 0b100000: PPC_DECODER_HIT(vcmpequw128);
-    }
-    switch ((ExtractBits(code, 22, 25) << 2)|(ExtractBits(code, 27, 27) << 0)) {
-      case 0b000101: PPC_DECODER_HIT(vrlw128);
-      case 0b001101: PPC_DECODER_HIT(vslw128);
-      case 0b010101: PPC_DECODER_HIT(vsraw128);
-      case 0b011101: PPC_DECODER_HIT(vsrw128);
-      case 0b101000: PPC_DECODER_HIT(vmaxfp128);
-      case 0b101100: PPC_DECODER_HIT(vminfp128);
-      case 0b110000: PPC_DECODER_HIT(vmrghw128);
-      case 0b110100: PPC_DECODER_HIT(vmrglw128);
-      case 0b111000: PPC_DECODER_HIT(vupkhsb128);
-      case 0b111100: PPC_DECODER_HIT(vupklsb128);
-    }
-    PPC_DECODER_MISS;
-  case 7: PPC_DECODER_HIT(mulli);
-  case 8: PPC_DECODER_HIT(subficx);
-  case 10: PPC_DECODER_HIT(cmpli);
-  case 11: PPC_DECODER_HIT(cmpi);
-  case 12: PPC_DECODER_HIT(addic);
-  case 13: PPC_DECODER_HIT(addicx);
-  case 14: PPC_DECODER_HIT(addi);
-  case 15: PPC_DECODER_HIT(addis);
-  case 16: PPC_DECODER_HIT(bcx);
-  case 17: PPC_DECODER_HIT(sc);
-  case 18: PPC_DECODER_HIT(bx);
-  case 19:
-    switch ((ExtractBits(code, 21, 30) << 0)) {
-      case 0b0000000000: PPC_DECODER_HIT(mcrf);
-      case 0b0000010000: PPC_DECODER_HIT(bclrx);
-      case 0b0000100001: PPC_DECODER_HIT(crnor);
-      case 0b0010000001: PPC_DECODER_HIT(crandc);
-      case 0b0010010110: PPC_DECODER_HIT(isync);
-      case 0b0011000001: PPC_DECODER_HIT(crxor);
-      case 0b0011100001: PPC_DECODER_HIT(crnand);
-      case 0b0100000001: PPC_DECODER_HIT(crand);
-      case 0b0100100001: PPC_DECODER_HIT(creqv);
-      case 0b0110100001: PPC_DECODER_HIT(crorc);
-      case 0b0111000001: PPC_DECODER_HIT(cror);
-      case 0b1000010000: PPC_DECODER_HIT(bcctrx);
-    }
-    PPC_DECODER_MISS;
-  case 20: PPC_DECODER_HIT(rlwimix);
-  case 21: PPC_DECODER_HIT(rlwinmx);
-  case 23: PPC_DECODER_HIT(rlwnmx);
-  case 24: PPC_DECODER_HIT(ori);
-  case 25: PPC_DECODER_HIT(oris);
-  case 26: PPC_DECODER_HIT(xori);
-  case 27: PPC_DECODER_HIT(xoris);
-  case 28: PPC_DECODER_HIT(andix);
-  case 29: PPC_DECODER_HIT(andisx);
-  case 30:
-    switch ((ExtractBits(code, 27, 29) << 0)) {
-      case 0b000: PPC_DECODER_HIT(rldiclx);
-      case 0b001: PPC_DECODER_HIT(rldicrx);
-      case 0b010: PPC_DECODER_HIT(rldicx);
-      case 0b011: PPC_DECODER_HIT(rldimix);
-    }
-    switch ((ExtractBits(code, 27, 30) << 0)) {
-      case 0b1000: PPC_DECODER_HIT(rldclx);
-      case 0b1001: PPC_DECODER_HIT(rldcrx);
-    }
-    PPC_DECODER_MISS;
-  case 31:
-    switch ((ExtractBits(code, 21, 29) << 0)) {
-      case 0b110011101: PPC_DECODER_HIT(sradix);
-    }
-    switch ((ExtractBits(code, 21, 30) << 0)) {
-      case 0b0000000000: PPC_DECODER_HIT(cmp);
-      case 0b0000000100: PPC_DECODER_HIT(tw);
-      case 0b0000000110: PPC_DECODER_HIT(lvsl);
-      case 0b0000000111: PPC_DECODER_HIT(lvebx);
-      case 0b0000010011: PPC_DECODER_HIT(mfcr);
-      case 0b0000010100: PPC_DECODER_HIT(lwarx);
-      case 0b0000010101: PPC_DECODER_HIT(ldx);
-      case 0b0000010111: PPC_DECODER_HIT(lwzx);
-      case 0b0000011000: PPC_DECODER_HIT(slwx);
-      case 0b0000011010: PPC_DECODER_HIT(cntlzwx);
-      case 0b0000011011: PPC_DECODER_HIT(sldx);
-      case 0b0000011100: PPC_DECODER_HIT(andx);
-      case 0b0000100000: PPC_DECODER_HIT(cmpl);
-      case 0b0000100110: PPC_DECODER_HIT(lvsr);
-      case 0b0000100111: PPC_DECODER_HIT(lvehx);
-      case 0b0000110101: PPC_DECODER_HIT(ldux);
-      case 0b0000110110: PPC_DECODER_HIT(dcbst);
-      case 0b0000110111: PPC_DECODER_HIT(lwzux);
-      case 0b0000111010: PPC_DECODER_HIT(cntlzdx);
-      case 0b0000111100: PPC_DECODER_HIT(andcx);
-      case 0b0001000100: PPC_DECODER_HIT(td);
-      case 0b0001000111: PPC_DECODER_HIT(lvewx);
-      case 0b0001010011: PPC_DECODER_HIT(mfmsr);
-      case 0b0001010100: PPC_DECODER_HIT(ldarx);
-      case 0b0001010110: PPC_DECODER_HIT(dcbf);
-      case 0b0001010111: PPC_DECODER_HIT(lbzx);
-      case 0b0001100111: PPC_DECODER_HIT(lvx);
-      case 0b0001110111: PPC_DECODER_HIT(lbzux);
-      case 0b0001111100: PPC_DECODER_HIT(norx);
-      case 0b0010000111: PPC_DECODER_HIT(stvebx);
-      case 0b0010010000: PPC_DECODER_HIT(mtcrf);
-      case 0b0010010010: PPC_DECODER_HIT(mtmsr);
-      case 0b0010010101: PPC_DECODER_HIT(stdx);
-      case 0b0010010110: PPC_DECODER_HIT(stwcx);
-      case 0b0010010111: PPC_DECODER_HIT(stwx);
-      case 0b0010100111: PPC_DECODER_HIT(stvehx);
-      case 0b0010110010: PPC_DECODER_HIT(mtmsrd);
-      case 0b0010110101: PPC_DECODER_HIT(stdux);
-      case 0b0010110111: PPC_DECODER_HIT(stwux);
-      case 0b0011000111: PPC_DECODER_HIT(stvewx);
-      case 0b0011010110: PPC_DECODER_HIT(stdcx);
-      case 0b0011010111: PPC_DECODER_HIT(stbx);
-      case 0b0011100111: PPC_DECODER_HIT(stvx);
-      case 0b0011110110: PPC_DECODER_HIT(dcbtst);
-      case 0b0011110111: PPC_DECODER_HIT(stbux);
-      case 0b0100010110: PPC_DECODER_HIT(dcbt);
-      case 0b0100010111: PPC_DECODER_HIT(lhzx);
-      case 0b0100011100: PPC_DECODER_HIT(eqvx);
-      case 0b0100110111: PPC_DECODER_HIT(lhzux);
-      case 0b0100111100: PPC_DECODER_HIT(xorx);
-      case 0b0101010011: PPC_DECODER_HIT(mfspr);
-      case 0b0101010101: PPC_DECODER_HIT(lwax);
-      case 0b0101010111: PPC_DECODER_HIT(lhax);
-      case 0b0101100111: PPC_DECODER_HIT(lvxl);
-      case 0b0101110011: PPC_DECODER_HIT(mftb);
-      case 0b0101110101: PPC_DECODER_HIT(lwaux);
-      case 0b0101110111: PPC_DECODER_HIT(lhaux);
-      case 0b0110010111: PPC_DECODER_HIT(sthx);
-      case 0b0110011100: PPC_DECODER_HIT(orcx);
-      case 0b0110110111: PPC_DECODER_HIT(sthux);
-      case 0b0110111100: PPC_DECODER_HIT(orx);
-      case 0b0111010011: PPC_DECODER_HIT(mtspr);
-      case 0b0111010110: PPC_DECODER_HIT(dcbi);
-      case 0b0111011100: PPC_DECODER_HIT(nandx);
-      case 0b0111100111: PPC_DECODER_HIT(stvxl);
-      case 0b1000000000: PPC_DECODER_HIT(mcrxr);
-      case 0b1000000111: PPC_DECODER_HIT(lvlx);
-      case 0b1000010100: PPC_DECODER_HIT(ldbrx);
-      case 0b1000010101: PPC_DECODER_HIT(lswx);
-      case 0b1000010110: PPC_DECODER_HIT(lwbrx);
-      case 0b1000010111: PPC_DECODER_HIT(lfsx);
-      case 0b1000011000: PPC_DECODER_HIT(srwx);
-      case 0b1000011011: PPC_DECODER_HIT(srdx);
-      case 0b1000100111: PPC_DECODER_HIT(lvrx);
-      case 0b1000110111: PPC_DECODER_HIT(lfsux);
-      case 0b1001010101: PPC_DECODER_HIT(lswi);
-      case 0b1001010110: PPC_DECODER_HIT(sync);
-      case 0b1001010111: PPC_DECODER_HIT(lfdx);
-      case 0b1001110111: PPC_DECODER_HIT(lfdux);
-      case 0b1010000111: PPC_DECODER_HIT(stvlx);
-      case 0b1010010100: PPC_DECODER_HIT(stdbrx);
-      case 0b1010010101: PPC_DECODER_HIT(stswx);
-      case 0b1010010110: PPC_DECODER_HIT(stwbrx);
-      case 0b1010010111: PPC_DECODER_HIT(stfsx);
-      case 0b1010100111: PPC_DECODER_HIT(stvrx);
-      case 0b1010110111: PPC_DECODER_HIT(stfsux);
-      case 0b1011010101: PPC_DECODER_HIT(stswi);
-      case 0b1011010111: PPC_DECODER_HIT(stfdx);
-      case 0b1011110111: PPC_DECODER_HIT(stfdux);
-      case 0b1100000111: PPC_DECODER_HIT(lvlxl);
-      case 0b1100010110: PPC_DECODER_HIT(lhbrx);
-      case 0b1100011000: PPC_DECODER_HIT(srawx);
-      case 0b1100011010: PPC_DECODER_HIT(sradx);
-      case 0b1100100111: PPC_DECODER_HIT(lvrxl);
-      case 0b1100111000: PPC_DECODER_HIT(srawix);
-      case 0b1101010110: PPC_DECODER_HIT(eieio);
-      case 0b1110000111: PPC_DECODER_HIT(stvlxl);
-      case 0b1110010110: PPC_DECODER_HIT(sthbrx);
-      case 0b1110011010: PPC_DECODER_HIT(extshx);
-      case 0b1110100111: PPC_DECODER_HIT(stvrxl);
-      case 0b1110111010: PPC_DECODER_HIT(extsbx);
-      case 0b1111010110: PPC_DECODER_HIT(icbi);
-      case 0b1111010111: PPC_DECODER_HIT(stfiwx);
-      case 0b1111011010: PPC_DECODER_HIT(extswx);
-    }
-    switch ((ExtractBits(code, 22, 30) << 0)) {
-      case 0b000001000: PPC_DECODER_HIT(subfcx);
-      case 0b000001001: PPC_DECODER_HIT(mulhdux);
-      case 0b000001010: PPC_DECODER_HIT(addcx);
-      case 0b000001011: PPC_DECODER_HIT(mulhwux);
-      case 0b000101000: PPC_DECODER_HIT(subfx);
-      case 0b001001001: PPC_DECODER_HIT(mulhdx);
-      case 0b001001011: PPC_DECODER_HIT(mulhwx);
-      case 0b001101000: PPC_DECODER_HIT(negx);
-      case 0b010001000: PPC_DECODER_HIT(subfex);
-      case 0b010001010: PPC_DECODER_HIT(addex);
-      case 0b011001000: PPC_DECODER_HIT(subfzex);
-      case 0b011001010: PPC_DECODER_HIT(addzex);
-      case 0b011101000: PPC_DECODER_HIT(subfmex);
-      case 0b011101001: PPC_DECODER_HIT(mulldx);
-      case 0b011101010: PPC_DECODER_HIT(addmex);
-      case 0b011101011: PPC_DECODER_HIT(mullwx);
-      case 0b100001010: PPC_DECODER_HIT(addx);
-      case 0b111001001: PPC_DECODER_HIT(divdux);
-      case 0b111001011: PPC_DECODER_HIT(divwux);
-      case 0b111101001: PPC_DECODER_HIT(divdx);
-      case 0b111101011: PPC_DECODER_HIT(divwx);
-    }
-    switch ((ExtractBits(code, 6, 10) << 20)|(ExtractBits(code, 21, 30) << 0)) {
-      case 0b0000000000000001111110110: PPC_DECODER_HIT(dcbz);
-      case 0b0000100000000001111110110: PPC_DECODER_HIT(dcbz128);
-    }
-    PPC_DECODER_MISS;
-  case 32: PPC_DECODER_HIT(lwz);
-  case 33: PPC_DECODER_HIT(lwzu);
-  case 34: PPC_DECODER_HIT(lbz);
-  case 35: PPC_DECODER_HIT(lbzu);
-  case 36: PPC_DECODER_HIT(stw);
-  case 37: PPC_DECODER_HIT(stwu);
-  case 38: PPC_DECODER_HIT(stb);
-  case 39: PPC_DECODER_HIT(stbu);
-  case 40: PPC_DECODER_HIT(lhz);
-  case 41: PPC_DECODER_HIT(lhzu);
-  case 42: PPC_DECODER_HIT(lha);
-  case 43: PPC_DECODER_HIT(lhau);
-  case 44: PPC_DECODER_HIT(sth);
-  case 45: PPC_DECODER_HIT(sthu);
-  case 46: PPC_DECODER_HIT(lmw);
-  case 47: PPC_DECODER_HIT(stmw);
-  case 48: PPC_DECODER_HIT(lfs);
-  case 49: PPC_DECODER_HIT(lfsu);
-  case 50: PPC_DECODER_HIT(lfd);
-  case 51: PPC_DECODER_HIT(lfdu);
-  case 52: PPC_DECODER_HIT(stfs);
-  case 53: PPC_DECODER_HIT(stfsu);
-  case 54: PPC_DECODER_HIT(stfd);
-  case 55: PPC_DECODER_HIT(stfdu);
-  case 58:
-    switch ((ExtractBits(code, 30, 31) << 0)) {
-      case 0b00: PPC_DECODER_HIT(ld);
-      case 0b01: PPC_DECODER_HIT(ldu);
-      case 0b10: PPC_DECODER_HIT(lwa);
-    }
-    PPC_DECODER_MISS;
-  case 59:
-    switch ((ExtractBits(code, 26, 30) << 0)) {
-      case 0b10010: PPC_DECODER_HIT(fdivsx);
-      case 0b10100: PPC_DECODER_HIT(fsubsx);
-      case 0b10101: PPC_DECODER_HIT(faddsx);
-      case 0b10110: PPC_DECODER_HIT(fsqrtsx);
-      case 0b11000: PPC_DECODER_HIT(fresx);
-      case 0b11001: PPC_DECODER_HIT(fmulsx);
-      case 0b11100: PPC_DECODER_HIT(fmsubsx);
-      case 0b11101: PPC_DECODER_HIT(fmaddsx);
-      case 0b11110: PPC_DECODER_HIT(fnmsubsx);
-      case 0b11111: PPC_DECODER_HIT(fnmaddsx);
-    }
-    PPC_DECODER_MISS;
-  case 62:
-    switch ((ExtractBits(code, 30, 31) << 0)) {
-      case 0b00: PPC_DECODER_HIT(std);
-      case 0b01: PPC_DECODER_HIT(stdu);
-    }
-    PPC_DECODER_MISS;
-  case 63:
-    switch ((ExtractBits(code, 21, 30) << 0)) {
-      case 0b0000000000: PPC_DECODER_HIT(fcmpu);
-      case 0b0000001100: PPC_DECODER_HIT(frspx);
-      case 0b0000001110: PPC_DECODER_HIT(fctiwx);
-      case 0b0000001111: PPC_DECODER_HIT(fctiwzx);
-      case 0b0000100000: PPC_DECODER_HIT(fcmpo);
-      case 0b0000100110: PPC_DECODER_HIT(mtfsb1x);
-      case 0b0000101000: PPC_DECODER_HIT(fnegx);
-      case 0b0001000000: PPC_DECODER_HIT(mcrfs);
-      case 0b0001000110: PPC_DECODER_HIT(mtfsb0x);
-      case 0b0001001000: PPC_DECODER_HIT(fmrx);
-      case 0b0010000110: PPC_DECODER_HIT(mtfsfix);
-      case 0b0010001000: PPC_DECODER_HIT(fnabsx);
-      case 0b0100001000: PPC_DECODER_HIT(fabsx);
-      case 0b1001000111: PPC_DECODER_HIT(mffsx);
-      case 0b1011000111: PPC_DECODER_HIT(mtfsfx);
-      case 0b1100101110: PPC_DECODER_HIT(fctidx);
-      case 0b1100101111: PPC_DECODER_HIT(fctidzx);
-      case 0b1101001110: PPC_DECODER_HIT(fcfidx);
-    }
-    switch ((ExtractBits(code, 26, 30) << 0)) {
-      case 0b10010: PPC_DECODER_HIT(fdivx);
-      case 0b10100: PPC_DECODER_HIT(fsubx);
-      case 0b10101: PPC_DECODER_HIT(faddx);
-      case 0b10110: PPC_DECODER_HIT(fsqrtx);
-      case 0b10111: PPC_DECODER_HIT(fselx);
-      case 0b11001: PPC_DECODER_HIT(fmulx);
-      case 0b11010: PPC_DECODER_HIT(frsqrtex);
-      case 0b11100: PPC_DECODER_HIT(fmsubx);
-      case 0b11101: PPC_DECODER_HIT(fmaddx);
-      case 0b11110: PPC_DECODER_HIT(fnmsubx);
-      case 0b11111: PPC_DECODER_HIT(fnmaddx);
-    }
-    PPC_DECODER_MISS;
-  default: PPC_DECODER_MISS;
+  auto& primary = kPrimaryTable[code >> 26];
+  uint16_t opcode =
+    kExtendedTable[primary.offset + ((code >> primary.shift) & primary.mask)];
+  if (opcode & kResidualFlag) {
+    opcode = LookupResidual(code, opcode & ~kResidualFlag);
   }
+  return static_cast<PPCOpcode>(opcode);
 }
 
 }  // namespace ppc
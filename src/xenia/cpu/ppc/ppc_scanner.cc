@@ -32,7 +32,8 @@ namespace xe {
 namespace cpu {
 namespace ppc {
 
-PPCScanner::PPCScanner(PPCFrontend* frontend) : frontend_(frontend) {}
+PPCScanner::PPCScanner(PPCFrontend* frontend)
+    : frontend_(frontend), decode_cache_(frontend->memory()) {}
 
 PPCScanner::~PPCScanner() {}
 
@@ -49,8 +50,6 @@ bool PPCScanner::Scan(GuestFunction* function, FunctionDebugInfo* debug_info) {
   // is before the expected end address then the function address range is
   // split up and the second half is treated as another function.
 
-  Memory* memory = frontend_->memory();
-
   LOGPPC("Analyzing function %.8X...", function->address());
 
   // For debug info, only if needed.
@@ -64,9 +63,10 @@ bool PPCScanner::Scan(GuestFunction* function, FunctionDebugInfo* debug_info) {
   size_t blocks_found = 0;
   bool in_block = false;
   bool starts_with_mfspr_lr = false;
+  decode_cache_.Reset(start_address);
   while (true) {
-    uint32_t code =
-        xe::load_and_swap<uint32_t>(memory->TranslateVirtual(address));
+    auto decoded = decode_cache_.Decode(address);
+    uint32_t code = decoded.code;
 
     // If we fetched 0 assume that we somehow hit one of the awesome
     // 'no really we meant to end after that bl' functions.
@@ -77,7 +77,7 @@ bool PPCScanner::Scan(GuestFunction* function, FunctionDebugInfo* debug_info) {
       break;
     }
 
-    auto opcode = LookupOpcode(code);
+    auto opcode = decoded.opcode;
 
     PPCDecodeData d;
     d.address = address;
@@ -289,9 +289,72 @@ bool PPCScanner::Scan(GuestFunction* function, FunctionDebugInfo* debug_info) {
   return true;
 }
 
-std::vector<BlockInfo> PPCScanner::FindBlocks(GuestFunction* function) {
-  Memory* memory = frontend_->memory();
+bool PPCScanner::ScanInlineCandidate(uint32_t start_address,
+                                     uint32_t max_instr_count,
+                                     uint32_t* out_end_address) {
+  uint32_t furthest_target = start_address;
+  uint32_t address = start_address;
+  for (uint32_t n = 0; n < max_instr_count; ++n, address += 4) {
+    auto decoded = decode_cache_.Decode(address);
+    uint32_t code = decoded.code;
+    auto opcode = decoded.opcode;
+    if (!code || opcode == PPCOpcode::kInvalid) {
+      return false;
+    }
+
+    PPCDecodeData d;
+    d.address = address;
+    d.code = code;
 
+    uint32_t target;
+    if (code == 0x4E800020) {
+      // blr -- the end of the function, unless something branches past it.
+      if (furthest_target <= address) {
+        *out_end_address = address;
+        return true;
+      }
+      continue;
+    } else if (opcode == PPCOpcode::bx) {
+      if (d.I.LK()) {
+        return false;
+      }
+      target = d.I.ADDR();
+    } else if (opcode == PPCOpcode::bcx) {
+      if (d.B.LK()) {
+        return false;
+      }
+      target = d.B.ADDR();
+    } else if (opcode == PPCOpcode::bclrx) {
+      // Conditional returns are fine, calls through LR are not.
+      if (d.XL.LK()) {
+        return false;
+      }
+      continue;
+    } else if (opcode == PPCOpcode::bcctrx || opcode == PPCOpcode::sc) {
+      return false;
+    } else if (opcode == PPCOpcode::mtspr &&
+               (((d.XFX.SPR() & 0x1F) << 5) | ((d.XFX.SPR() >> 5) & 0x1F)) ==
+                   8) {
+      // mtlr -- blr would no longer be a return.
+      return false;
+    } else {
+      continue;
+    }
+
+    // Branches must stay within the function. Anything before the start is a
+    // tail call or a jump into some other function.
+    if (target < start_address) {
+      return false;
+    }
+    furthest_target = std::max(furthest_target, target);
+  }
+
+  LOGPPC("Not inlining %.8X: over %d instructions", start_address,
+         max_instr_count);
+  return false;
+}
+
+std::vector<BlockInfo> PPCScanner::FindBlocks(GuestFunction* function) {
   std::map<uint32_t, BlockInfo> block_map;
 
   uint32_t start_address = function->address();
@@ -299,12 +362,12 @@ std::vector<BlockInfo> PPCScanner::FindBlocks(GuestFunction* function) {
   bool in_block = false;
   uint32_t block_start = 0;
   for (uint32_t address = start_address; address <= end_address; address += 4) {
-    uint32_t code =
-        xe::load_and_swap<uint32_t>(memory->TranslateVirtual(address));
+    auto decoded = decode_cache_.Decode(address);
+    uint32_t code = decoded.code;
     if (!code) {
       continue;
     }
-    auto opcode = xe::cpu::ppc::LookupOpcode(code);
+    auto opcode = decoded.opcode;
 
     if (!in_block) {
       in_block = true;
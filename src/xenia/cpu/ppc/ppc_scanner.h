@@ -14,6 +14,7 @@
 
 #include "xenia/cpu/function.h"
 #include "xenia/cpu/function_debug_info.h"
+#include "xenia/cpu/ppc/ppc_decode_cache.h"
 
 namespace xe {
 namespace cpu {
@@ -31,14 +32,25 @@ class PPCScanner {
   explicit PPCScanner(PPCFrontend* frontend);
   ~PPCScanner();
 
+  // Instructions decoded by the last Scan, for the rest of the translation.
+  PPCDecodeCache* decode_cache() { return &decode_cache_; }
+
   bool Scan(GuestFunction* function, FunctionDebugInfo* debug_info);
 
   std::vector<BlockInfo> FindBlocks(GuestFunction* function);
 
+  // Checks whether the code at the given address is a small leaf function
+  // that can be inlined into its callers: it makes no calls, only branches
+  // within itself and only leaves through blr. Fails if it is longer than
+  // max_instr_count instructions.
+  bool ScanInlineCandidate(uint32_t start_address, uint32_t max_instr_count,
+                           uint32_t* out_end_address);
+
  private:
   bool IsRestGprLr(uint32_t address);
 
   PPCFrontend* frontend_ = nullptr;
+  PPCDecodeCache decode_cache_;
 };
 
 }  // namespace ppc
@@ -13,6 +13,7 @@
 
 #include "xenia/base/assert.h"
 #include "xenia/base/byte_order.h"
+#include "xenia/base/clock.h"
 #include "xenia/base/memory.h"
 #include "xenia/base/profiling.h"
 #include "xenia/base/reset_scope.h"
@@ -36,7 +37,7 @@ PPCTranslator::PPCTranslator(PPCFrontend* frontend) : frontend_(frontend) {
   Backend* backend = frontend->processor()->backend();
 
   scanner_.reset(new PPCScanner(frontend));
-  builder_.reset(new PPCHIRBuilder(frontend));
+  builder_.reset(new PPCHIRBuilder(frontend, scanner_.get()));
   compiler_.reset(new Compiler(frontend->processor()));
   assembler_ = backend->CreateAssembler();
   assembler_->Initialize();
@@ -57,6 +58,10 @@ PPCTranslator::PPCTranslator(PPCFrontend* frontend) : frontend_(frontend) {
   if (validate) compiler_->AddPass(std::make_unique<passes::ValidationPass>());
   compiler_->AddPass(std::make_unique<passes::ConstantPropagationPass>());
   if (validate) compiler_->AddPass(std::make_unique<passes::ValidationPass>());
+  compiler_->AddPass(std::make_unique<passes::ValueNumberingPass>());
+  if (validate) compiler_->AddPass(std::make_unique<passes::ValidationPass>());
+  compiler_->AddPass(std::make_unique<passes::LoopInvariantCodeMotionPass>());
+  if (validate) compiler_->AddPass(std::make_unique<passes::ValidationPass>());
   if (backend->machine_info()->supports_extended_load_store) {
     // Backend supports the advanced LOAD/STORE instructions.
     // These will save us a lot of HIR opcodes.
@@ -73,6 +78,10 @@ PPCTranslator::PPCTranslator(PPCFrontend* frontend) : frontend_(frontend) {
   compiler_->AddPass(std::make_unique<passes::DeadCodeEliminationPass>());
   if (validate) compiler_->AddPass(std::make_unique<passes::ValidationPass>());
 
+  // Orders blocks by the title's execution profile, if it has one.
+  compiler_->AddPass(std::make_unique<passes::BlockLayoutPass>());
+  if (validate) compiler_->AddPass(std::make_unique<passes::ValidationPass>());
+
   //// Removes all unneeded variables. Try not to add new ones after this.
   // compiler_->AddPass(new passes::ValueReductionPass());
   // if (validate) compiler_->AddPass(new passes::ValidationPass());
@@ -95,6 +104,21 @@ bool PPCTranslator::Translate(GuestFunction* function,
                               uint32_t debug_info_flags) {
   SCOPE_profile_cpu_f("cpu");
 
+  // Stage timings are cheap enough to always take, but are only gathered
+  // into the frontend totals when stats are enabled.
+  StageStats stage_stats = {0};
+  uint64_t start_ticks = Clock::QueryHostTickCount();
+  bool result = TranslateFunction(function, debug_info_flags, &stage_stats);
+  if (frontend_->stats_enabled()) {
+    RecordStats(function, result, stage_stats,
+                Clock::QueryHostTickCount() - start_ticks);
+  }
+  return result;
+}
+
+bool PPCTranslator::TranslateFunction(GuestFunction* function,
+                                      uint32_t debug_info_flags,
+                                      StageStats* stage_stats) {
   // Reset() all caching when we leave.
   xe::make_reset_scope(builder_);
   xe::make_reset_scope(compiler_);
@@ -117,15 +141,21 @@ bool PPCTranslator::Translate(GuestFunction* function,
   if (FLAGS_trace_function_data) {
     debug_info_flags |= DebugInfoFlags::kDebugInfoTraceFunctionData;
   }
+  if (frontend_->processor()->is_recording_execution_profile()) {
+    debug_info_flags |= DebugInfoFlags::kDebugInfoTraceFunctions |
+                        DebugInfoFlags::kDebugInfoTraceFunctionCoverage;
+  }
   std::unique_ptr<FunctionDebugInfo> debug_info;
   if (debug_info_flags) {
     debug_info.reset(new FunctionDebugInfo());
   }
 
   // Scan the function to find its extents and gather debug data.
+  uint64_t stage_start_ticks = Clock::QueryHostTickCount();
   if (!scanner_->Scan(function, debug_info.get())) {
     return false;
   }
+  stage_stats->scan_ticks = Clock::QueryHostTickCount() - stage_start_ticks;
 
   // Setup trace data, if needed.
   if (debug_info_flags & DebugInfoFlags::kDebugInfoTraceFunctions) {
@@ -160,9 +190,25 @@ bool PPCTranslator::Translate(GuestFunction* function,
   if (debug_info) {
     emit_flags |= PPCHIRBuilder::EMIT_DEBUG_COMMENTS;
   }
+  // Inlined code can't be broken into or traced, as both work on the address
+  // range of the function.
+  if (!FLAGS_debug &&
+      !(debug_info_flags & DebugInfoFlags::kDebugInfoTraceFunctions)) {
+    emit_flags |= PPCHIRBuilder::EMIT_INLINE_CALLS;
+  }
+  stage_start_ticks = Clock::QueryHostTickCount();
   if (!builder_->Emit(function, emit_flags)) {
     return false;
   }
+  stage_stats->hir_build_ticks =
+      Clock::QueryHostTickCount() - stage_start_ticks;
+  if (frontend_->stats_enabled()) {
+    for (auto block = builder_->first_block(); block; block = block->next) {
+      for (auto instr = block->instr_head; instr; instr = instr->next) {
+        ++stage_stats->hir_instr_count;
+      }
+    }
+  }
 
   // Stash raw HIR.
   if (debug_info_flags & DebugInfoFlags::kDebugInfoDisasmRawHir) {
@@ -172,6 +218,7 @@ bool PPCTranslator::Translate(GuestFunction* function,
   }
 
   // Compile/optimize/etc.
+  // Passes time themselves.
   if (!compiler_->Compile(builder_.get())) {
     return false;
   }
@@ -184,18 +231,50 @@ bool PPCTranslator::Translate(GuestFunction* function,
   }
 
   // Assemble to backend machine code.
+  stage_start_ticks = Clock::QueryHostTickCount();
   if (!assembler_->Assemble(function, builder_.get(), debug_info_flags,
                             std::move(debug_info))) {
     return false;
   }
+  stage_stats->assemble_ticks =
+      Clock::QueryHostTickCount() - stage_start_ticks;
 
   return true;
 }
 
+void PPCTranslator::RecordStats(GuestFunction* function, bool succeeded,
+                                const StageStats& stage_stats,
+                                uint64_t total_ticks) {
+  PPCTranslationStats stats;
+  stats.total_ticks = total_ticks;
+  if (!succeeded) {
+    // Stages may not have run, so only the time spent is meaningful.
+    stats.failed_count = 1;
+    frontend_->AccumulateStats(stats);
+    return;
+  }
+  stats.function_count = 1;
+  stats.guest_instr_count =
+      (function->end_address() - function->address()) / 4 + 1;
+  stats.hir_instr_count = stage_stats.hir_instr_count;
+  stats.machine_code_size = function->machine_code_length();
+  stats.inlined_call_count = builder_->inlined_call_count();
+  stats.scan_ticks = stage_stats.scan_ticks;
+  stats.hir_build_ticks = stage_stats.hir_build_ticks;
+  stats.passes.reserve(compiler_->pass_count());
+  for (size_t i = 0; i < compiler_->pass_count(); ++i) {
+    stats.passes.push_back({compiler_->pass_name(i), compiler_->pass_ticks(i)});
+  }
+  stats.assemble_ticks = stage_stats.assemble_ticks;
+  stats.place_ticks = assembler_->place_ticks();
+  stats.hir_arena_high_water = builder_->arena()->high_water_mark();
+  stats.scratch_arena_high_water =
+      compiler_->scratch_arena()->high_water_mark();
+  frontend_->AccumulateStats(stats);
+}
+
 void PPCTranslator::DumpSource(GuestFunction* function,
                                StringBuffer* string_buffer) {
-  Memory* memory = frontend_->memory();
-
   string_buffer->AppendFormat(
       "%s fn %.8X-%.8X %s\n", function->module()->name().c_str(),
       function->address(), function->end_address(), function->name().c_str());
@@ -207,8 +286,7 @@ void PPCTranslator::DumpSource(GuestFunction* function,
   auto block_it = blocks.begin();
   for (uint32_t address = start_address, offset = 0; address <= end_address;
        address += 4, offset++) {
-    uint32_t code =
-        xe::load_and_swap<uint32_t>(memory->TranslateVirtual(address));
+    uint32_t code = scanner_->decode_cache()->Decode(address).code;
 
     // Check labels.
     if (block_it != blocks.end() && block_it->start_address == address) {
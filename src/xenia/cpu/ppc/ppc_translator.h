@@ -33,6 +33,18 @@ class PPCTranslator {
   bool Translate(GuestFunction* function, uint32_t debug_info_flags);
 
  private:
+  // Per-stage results of a single translation, for PPCTranslationStats.
+  struct StageStats {
+    uint64_t scan_ticks;
+    uint64_t hir_build_ticks;
+    uint64_t assemble_ticks;
+    uint64_t hir_instr_count;
+  };
+
+  bool TranslateFunction(GuestFunction* function, uint32_t debug_info_flags,
+                         StageStats* stage_stats);
+  void RecordStats(GuestFunction* function, bool succeeded,
+                   const StageStats& stage_stats, uint64_t total_ticks);
   void DumpSource(GuestFunction* function, StringBuffer* string_buffer);
 
   PPCFrontend* frontend_;
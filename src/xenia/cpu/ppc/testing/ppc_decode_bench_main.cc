@@ -0,0 +1,161 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#include <gflags/gflags.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <vector>
+
+#include "xenia/base/byte_order.h"
+#include "xenia/base/clock.h"
+#include "xenia/base/logging.h"
+#include "xenia/base/main.h"
+#include "xenia/base/mapped_memory.h"
+#include "xenia/base/string.h"
+#include "xenia/cpu/ppc/ppc_decode_cache.h"
+#include "xenia/cpu/ppc/ppc_opcode_info.h"
+#include "xenia/kernel/util/xex2.h"
+#include "xenia/memory.h"
+
+DEFINE_string(decode_bench_xex_path, "",
+              "XEX whose .text section is decoded, if not given as argument.");
+DEFINE_int32(decode_bench_iterations, 100,
+             "Number of times to decode the whole section.");
+
+namespace xe {
+namespace cpu {
+namespace bench {
+
+using ppc::PPCDecodeCache;
+using ppc::PPCOpcode;
+
+struct Timing {
+  uint64_t ticks = 0;
+  // Keeps the decoding from being optimized away.
+  uint64_t checksum = 0;
+};
+
+// Looks up every instruction word like the translator used to at each stage.
+Timing BenchLookup(const uint32_t* words, uint32_t word_count,
+                   int iterations) {
+  Timing timing;
+  uint64_t start_ticks = Clock::QueryHostTickCount();
+  for (int i = 0; i < iterations; ++i) {
+    for (uint32_t n = 0; n < word_count; ++n) {
+      uint32_t code = xe::byte_swap(words[n]);
+      timing.checksum += uint32_t(ppc::LookupOpcode(code));
+    }
+  }
+  timing.ticks = Clock::QueryHostTickCount() - start_ticks;
+  return timing;
+}
+
+// Decodes the section into the cache, as the scanner does, and then walks it
+// again, as block discovery and HIR building do.
+void BenchDecodeCache(Memory* memory, uint32_t address, uint32_t word_count,
+                      int iterations, Timing* out_fill, Timing* out_hit) {
+  PPCDecodeCache decode_cache(memory);
+  for (int i = 0; i < iterations; ++i) {
+    uint64_t start_ticks = Clock::QueryHostTickCount();
+    decode_cache.Reset(address);
+    for (uint32_t n = 0; n < word_count; ++n) {
+      out_fill->checksum +=
+          uint32_t(decode_cache.Decode(address + n * 4).opcode);
+    }
+    uint64_t fill_ticks = Clock::QueryHostTickCount();
+    for (uint32_t n = 0; n < word_count; ++n) {
+      out_hit->checksum +=
+          uint32_t(decode_cache.Decode(address + n * 4).opcode);
+    }
+    uint64_t hit_ticks = Clock::QueryHostTickCount();
+    out_fill->ticks += fill_ticks - start_ticks;
+    out_hit->ticks += hit_ticks - fill_ticks;
+  }
+}
+
+void Report(const char* name, const Timing& timing, uint64_t instr_count) {
+  double seconds = double(timing.ticks) / double(Clock::host_tick_frequency());
+  XELOGI("  %-16s %10.3fms %8.2fns/instr %10.1fM instr/s (%.16" PRIX64 ")",
+         name, seconds * 1000.0,
+         instr_count ? seconds * 1000000000.0 / instr_count : 0.0,
+         seconds > 0.0 ? instr_count / seconds / 1000000.0 : 0.0,
+         timing.checksum);
+}
+
+int main(const std::vector<std::wstring>& args) {
+  std::wstring path = args.size() >= 2
+                          ? args[1]
+                          : xe::to_wstring(FLAGS_decode_bench_xex_path);
+  if (path.empty()) {
+    XELOGE("Specify the XEX to decode");
+    return 1;
+  }
+  auto map = MappedMemory::Open(path, MappedMemory::Mode::kRead);
+  if (!map) {
+    XELOGE("Unable to open %ls", path.c_str());
+    return 1;
+  }
+
+  auto memory = std::make_unique<Memory>();
+  if (!memory->Initialize()) {
+    XELOGE("Unable to initialize memory");
+    return 1;
+  }
+  auto xex = xe_xex2_load(memory.get(), map->data(), map->size(), {0});
+  if (!xex) {
+    XELOGE("Unable to load %ls", path.c_str());
+    return 1;
+  }
+  auto section = xe_xex2_get_pe_section(xex, ".text");
+  if (!section) {
+    XELOGE("No .text section in %ls", path.c_str());
+    xe_xex2_dealloc(xex);
+    return 1;
+  }
+
+  uint32_t address = section->address;
+  uint32_t word_count = section->size / 4;
+  auto words = memory->TranslateVirtual<const uint32_t*>(address);
+  std::vector<uint32_t> opcode_counts(size_t(PPCOpcode::kInvalid) + 1);
+  for (uint32_t n = 0; n < word_count; ++n) {
+    ++opcode_counts[size_t(ppc::LookupOpcode(xe::byte_swap(words[n])))];
+  }
+  uint32_t invalid_count = opcode_counts[size_t(PPCOpcode::kInvalid)];
+  size_t distinct_count =
+      std::count_if(opcode_counts.begin(), opcode_counts.end() - 1,
+                    [](uint32_t count) { return count != 0; });
+
+  int iterations = std::max(1, FLAGS_decode_bench_iterations);
+  uint64_t instr_count = uint64_t(word_count) * iterations;
+  auto lookup = BenchLookup(words, word_count, iterations);
+  Timing fill;
+  Timing hit;
+  BenchDecodeCache(memory.get(), address, word_count, iterations, &fill, &hit);
+
+  XELOGI("Decode bench results:");
+  XELOGI("  .text: %.8X-%.8X, %u words (%u invalid, %d distinct opcodes)",
+         address, address + section->size, word_count, invalid_count,
+         int(distinct_count));
+  XELOGI("  Iterations: %d", iterations);
+  Report("lookup", lookup, instr_count);
+  Report("cache fill", fill, instr_count);
+  Report("cache hit", hit, instr_count);
+
+  xe_xex2_dealloc(xex);
+  return 0;
+}
+
+}  // namespace bench
+}  // namespace cpu
+}  // namespace xe
+
+DEFINE_ENTRY_POINT(L"xenia-cpu-ppc-decode-bench",
+                   L"xenia-cpu-ppc-decode-bench some.xex",
+                   xe::cpu::bench::main);
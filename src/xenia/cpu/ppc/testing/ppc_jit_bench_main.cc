@@ -0,0 +1,226 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#include <gflags/gflags.h>
+
+#include <algorithm>
+#include <cinttypes>
+
+#include "xenia/base/clock.h"
+#include "xenia/base/filesystem.h"
+#include "xenia/base/logging.h"
+#include "xenia/base/main.h"
+#include "xenia/base/string.h"
+#include "xenia/cpu/backend/x64/x64_backend.h"
+#include "xenia/cpu/cpu_flags.h"
+#include "xenia/cpu/ppc/ppc_frontend.h"
+#include "xenia/cpu/processor.h"
+#include "xenia/cpu/raw_module.h"
+
+DEFINE_string(jit_bench_bin_path, "src/xenia/cpu/ppc/testing/bin/",
+              "Directory with binary outputs of the ppc test files.");
+DEFINE_int32(jit_bench_iterations, 1,
+             "Number of times to compile the whole corpus, each time with a "
+             "fresh processor.");
+
+namespace xe {
+namespace cpu {
+namespace bench {
+
+// Each binary is loaded into its own slot so they can all share a processor.
+const uint32_t kStartAddress = 0x80000000;
+const uint32_t kSlotSize = 1 * 1024 * 1024;
+
+struct CorpusFile {
+  std::wstring bin_path;
+  std::vector<uint32_t> function_offsets;
+};
+
+// Reads all function symbols from an nm-style map file.
+bool ReadMap(const std::wstring& map_path, CorpusFile* file) {
+  FILE* f = fopen(xe::to_string(map_path).c_str(), "r");
+  if (!f) {
+    return false;
+  }
+  char line_buffer[BUFSIZ];
+  while (fgets(line_buffer, sizeof(line_buffer), f)) {
+    // 0000000000000000 t test_add1\n
+    uint64_t offset;
+    char type;
+    if (sscanf(line_buffer, "%" SCNx64 " %c", &offset, &type) == 2 &&
+        (type == 't' || type == 'T') && offset < kSlotSize) {
+      file->function_offsets.push_back(static_cast<uint32_t>(offset));
+    }
+  }
+  fclose(f);
+  return true;
+}
+
+bool DiscoverCorpus(const std::wstring& bin_path,
+                    std::vector<CorpusFile>* corpus) {
+  auto file_infos = xe::filesystem::ListFiles(bin_path);
+  for (auto& file_info : file_infos) {
+    auto& name = file_info.name;
+    if (name.size() < 4 || name.rfind(L".map") != name.size() - 4) {
+      continue;
+    }
+    auto base_path = xe::join_paths(bin_path, name.substr(0, name.size() - 4));
+    CorpusFile file;
+    file.bin_path = base_path + L".bin";
+    if (!xe::filesystem::PathExists(file.bin_path) ||
+        !ReadMap(base_path + L".map", &file)) {
+      XELOGE("Unable to read %ls", base_path.c_str());
+      continue;
+    }
+    std::sort(file.function_offsets.begin(), file.function_offsets.end());
+    file.function_offsets.erase(std::unique(file.function_offsets.begin(),
+                                            file.function_offsets.end()),
+                                file.function_offsets.end());
+    corpus->push_back(std::move(file));
+  }
+  return true;
+}
+
+std::unique_ptr<backend::Backend> CreateBackend() {
+  std::unique_ptr<backend::Backend> backend;
+#if defined(XENIA_HAS_X64_BACKEND) && XENIA_HAS_X64_BACKEND
+  if (FLAGS_cpu == "x64" || FLAGS_cpu == "any") {
+    backend.reset(new backend::x64::X64Backend());
+  }
+#endif  // XENIA_HAS_X64_BACKEND
+  return backend;
+}
+
+// Compiles every function in the corpus with a fresh processor, so nothing
+// is cached from previous iterations.
+bool CompileCorpus(Memory* memory, const std::vector<CorpusFile>& corpus,
+                   ppc::PPCTranslationStats* out_stats) {
+  memory->Reset();
+  auto processor = std::make_unique<Processor>(memory, nullptr);
+  if (!processor->Setup(CreateBackend())) {
+    XELOGE("Unable to setup processor");
+    return false;
+  }
+  processor->frontend()->set_stats_enabled(true);
+
+  for (size_t i = 0; i < corpus.size(); ++i) {
+    uint32_t base_address = kStartAddress + uint32_t(i) * kSlotSize;
+    auto module = std::make_unique<RawModule>(processor.get());
+    if (!module->LoadFile(base_address, corpus[i].bin_path)) {
+      XELOGE("Unable to load %ls", corpus[i].bin_path.c_str());
+      return false;
+    }
+    processor->AddModule(std::move(module));
+    processor->backend()->CommitExecutableRange(base_address,
+                                                base_address + kSlotSize);
+  }
+
+  for (size_t i = 0; i < corpus.size(); ++i) {
+    uint32_t base_address = kStartAddress + uint32_t(i) * kSlotSize;
+    for (uint32_t offset : corpus[i].function_offsets) {
+      processor->ResolveFunction(base_address + offset);
+    }
+  }
+
+  *out_stats = processor->frontend()->stats();
+  return true;
+}
+
+void Report(const ppc::PPCTranslationStats& stats, int iterations,
+            double elapsed_seconds) {
+  const double tick_frequency = double(Clock::host_tick_frequency());
+  auto ticks_to_ms = [&](uint64_t ticks) {
+    return double(ticks) * 1000.0 / tick_frequency;
+  };
+  auto percent = [&](uint64_t ticks) {
+    return stats.total_ticks ? double(ticks) * 100.0 / stats.total_ticks : 0.0;
+  };
+  double compile_seconds = ticks_to_ms(stats.total_ticks) / 1000.0;
+  auto per_second = [&](uint64_t count) {
+    return compile_seconds > 0.0 ? double(count) / compile_seconds : 0.0;
+  };
+
+  XELOGI("JIT bench results:");
+  XELOGI("  Iterations: %d", iterations);
+  XELOGI("  Elapsed: %.3fms (%.3fms translating)", elapsed_seconds * 1000.0,
+         ticks_to_ms(stats.total_ticks));
+  XELOGI("  Functions: %" PRIu64 " (%.0f/s), %" PRIu64 " failed",
+         stats.function_count, per_second(stats.function_count),
+         stats.failed_count);
+  XELOGI("  Guest instructions: %" PRIu64 " (%.0f/s)", stats.guest_instr_count,
+         per_second(stats.guest_instr_count));
+  XELOGI("  HIR instructions: %" PRIu64 " (%.0f/s)", stats.hir_instr_count,
+         per_second(stats.hir_instr_count));
+  XELOGI("  Machine code: %" PRIu64 " bytes", stats.machine_code_size);
+  XELOGI("  Inlined calls: %" PRIu64, stats.inlined_call_count);
+  XELOGI("  HIR arena high water: %zu bytes", stats.hir_arena_high_water);
+  XELOGI("  Scratch arena high water: %zu bytes",
+         stats.scratch_arena_high_water);
+
+  XELOGI("Stages:");
+  XELOGI("  %-32s %10.3fms %5.1f%%", "scan", ticks_to_ms(stats.scan_ticks),
+         percent(stats.scan_ticks));
+  XELOGI("  %-32s %10.3fms %5.1f%%", "hir_build",
+         ticks_to_ms(stats.hir_build_ticks), percent(stats.hir_build_ticks));
+  for (auto& pass : stats.passes) {
+    XELOGI("  %-32s %10.3fms %5.1f%%", pass.name, ticks_to_ms(pass.ticks),
+           percent(pass.ticks));
+  }
+  XELOGI("  %-32s %10.3fms %5.1f%%", "emit",
+         ticks_to_ms(stats.assemble_ticks - stats.place_ticks),
+         percent(stats.assemble_ticks - stats.place_ticks));
+  XELOGI("  %-32s %10.3fms %5.1f%%", "place_guest_code",
+         ticks_to_ms(stats.place_ticks), percent(stats.place_ticks));
+}
+
+int main(const std::vector<std::wstring>& args) {
+  auto bin_path =
+      xe::fix_path_separators(xe::to_wstring(FLAGS_jit_bench_bin_path));
+  std::vector<CorpusFile> corpus;
+  DiscoverCorpus(bin_path, &corpus);
+  if (corpus.empty()) {
+    XELOGE("No binaries found in %ls - build the ppc tests first?",
+           bin_path.c_str());
+    return 1;
+  }
+  if (corpus.size() * kSlotSize > 0x10000000) {
+    XELOGE("Too many binaries in corpus");
+    return 1;
+  }
+  XELOGI("Compiling %d binaries...", int(corpus.size()));
+
+  auto memory = std::make_unique<Memory>();
+  if (!memory->Initialize()) {
+    XELOGE("Unable to initialize memory");
+    return 1;
+  }
+
+  int iterations = std::max(1, FLAGS_jit_bench_iterations);
+  ppc::PPCTranslationStats total_stats;
+  uint64_t start_ticks = Clock::QueryHostTickCount();
+  for (int i = 0; i < iterations; ++i) {
+    ppc::PPCTranslationStats stats;
+    if (!CompileCorpus(memory.get(), corpus, &stats)) {
+      return 1;
+    }
+    total_stats.Accumulate(stats);
+  }
+  uint64_t end_ticks = Clock::QueryHostTickCount();
+
+  Report(total_stats, iterations,
+         double(end_ticks - start_ticks) / double(Clock::host_tick_frequency()));
+  return 0;
+}
+
+}  // namespace bench
+}  // namespace cpu
+}  // namespace xe
+
+DEFINE_ENTRY_POINT(L"xenia-cpu-ppc-jit-bench", L"xenia-cpu-ppc-jit-bench",
+                   xe::cpu::bench::main);
@@ -37,6 +37,65 @@ project("xenia-cpu-ppc-tests")
     -- xenia-base needs this
     links({"xenia-ui"})
 
+project("xenia-cpu-ppc-jit-bench")
+  uuid("c4f0e1a2-7b3d-4e58-9a61-2d8f5b0c3e74")
+  kind("ConsoleApp")
+  language("C++")
+  links({
+    "xenia-core",
+    "xenia-cpu-backend-x64",
+    "xenia-cpu",
+    "xenia-base",
+    "gflags",
+    "capstone", -- cpu-backend-x64
+  })
+  files({
+    "ppc_jit_bench_main.cc",
+    "../../../base/main_"..platform_suffix..".cc",
+  })
+  includedirs({
+    project_root.."/third_party/gflags/src",
+  })
+  filter("platforms:Windows")
+    debugdir(project_root)
+    debugargs({
+      "--flagfile=scratch/flags.txt",
+      "2>&1",
+      "1>scratch/stdout-jit-bench.txt",
+    })
+
+    -- xenia-base needs this
+    links({"xenia-ui"})
+
+project("xenia-cpu-ppc-decode-bench")
+  uuid("6d2b9c47-31e8-4f0a-b5d6-8e4a7f19c2d3")
+  kind("ConsoleApp")
+  language("C++")
+  links({
+    "xenia-kernel",
+    "xenia-core",
+    "xenia-cpu",
+    "xenia-base",
+    "gflags",
+  })
+  files({
+    "ppc_decode_bench_main.cc",
+    "../../../base/main_"..platform_suffix..".cc",
+  })
+  includedirs({
+    project_root.."/third_party/gflags/src",
+  })
+  filter("platforms:Windows")
+    debugdir(project_root)
+    debugargs({
+      "--flagfile=scratch/flags.txt",
+      "2>&1",
+      "1>scratch/stdout-decode-bench.txt",
+    })
+
+    -- xenia-base needs this
+    links({"xenia-ui"})
+
 if ARCH == "ppc64" or ARCH == "powerpc64" then
 
 project("xenia-cpu-ppc-nativetests")
@@ -0,0 +1,59 @@
+# Calls to small leaf functions are inlined into the caller. These check that
+# the inlined code behaves as the call would have.
+
+test_inline_leaf_1:
+  #_ REGISTER_IN r3 5
+  #_ REGISTER_IN r4 7
+  mflr r12
+  bl inline_leaf_add
+  mtlr r12
+  blr
+  #_ REGISTER_OUT r3 12
+  #_ REGISTER_OUT r4 7
+
+test_inline_leaf_2:
+  #_ REGISTER_IN r3 0
+  #_ REGISTER_IN r4 7
+  mflr r12
+  bl inline_leaf_clamp
+  mr r5, r3
+  li r3, 100
+  bl inline_leaf_clamp
+  mr r6, r3
+  mtlr r12
+  blr
+  #_ REGISTER_OUT r3 64
+  #_ REGISTER_OUT r5 0
+  #_ REGISTER_OUT r6 64
+
+test_inline_leaf_3:
+  #_ REGISTER_IN r3 4
+  mflr r12
+  li r4, 0
+  bl inline_leaf_sum
+  mtlr r12
+  blr
+  #_ REGISTER_OUT r3 0
+  #_ REGISTER_OUT r4 10
+
+inline_leaf_add:
+  add r3, r3, r4
+  blr
+
+# Returns early through a conditional blr.
+inline_leaf_clamp:
+  cmplwi r3, 64
+  bltlr
+  li r3, 64
+  blr
+
+# Loops within itself.
+inline_leaf_sum:
+  cmpwi r3, 0
+  beq inline_leaf_sum_done
+inline_leaf_sum_loop:
+  add r4, r4, r3
+  addic. r3, r3, -1
+  bne inline_leaf_sum_loop
+inline_leaf_sum_done:
+  blr
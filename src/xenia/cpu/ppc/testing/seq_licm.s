@@ -0,0 +1,78 @@
+# Loop invariant computations are hoisted out of loops. These check that only
+# computations that really don't change are.
+
+test_licm_1:
+  #_ REGISTER_IN r3 10
+  #_ REGISTER_IN r4 3
+  li r5, 0
+  mtctr r3
+licm_1_loop:
+  addi r6, r4, 5
+  slwi r7, r6, 1
+  add r5, r5, r7
+  bdnz licm_1_loop
+  blr
+  #_ REGISTER_OUT r4 3
+  #_ REGISTER_OUT r5 160
+  #_ REGISTER_OUT r6 8
+  #_ REGISTER_OUT r7 16
+
+test_licm_2:
+  #_ REGISTER_IN r3 4
+  #_ REGISTER_IN r4 1
+  li r5, 0
+  mtctr r3
+licm_2_loop:
+  addi r6, r4, 1
+  slwi r7, r6, 1
+  mr r4, r6
+  add r5, r5, r7
+  bdnz licm_2_loop
+  blr
+  #_ REGISTER_OUT r4 5
+  #_ REGISTER_OUT r5 28
+  #_ REGISTER_OUT r6 5
+  #_ REGISTER_OUT r7 10
+
+# The loop's input is changed by the call right before it, so nothing may be
+# hoisted above the call.
+test_licm_3:
+  #_ REGISTER_IN r3 3
+  #_ REGISTER_IN r4 1
+  mflr r12
+  li r5, 0
+  mtctr r3
+  bl licm_3_set_r4
+licm_3_loop:
+  addi r6, r4, 5
+  slwi r7, r6, 1
+  add r5, r5, r7
+  bdnz licm_3_loop
+  mtlr r12
+  blr
+  #_ REGISTER_OUT r4 17
+  #_ REGISTER_OUT r5 132
+  #_ REGISTER_OUT r6 22
+  #_ REGISTER_OUT r7 44
+
+# Too long to be inlined, so it stays a call.
+licm_3_set_r4:
+  li r4, 0
+  addi r4, r4, 1
+  addi r4, r4, 1
+  addi r4, r4, 1
+  addi r4, r4, 1
+  addi r4, r4, 1
+  addi r4, r4, 1
+  addi r4, r4, 1
+  addi r4, r4, 1
+  addi r4, r4, 1
+  addi r4, r4, 1
+  addi r4, r4, 1
+  addi r4, r4, 1
+  addi r4, r4, 1
+  addi r4, r4, 1
+  addi r4, r4, 1
+  addi r4, r4, 1
+  addi r4, r4, 1
+  blr
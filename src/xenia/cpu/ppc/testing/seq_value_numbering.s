@@ -0,0 +1,34 @@
+# Redundant computations are replaced by earlier results. These check that
+# only truly equivalent ones are.
+
+test_value_numbering_1:
+  #_ REGISTER_IN r3 5
+  #_ REGISTER_IN r4 7
+  add r5, r3, r4
+  add r6, r4, r3
+  subf r7, r3, r4
+  subf r8, r4, r3
+  blr
+  #_ REGISTER_OUT r5 12
+  #_ REGISTER_OUT r6 12
+  #_ REGISTER_OUT r7 2
+  #_ REGISTER_OUT r8 0xfffffffffffffffe
+
+test_value_numbering_2:
+  #_ REGISTER_IN r3 5
+  #_ REGISTER_IN r4 7
+  #_ REGISTER_IN r9 9
+  addi r5, r3, 16
+  slwi r6, r5, 2
+  mr r3, r9
+  addi r7, r3, 16
+  slwi r8, r7, 2
+  addi r10, r9, 16
+  slwi r11, r10, 2
+  blr
+  #_ REGISTER_OUT r5 21
+  #_ REGISTER_OUT r6 84
+  #_ REGISTER_OUT r7 25
+  #_ REGISTER_OUT r8 100
+  #_ REGISTER_OUT r10 25
+  #_ REGISTER_OUT r11 100
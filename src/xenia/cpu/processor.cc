@@ -17,16 +17,20 @@
 #include "xenia/base/byte_stream.h"
 #include "xenia/base/debugging.h"
 #include "xenia/base/exception_handler.h"
+#include "xenia/base/filesystem.h"
 #include "xenia/base/logging.h"
 #include "xenia/base/memory.h"
 #include "xenia/base/profiling.h"
+#include "xenia/base/string.h"
 #include "xenia/base/threading.h"
 #include "xenia/cpu/breakpoint.h"
 #include "xenia/cpu/cpu_flags.h"
+#include "xenia/cpu/execution_profile.h"
 #include "xenia/cpu/export_resolver.h"
 #include "xenia/cpu/module.h"
 #include "xenia/cpu/ppc/ppc_decode_data.h"
 #include "xenia/cpu/ppc/ppc_frontend.h"
+#include "xenia/cpu/sampling_profiler.h"
 #include "xenia/cpu/stack_walker.h"
 #include "xenia/cpu/thread.h"
 #include "xenia/cpu/thread_state.h"
@@ -44,6 +48,16 @@
 DEFINE_bool(debug, DEFAULT_DEBUG_FLAG,
             "Allow debugging and retain debug information.");
 DEFINE_string(trace_function_data_path, "", "File to write trace data to.");
+DEFINE_string(sampling_profiler_path, "",
+              "Enables the guest sampling profiler, writing collapsed stacks "
+              "(for flamegraph.pl) to the given file on exit.");
+DEFINE_string(execution_profile_path, "",
+              "Directory of per-title execution profiles. Code of titles with "
+              "a saved profile is laid out hot blocks first.");
+DEFINE_bool(record_execution_profile, false,
+            "Count how often each guest instruction runs and add the counts "
+            "to the title's profile in --execution_profile_path on exit. "
+            "Slows down generated code.");
 DEFINE_bool(break_on_start, false, "Break into the debugger on startup.");
 
 namespace xe {
@@ -81,6 +95,17 @@ Processor::Processor(xe::Memory* memory, ExportResolver* export_resolver)
     : memory_(memory), export_resolver_(export_resolver) {}
 
 Processor::~Processor() {
+  // Functions must still be alive to resolve samples.
+  if (sampling_profiler_) {
+    sampling_profiler_->Stop(xe::to_wstring(FLAGS_sampling_profiler_path));
+    sampling_profiler_.reset();
+  }
+
+  // Trace data is kept alive by the functions.
+  if (!execution_profile_path_.empty()) {
+    SaveExecutionProfile();
+  }
+
   {
     auto global_lock = global_critical_region_.Acquire();
     modules_.clear();
@@ -138,6 +163,15 @@ bool Processor::Setup(std::unique_ptr<backend::Backend> backend) {
     }
   }
 
+  // Sampling profiler attributes host time to guest code, if requested.
+  if (!FLAGS_sampling_profiler_path.empty()) {
+    sampling_profiler_ = SamplingProfiler::Create(backend_->code_cache());
+    if (!sampling_profiler_ || !sampling_profiler_->Start()) {
+      XELOGE("Unable to start sampling profiler");
+      sampling_profiler_.reset();
+    }
+  }
+
   // Open the trace data path, if requested.
   functions_trace_path_ = xe::to_wstring(FLAGS_trace_function_data_path);
   if (!functions_trace_path_.empty()) {
@@ -148,6 +182,61 @@ bool Processor::Setup(std::unique_ptr<backend::Backend> backend) {
   return true;
 }
 
+void Processor::OpenExecutionProfile(uint32_t title_id) {
+  if (FLAGS_execution_profile_path.empty() || !title_id) {
+    return;
+  }
+  auto base_path =
+      xe::join_paths(xe::to_wstring(FLAGS_execution_profile_path),
+                     xe::to_wstring(xe::format_string("%.8X", title_id)));
+  auto path = base_path + L".xprof";
+
+  execution_profile_ = std::make_unique<ExecutionProfile>();
+  if (execution_profile_->Load(path)) {
+    XELOGI("Loaded execution profile of %d functions from %ls",
+           int(execution_profile_->function_count()), path.c_str());
+  } else if (xe::filesystem::PathExists(path)) {
+    XELOGE("Ignoring invalid execution profile %ls", path.c_str());
+  }
+
+  if (FLAGS_record_execution_profile) {
+    // Coverage counters must be in the trace file, as generated code
+    // addresses them absolutely.
+    if (!functions_trace_file_) {
+      xe::filesystem::CreateFolder(
+          xe::to_wstring(FLAGS_execution_profile_path));
+      functions_trace_path_ = base_path + L".trace";
+      functions_trace_file_ = ChunkedMappedMemoryWriter::Open(
+          functions_trace_path_, 32 * 1024 * 1024, true);
+    }
+    if (functions_trace_file_) {
+      execution_profile_path_ = path;
+    } else {
+      XELOGE("Unable to record execution profile");
+    }
+  }
+}
+
+void Processor::SaveExecutionProfile() {
+  std::vector<Module*> modules = GetModules();
+  for (auto module : modules) {
+    module->ForEachFunction([&](Function* function) {
+      if (function->is_guest()) {
+        execution_profile_->Accumulate(
+            static_cast<GuestFunction*>(function)->trace_data());
+      }
+    });
+  }
+  if (execution_profile_->Save(execution_profile_path_)) {
+    XELOGI("Saved execution profile of %d functions to %ls",
+           int(execution_profile_->function_count()),
+           execution_profile_path_.c_str());
+  } else {
+    XELOGE("Unable to save execution profile to %ls",
+           execution_profile_path_.c_str());
+  }
+}
+
 void Processor::PreLaunch() {
   if (FLAGS_break_on_start) {
     // Start paused.
@@ -392,9 +481,11 @@ uint64_t Processor::ExecuteInterrupt(ThreadState* thread_state,
                                      size_t arg_count) {
   SCOPE_profile_cpu_f("cpu");
 
-  // Hold the global lock during interrupt dispatch.
-  // This will block if any code is in a critical region (has interrupts
-  // disabled) or if any other interrupt is executing.
+  // Hold the guest global lock during interrupt dispatch.
+  // This will block if any guest code has interrupts disabled or if any other
+  // interrupt is executing. As everywhere else, it is taken before the global
+  // critical region, which guest code may need while holding it.
+  std::lock_guard<GuestGlobalLock> guest_lock(*frontend_->global_lock());
   auto global_lock = global_critical_region_.Acquire();
 
   auto context = thread_state->context();
@@ -488,12 +579,22 @@ void Processor::OnThreadCreated(uint32_t thread_handle,
   thread_debug_infos_.emplace(thread_info->thread_id, std::move(thread_info));
 }
 
+void Processor::OnThreadEnter(uint32_t thread_id, const std::string& name) {
+  if (sampling_profiler_) {
+    sampling_profiler_->ThreadEnter(thread_id, name);
+  }
+}
+
 void Processor::OnThreadExit(uint32_t thread_id) {
   auto global_lock = global_critical_region_.Acquire();
   auto it = thread_debug_infos_.find(thread_id);
   assert_true(it != thread_debug_infos_.end());
   auto thread_info = it->second.get();
   thread_info->state = ThreadDebugInfo::State::kExited;
+
+  if (sampling_profiler_) {
+    sampling_profiler_->ThreadExit(thread_id);
+  }
 }
 
 void Processor::OnThreadDestroyed(uint32_t thread_id) {
@@ -36,6 +36,8 @@ namespace xe {
 namespace cpu {
 
 class Breakpoint;
+class ExecutionProfile;
+class SamplingProfiler;
 class StackWalker;
 class XexModule;
 
@@ -99,6 +101,19 @@ class Processor {
     debug_info_flags_ = debug_info_flags;
   }
 
+  // Loads the execution profile saved for the given title, if any, and starts
+  // recording into it if requested. Must be called before any of the title's
+  // code is compiled.
+  void OpenExecutionProfile(uint32_t title_id);
+  // Profile generated code is laid out with, if one was loaded.
+  const ExecutionProfile* execution_profile() const {
+    return execution_profile_.get();
+  }
+  // True if instruction execution counts are being recorded for the profile.
+  bool is_recording_execution_profile() const {
+    return !execution_profile_path_.empty();
+  }
+
   bool AddModule(std::unique_ptr<Module> module);
   Module* GetModule(const char* name);
   Module* GetModule(const std::string& name) { return GetModule(name.c_str()); }
@@ -190,6 +205,8 @@ class Processor {
   // TODO(benvanik): hide.
   void OnThreadCreated(uint32_t handle, ThreadState* thread_state,
                        Thread* thread);
+  // Called on the thread itself once it starts running.
+  void OnThreadEnter(uint32_t thread_id, const std::string& name);
   void OnThreadExit(uint32_t thread_id);
   void OnThreadDestroyed(uint32_t thread_id);
   void OnThreadEnteringWait(uint32_t thread_id);
@@ -236,9 +253,11 @@ class Processor {
                                          uint32_t current_pc);
 
   bool DemandFunction(Function* function);
+  void SaveExecutionProfile();
 
   Memory* memory_ = nullptr;
   std::unique_ptr<StackWalker> stack_walker_;
+  std::unique_ptr<SamplingProfiler> sampling_profiler_;
 
   std::function<DebugListener*(Processor*)> debug_listener_handler_;
   DebugListener* debug_listener_ = nullptr;
@@ -248,6 +267,10 @@ class Processor {
   // If specified, the file trace data gets written to when running.
   std::wstring functions_trace_path_;
   std::unique_ptr<ChunkedMappedMemoryWriter> functions_trace_file_;
+  // Execution profile of the running title and where to save it to when
+  // recording.
+  std::unique_ptr<ExecutionProfile> execution_profile_;
+  std::wstring execution_profile_path_;
 
   std::unique_ptr<ppc::PPCFrontend> frontend_;
   std::unique_ptr<backend::Backend> backend_;
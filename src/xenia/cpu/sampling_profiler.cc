@@ -0,0 +1,338 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#include "xenia/cpu/sampling_profiler.h"
+
+#include <gflags/gflags.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+
+#include "xenia/base/assert.h"
+#include "xenia/base/filesystem.h"
+#include "xenia/base/logging.h"
+#include "xenia/base/mutex.h"
+#include "xenia/base/string.h"
+#include "xenia/cpu/backend/code_cache.h"
+#include "xenia/cpu/function.h"
+
+DEFINE_int32(sampling_profiler_interval_us, 1000,
+             "Interval between samples of each guest thread, in microseconds "
+             "of thread CPU time.");
+DEFINE_bool(sampling_profiler_instructions, false,
+            "Attribute samples to individual PPC instructions by adding the "
+            "guest address as the leaf frame of each stack.");
+
+namespace xe {
+namespace cpu {
+
+// Maximum number of frames walked per sample.
+const size_t kMaxStackDepth = 128;
+// Interval the collector thread drains sample buffers at.
+const std::chrono::milliseconds kCollectInterval(50);
+
+SamplingProfiler::SamplingProfiler(backend::CodeCache* code_cache)
+    : code_cache_(code_cache) {
+  code_cache_low_ = code_cache->base_address();
+  code_cache_high_ = code_cache_low_ + code_cache->total_size();
+  interval_ = std::chrono::microseconds(
+      std::max(100, FLAGS_sampling_profiler_interval_us));
+}
+
+SamplingProfiler::~SamplingProfiler() { assert_false(running_); }
+
+bool SamplingProfiler::Start() {
+  if (!StartSampling()) {
+    return false;
+  }
+  running_ = true;
+  collector_thread_ = std::thread([this]() { CollectorThreadMain(); });
+  return true;
+}
+
+void SamplingProfiler::Stop(const std::wstring& output_path) {
+  if (!running_) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(threads_mutex_);
+    running_ = false;
+    for (auto& thread_samples : threads_) {
+      if (thread_samples->active) {
+        thread_samples->active = false;
+        ThreadExitSampling(thread_samples.get());
+      }
+    }
+  }
+  StopSampling();
+
+  collector_cond_.notify_all();
+  collector_thread_.join();
+
+  // Pick up anything captured since the last collection.
+  Collect();
+
+  if (!WriteCollapsedStacks(output_path)) {
+    XELOGE("Unable to write sampling profile to %ls", output_path.c_str());
+  }
+}
+
+void SamplingProfiler::ThreadEnter(uint32_t thread_id,
+                                   const std::string& name) {
+  std::lock_guard<std::mutex> lock(threads_mutex_);
+  if (!running_) {
+    return;
+  }
+  auto thread_samples = std::make_unique<ThreadSamples>();
+  thread_samples->thread_id = thread_id;
+  thread_samples->name = name;
+  if (!ThreadEnterSampling(thread_samples.get())) {
+    XELOGE("Unable to sample thread %s", name.c_str());
+    return;
+  }
+  thread_samples->active = true;
+  threads_.push_back(std::move(thread_samples));
+}
+
+void SamplingProfiler::ThreadExit(uint32_t thread_id) {
+  std::lock_guard<std::mutex> lock(threads_mutex_);
+  for (auto& thread_samples : threads_) {
+    if (thread_samples->thread_id == thread_id && thread_samples->active) {
+      thread_samples->active = false;
+      ThreadExitSampling(thread_samples.get());
+    }
+  }
+}
+
+void SamplingProfiler::CaptureSample(ThreadSamples* thread_samples,
+                                     uint64_t host_pc,
+                                     uintptr_t stack_pointer) {
+  size_t tail = thread_samples->tail.load(std::memory_order_relaxed);
+  if (tail - thread_samples->head.load(std::memory_order_acquire) >=
+      kSampleBufferCount) {
+    // Collector has fallen behind.
+    thread_samples->dropped_count.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  auto& sample = thread_samples->samples[tail % kSampleBufferCount];
+  sample.host_pc = host_pc;
+  sample.candidate_count = 0;
+  if (stack_pointer >= thread_samples->stack_low &&
+      stack_pointer < thread_samples->stack_high) {
+    // We can't walk frames here (the code cache tables may be mid-update), so
+    // record every slot that could be a return address into generated code.
+    uintptr_t stack_end =
+        std::min(thread_samples->stack_high, stack_pointer + kMaxStackScan);
+    for (uintptr_t p = stack_pointer;
+         p + 8 <= stack_end && sample.candidate_count < kMaxCandidates;
+         p += 8) {
+      uint64_t value = *reinterpret_cast<const uint64_t*>(p);
+      if (is_code_address(value)) {
+        sample.candidate_offsets[sample.candidate_count] =
+            uint32_t(p - stack_pointer);
+        sample.candidate_values[sample.candidate_count] = value;
+        ++sample.candidate_count;
+      }
+    }
+  }
+
+  thread_samples->tail.store(tail + 1, std::memory_order_release);
+}
+
+void SamplingProfiler::CollectorThreadMain() {
+  while (running_) {
+    {
+      std::unique_lock<std::mutex> lock(collector_mutex_);
+      collector_cond_.wait_for(lock, kCollectInterval,
+                               [this]() { return !running_; });
+    }
+    Collect();
+  }
+}
+
+void SamplingProfiler::Collect() {
+  // Code cache tables are only modified under the global lock.
+  auto global_lock = global_critical_region::AcquireDirect();
+  std::lock_guard<std::mutex> lock(threads_mutex_);
+  std::vector<uint64_t> stack;
+  for (auto& thread_samples : threads_) {
+    size_t head = thread_samples->head.load(std::memory_order_relaxed);
+    size_t tail = thread_samples->tail.load(std::memory_order_acquire);
+    for (; head != tail; ++head) {
+      WalkSample(thread_samples->samples[head % kSampleBufferCount], &stack);
+      ++thread_samples->stacks[stack];
+      ++thread_samples->sample_count;
+    }
+    thread_samples->head.store(head, std::memory_order_release);
+  }
+}
+
+void SamplingProfiler::WalkSample(const RawSample& sample,
+                                  std::vector<uint64_t>* out_stack) {
+  out_stack->clear();
+  out_stack->push_back(sample.host_pc);
+
+  auto find_candidate = [&](uint64_t offset, uint64_t* out_value) {
+    for (uint32_t i = 0; i < sample.candidate_count; ++i) {
+      if (sample.candidate_offsets[i] == offset) {
+        *out_value = sample.candidate_values[i];
+        return true;
+      } else if (sample.candidate_offsets[i] > offset) {
+        break;
+      }
+    }
+    return false;
+  };
+  // All calls from generated code are emitted as call rax.
+  auto is_return_address = [&](uint64_t value) {
+    size_t stack_size;
+    if (value < code_cache_low_ + 2 ||
+        !code_cache_->LookupStackSize(value - 1, &stack_size)) {
+      return false;
+    }
+    auto code = reinterpret_cast<const uint8_t*>(value);
+    return code[-2] == 0xFF && code[-1] == 0xD0;
+  };
+
+  // Offset of the slot holding the return address of the current frame.
+  uint64_t slot_offset = 0;
+  uint64_t return_address = 0;
+  size_t stack_size;
+  if (code_cache_->LookupStackSize(sample.host_pc, &stack_size)) {
+    // All generated code allocates its whole frame up front, so the return
+    // address is just above it. In the prolog or epilog it's on top.
+    if (find_candidate(stack_size, &return_address) &&
+        is_return_address(return_address)) {
+      slot_offset = stack_size;
+    } else if (find_candidate(0, &return_address) &&
+               is_return_address(return_address)) {
+      slot_offset = 0;
+    } else {
+      return;
+    }
+  } else {
+    // Host code, such as a kernel export. Its frames can't be walked without
+    // unwind info, so start from the innermost return into generated code.
+    uint32_t i = 0;
+    for (; i < sample.candidate_count; ++i) {
+      if (is_return_address(sample.candidate_values[i])) {
+        break;
+      }
+    }
+    if (i == sample.candidate_count) {
+      return;
+    }
+    slot_offset = sample.candidate_offsets[i];
+    return_address = sample.candidate_values[i];
+  }
+
+  while (out_stack->size() < kMaxStackDepth) {
+    out_stack->push_back(return_address);
+    // The caller's frame starts just above the return address.
+    if (!code_cache_->LookupStackSize(return_address - 1, &stack_size)) {
+      break;
+    }
+    slot_offset += 8 + stack_size;
+    if (!find_candidate(slot_offset, &return_address) ||
+        !is_return_address(return_address)) {
+      break;
+    }
+  }
+}
+
+bool SamplingProfiler::WriteCollapsedStacks(const std::wstring& output_path) {
+  FILE* file = xe::filesystem::OpenFile(output_path, "w");
+  if (!file) {
+    return false;
+  }
+
+  auto function_name = [](Function* function) {
+    if (!function->name().empty()) {
+      return function->name();
+    }
+    return xe::format_string("sub_%.8X", function->address());
+  };
+
+  // Collapsed stack lines to sample counts.
+  std::map<std::string, uint64_t> lines;
+  // Self samples per function, for the summary.
+  std::map<std::string, uint64_t> function_samples;
+  uint64_t total_samples = 0;
+  uint64_t total_dropped = 0;
+  std::vector<std::string> frames;
+  std::string leaf_function_name;
+  std::lock_guard<std::mutex> lock(threads_mutex_);
+  for (auto& thread_samples : threads_) {
+    total_samples += thread_samples->sample_count;
+    total_dropped += thread_samples->dropped_count;
+    for (auto& it : thread_samples->stacks) {
+      auto& stack = it.first;
+      frames.clear();
+      leaf_function_name = "[host]";
+      for (size_t i = 0; i < stack.size(); ++i) {
+        // Callers are adjusted by -1 so that they map to the call itself.
+        uint64_t host_pc = i ? stack[i] - 1 : stack[i];
+        if (!is_code_address(host_pc)) {
+          // Host frames (other than the leaf) are never walked.
+          frames.push_back("[host]");
+          continue;
+        }
+        auto function = code_cache_->LookupFunction(host_pc);
+        if (!function) {
+          // Thunks and other generated host code.
+          continue;
+        }
+        if (!i) {
+          leaf_function_name = function_name(function);
+          if (FLAGS_sampling_profiler_instructions) {
+            frames.push_back(xe::format_string(
+                "%.8X",
+                function->MapMachineCodeToGuestAddress(uintptr_t(host_pc))));
+          }
+        }
+        frames.push_back(function_name(function));
+      }
+      function_samples[leaf_function_name] += it.second;
+
+      // Host leaves from different host PCs collapse into the same line.
+      std::string line = thread_samples->name;
+      for (auto frame = frames.rbegin(); frame != frames.rend(); ++frame) {
+        line += ';';
+        line += *frame;
+      }
+      lines[line] += it.second;
+    }
+  }
+  for (auto& it : lines) {
+    fprintf(file, "%s %" PRIu64 "\n", it.first.c_str(), it.second);
+  }
+  fclose(file);
+
+  XELOGI("Sampling profiler: %" PRIu64 " samples (%" PRIu64
+         " dropped) written to %ls",
+         total_samples, total_dropped, output_path.c_str());
+  std::vector<std::pair<uint64_t, std::string>> top_functions;
+  for (auto& it : function_samples) {
+    top_functions.emplace_back(it.second, it.first);
+  }
+  std::sort(top_functions.rbegin(), top_functions.rend());
+  top_functions.resize(std::min(top_functions.size(), size_t(20)));
+  for (auto& it : top_functions) {
+    XELOGI("  %6.2f%% %s",
+           total_samples ? it.first * 100.0 / total_samples : 0.0,
+           it.second.c_str());
+  }
+  return true;
+}
+
+}  // namespace cpu
+}  // namespace xe
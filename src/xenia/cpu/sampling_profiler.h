@@ -0,0 +1,146 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#ifndef XENIA_CPU_SAMPLING_PROFILER_H_
+#define XENIA_CPU_SAMPLING_PROFILER_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace xe {
+namespace cpu {
+namespace backend {
+class CodeCache;
+}  // namespace backend
+}  // namespace cpu
+}  // namespace xe
+
+namespace xe {
+namespace cpu {
+
+// Periodically samples the host PC of guest threads and attributes the samples
+// to the guest functions (and optionally PPC instructions) they were in.
+// Results are written as collapsed stacks, as consumed by flamegraph.pl.
+//
+// Samples are captured either from a signal handler on the sampled thread or
+// while it is suspended, so capturing only records raw return address
+// candidates from the host stack. Walking and resolving them against the code
+// cache happens later on a collector thread.
+class SamplingProfiler {
+ public:
+  // Creates a sampling profiler. Only one should exist within a process.
+  // Returns nullptr if sampling is not supported on this platform.
+  static std::unique_ptr<SamplingProfiler> Create(
+      backend::CodeCache* code_cache);
+
+  virtual ~SamplingProfiler();
+
+  // Begins sampling all registered threads.
+  bool Start();
+  // Stops sampling and writes all collected stacks to the given path.
+  void Stop(const std::wstring& output_path);
+
+  // Registers the calling thread for sampling.
+  // Must be called on the thread being registered.
+  void ThreadEnter(uint32_t thread_id, const std::string& name);
+  // Stops sampling the given thread. Samples taken so far are kept.
+  void ThreadExit(uint32_t thread_id);
+
+ protected:
+  // Maximum number of return address candidates captured per sample.
+  static const size_t kMaxCandidates = 32;
+  // Maximum number of bytes of host stack scanned per sample.
+  static const size_t kMaxStackScan = 16 * 1024;
+  // Number of samples buffered per thread between collections.
+  static const size_t kSampleBufferCount = 256;
+
+  struct RawSample {
+    uint64_t host_pc;
+    uint32_t candidate_count;
+    // Offsets from the sampled stack pointer and values of stack slots that
+    // point into generated code.
+    uint32_t candidate_offsets[kMaxCandidates];
+    uint64_t candidate_values[kMaxCandidates];
+  };
+
+  struct ThreadSamples {
+    uint32_t thread_id = 0;
+    std::string name;
+    // Host stack bounds, used to limit scanning.
+    uintptr_t stack_low = 0;
+    uintptr_t stack_high = 0;
+    // Platform data, such as a timer or thread handle.
+    void* platform_data = nullptr;
+    std::atomic<bool> active = {false};
+
+    // Single-producer single-consumer ring of raw samples. Written by the
+    // capturing side, drained by the collector thread.
+    RawSample samples[kSampleBufferCount];
+    std::atomic<size_t> head = {0};
+    std::atomic<size_t> tail = {0};
+    std::atomic<uint64_t> dropped_count = {0};
+
+    // Owned by the collector thread.
+    // Maps walked host PC stacks (leaf first) to sample counts.
+    std::map<std::vector<uint64_t>, uint64_t> stacks;
+    uint64_t sample_count = 0;
+  };
+
+  explicit SamplingProfiler(backend::CodeCache* code_cache);
+
+  // Platform hooks.
+  virtual bool StartSampling() = 0;
+  virtual void StopSampling() = 0;
+  // Called on the thread being registered.
+  virtual bool ThreadEnterSampling(ThreadSamples* thread_samples) = 0;
+  // May be called from any thread.
+  virtual void ThreadExitSampling(ThreadSamples* thread_samples) = 0;
+
+  // Records a sample of a thread that is interrupted at the given host PC and
+  // stack pointer. Must be async-signal-safe: no allocations or locks.
+  void CaptureSample(ThreadSamples* thread_samples, uint64_t host_pc,
+                     uintptr_t stack_pointer);
+
+  bool is_code_address(uint64_t address) const {
+    return address >= code_cache_low_ && address < code_cache_high_;
+  }
+
+  backend::CodeCache* code_cache_ = nullptr;
+  // Thread CPU time between samples.
+  std::chrono::microseconds interval_;
+  uint64_t code_cache_low_ = 0;
+  uint64_t code_cache_high_ = 0;
+
+  // Guards the thread list. Never taken while capturing.
+  std::mutex threads_mutex_;
+  std::vector<std::unique_ptr<ThreadSamples>> threads_;
+
+ private:
+  void CollectorThreadMain();
+  void Collect();
+  void WalkSample(const RawSample& sample, std::vector<uint64_t>* out_stack);
+  bool WriteCollapsedStacks(const std::wstring& output_path);
+
+  std::atomic<bool> running_ = {false};
+  std::thread collector_thread_;
+  std::mutex collector_mutex_;
+  std::condition_variable collector_cond_;
+};
+
+}  // namespace cpu
+}  // namespace xe
+
+#endif  // XENIA_CPU_SAMPLING_PROFILER_H_
@@ -0,0 +1,134 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#include "xenia/cpu/sampling_profiler.h"
+
+#include <pthread.h>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "xenia/base/logging.h"
+
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+namespace xe {
+namespace cpu {
+
+// Samples with SIGPROF, raised by a per-thread timer on the thread's own CPU
+// clock. Idle (waiting) guest threads are never sampled and no other threads
+// are interrupted.
+class PosixSamplingProfiler : public SamplingProfiler {
+ public:
+  explicit PosixSamplingProfiler(backend::CodeCache* code_cache)
+      : SamplingProfiler(code_cache) {}
+  ~PosixSamplingProfiler() override = default;
+
+ protected:
+  bool StartSampling() override {
+    profiler_ = this;
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_sigaction = SignalHandler;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(SIGPROF, &action, nullptr) != 0) {
+      XELOGE("Unable to install SIGPROF handler: %d", errno);
+      return false;
+    }
+    return true;
+  }
+
+  void StopSampling() override {
+    // Ignore (rather than default, which terminates) any signals still in
+    // flight now that all timers are deleted.
+    signal(SIGPROF, SIG_IGN);
+  }
+
+  bool ThreadEnterSampling(ThreadSamples* thread_samples) override {
+    pthread_attr_t attr;
+    if (pthread_getattr_np(pthread_self(), &attr) != 0) {
+      return false;
+    }
+    void* stack_address = nullptr;
+    size_t stack_size = 0;
+    pthread_attr_getstack(&attr, &stack_address, &stack_size);
+    pthread_attr_destroy(&attr);
+    thread_samples->stack_low = reinterpret_cast<uintptr_t>(stack_address);
+    thread_samples->stack_high = thread_samples->stack_low + stack_size;
+
+    struct sigevent event;
+    std::memset(&event, 0, sizeof(event));
+    event.sigev_notify = SIGEV_THREAD_ID;
+    event.sigev_signo = SIGPROF;
+    event.sigev_notify_thread_id = static_cast<pid_t>(syscall(SYS_gettid));
+    timer_t timer;
+    if (timer_create(CLOCK_THREAD_CPUTIME_ID, &event, &timer) != 0) {
+      XELOGE("Unable to create sampling timer: %d", errno);
+      return false;
+    }
+    current_thread_samples_ = thread_samples;
+
+    struct itimerspec spec;
+    spec.it_interval.tv_sec = time_t(interval_.count() / 1000000);
+    spec.it_interval.tv_nsec = long((interval_.count() % 1000000) * 1000);
+    spec.it_value = spec.it_interval;
+    if (timer_settime(timer, 0, &spec, nullptr) != 0) {
+      XELOGE("Unable to start sampling timer: %d", errno);
+      current_thread_samples_ = nullptr;
+      timer_delete(timer);
+      return false;
+    }
+    thread_samples->platform_data = timer;
+    return true;
+  }
+
+  void ThreadExitSampling(ThreadSamples* thread_samples) override {
+    timer_delete(static_cast<timer_t>(thread_samples->platform_data));
+    thread_samples->platform_data = nullptr;
+    if (current_thread_samples_ == thread_samples) {
+      current_thread_samples_ = nullptr;
+    }
+  }
+
+ private:
+  static void SignalHandler(int signal_number, siginfo_t* signal_info,
+                            void* signal_context) {
+    auto thread_samples = current_thread_samples_;
+    if (!thread_samples || !thread_samples->active) {
+      return;
+    }
+    auto context = reinterpret_cast<ucontext_t*>(signal_context);
+    profiler_->CaptureSample(
+        thread_samples, uint64_t(context->uc_mcontext.gregs[REG_RIP]),
+        uintptr_t(context->uc_mcontext.gregs[REG_RSP]));
+  }
+
+  static PosixSamplingProfiler* profiler_;
+  static thread_local ThreadSamples* current_thread_samples_;
+};
+
+PosixSamplingProfiler* PosixSamplingProfiler::profiler_ = nullptr;
+thread_local SamplingProfiler::ThreadSamples*
+    PosixSamplingProfiler::current_thread_samples_ = nullptr;
+
+std::unique_ptr<SamplingProfiler> SamplingProfiler::Create(
+    backend::CodeCache* code_cache) {
+  return std::make_unique<PosixSamplingProfiler>(code_cache);
+}
+
+}  // namespace cpu
+}  // namespace xe
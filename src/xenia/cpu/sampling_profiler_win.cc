@@ -0,0 +1,121 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#include "xenia/cpu/sampling_profiler.h"
+
+#include <algorithm>
+
+#include "xenia/base/logging.h"
+#include "xenia/base/platform_win.h"
+
+namespace xe {
+namespace cpu {
+
+// Samples from a dedicated thread by briefly suspending each guest thread and
+// reading its context. Threads that haven't run since the last sample (such as
+// those waiting) are skipped so results reflect CPU time.
+class Win32SamplingProfiler : public SamplingProfiler {
+ public:
+  explicit Win32SamplingProfiler(backend::CodeCache* code_cache)
+      : SamplingProfiler(code_cache) {}
+  ~Win32SamplingProfiler() override = default;
+
+ protected:
+  struct ThreadData {
+    HANDLE handle;
+    ULONG64 last_cycle_time;
+  };
+
+  bool StartSampling() override {
+    sampling_ = true;
+    sampler_thread_ = std::thread([this]() { SamplerThreadMain(); });
+    return true;
+  }
+
+  void StopSampling() override {
+    sampling_ = false;
+    sampler_thread_.join();
+  }
+
+  bool ThreadEnterSampling(ThreadSamples* thread_samples) override {
+    ULONG_PTR stack_low = 0;
+    ULONG_PTR stack_high = 0;
+    GetCurrentThreadStackLimits(&stack_low, &stack_high);
+    thread_samples->stack_low = stack_low;
+    thread_samples->stack_high = stack_high;
+
+    HANDLE handle = OpenThread(
+        THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT | THREAD_QUERY_INFORMATION,
+        FALSE, GetCurrentThreadId());
+    if (!handle) {
+      XELOGE("Unable to open thread for sampling: %d", GetLastError());
+      return false;
+    }
+    auto thread_data = new ThreadData();
+    thread_data->handle = handle;
+    thread_data->last_cycle_time = 0;
+    thread_samples->platform_data = thread_data;
+    return true;
+  }
+
+  void ThreadExitSampling(ThreadSamples* thread_samples) override {
+    // The sampler holds the thread lock while sampling, as do we, so the
+    // handle isn't in use.
+    auto thread_data = static_cast<ThreadData*>(thread_samples->platform_data);
+    CloseHandle(thread_data->handle);
+    delete thread_data;
+    thread_samples->platform_data = nullptr;
+  }
+
+ private:
+  void SamplerThreadMain() {
+    while (sampling_) {
+      Sleep(DWORD(std::max(int64_t(1), int64_t(interval_.count() / 1000))));
+
+      std::lock_guard<std::mutex> lock(threads_mutex_);
+      for (auto& thread_samples : threads_) {
+        if (!thread_samples->active) {
+          continue;
+        }
+        auto thread_data =
+            static_cast<ThreadData*>(thread_samples->platform_data);
+        ULONG64 cycle_time = 0;
+        QueryThreadCycleTime(thread_data->handle, &cycle_time);
+        if (cycle_time == thread_data->last_cycle_time) {
+          continue;
+        }
+        thread_data->last_cycle_time = cycle_time;
+
+        // Nothing below may allocate or lock, as the thread may be holding
+        // the heap lock or similar.
+        if (SuspendThread(thread_data->handle) == DWORD(-1)) {
+          continue;
+        }
+        CONTEXT thread_context;
+        thread_context.ContextFlags = CONTEXT_CONTROL;
+        if (GetThreadContext(thread_data->handle, &thread_context)) {
+          CaptureSample(thread_samples.get(), thread_context.Rip,
+                        uintptr_t(thread_context.Rsp));
+        }
+        ResumeThread(thread_data->handle);
+      }
+    }
+  }
+
+  std::atomic<bool> sampling_ = {false};
+  std::thread sampler_thread_;
+};
+
+std::unique_ptr<SamplingProfiler> SamplingProfiler::Create(
+    backend::CodeCache* code_cache) {
+  return std::make_unique<Win32SamplingProfiler>(code_cache);
+}
+
+}  // namespace cpu
+}  // namespace xe
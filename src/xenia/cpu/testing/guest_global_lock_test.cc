@@ -0,0 +1,110 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#include "xenia/cpu/guest_global_lock.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "xenia/base/threading.h"
+
+#include "third_party/catch/include/catch.hpp"
+
+namespace xe {
+namespace cpu {
+
+// Takes a ticket on behalf of a guest thread that then gets suspended before
+// its turn, and later lets it carry on waiting.
+class GuestGlobalLockTest {
+ public:
+  static uint32_t TakeTicket(GuestGlobalLock* lock) {
+    return lock->TakeTicket();
+  }
+  static void Acquire(GuestGlobalLock* lock, uint32_t ticket) {
+    lock->Acquire(ticket, xe::threading::current_thread_system_id());
+  }
+};
+
+namespace test {
+
+TEST_CASE("guest_global_lock_recursion", "GuestGlobalLock") {
+  GuestGlobalLock lock;
+  REQUIRE_FALSE(lock.is_held_by_current_thread());
+  lock.lock();
+  lock.lock();
+  REQUIRE(lock.is_held_by_current_thread());
+  lock.unlock();
+  REQUIRE(lock.is_held_by_current_thread());
+  lock.unlock();
+  REQUIRE_FALSE(lock.is_held_by_current_thread());
+  REQUIRE(lock.stats().acquire_count == 1);
+}
+
+TEST_CASE("guest_global_lock_exclusion", "GuestGlobalLock") {
+  GuestGlobalLock lock;
+  const int kThreadCount = 8;
+  const int kIterationCount = 10000;
+  int counter = 0;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreadCount; ++i) {
+    threads.emplace_back([&]() {
+      for (int j = 0; j < kIterationCount; ++j) {
+        lock.lock();
+        ++counter;
+        lock.unlock();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  REQUIRE(counter == kThreadCount * kIterationCount);
+}
+
+TEST_CASE("guest_global_lock_skips_suspended_waiter", "GuestGlobalLock") {
+  GuestGlobalLock lock;
+  lock.lock();
+
+  // Queued ahead of the waiter below, but never comes to take its turn.
+  uint32_t suspended_ticket = GuestGlobalLockTest::TakeTicket(&lock);
+
+  std::atomic<bool> acquired = {false};
+  std::thread waiter([&]() {
+    lock.lock();
+    acquired = true;
+    lock.unlock();
+  });
+  lock.unlock();
+
+  // Without skipping, the waiter would be stuck behind the suspended ticket
+  // forever.
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (!acquired && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  REQUIRE(acquired);
+  waiter.join();
+  REQUIRE(lock.stats().skipped_count == 1);
+
+  // Once resumed, the skipped thread queues again and gets the lock.
+  GuestGlobalLockTest::Acquire(&lock, suspended_ticket);
+  REQUIRE(lock.is_held_by_current_thread());
+  lock.unlock();
+
+  // And the lock keeps working in order afterwards.
+  lock.lock();
+  lock.unlock();
+  REQUIRE(lock.stats().skipped_count == 1);
+}
+
+}  // namespace test
+}  // namespace cpu
+}  // namespace xe
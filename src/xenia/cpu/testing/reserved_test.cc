@@ -0,0 +1,133 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#include "xenia/cpu/testing/util.h"
+
+#include <thread>
+
+using namespace xe::cpu::hir;
+using namespace xe::cpu;
+using namespace xe::cpu::testing;
+using xe::cpu::ppc::PPCContext;
+
+TEST_CASE("RESERVED_STORE_I32", "[instr]") {
+  TestFunction test([](HIRBuilder& b) {
+    auto address = LoadGPR(b, 4);
+    auto value = b.ReservedLoad(address, INT32_TYPE);
+    StoreGPR(b, 3,
+             b.ZeroExtend(b.ReservedStore(LoadGPR(b, 4),
+                                          b.Add(value, b.LoadConstantInt32(1))),
+                          INT64_TYPE));
+    // The reservation is gone after any reserved store.
+    StoreGPR(b, 5,
+             b.ZeroExtend(b.ReservedStore(LoadGPR(b, 4), value), INT64_TYPE));
+    b.Return();
+  });
+  uint32_t address = test.memory->SystemHeapAlloc(4);
+  auto host_address = test.memory->TranslateVirtual<uint32_t*>(address);
+  *host_address = 41;
+  test.Run([address](PPCContext* ctx) { ctx->r[4] = address; },
+           [host_address](PPCContext* ctx) {
+             REQUIRE(ctx->r[3] == 1);
+             REQUIRE(ctx->r[5] == 0);
+             REQUIRE(*host_address == 42);
+           });
+}
+
+TEST_CASE("RESERVED_STORE_I32_LOST", "[instr]") {
+  TestFunction test([](HIRBuilder& b) {
+    auto value = b.ReservedLoad(LoadGPR(b, 4), INT32_TYPE);
+    // A plain store changing the value loses the reservation.
+    b.Store(LoadGPR(b, 4), b.Add(value, b.LoadConstantInt32(1)));
+    StoreGPR(b, 3,
+             b.ZeroExtend(b.ReservedStore(LoadGPR(b, 4), value), INT64_TYPE));
+    // As does a reserved store to another address.
+    value = b.ReservedLoad(LoadGPR(b, 4), INT32_TYPE);
+    StoreGPR(b, 5,
+             b.ZeroExtend(b.ReservedStore(LoadGPR(b, 6), value), INT64_TYPE));
+    b.Return();
+  });
+  uint32_t address = test.memory->SystemHeapAlloc(8);
+  auto host_address = test.memory->TranslateVirtual<uint32_t*>(address);
+  host_address[0] = 41;
+  host_address[1] = 0;
+  test.Run(
+      [address](PPCContext* ctx) {
+        ctx->r[4] = address;
+        ctx->r[6] = address + 4;
+      },
+      [host_address](PPCContext* ctx) {
+        REQUIRE(ctx->r[3] == 0);
+        REQUIRE(ctx->r[5] == 0);
+        REQUIRE(host_address[0] == 42);
+        REQUIRE(host_address[1] == 0);
+      });
+}
+
+// Many threads incrementing the same counters with reserved load/store loops,
+// like guest atomics do. Every increment must land exactly once.
+TEST_CASE("RESERVED_STORE_STRESS", "[instr]") {
+  const int kThreadCount = 8;
+  const uint32_t kIterationCount = 100000;
+  TestFunction test([](HIRBuilder& b) {
+    // do {
+    //   do {
+    //     v = reserved_load [r4]
+    //   } while (!reserved_store [r4], v + 1);
+    //   do { ... } while (!reserved_store [r4 + 64], v + 1);
+    // } while (--r5);
+    auto loop_label = b.NewLabel();
+    auto retry_label = b.NewLabel();
+    auto retry_other_label = b.NewLabel();
+    b.MarkLabel(loop_label);
+    b.MarkLabel(retry_label);
+    auto address = LoadGPR(b, 4);
+    auto value = b.ReservedLoad(address, INT32_TYPE);
+    b.BranchFalse(
+        b.ReservedStore(address, b.Add(value, b.LoadConstantInt32(1))),
+        retry_label);
+    // Another counter in the same granule.
+    b.MarkLabel(retry_other_label);
+    address = b.Add(LoadGPR(b, 4), b.LoadConstantInt64(64));
+    value = b.ReservedLoad(address, INT32_TYPE);
+    b.BranchFalse(
+        b.ReservedStore(address, b.Add(value, b.LoadConstantInt32(1))),
+        retry_other_label);
+    auto count = b.Sub(LoadGPR(b, 5), b.LoadConstantInt64(1));
+    StoreGPR(b, 5, count);
+    b.BranchTrue(b.IsTrue(count), loop_label);
+    b.Return();
+  });
+  uint32_t address = test.memory->SystemHeapAlloc(128, 128);
+  auto host_address = test.memory->TranslateVirtual<uint32_t*>(address);
+  host_address[0] = 0;
+  host_address[16] = 0;
+
+  auto& processor = test.processors.front();
+  auto fn = processor->ResolveFunction(0x80000000);
+  REQUIRE(fn != nullptr);
+  std::vector<std::thread> threads;
+  for (int n = 0; n < kThreadCount; ++n) {
+    threads.emplace_back([&, n]() {
+      auto thread_state =
+          std::make_unique<ThreadState>(processor.get(), 0x100 + n);
+      auto ctx = thread_state->context();
+      ctx->lr = 0xBCBCBCBC;
+      ctx->r[4] = address;
+      ctx->r[5] = kIterationCount;
+      fn->Call(thread_state.get(), uint32_t(ctx->lr));
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  REQUIRE(host_address[0] == kThreadCount * kIterationCount);
+  REQUIRE(host_address[16] == kThreadCount * kIterationCount);
+}
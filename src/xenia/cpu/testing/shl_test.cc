@@ -228,3 +228,50 @@ TEST_CASE("SHL_I64", "[instr]") {
         REQUIRE(result == 0x8000000000000000ull);
       });
 }
+
+TEST_CASE("SHL_V128", "[instr]") {
+  TestFunction test([](HIRBuilder& b) {
+    StoreVR(b, 3, b.Shl(LoadVR(b, 4), b.Truncate(LoadGPR(b, 1), INT8_TYPE)));
+    b.Return();
+  });
+  test.Run(
+      [](PPCContext* ctx) {
+        ctx->r[1] = 0;
+        ctx->v[4] = vec128i(0x12345678, 0x9ABCDEF0, 0x0FEDCBA9, 0x87654321);
+      },
+      [](PPCContext* ctx) {
+        auto result1 = ctx->v[3];
+        REQUIRE(result1 ==
+                vec128i(0x12345678, 0x9ABCDEF0, 0x0FEDCBA9, 0x87654321));
+      });
+  test.Run(
+      [](PPCContext* ctx) {
+        ctx->r[1] = 1;
+        ctx->v[4] = vec128i(0x80000001, 0x80000000, 0x00000000, 0x00000001);
+      },
+      [](PPCContext* ctx) {
+        auto result1 = ctx->v[3];
+        REQUIRE(result1 ==
+                vec128i(0x00000003, 0x00000000, 0x00000000, 0x00000002));
+      });
+  test.Run(
+      [](PPCContext* ctx) {
+        ctx->r[1] = 4;
+        ctx->v[4] = vec128i(0x12345678, 0x9ABCDEF0, 0x0FEDCBA9, 0x87654321);
+      },
+      [](PPCContext* ctx) {
+        auto result1 = ctx->v[3];
+        REQUIRE(result1 ==
+                vec128i(0x23456789, 0xABCDEF00, 0xFEDCBA98, 0x76543210));
+      });
+  test.Run(
+      [](PPCContext* ctx) {
+        ctx->r[1] = 8;
+        ctx->v[4] = vec128i(0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF);
+      },
+      [](PPCContext* ctx) {
+        auto result1 = ctx->v[3];
+        REQUIRE(result1 ==
+                vec128i(0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF));
+      });
+}
@@ -275,4 +275,93 @@ TEST_CASE("SHR_V128", "[instr]") {
         REQUIRE(result1 ==
                 vec128i(0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF));
       });
+  test.Run(
+      [](PPCContext* ctx) {
+        ctx->r[1] = 0;
+        ctx->v[4] = vec128i(0x12345678, 0x9ABCDEF0, 0x0FEDCBA9, 0x87654321);
+      },
+      [](PPCContext* ctx) {
+        auto result1 = ctx->v[3];
+        REQUIRE(result1 ==
+                vec128i(0x12345678, 0x9ABCDEF0, 0x0FEDCBA9, 0x87654321));
+      });
+  test.Run(
+      [](PPCContext* ctx) {
+        ctx->r[1] = 7;
+        ctx->v[4] = vec128i(0x12345678, 0x9ABCDEF0, 0x0FEDCBA9, 0x87654321);
+      },
+      [](PPCContext* ctx) {
+        auto result1 = ctx->v[3];
+        REQUIRE(result1 ==
+                vec128i(0x002468AC, 0xF13579BD, 0xE01FDB97, 0x530ECA86));
+      });
+  test.Run(
+      [](PPCContext* ctx) {
+        ctx->r[1] = 8;
+        ctx->v[4] = vec128i(0x12345678, 0x9ABCDEF0, 0x0FEDCBA9, 0x87654321);
+      },
+      [](PPCContext* ctx) {
+        auto result1 = ctx->v[3];
+        REQUIRE(result1 ==
+                vec128i(0x12345678, 0x9ABCDEF0, 0x0FEDCBA9, 0x87654321));
+      });
+  test.Run(
+      [](PPCContext* ctx) {
+        ctx->r[1] = 15;
+        ctx->v[4] = vec128i(0x12345678, 0x9ABCDEF0, 0x0FEDCBA9, 0x87654321);
+      },
+      [](PPCContext* ctx) {
+        auto result1 = ctx->v[3];
+        REQUIRE(result1 ==
+                vec128i(0x002468AC, 0xF13579BD, 0xE01FDB97, 0x530ECA86));
+      });
+  // Bits crossing byte and dword boundaries.
+  test.Run(
+      [](PPCContext* ctx) {
+        ctx->r[1] = 1;
+        ctx->v[4] = vec128i(0x00000001, 0x00000100, 0x00010000, 0x01000000);
+      },
+      [](PPCContext* ctx) {
+        auto result1 = ctx->v[3];
+        REQUIRE(result1 ==
+                vec128i(0x00000000, 0x80000080, 0x00008000, 0x00800000));
+      });
+  test.Run(
+      [](PPCContext* ctx) {
+        ctx->r[1] = 7;
+        ctx->v[4] = vec128i(0x00000001, 0x00000100, 0x00010000, 0x01000000);
+      },
+      [](PPCContext* ctx) {
+        auto result1 = ctx->v[3];
+        REQUIRE(result1 ==
+                vec128i(0x00000000, 0x02000002, 0x00000200, 0x00020000));
+      });
+}
+
+TEST_CASE("SHR_V128_CONSTANT", "[instr]") {
+  // Only the low 3 bits of the shift amount are used.
+  const struct {
+    int8_t shamt;
+    vec128_t expected;
+  } cases[] = {
+      {0, vec128i(0x12345678, 0x9ABCDEF0, 0x0FEDCBA9, 0x87654321)},
+      {7, vec128i(0x002468AC, 0xF13579BD, 0xE01FDB97, 0x530ECA86)},
+      {8, vec128i(0x12345678, 0x9ABCDEF0, 0x0FEDCBA9, 0x87654321)},
+      {15, vec128i(0x002468AC, 0xF13579BD, 0xE01FDB97, 0x530ECA86)},
+  };
+  for (auto& c : cases) {
+    TestFunction([&c](HIRBuilder& b) {
+      StoreVR(b, 3, b.Shr(LoadVR(b, 4), b.LoadConstantInt8(c.shamt)));
+      b.Return();
+    })
+        .Run(
+            [](PPCContext* ctx) {
+              ctx->v[4] =
+                  vec128i(0x12345678, 0x9ABCDEF0, 0x0FEDCBA9, 0x87654321);
+            },
+            [&c](PPCContext* ctx) {
+              auto result1 = ctx->v[3];
+              REQUIRE(result1 == c.expected);
+            });
+  }
 }
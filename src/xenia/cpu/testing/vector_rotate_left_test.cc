@@ -54,6 +54,48 @@ TEST_CASE("VECTOR_ROTATE_LEFT_I16", "[instr]") {
       });
 }
 
+TEST_CASE("VECTOR_ROTATE_LEFT_I8_CONSTANT", "[instr]") {
+  TestFunction test([](HIRBuilder& b) {
+    StoreVR(b, 3, b.VectorRotateLeft(
+                      LoadVR(b, 4),
+                      b.LoadConstantVec128(vec128b(0, 1, 7, 8, 1, 3, 4, 9, 2,
+                                                   6, 5, 15, 1, 7, 3, 255)),
+                      INT8_TYPE));
+    b.Return();
+  });
+  test.Run(
+      [](PPCContext* ctx) {
+        ctx->v[4] = vec128b(0x81, 0x81, 0x81, 0x81, 0x12, 0x12, 0x12, 0x12,
+                            0xF0, 0xF0, 0x3C, 0x3C, 0x80, 0x01, 0xA5, 0xFF);
+      },
+      [](PPCContext* ctx) {
+        auto result = ctx->v[3];
+        REQUIRE(result == vec128b(0x81, 0x03, 0xC0, 0x81, 0x24, 0x90, 0x21,
+                                  0x24, 0xC3, 0x3C, 0x87, 0x1E, 0x01, 0x80,
+                                  0x2D, 0xFF));
+      });
+}
+
+TEST_CASE("VECTOR_ROTATE_LEFT_I16_CONSTANT", "[instr]") {
+  TestFunction test([](HIRBuilder& b) {
+    StoreVR(b, 3, b.VectorRotateLeft(LoadVR(b, 4),
+                                     b.LoadConstantVec128(
+                                         vec128s(1, 4, 8, 15, 16, 12, 3, 17)),
+                                     INT16_TYPE));
+    b.Return();
+  });
+  test.Run(
+      [](PPCContext* ctx) {
+        ctx->v[4] = vec128s(0x8001, 0x1234, 0xF00F, 0x8000, 0x0001, 0xABCD,
+                            0x7FFF, 0xFFFE);
+      },
+      [](PPCContext* ctx) {
+        auto result = ctx->v[3];
+        REQUIRE(result == vec128s(0x0003, 0x2341, 0x0FF0, 0x4000, 0x0001,
+                                  0xDABC, 0xFFFB, 0xFFFD));
+      });
+}
+
 TEST_CASE("VECTOR_ROTATE_LEFT_I32", "[instr]") {
   TestFunction test([](HIRBuilder& b) {
     StoreVR(b, 3, b.VectorRotateLeft(LoadVR(b, 4), LoadVR(b, 5), INT32_TYPE));
@@ -192,10 +192,12 @@ X_STATUS Emulator::Setup(
   ExceptionHandler::Install(Emulator::ExceptionCallbackThunk, this);
 
   // Finish initializing the display.
-  display_window_->loop()->PostSynchronous([this]() {
-    xe::ui::GraphicsContextLock context_lock(display_window_->context());
-    Profiler::set_window(display_window_);
-  });
+  if (display_window_) {
+    display_window_->loop()->PostSynchronous([this]() {
+      xe::ui::GraphicsContextLock context_lock(display_window_->context());
+      Profiler::set_window(display_window_);
+    });
+  }
 
   return result;
 }
@@ -616,6 +618,10 @@ X_STATUS Emulator::CompleteLaunch(const std::wstring& path,
     title_id_ = info->title_id;
   }
 
+  // Code is compiled on demand once launched, so the profile it's laid out
+  // with must be ready now.
+  processor_->OpenExecutionProfile(title_id_);
+
   // Try and load the resource database (xex only).
   if (module->title_id()) {
     char title_id[9] = {0};
@@ -13,8 +13,10 @@
 #include <cmath>
 
 #include "xenia/base/byte_stream.h"
+#include "xenia/base/clock.h"
 #include "xenia/base/logging.h"
 #include "xenia/base/math.h"
+#include "xenia/base/mutex.h"
 #include "xenia/base/profiling.h"
 #include "xenia/base/ring_buffer.h"
 #include "xenia/gpu/gpu_flags.h"
@@ -39,7 +41,8 @@ CommandProcessor::CommandProcessor(GraphicsSystem* graphics_system,
       trace_writer_(graphics_system->memory()->physical_membase()),
       worker_running_(true),
       write_ptr_index_event_(xe::threading::Event::CreateAutoResetEvent(false)),
-      write_ptr_index_(0) {}
+      write_ptr_index_(0),
+      wait_reg_mem_event_(xe::threading::Event::CreateAutoResetEvent(false)) {}
 
 CommandProcessor::~CommandProcessor() = default;
 
@@ -109,13 +112,18 @@ void CommandProcessor::CallInThread(std::function<void()> fn) {
     fn();
   } else {
     pending_fns_.push(std::move(fn));
+    // Wake the worker if it's idle waiting for commands.
+    write_ptr_index_event_->Set();
   }
 }
 
 void CommandProcessor::ClearCaches() {}
 
 void CommandProcessor::WorkerThreadMain() {
-  context_->MakeCurrent();
+  // The null backend runs without a graphics context.
+  if (context_) {
+    context_->MakeCurrent();
+  }
   if (!SetupContext()) {
     xe::FatalError("Unable to setup command processor GL state");
     return;
@@ -251,6 +259,12 @@ void CommandProcessor::UpdateWritePointer(uint32_t value) {
   write_ptr_index_event_->Set();
 }
 
+void CommandProcessor::NotifyRegisterWrite(uint32_t index) {
+  if (wait_reg_mem_register_.load(std::memory_order_acquire) == index) {
+    wait_reg_mem_event_->Set();
+  }
+}
+
 void CommandProcessor::WriteRegister(uint32_t index, uint32_t value) {
   RegisterFile* regs = register_file_;
   if (index >= RegisterFile::kRegisterCount) {
@@ -258,8 +272,14 @@ void CommandProcessor::WriteRegister(uint32_t index, uint32_t value) {
     return;
   }
 
+  if (stats_enabled_) {
+    ++stats_.register_write_count;
+    ++stats_.register_write_counts[index];
+  }
+
   // 0x1844 - pointer to frontbuffer
   regs->values[index].u32 = value;
+  regs->MarkDirty(index);
   if (!regs->GetRegisterInfo(index)) {
     XELOGW("GPU: Write to unknown register (%.4X = %.8X)", index, value);
   }
@@ -283,6 +303,48 @@ void CommandProcessor::WriteRegister(uint32_t index, uint32_t value) {
   }
 }
 
+void CommandProcessor::WriteRegistersFromMem(uint32_t start_index,
+                                             const uint32_t* base,
+                                             uint32_t count) {
+  if (start_index >= XE_GPU_REG_SHADER_CONSTANT_000_X &&
+      start_index + count <= XE_GPU_REG_SHADER_CONSTANT_LOOP_31 + 1) {
+    xe::copy_and_swap_32_unaligned(&register_file_->values[start_index].u32,
+                                   base, count);
+    register_file_->MarkRangeDirty(start_index, count);
+    if (stats_enabled_) {
+      stats_.register_write_count += count;
+      for (uint32_t i = 0; i < count; ++i) {
+        ++stats_.register_write_counts[start_index + i];
+      }
+    }
+    return;
+  }
+
+  for (uint32_t i = 0; i < count; ++i) {
+    WriteRegister(start_index + i, xe::load_and_swap<uint32_t>(base + i));
+  }
+}
+
+void CommandProcessor::WriteRegisterRangeFromRing(RingBuffer* ring,
+                                                  uint32_t start_index,
+                                                  uint32_t count) {
+  if (!count) {
+    return;
+  }
+  // The range may wrap around the end of the ring buffer.
+  auto range = ring->BeginRead(count * sizeof(uint32_t));
+  uint32_t first_count = uint32_t(range.first_length / sizeof(uint32_t));
+  WriteRegistersFromMem(start_index,
+                        reinterpret_cast<const uint32_t*>(range.first),
+                        first_count);
+  if (range.second) {
+    WriteRegistersFromMem(start_index + first_count,
+                          reinterpret_cast<const uint32_t*>(range.second),
+                          count - first_count);
+  }
+  ring->EndRead(range);
+}
+
 void CommandProcessor::MakeCoherent() {
   SCOPE_profile_cpu_f("gpu");
 
@@ -447,19 +509,31 @@ bool CommandProcessor::ExecutePacket(RingBuffer* reader) {
     return true;
   }
 
+  uint64_t start_ticks = stats_enabled_ ? Clock::QueryHostTickCount() : 0;
+  bool result = false;
   switch (packet_type) {
     case 0x00:
-      return ExecutePacketType0(reader, packet);
+      result = ExecutePacketType0(reader, packet);
+      break;
     case 0x01:
-      return ExecutePacketType1(reader, packet);
+      result = ExecutePacketType1(reader, packet);
+      break;
     case 0x02:
-      return ExecutePacketType2(reader, packet);
+      result = ExecutePacketType2(reader, packet);
+      break;
     case 0x03:
-      return ExecutePacketType3(reader, packet);
+      result = ExecutePacketType3(reader, packet);
+      break;
     default:
       assert_unhandled_case(packet_type);
       return false;
   }
+  if (stats_enabled_) {
+    ++stats_.packet_counts[packet_type];
+    stats_.packet_ticks[packet_type] +=
+        Clock::QueryHostTickCount() - start_ticks;
+  }
+  return result;
 }
 
 bool CommandProcessor::ExecutePacketType0(RingBuffer* reader, uint32_t packet) {
@@ -477,10 +551,12 @@ bool CommandProcessor::ExecutePacketType0(RingBuffer* reader, uint32_t packet) {
 
   uint32_t base_index = (packet & 0x7FFF);
   uint32_t write_one_reg = (packet >> 15) & 0x1;
-  for (uint32_t m = 0; m < count; m++) {
-    uint32_t reg_data = reader->Read<uint32_t>(true);
-    uint32_t target_index = write_one_reg ? base_index : base_index + m;
-    WriteRegister(target_index, reg_data);
+  if (write_one_reg) {
+    for (uint32_t m = 0; m < count; m++) {
+      WriteRegister(base_index, reader->Read<uint32_t>(true));
+    }
+  } else {
+    WriteRegisterRangeFromRing(reader, base_index, count);
   }
 
   trace_writer_.WritePacketEnd();
@@ -540,6 +616,7 @@ bool CommandProcessor::ExecutePacketType3(RingBuffer* reader, uint32_t packet) {
     }
   }
 
+  uint64_t start_ticks = stats_enabled_ ? Clock::QueryHostTickCount() : 0;
   bool result = false;
   switch (opcode) {
     case PM4_ME_INIT:
@@ -660,6 +737,10 @@ bool CommandProcessor::ExecutePacketType3(RingBuffer* reader, uint32_t packet) {
       reader->AdvanceRead(count * sizeof(uint32_t));
       break;
   }
+  if (stats_enabled_) {
+    ++stats_.type3_counts[opcode];
+    stats_.type3_ticks[opcode] += Clock::QueryHostTickCount() - start_ticks;
+  }
 
   trace_writer_.WritePacketEnd();
   assert_true(reader->read_offset() ==
@@ -708,6 +789,10 @@ bool CommandProcessor::ExecutePacketType3_XE_SWAP(RingBuffer* reader,
 
   Profiler::Flip();
 
+  if (stats_enabled_) {
+    ++stats_.swap_count;
+  }
+
   // Xenia-specific VdSwap hook.
   // VdSwap will post this to tell us we need to swap the screen/fire an
   // interrupt.
@@ -767,71 +852,148 @@ bool CommandProcessor::ExecutePacketType3_WAIT_REG_MEM(RingBuffer* reader,
   uint32_t ref = reader->Read<uint32_t>(true);
   uint32_t mask = reader->Read<uint32_t>(true);
   uint32_t wait = reader->Read<uint32_t>(true);
-  bool matched = false;
-  do {
-    uint32_t value;
-    if (wait_info & 0x10) {
-      // Memory.
-      auto endianness = static_cast<Endian>(poll_reg_addr & 0x3);
-      poll_reg_addr &= ~0x3;
-      value = xe::load<uint32_t>(memory_->TranslatePhysical(poll_reg_addr));
-      value = GpuSwap(value, endianness);
-      trace_writer_.WriteMemoryRead(CpuToGpu(poll_reg_addr), 4);
-    } else {
-      // Register.
-      assert_true(poll_reg_addr < RegisterFile::kRegisterCount);
-      value = register_file_->values[poll_reg_addr].u32;
-      if (poll_reg_addr == XE_GPU_REG_COHER_STATUS_HOST) {
-        MakeCoherent();
-        value = register_file_->values[poll_reg_addr].u32;
-      }
-    }
+  auto test = [&](uint32_t value) {
     switch (wait_info & 0x7) {
       case 0x0:  // Never.
-        matched = false;
-        break;
+        return false;
       case 0x1:  // Less than reference.
-        matched = (value & mask) < ref;
-        break;
+        return (value & mask) < ref;
       case 0x2:  // Less than or equal to reference.
-        matched = (value & mask) <= ref;
-        break;
+        return (value & mask) <= ref;
       case 0x3:  // Equal to reference.
-        matched = (value & mask) == ref;
-        break;
+        return (value & mask) == ref;
       case 0x4:  // Not equal to reference.
-        matched = (value & mask) != ref;
-        break;
+        return (value & mask) != ref;
       case 0x5:  // Greater than or equal to reference.
-        matched = (value & mask) >= ref;
-        break;
+        return (value & mask) >= ref;
       case 0x6:  // Greater than reference.
-        matched = (value & mask) > ref;
-        break;
+        return (value & mask) > ref;
       case 0x7:  // Always
-        matched = true;
-        break;
+      default:
+        return true;
     }
-    if (!matched) {
-      // Wait.
-      if (wait >= 0x100) {
-        PrepareForWait();
-        if (!FLAGS_vsync) {
-          // User wants it fast and dangerous.
-          xe::threading::MaybeYield();
-        } else {
-          xe::threading::Sleep(std::chrono::milliseconds(wait / 0x100));
-        }
-        xe::threading::SyncMemory();
-        ReturnFromWait();
-      } else {
-        xe::threading::MaybeYield();
-      }
+  };
+
+  auto matched = [&]() {
+    return test(ReadWaitRegMemValue(wait_info, poll_reg_addr));
+  };
+  // The location is recorded once, with the value that satisfied the wait,
+  // rather than on every poll.
+  auto trace_read = [&]() {
+    if (wait_info & 0x10) {
+      trace_writer_.WriteMemoryRead(CpuToGpu(poll_reg_addr & ~0x3), 4);
     }
-  } while (!matched);
+  };
+
+  if (matched()) {
+    trace_read();
+    return true;
+  }
+
+  if (!FLAGS_vsync) {
+    // User wants it fast and dangerous.
+    do {
+      xe::threading::MaybeYield();
+      xe::threading::SyncMemory();
+    } while (!matched());
+    trace_read();
+    return true;
+  }
+
+  // Most waits are satisfied within microseconds, so keep polling for a
+  // while before paying for a park, whose timeout is at least 1ms.
+  uint64_t spin_end_ticks =
+      Clock::QueryHostTickCount() +
+      uint64_t(std::max(0, FLAGS_gpu_wait_spin_us)) *
+          Clock::host_tick_frequency() / 1000000;
+  do {
+    xe::threading::MaybeYield();
+    xe::threading::SyncMemory();
+    if (matched()) {
+      trace_read();
+      return true;
+    }
+  } while (Clock::QueryHostTickCount() < spin_end_ticks);
+
+  // Park until the CPU writes the location. The wake source is armed before
+  // re-checking so a write landing in between is not missed. Wakes may be
+  // spurious (watches cover whole pages) so the condition is always re-tested,
+  // and the timeout covers writers we can't observe.
+  auto timeout = std::chrono::milliseconds(std::max(1u, wait / 0x100));
+  bool prepared = false;
+  while (true) {
+    ArmWaitRegMemWake(wait_info, poll_reg_addr, true);
+    if (matched()) {
+      break;
+    }
+    auto result =
+        xe::threading::Wait(wait_reg_mem_event_.get(), true, timeout);
+    xe::threading::SyncMemory();
+    // Only a long wait that has gone a full timeout without a write is worth
+    // flushing the backend (and trace) for.
+    if (result == xe::threading::WaitResult::kTimeout && !prepared &&
+        wait >= 0x100) {
+      PrepareForWait();
+      prepared = true;
+    }
+  }
+  ArmWaitRegMemWake(wait_info, poll_reg_addr, false);
+  if (prepared) {
+    ReturnFromWait();
+  }
+  trace_read();
   return true;
 }
 
+uint32_t CommandProcessor::ReadWaitRegMemValue(uint32_t wait_info,
+                                               uint32_t poll_reg_addr) {
+  uint32_t value;
+  if (wait_info & 0x10) {
+    // Memory.
+    auto endianness = static_cast<Endian>(poll_reg_addr & 0x3);
+    poll_reg_addr &= ~0x3;
+    value = xe::load<uint32_t>(memory_->TranslatePhysical(poll_reg_addr));
+    value = GpuSwap(value, endianness);
+  } else {
+    // Register.
+    assert_true(poll_reg_addr < RegisterFile::kRegisterCount);
+    value = register_file_->values[poll_reg_addr].u32;
+    if (poll_reg_addr == XE_GPU_REG_COHER_STATUS_HOST) {
+      MakeCoherent();
+      value = register_file_->values[poll_reg_addr].u32;
+    }
+  }
+  return value;
+}
+
+void CommandProcessor::ArmWaitRegMemWake(uint32_t wait_info,
+                                         uint32_t poll_reg_addr, bool armed) {
+  if (!(wait_info & 0x10)) {
+    wait_reg_mem_register_.store(armed ? poll_reg_addr : UINT32_MAX,
+                                 std::memory_order_release);
+    return;
+  }
+
+  // Watches are one-shot and the callback runs under the global lock, so it
+  // must be held to know whether ours is still live.
+  auto global_lock = global_critical_region::AcquireDirect();
+  if (armed) {
+    if (!wait_reg_mem_watch_) {
+      wait_reg_mem_watch_ = memory_->AddPhysicalAccessWatch(
+          poll_reg_addr & ~0x3, 4, cpu::MMIOHandler::kWatchWrite,
+          [](void* context_ptr, void* data_ptr, uint32_t address) {
+            auto self = reinterpret_cast<CommandProcessor*>(context_ptr);
+            self->wait_reg_mem_watch_ = 0;
+            self->wait_reg_mem_event_->Set();
+          },
+          this, nullptr);
+    }
+  } else if (wait_reg_mem_watch_) {
+    memory_->CancelAccessWatch(wait_reg_mem_watch_);
+    wait_reg_mem_watch_ = 0;
+  }
+}
+
 bool CommandProcessor::ExecutePacketType3_REG_RMW(RingBuffer* reader,
                                                   uint32_t packet,
                                                   uint32_t count) {
@@ -1096,6 +1258,9 @@ bool CommandProcessor::ExecutePacketType3_DRAW_INDX(RingBuffer* reader,
     XELOGE("PM4_DRAW_INDX(%d, %d, %d): Failed in backend", index_count,
            prim_type, src_sel);
   }
+  if (stats_enabled_) {
+    ++stats_.draw_count;
+  }
 
   return true;
 }
@@ -1120,6 +1285,9 @@ bool CommandProcessor::ExecutePacketType3_DRAW_INDX_2(RingBuffer* reader,
     XELOGE("PM4_DRAW_INDX_IMM(%d, %d): Failed in backend", index_count,
            prim_type);
   }
+  if (stats_enabled_) {
+    ++stats_.draw_count;
+  }
 
   return true;
 }
@@ -1154,10 +1322,7 @@ bool CommandProcessor::ExecutePacketType3_SET_CONSTANT(RingBuffer* reader,
       reader->AdvanceRead((count - 1) * sizeof(uint32_t));
       return true;
   }
-  for (uint32_t n = 0; n < count - 1; n++, index++) {
-    uint32_t data = reader->Read<uint32_t>(true);
-    WriteRegister(index, data);
-  }
+  WriteRegisterRangeFromRing(reader, index, count - 1);
   return true;
 }
 
@@ -1166,10 +1331,7 @@ bool CommandProcessor::ExecutePacketType3_SET_CONSTANT2(RingBuffer* reader,
                                                         uint32_t count) {
   uint32_t offset_type = reader->Read<uint32_t>(true);
   uint32_t index = offset_type & 0xFFFF;
-  for (uint32_t n = 0; n < count - 1; n++, index++) {
-    uint32_t data = reader->Read<uint32_t>(true);
-    WriteRegister(index, data);
-  }
+  WriteRegisterRangeFromRing(reader, index, count - 1);
   return true;
 }
 
@@ -1205,11 +1367,9 @@ bool CommandProcessor::ExecutePacketType3_LOAD_ALU_CONSTANT(RingBuffer* reader,
       return true;
   }
   trace_writer_.WriteMemoryRead(CpuToGpu(address), size_dwords * 4);
-  for (uint32_t n = 0; n < size_dwords; n++, index++) {
-    uint32_t data = xe::load_and_swap<uint32_t>(
-        memory_->TranslatePhysical(address + n * 4));
-    WriteRegister(index, data);
-  }
+  WriteRegistersFromMem(
+      index, memory_->TranslatePhysical<const uint32_t*>(address),
+      size_dwords);
   return true;
 }
 
@@ -1217,10 +1377,7 @@ bool CommandProcessor::ExecutePacketType3_SET_SHADER_CONSTANTS(
     RingBuffer* reader, uint32_t packet, uint32_t count) {
   uint32_t offset_type = reader->Read<uint32_t>(true);
   uint32_t index = offset_type & 0xFFFF;
-  for (uint32_t n = 0; n < count - 1; n++, index++) {
-    uint32_t data = reader->Read<uint32_t>(true);
-    WriteRegister(index, data);
-  }
+  WriteRegisterRangeFromRing(reader, index, count - 1);
   return true;
 }
 
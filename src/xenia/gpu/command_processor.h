@@ -58,6 +58,30 @@ enum class SwapMode {
   kIgnored,
 };
 
+// Counters gathered while executing packets, used for profiling the CPU side
+// of GPU emulation (such as by the trace benchmark tool).
+// Only collected when enabled with CommandProcessor::set_stats_enabled and
+// only touched from the command processor thread.
+struct CommandProcessorStats {
+  CommandProcessorStats()
+      : register_write_counts(RegisterFile::kRegisterCount) {}
+
+  // Packets executed, by packet type (0-3).
+  uint64_t packet_counts[4] = {0};
+  // Host ticks spent executing packets, by packet type (0-3).
+  // Type 3 indirect buffer packets include the time of their child packets.
+  uint64_t packet_ticks[4] = {0};
+  // Type 3 packets executed, by PM4 opcode.
+  uint64_t type3_counts[128] = {0};
+  // Host ticks spent executing type 3 packets, by PM4 opcode.
+  uint64_t type3_ticks[128] = {0};
+  // Total register writes and writes by register index.
+  uint64_t register_write_count = 0;
+  std::vector<uint64_t> register_write_counts;
+  uint64_t draw_count = 0;
+  uint64_t swap_count = 0;
+};
+
 class CommandProcessor {
  public:
   CommandProcessor(GraphicsSystem* graphics_system,
@@ -95,6 +119,10 @@ class CommandProcessor {
 
   void UpdateWritePointer(uint32_t value);
 
+  // Called after the CPU writes a register through MMIO. Wakes the worker if
+  // it is parked in a WAIT_REG_MEM on that register.
+  void NotifyRegisterWrite(uint32_t index);
+
   void ExecutePacket(uint32_t ptr, uint32_t count);
 
   bool is_paused() const { return paused_; }
@@ -104,6 +132,11 @@ class CommandProcessor {
   bool Save(ByteStream* stream);
   bool Restore(ByteStream* stream);
 
+  bool stats_enabled() const { return stats_enabled_; }
+  void set_stats_enabled(bool enabled) { stats_enabled_ = enabled; }
+  const CommandProcessorStats& stats() const { return stats_; }
+  void ResetStats() { stats_ = CommandProcessorStats(); }
+
  protected:
   struct IndexBufferInfo {
     IndexFormat format = IndexFormat::kInt16;
@@ -118,6 +151,14 @@ class CommandProcessor {
   virtual void ShutdownContext() = 0;
 
   virtual void WriteRegister(uint32_t index, uint32_t value);
+  // Writes count consecutive registers from big-endian source data.
+  // Shader constants have no write side effects and are copied in bulk without
+  // going through WriteRegister; anything else is written one at a time.
+  void WriteRegistersFromMem(uint32_t start_index, const uint32_t* base,
+                             uint32_t count);
+  // As WriteRegistersFromMem, consuming the data from the ring buffer.
+  void WriteRegisterRangeFromRing(RingBuffer* ring, uint32_t start_index,
+                                  uint32_t count);
 
   virtual void MakeCoherent();
   virtual void PrepareForWait();
@@ -145,6 +186,12 @@ class CommandProcessor {
                                           uint32_t count);
   bool ExecutePacketType3_WAIT_REG_MEM(RingBuffer* reader, uint32_t packet,
                                        uint32_t count);
+  // Reads the register or memory location polled by a WAIT_REG_MEM.
+  uint32_t ReadWaitRegMemValue(uint32_t wait_info, uint32_t poll_reg_addr);
+  // Arms (or disarms, with armed = false) the wake source for a parked
+  // WAIT_REG_MEM: an access watch for memory or a register index for MMIO.
+  void ArmWaitRegMemWake(uint32_t wait_info, uint32_t poll_reg_addr,
+                         bool armed);
   bool ExecutePacketType3_REG_RMW(RingBuffer* reader, uint32_t packet,
                                   uint32_t count);
   bool ExecutePacketType3_REG_TO_MEM(RingBuffer* reader, uint32_t packet,
@@ -227,6 +274,14 @@ class CommandProcessor {
   std::unique_ptr<xe::threading::Event> write_ptr_index_event_;
   std::atomic<uint32_t> write_ptr_index_;
 
+  // Signaled when the location a parked WAIT_REG_MEM polls may have changed.
+  std::unique_ptr<xe::threading::Event> wait_reg_mem_event_;
+  // Register index being waited on, or UINT32_MAX if none.
+  std::atomic<uint32_t> wait_reg_mem_register_ = {UINT32_MAX};
+  // Access watch on the memory being waited on. Guarded by the global critical
+  // region, as the watch callback clears it when fired.
+  uintptr_t wait_reg_mem_watch_ = 0;
+
   uint64_t bin_select_ = 0xFFFFFFFFull;
   uint64_t bin_mask_ = 0xFFFFFFFFull;
 
@@ -234,6 +289,9 @@ class CommandProcessor {
   Shader* active_pixel_shader_ = nullptr;
 
   bool paused_ = false;
+
+  bool stats_enabled_ = false;
+  CommandProcessorStats stats_;
 };
 
 }  // namespace gpu
@@ -17,3 +17,8 @@ DEFINE_string(dump_shaders, "",
               "Path to write GPU shaders to as they are compiled.");
 
 DEFINE_bool(vsync, true, "Enable VSYNC.");
+
+DEFINE_int32(gpu_wait_spin_us, 50,
+             "Microseconds the command processor keeps re-polling before "
+             "parking until a waited-on register or memory location is "
+             "written. Parks last at least 1ms if the write goes unseen.");
@@ -19,4 +19,6 @@ DECLARE_string(dump_shaders);
 
 DECLARE_bool(vsync);
 
+DECLARE_int32(gpu_wait_spin_us);
+
 #endif  // XENIA_GPU_GPU_FLAGS_H_
@@ -79,12 +79,16 @@ X_STATUS GraphicsSystem::Setup(cpu::Processor* processor,
     XELOGE("Unable to initialize command processor");
     return X_STATUS_UNSUCCESSFUL;
   }
-  command_processor_->set_swap_request_handler(
-      [this]() { target_window_->Invalidate(); });
-
-  // Watch for paint requests to do our swap.
-  target_window->on_painting.AddListener(
-      [this](xe::ui::UIEvent* e) { Swap(e); });
+  // Without a target window (such as in headless tools) there is nothing to
+  // present to and swaps are dropped.
+  if (target_window_) {
+    command_processor_->set_swap_request_handler(
+        [this]() { target_window_->Invalidate(); });
+
+    // Watch for paint requests to do our swap.
+    target_window_->on_painting.AddListener(
+        [this](xe::ui::UIEvent* e) { Swap(e); });
+  }
 
   // Let the processor know we want register access callbacks.
   memory_->AddVirtualMappedRange(
@@ -179,6 +183,15 @@ void GraphicsSystem::WriteRegister(uint32_t addr, uint32_t value) {
     case 0x01C5:  // CP_RB_WPTR
       command_processor_->UpdateWritePointer(value);
       break;
+    case 0x0578:  // SCRATCH_REG0
+    case 0x0579:  // SCRATCH_REG1
+    case 0x057A:  // SCRATCH_REG2
+    case 0x057B:  // SCRATCH_REG3
+    case 0x057C:  // SCRATCH_REG4
+    case 0x057D:  // SCRATCH_REG5
+    case 0x057E:  // SCRATCH_REG6
+    case 0x057F:  // SCRATCH_REG7
+      break;
     case 0x1844:  // AVIVO_D1GRPH_PRIMARY_SURFACE_ADDRESS
       break;
     default:
@@ -188,6 +201,10 @@ void GraphicsSystem::WriteRegister(uint32_t addr, uint32_t value) {
 
   assert_true(r < RegisterFile::kRegisterCount);
   register_file_.values[r].u32 = value;
+  register_file_.MarkDirty(r);
+
+  // Wake the command processor if it's waiting on this register.
+  command_processor_->NotifyRegisterWrite(r);
 }
 
 void GraphicsSystem::InitializeRingBuffer(uint32_t ptr, uint32_t log2_size) {
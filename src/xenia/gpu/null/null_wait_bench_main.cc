@@ -0,0 +1,36 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#include "xenia/base/logging.h"
+#include "xenia/base/main.h"
+#include "xenia/gpu/null/null_graphics_system.h"
+#include "xenia/gpu/wait_bench.h"
+
+namespace xe {
+namespace gpu {
+namespace null {
+
+class NullWaitBench : public WaitBench {
+ public:
+  std::unique_ptr<gpu::GraphicsSystem> CreateGraphicsSystem() override {
+    return std::unique_ptr<gpu::GraphicsSystem>(new NullGraphicsSystem());
+  }
+};
+
+int wait_bench_main(const std::vector<std::wstring>& args) {
+  NullWaitBench wait_bench;
+  return wait_bench.Main(args);
+}
+
+}  // namespace null
+}  // namespace gpu
+}  // namespace xe
+
+DEFINE_ENTRY_POINT(L"xenia-gpu-wait-bench", L"xenia-gpu-wait-bench",
+                   xe::gpu::null::wait_bench_main);
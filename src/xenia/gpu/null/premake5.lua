@@ -19,3 +19,93 @@ project("xenia-gpu-null")
     project_root.."/third_party/gflags/src",
   })
   local_platform_files()
+
+group("src")
+project("xenia-gpu-trace-bench")
+  uuid("a333504c-04a8-493a-bb21-54d96fc04401")
+  kind("ConsoleApp")
+  language("C++")
+  links({
+    "gflags",
+    "vulkan-loader",
+    "xenia-apu",
+    "xenia-apu-nop",
+    "xenia-base",
+    "xenia-core",
+    "xenia-cpu",
+    "xenia-cpu-backend-x64",
+    "xenia-gpu",
+    "xenia-gpu-null",
+    "xenia-hid-nop",
+    "xenia-kernel",
+    "xenia-ui",
+    "xenia-ui-spirv",
+    "xenia-ui-vulkan",
+    "xenia-vfs",
+  })
+  defines({
+  })
+  includedirs({
+    project_root.."/third_party/gflags/src",
+  })
+  files({
+    "null_trace_bench_main.cc",
+    "../../base/main_"..platform_suffix..".cc",
+  })
+
+  filter("platforms:Windows")
+    -- Only create the .user file if it doesn't already exist.
+    local user_file = project_root.."/build/xenia-gpu-trace-bench.vcxproj.user"
+    if not os.isfile(user_file) then
+      debugdir(project_root)
+      debugargs({
+        "--flagfile=scratch/flags.txt",
+        "2>&1",
+        "1>scratch/stdout-trace-bench.txt",
+      })
+    end
+
+group("src")
+project("xenia-gpu-wait-bench")
+  uuid("6e1b2c7d-93f4-4a51-8d0e-3b5f0c9a7e21")
+  kind("ConsoleApp")
+  language("C++")
+  links({
+    "gflags",
+    "vulkan-loader",
+    "xenia-apu",
+    "xenia-apu-nop",
+    "xenia-base",
+    "xenia-core",
+    "xenia-cpu",
+    "xenia-cpu-backend-x64",
+    "xenia-gpu",
+    "xenia-gpu-null",
+    "xenia-hid-nop",
+    "xenia-kernel",
+    "xenia-ui",
+    "xenia-ui-spirv",
+    "xenia-ui-vulkan",
+    "xenia-vfs",
+  })
+  defines({
+  })
+  includedirs({
+    project_root.."/third_party/gflags/src",
+  })
+  files({
+    "null_wait_bench_main.cc",
+    "../../base/main_"..platform_suffix..".cc",
+  })
+
+  filter("platforms:Windows")
+    -- Only create the .user file if it doesn't already exist.
+    local user_file = project_root.."/build/xenia-gpu-wait-bench.vcxproj.user"
+    if not os.isfile(user_file) then
+      debugdir(project_root)
+      debugargs({
+        "--flagfile=scratch/flags.txt",
+        "2>&1",
+        "1>scratch/stdout-wait-bench.txt",
+      })
+    end
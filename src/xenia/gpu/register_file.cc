@@ -16,7 +16,10 @@
 namespace xe {
 namespace gpu {
 
-RegisterFile::RegisterFile() { std::memset(values, 0, sizeof(values)); }
+RegisterFile::RegisterFile() {
+  std::memset(values, 0, sizeof(values));
+  MarkAllDirty();
+}
 
 const RegisterInfo* RegisterFile::GetRegisterInfo(uint32_t index) {
   switch (index) {
@@ -34,5 +37,61 @@ const RegisterInfo* RegisterFile::GetRegisterInfo(uint32_t index) {
   }
 }
 
+// Calls fn(word_index, mask) for each bitmap word overlapping the range.
+template <typename T>
+inline void ForEachDirtyWord(uint32_t first, uint32_t count, T fn) {
+  if (!count) {
+    return;
+  }
+  uint32_t last = first + count - 1;
+  uint32_t first_word = first >> 6;
+  uint32_t last_word = last >> 6;
+  for (uint32_t i = first_word; i <= last_word; ++i) {
+    uint64_t mask = ~0ull;
+    if (i == first_word) {
+      mask &= ~0ull << (first & 63);
+    }
+    if (i == last_word) {
+      mask &= ~0ull >> (63 - (last & 63));
+    }
+    if (!fn(i, mask)) {
+      return;
+    }
+  }
+}
+
+void RegisterFile::MarkRangeDirty(uint32_t first, uint32_t count) {
+  ForEachDirtyWord(first, count, [this](uint32_t i, uint64_t mask) {
+    dirty_bits[i].fetch_or(mask, std::memory_order_release);
+    return true;
+  });
+}
+
+void RegisterFile::MarkAllDirty() {
+  for (auto& word : dirty_bits) {
+    word.store(~0ull, std::memory_order_release);
+  }
+}
+
+bool RegisterFile::IsRangeDirty(uint32_t first, uint32_t count) const {
+  bool dirty = false;
+  ForEachDirtyWord(first, count, [&](uint32_t i, uint64_t mask) {
+    dirty = (dirty_bits[i].load(std::memory_order_relaxed) & mask) != 0;
+    return !dirty;
+  });
+  return dirty;
+}
+
+void RegisterFile::ClearRangeDirty(uint32_t first, uint32_t count) {
+  ForEachDirtyWord(first, count, [this](uint32_t i, uint64_t mask) {
+    if (mask == ~0ull) {
+      dirty_bits[i].exchange(0, std::memory_order_acquire);
+    } else {
+      dirty_bits[i].fetch_and(~mask, std::memory_order_acquire);
+    }
+    return true;
+  });
+}
+
 }  //  namespace gpu
 }  //  namespace xe
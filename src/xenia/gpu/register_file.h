@@ -10,6 +10,7 @@
 #ifndef XENIA_GPU_REGISTER_FILE_H_
 #define XENIA_GPU_REGISTER_FILE_H_
 
+#include <atomic>
 #include <cstdint>
 #include <cstdlib>
 
@@ -46,6 +47,25 @@ class RegisterFile {
 
   RegisterValue& operator[](int reg) { return values[reg]; }
   RegisterValue& operator[](Register reg) { return values[reg]; }
+
+  // One bit per register, set when the register is written. Consumers that
+  // own a register range (such as the constant uploader) check it to skip
+  // work when nothing changed, and clear their range before reading the
+  // values so that writes landing meanwhile stay dirty.
+  // Registers are written from both the CPU (MMIO) and the command processor
+  // thread, so the words are atomic; marking releases the value written
+  // before it, and clearing acquires it.
+  static const size_t kDirtyWordCount = (kRegisterCount + 63) / 64;
+  std::atomic<uint64_t> dirty_bits[kDirtyWordCount];
+
+  void MarkDirty(uint32_t index) {
+    dirty_bits[index >> 6].fetch_or(1ull << (index & 63),
+                                    std::memory_order_release);
+  }
+  void MarkRangeDirty(uint32_t first, uint32_t count);
+  void MarkAllDirty();
+  bool IsRangeDirty(uint32_t first, uint32_t count) const;
+  void ClearRangeDirty(uint32_t first, uint32_t count);
 };
 
 }  // namespace gpu
@@ -0,0 +1,212 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#include "xenia/gpu/trace_bench.h"
+
+#include <gflags/gflags.h>
+
+#include <algorithm>
+#include <cinttypes>
+
+#include "xenia/base/clock.h"
+#include "xenia/base/logging.h"
+#include "xenia/base/profiling.h"
+#include "xenia/base/string.h"
+#include "xenia/base/threading.h"
+#include "xenia/gpu/graphics_system.h"
+#include "xenia/gpu/packet_disassembler.h"
+#include "xenia/gpu/register_file.h"
+
+DEFINE_string(target_trace_file, "", "Specifies the trace file to load.");
+DEFINE_int32(trace_bench_iterations, 1,
+             "Number of times to replay the whole trace.");
+DEFINE_int32(trace_bench_top_registers, 16,
+             "Number of most-written registers to report.");
+
+namespace xe {
+namespace gpu {
+
+TraceBench::TraceBench() = default;
+
+TraceBench::~TraceBench() = default;
+
+int TraceBench::Main(const std::vector<std::wstring>& args) {
+  // Grab path from the flag or unnamed argument.
+  std::wstring path;
+  if (!FLAGS_target_trace_file.empty()) {
+    path = xe::to_wstring(FLAGS_target_trace_file);
+  } else if (args.size() >= 2) {
+    path = args[1];
+  }
+  if (path.empty()) {
+    XELOGE("No trace file specified");
+    return 1;
+  }
+
+  auto abs_path = xe::to_absolute_path(path);
+  XELOGI("Loading trace file %ls...", abs_path.c_str());
+
+  if (!Setup()) {
+    XELOGE("Unable to setup trace bench");
+    return 1;
+  }
+  if (!Load(abs_path)) {
+    XELOGE("Unable to load trace file; not found?");
+    return 1;
+  }
+
+  Run(std::max(1, FLAGS_trace_bench_iterations));
+
+  Profiler::Shutdown();
+  player_.reset();
+  emulator_.reset();
+  return 0;
+}
+
+bool TraceBench::Setup() {
+  // No window: the graphics system must be able to run headless.
+  emulator_ = std::make_unique<Emulator>(L"");
+  X_STATUS result = emulator_->Setup(
+      nullptr, nullptr, [this]() { return CreateGraphicsSystem(); }, nullptr);
+  if (XFAILED(result)) {
+    XELOGE("Failed to setup emulator: %.8X", result);
+    return false;
+  }
+  graphics_system_ = emulator_->graphics_system();
+
+  player_ = std::make_unique<TracePlayer>(nullptr, graphics_system_);
+  return true;
+}
+
+bool TraceBench::Load(const std::wstring& trace_file_path) {
+  if (!player_->Open(trace_file_path)) {
+    XELOGE("Could not load trace file");
+    return false;
+  }
+  return true;
+}
+
+void TraceBench::Run(int iterations) {
+  auto command_processor = graphics_system_->command_processor();
+
+  // Stats must only be touched from the command processor thread.
+  xe::threading::Fence setup_fence;
+  command_processor->CallInThread([&]() {
+    command_processor->ResetStats();
+    command_processor->set_stats_enabled(true);
+    setup_fence.Signal();
+  });
+  setup_fence.Wait();
+
+  uint64_t start_ticks = Clock::QueryHostTickCount();
+  for (int i = 0; i < iterations; ++i) {
+    player_->PlayAll(true);
+    player_->WaitOnPlayback();
+  }
+  uint64_t end_ticks = Clock::QueryHostTickCount();
+  double elapsed_seconds = double(end_ticks - start_ticks) /
+                           double(Clock::host_tick_frequency());
+
+  CommandProcessorStats stats;
+  xe::threading::Fence stats_fence;
+  command_processor->CallInThread([&]() {
+    command_processor->set_stats_enabled(false);
+    stats = command_processor->stats();
+    stats_fence.Signal();
+  });
+  stats_fence.Wait();
+
+  Report(stats, iterations, elapsed_seconds);
+}
+
+void TraceBench::Report(const CommandProcessorStats& stats, int iterations,
+                        double elapsed_seconds) {
+  const double tick_frequency = double(Clock::host_tick_frequency());
+  auto ticks_to_ms = [&](uint64_t ticks) {
+    return double(ticks) * 1000.0 / tick_frequency;
+  };
+  auto per_second = [&](uint64_t count) {
+    return elapsed_seconds > 0.0 ? double(count) / elapsed_seconds : 0.0;
+  };
+
+  uint64_t packet_count = 0;
+  for (size_t i = 0; i < xe::countof(stats.packet_counts); ++i) {
+    packet_count += stats.packet_counts[i];
+  }
+
+  XELOGI("Trace bench results:");
+  XELOGI("  Iterations: %d (%d frames each)", iterations,
+         player_->frame_count());
+  XELOGI("  Elapsed: %.3fms", elapsed_seconds * 1000.0);
+  XELOGI("  Packets: %" PRIu64 " (%.0f/s)", packet_count,
+         per_second(packet_count));
+  XELOGI("  Draws: %" PRIu64 " (%.0f/s)", stats.draw_count,
+         per_second(stats.draw_count));
+  XELOGI("  Swaps: %" PRIu64 " (%.0f/s)", stats.swap_count,
+         per_second(stats.swap_count));
+  XELOGI("  Register writes: %" PRIu64 " (%.0f/s)",
+         stats.register_write_count, per_second(stats.register_write_count));
+
+  XELOGI("Packet types:");
+  for (size_t i = 0; i < xe::countof(stats.packet_counts); ++i) {
+    if (!stats.packet_counts[i]) {
+      continue;
+    }
+    XELOGI("  PM4_TYPE%d: %" PRIu64 " packets, %.3fms", int(i),
+           stats.packet_counts[i], ticks_to_ms(stats.packet_ticks[i]));
+  }
+
+  // Type 3 opcodes sorted by inclusive time.
+  std::vector<uint32_t> opcodes;
+  for (uint32_t i = 0; i < xe::countof(stats.type3_counts); ++i) {
+    if (stats.type3_counts[i]) {
+      opcodes.push_back(i);
+    }
+  }
+  std::sort(opcodes.begin(), opcodes.end(), [&](uint32_t a, uint32_t b) {
+    return stats.type3_ticks[a] > stats.type3_ticks[b];
+  });
+  XELOGI("Type 3 opcodes (inclusive time):");
+  for (uint32_t opcode : opcodes) {
+    // Disassemble an empty packet of this opcode to get its name.
+    uint8_t scratch[1024] = {0};
+    xe::store_and_swap<uint32_t>(scratch, (0x3u << 30) | (opcode << 8));
+    PacketInfo packet_info;
+    PacketDisassembler::DisasmPacketType3(
+        scratch, xe::load_and_swap<uint32_t>(scratch), &packet_info);
+    uint64_t count = stats.type3_counts[opcode];
+    uint64_t ticks = stats.type3_ticks[opcode];
+    XELOGI("  %-26s (%.2X): %10" PRIu64 " packets, %10.3fms, %8.0fns avg",
+           packet_info.type_info->name, opcode, count, ticks_to_ms(ticks),
+           ticks_to_ms(ticks) * 1000000.0 / double(count));
+  }
+
+  // Most written registers.
+  std::vector<uint32_t> registers;
+  for (uint32_t i = 0; i < stats.register_write_counts.size(); ++i) {
+    if (stats.register_write_counts[i]) {
+      registers.push_back(i);
+    }
+  }
+  std::sort(registers.begin(), registers.end(), [&](uint32_t a, uint32_t b) {
+    return stats.register_write_counts[a] > stats.register_write_counts[b];
+  });
+  if (registers.size() > size_t(FLAGS_trace_bench_top_registers)) {
+    registers.resize(std::max(0, FLAGS_trace_bench_top_registers));
+  }
+  XELOGI("Most written registers:");
+  for (uint32_t index : registers) {
+    auto info = RegisterFile::GetRegisterInfo(index);
+    XELOGI("  %-32s (%.4X): %10" PRIu64, info ? info->name : "<unknown>",
+           index, stats.register_write_counts[index]);
+  }
+}
+
+}  //  namespace gpu
+}  //  namespace xe
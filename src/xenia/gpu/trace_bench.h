@@ -0,0 +1,55 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#ifndef XENIA_GPU_TRACE_BENCH_H_
+#define XENIA_GPU_TRACE_BENCH_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "xenia/emulator.h"
+#include "xenia/gpu/command_processor.h"
+#include "xenia/gpu/trace_player.h"
+
+namespace xe {
+namespace gpu {
+
+// Headless trace replay benchmark.
+// Plays a trace back through the command processor as fast as possible with no
+// window or presentation and reports packet/draw throughput, per-packet timing
+// and register write counts. Used to track the CPU-side cost of GPU emulation
+// on machines without a usable GPU.
+class TraceBench {
+ public:
+  virtual ~TraceBench();
+
+  int Main(const std::vector<std::wstring>& args);
+
+ protected:
+  TraceBench();
+
+  virtual std::unique_ptr<gpu::GraphicsSystem> CreateGraphicsSystem() = 0;
+
+  std::unique_ptr<Emulator> emulator_;
+  GraphicsSystem* graphics_system_ = nullptr;
+  std::unique_ptr<TracePlayer> player_;
+
+ private:
+  bool Setup();
+  bool Load(const std::wstring& trace_file_path);
+  void Run(int iterations);
+  void Report(const CommandProcessorStats& stats, int iterations,
+              double elapsed_seconds);
+};
+
+}  // namespace gpu
+}  // namespace xe
+
+#endif  // XENIA_GPU_TRACE_BENCH_H_
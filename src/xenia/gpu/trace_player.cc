@@ -79,6 +79,19 @@ void TracePlayer::SeekCommand(int target_command) {
   }
 }
 
+void TracePlayer::PlayAll(bool clear_caches) {
+  if (!frame_count()) {
+    playback_event_->Set();
+    return;
+  }
+  auto first_frame = frame(0);
+  auto last_frame = frame(frame_count() - 1);
+  assert_true(first_frame->start_ptr <= last_frame->end_ptr);
+  PlayTrace(first_frame->start_ptr,
+            last_frame->end_ptr - first_frame->start_ptr,
+            TracePlaybackMode::kUntilEnd, clear_caches);
+}
+
 void TracePlayer::WaitOnPlayback() {
   xe::threading::Wait(playback_event_.get(), true);
 }
@@ -183,6 +196,19 @@ void TracePlayer::PlayTraceOnThread(const uint8_t* trace_data,
         trace_ptr += cmd->encoded_length;
         break;
       }
+      case TraceCommandType::kMemoryBlock: {
+        // Only used when referenced by kMemoryReadBlock.
+        auto cmd = reinterpret_cast<const MemoryBlockCommand*>(trace_ptr);
+        trace_ptr += sizeof(*cmd) + cmd->encoded_length;
+        break;
+      }
+      case TraceCommandType::kMemoryReadBlock: {
+        auto cmd = reinterpret_cast<const MemoryReadBlockCommand*>(trace_ptr);
+        trace_ptr += sizeof(*cmd);
+        DecodeMemoryBlock(cmd->block_index,
+                          memory->TranslatePhysical(cmd->base_ptr));
+        break;
+      }
       case TraceCommandType::kEvent: {
         auto cmd = reinterpret_cast<const EventCommand*>(trace_ptr);
         trace_ptr += sizeof(*cmd);
@@ -46,6 +46,10 @@ class TracePlayer : public TraceReader {
   void SeekFrame(int target_frame);
   void SeekCommand(int target_command);
 
+  // Plays back every frame of the trace in order, ignoring swaps.
+  // Use WaitOnPlayback to wait for completion.
+  void PlayAll(bool clear_caches);
+
   void WaitOnPlayback();
 
  private:
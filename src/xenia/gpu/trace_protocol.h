@@ -20,7 +20,7 @@ namespace gpu {
 // Other changes besides the file format may require bumps, such as
 // anything that changes what is recorded into the files (new GPU
 // command processor commands, etc).
-constexpr uint32_t kTraceFormatVersion = 1;
+constexpr uint32_t kTraceFormatVersion = 2;
 
 // Trace file header identifying information about the trace.
 // This must be positioned at the start of the file and must only occur once.
@@ -49,6 +49,8 @@ enum class TraceCommandType : uint32_t {
   kMemoryRead,
   kMemoryWrite,
   kEvent,
+  kMemoryBlock,
+  kMemoryReadBlock,
 };
 
 struct PrimaryBufferStartCommand {
@@ -107,6 +109,39 @@ struct MemoryCommand {
   uint32_t decoded_length;
 };
 
+// Content-addressed block of memory data.
+// Identical memory reads (such as vertex and texture data re-read every frame)
+// are stored only once in the file, the first time they are seen, and are
+// then referenced by index with MemoryReadBlockCommand.
+// Used for TraceCommandType::kMemoryBlock.
+struct MemoryBlockCommand {
+  TraceCommandType type;
+
+  // Sequential index of the block in the file, starting at 0.
+  uint32_t block_index;
+  // Encoding format of the data in the trace file.
+  MemoryEncodingFormat encoding_format;
+  // Number of bytes the data occupies in the trace file in its encoded form.
+  uint32_t encoded_length;
+  // Number of bytes the data occupies in memory after decoding.
+  uint32_t decoded_length;
+  uint32_t reserved;
+  // XXH64 of the decoded data.
+  uint64_t hash;
+};
+
+// Represents the GPU reading data from memory that is stored in a
+// previously-written MemoryBlockCommand.
+// Used for TraceCommandType::kMemoryReadBlock.
+struct MemoryReadBlockCommand {
+  TraceCommandType type;
+
+  // Base physical memory pointer this read starts at.
+  uint32_t base_ptr;
+  // Index of the MemoryBlockCommand containing the data.
+  uint32_t block_index;
+};
+
 // Represents a GPU event of EventCommand::Type.
 struct EventCommand {
   TraceCommandType type;
@@ -118,6 +153,45 @@ struct EventCommand {
   Type event_type;
 };
 
+// Index of a frame in the trace file.
+// Frames start after a swap event and end with the first packet following the
+// next swap event.
+struct TraceIndexFrame {
+  // Offset of the first command in the frame from the start of the file.
+  uint64_t start_offset;
+  // Offset just past the last command in the frame.
+  uint64_t end_offset;
+  // Number of draw packets in the frame.
+  uint32_t draw_count;
+  uint32_t reserved;
+};
+
+// Index of a memory block in the trace file.
+struct TraceIndexBlock {
+  // Offset of the MemoryBlockCommand from the start of the file.
+  uint64_t offset;
+};
+
+// 'XTRI'
+constexpr uint32_t kTraceFooterMagic = 0x49525458;
+
+// Footer appended to the end of the file when a trace is closed cleanly.
+// Points at a table of TraceIndexFrame followed by a table of TraceIndexBlock
+// so that readers can map the file and seek to any frame without parsing the
+// entire command stream. Traces without a footer (such as those from a crashed
+// session) can still be read by parsing the full stream.
+struct TraceFooter {
+  // Offset of the index tables from the start of the file. The command stream
+  // ends here.
+  uint64_t index_offset;
+  uint32_t frame_count;
+  uint32_t block_count;
+  // Set to kTraceFormatVersion.
+  uint32_t version;
+  // Must be the last 4 bytes of the file. Set to kTraceFooterMagic.
+  uint32_t magic;
+};
+
 }  // namespace gpu
 }  // namespace xe
 
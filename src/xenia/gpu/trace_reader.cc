@@ -33,6 +33,7 @@ bool TraceReader::Open(const std::wstring& path) {
 
   trace_data_ = reinterpret_cast<const uint8_t*>(mmap_->data());
   trace_size_ = mmap_->size();
+  trace_end_ = trace_data_ + trace_size_;
 
   // Verify version.
   auto header = reinterpret_cast<const TraceHeader*>(trace_data_);
@@ -53,7 +54,14 @@ bool TraceReader::Open(const std::wstring& path) {
   XELOGI("    Commit: %s", commit_str.c_str());
   XELOGI("  Title ID: %u", header->title_id);
 
-  ParseTrace();
+  if (ReadIndex()) {
+    XELOGI("     Index: %d frames, %d memory blocks", frame_count(),
+           int(memory_blocks_.size()));
+  } else {
+    // No index (trace was not closed cleanly?) - fall back to parsing it all.
+    XELOGI("     Index: not present, parsing trace");
+    ParseTrace();
+  }
 
   return true;
 }
@@ -62,6 +70,80 @@ void TraceReader::Close() {
   mmap_.reset();
   trace_data_ = nullptr;
   trace_size_ = 0;
+  trace_end_ = nullptr;
+  frames_.clear();
+  memory_blocks_.clear();
+}
+
+const TraceReader::Frame* TraceReader::frame(int n) const {
+  std::lock_guard<std::mutex> lock(frame_parse_mutex_);
+  auto& frame = frames_[n];
+  if (!frame.parsed) {
+    ParseFrame(frame.start_ptr, frame.end_ptr, &frame, nullptr);
+    frame.parsed = true;
+  }
+  return &frame;
+}
+
+bool TraceReader::ReadIndex() {
+  if (trace_size_ < sizeof(TraceHeader) + sizeof(TraceFooter)) {
+    return false;
+  }
+  auto footer = reinterpret_cast<const TraceFooter*>(
+      trace_data_ + trace_size_ - sizeof(TraceFooter));
+  if (footer->magic != kTraceFooterMagic ||
+      footer->version != kTraceFormatVersion) {
+    return false;
+  }
+  uint64_t index_size =
+      uint64_t(footer->frame_count) * sizeof(TraceIndexFrame) +
+      uint64_t(footer->block_count) * sizeof(TraceIndexBlock);
+  if (footer->index_offset < sizeof(TraceHeader) ||
+      footer->index_offset + index_size + sizeof(TraceFooter) != trace_size_) {
+    XELOGW("Trace index is corrupt; ignoring");
+    return false;
+  }
+
+  const uint64_t stream_end = footer->index_offset;
+  auto index_frames = reinterpret_cast<const TraceIndexFrame*>(
+      trace_data_ + footer->index_offset);
+  auto index_blocks = reinterpret_cast<const TraceIndexBlock*>(
+      index_frames + footer->frame_count);
+
+  std::vector<Frame> frames(footer->frame_count);
+  for (uint32_t i = 0; i < footer->frame_count; ++i) {
+    const auto& index_frame = index_frames[i];
+    if (index_frame.start_offset < sizeof(TraceHeader) ||
+        index_frame.start_offset > index_frame.end_offset ||
+        index_frame.end_offset > stream_end) {
+      XELOGW("Trace index frame %u is corrupt; ignoring index", i);
+      return false;
+    }
+    frames[i].start_ptr = trace_data_ + index_frame.start_offset;
+    frames[i].end_ptr = trace_data_ + index_frame.end_offset;
+  }
+
+  std::vector<const MemoryBlockCommand*> memory_blocks(footer->block_count);
+  for (uint32_t i = 0; i < footer->block_count; ++i) {
+    uint64_t offset = index_blocks[i].offset;
+    auto cmd =
+        reinterpret_cast<const MemoryBlockCommand*>(trace_data_ + offset);
+    if (offset < sizeof(TraceHeader) ||
+        offset + sizeof(MemoryBlockCommand) > stream_end ||
+        cmd->type != TraceCommandType::kMemoryBlock ||
+        cmd->block_index != i ||
+        offset + sizeof(MemoryBlockCommand) + cmd->encoded_length >
+            stream_end) {
+      XELOGW("Trace index memory block %u is corrupt; ignoring index", i);
+      return false;
+    }
+    memory_blocks[i] = cmd;
+  }
+
+  trace_end_ = trace_data_ + stream_end;
+  frames_ = std::move(frames);
+  memory_blocks_ = std::move(memory_blocks);
+  return true;
 }
 
 void TraceReader::ParseTrace() {
@@ -69,18 +151,31 @@ void TraceReader::ParseTrace() {
   auto trace_ptr = trace_data_;
   trace_ptr += sizeof(TraceHeader);
 
-  Frame current_frame;
-  current_frame.start_ptr = trace_ptr;
+  while (trace_ptr < trace_end_) {
+    Frame frame;
+    frame.start_ptr = trace_ptr;
+    trace_ptr = ParseFrame(trace_ptr, trace_end_, &frame, &memory_blocks_);
+    frame.end_ptr = trace_ptr;
+    frame.parsed = true;
+    frames_.push_back(std::move(frame));
+  }
+}
+
+const uint8_t* TraceReader::ParseFrame(
+    const uint8_t* trace_ptr, const uint8_t* trace_end, Frame* current_frame,
+    std::vector<const MemoryBlockCommand*>* out_memory_blocks) const {
+  current_frame->commands.clear();
+  current_frame->command_count = 0;
   const PacketStartCommand* packet_start = nullptr;
   const uint8_t* packet_start_ptr = nullptr;
   const uint8_t* last_ptr = trace_ptr;
   bool pending_break = false;
   auto current_command_buffer = new CommandBuffer();
-  current_frame.command_tree =
+  current_frame->command_tree =
       std::unique_ptr<CommandBuffer>(current_command_buffer);
 
-  while (trace_ptr < trace_data_ + trace_size_) {
-    ++current_frame.command_count;
+  while (trace_ptr < trace_end) {
+    ++current_frame->command_count;
     auto type = static_cast<TraceCommandType>(xe::load<uint32_t>(trace_ptr));
     switch (type) {
       case TraceCommandType::kPrimaryBufferStart: {
@@ -145,10 +240,10 @@ void TraceReader::ParseTrace() {
             command.head_ptr = packet_start_ptr;
             command.start_ptr = last_ptr;
             command.end_ptr = trace_ptr;
-            current_frame.commands.push_back(std::move(command));
+            current_frame->commands.push_back(std::move(command));
             last_ptr = trace_ptr;
             current_command_buffer->commands.push_back(CommandBuffer::Command(
-                uint32_t(current_frame.commands.size() - 1)));
+                uint32_t(current_frame->commands.size() - 1)));
             break;
           }
           case PacketCategory::kSwap:
@@ -158,15 +253,7 @@ void TraceReader::ParseTrace() {
           }
         }
         if (pending_break) {
-          current_frame.end_ptr = trace_ptr;
-          frames_.push_back(std::move(current_frame));
-          current_command_buffer = new CommandBuffer();
-          current_frame.command_tree =
-              std::unique_ptr<CommandBuffer>(current_command_buffer);
-          current_frame.start_ptr = trace_ptr;
-          current_frame.end_ptr = nullptr;
-          current_frame.command_count = 0;
-          pending_break = false;
+          return trace_ptr;
         }
         break;
       }
@@ -180,6 +267,22 @@ void TraceReader::ParseTrace() {
         trace_ptr += sizeof(*cmd) + cmd->encoded_length;
         break;
       }
+      case TraceCommandType::kMemoryBlock: {
+        auto cmd = reinterpret_cast<const MemoryBlockCommand*>(trace_ptr);
+        if (out_memory_blocks) {
+          if (cmd->block_index >= out_memory_blocks->size()) {
+            out_memory_blocks->resize(cmd->block_index + 1);
+          }
+          (*out_memory_blocks)[cmd->block_index] = cmd;
+        }
+        trace_ptr += sizeof(*cmd) + cmd->encoded_length;
+        break;
+      }
+      case TraceCommandType::kMemoryReadBlock: {
+        auto cmd = reinterpret_cast<const MemoryReadBlockCommand*>(trace_ptr);
+        trace_ptr += sizeof(*cmd);
+        break;
+      }
       case TraceCommandType::kEvent: {
         auto cmd = reinterpret_cast<const EventCommand*>(trace_ptr);
         trace_ptr += sizeof(*cmd);
@@ -194,18 +297,27 @@ void TraceReader::ParseTrace() {
       default:
         // Broken trace file?
         assert_unhandled_case(type);
-        break;
+        return trace_end;
     }
   }
-  if (pending_break || current_frame.command_count) {
-    current_frame.end_ptr = trace_ptr;
-    frames_.push_back(std::move(current_frame));
+  return trace_ptr;
+}
+
+bool TraceReader::DecodeMemoryBlock(uint32_t block_index,
+                                    uint8_t* dest) const {
+  if (block_index >= memory_blocks_.size() || !memory_blocks_[block_index]) {
+    XELOGE("Trace references unknown memory block %u", block_index);
+    return false;
   }
+  auto cmd = memory_blocks_[block_index];
+  return DecompressMemory(cmd->encoding_format,
+                          reinterpret_cast<const uint8_t*>(cmd + 1),
+                          cmd->encoded_length, dest, cmd->decoded_length);
 }
 
 bool TraceReader::DecompressMemory(MemoryEncodingFormat encoding_format,
                                    const uint8_t* src, size_t src_size,
-                                   uint8_t* dest, size_t dest_size) {
+                                   uint8_t* dest, size_t dest_size) const {
   switch (encoding_format) {
     case MemoryEncodingFormat::kNone:
       assert_true(src_size == dest_size);
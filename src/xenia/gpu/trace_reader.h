@@ -10,6 +10,7 @@
 #ifndef XENIA_GPU_TRACE_READER_H_
 #define XENIA_GPU_TRACE_READER_H_
 
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -111,6 +112,9 @@ class TraceReader {
     const uint8_t* start_ptr = nullptr;
     const uint8_t* end_ptr = nullptr;
     int command_count = 0;
+    // False if only the bounds are known (from the file index) and the
+    // commands have not yet been parsed.
+    bool parsed = false;
 
     // Flat list of all commands in this frame.
     std::vector<Command> commands;
@@ -126,7 +130,10 @@ class TraceReader {
     return reinterpret_cast<const TraceHeader*>(trace_data_);
   }
 
-  const Frame* frame(int n) const { return &frames_[n]; }
+  // Frames are parsed on first access when the trace was opened from its
+  // index. Safe to call from multiple threads; the returned frame is not
+  // changed again until the trace is closed.
+  const Frame* frame(int n) const;
   int frame_count() const { return int(frames_.size()); }
 
   bool Open(const std::wstring& path);
@@ -134,15 +141,35 @@ class TraceReader {
   void Close();
 
  protected:
+  // Reads the footer index, if present and valid.
+  bool ReadIndex();
+  // Parses the entire command stream to find frames and memory blocks.
   void ParseTrace();
+  // Parses commands starting at trace_ptr into the given frame until the end
+  // of the frame or trace_end is reached. Returns the end of the frame.
+  // Memory blocks found are added to out_memory_blocks if given, which is only
+  // done while opening the trace, as lazily parsed frames run concurrently
+  // with decoding.
+  const uint8_t* ParseFrame(
+      const uint8_t* trace_ptr, const uint8_t* trace_end, Frame* frame,
+      std::vector<const MemoryBlockCommand*>* out_memory_blocks) const;
+
+  // Decodes the given memory block into dest.
+  bool DecodeMemoryBlock(uint32_t block_index, uint8_t* dest) const;
   bool DecompressMemory(MemoryEncodingFormat encoding_format,
                         const uint8_t* src, size_t src_size, uint8_t* dest,
-                        size_t dest_size);
+                        size_t dest_size) const;
 
   std::unique_ptr<MappedMemory> mmap_;
   const uint8_t* trace_data_ = nullptr;
   size_t trace_size_ = 0;
-  std::vector<Frame> frames_;
+  // End of the command stream (start of the index, if any).
+  const uint8_t* trace_end_ = nullptr;
+  mutable std::vector<Frame> frames_;
+  // Guards parsing frames on first access.
+  mutable std::mutex frame_parse_mutex_;
+  // MemoryBlockCommands, by block index. Complete once the trace is open.
+  std::vector<const MemoryBlockCommand*> memory_blocks_;
 };
 
 }  // namespace gpu
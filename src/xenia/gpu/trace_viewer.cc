@@ -373,6 +373,17 @@ void TraceViewer::DrawPacketDisassemblerUI() {
         // ImGui::BulletText("MemoryWrite");
         break;
       }
+      case TraceCommandType::kMemoryBlock: {
+        auto cmd = reinterpret_cast<const MemoryBlockCommand*>(trace_ptr);
+        trace_ptr += sizeof(*cmd) + cmd->encoded_length;
+        break;
+      }
+      case TraceCommandType::kMemoryReadBlock: {
+        auto cmd = reinterpret_cast<const MemoryReadBlockCommand*>(trace_ptr);
+        trace_ptr += sizeof(*cmd);
+        // ImGui::BulletText("MemoryRead");
+        break;
+      }
       case TraceCommandType::kEvent: {
         auto cmd = reinterpret_cast<const EventCommand*>(trace_ptr);
         trace_ptr += sizeof(*cmd);
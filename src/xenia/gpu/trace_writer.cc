@@ -11,13 +11,15 @@
 
 #include <cstring>
 
-#include "third_party/snappy/snappy-sinksource.h"
 #include "third_party/snappy/snappy.h"
+#include "third_party/xxhash/xxhash.h"
 
 #include "build/version.h"
 #include "xenia/base/assert.h"
 #include "xenia/base/logging.h"
+#include "xenia/base/memory.h"
 #include "xenia/base/string.h"
+#include "xenia/gpu/packet_disassembler.h"
 
 namespace xe {
 namespace gpu {
@@ -25,7 +27,7 @@ namespace gpu {
 TraceWriter::TraceWriter(uint8_t* membase)
     : membase_(membase), file_(nullptr) {}
 
-TraceWriter::~TraceWriter() = default;
+TraceWriter::~TraceWriter() { Close(); }
 
 bool TraceWriter::Open(const std::wstring& path, uint32_t title_id) {
   Close();
@@ -45,26 +47,104 @@ bool TraceWriter::Open(const std::wstring& path, uint32_t title_id) {
   std::memcpy(header.build_commit_sha, XE_BUILD_COMMIT,
               sizeof(header.build_commit_sha));
   header.title_id = title_id;
-  fwrite(&header, sizeof(header), 1, file_);
+  file_offset_ = 0;
+  WriteBytes(&header, sizeof(header));
 
   cached_memory_reads_.clear();
+  memory_blocks_.clear();
+  index_frames_.clear();
+  index_blocks_.clear();
+  current_frame_ = {0};
+  current_frame_.start_offset = file_offset_;
+  current_frame_empty_ = true;
+  pending_frame_end_ = false;
+  skip_next_packet_end_ = false;
+
+  // Setup the chunk pool. All chunks start out free.
+  if (chunks_.empty()) {
+    chunk_pending_event_ = xe::threading::Event::CreateAutoResetEvent(false);
+    chunk_free_event_ = xe::threading::Event::CreateAutoResetEvent(false);
+    for (size_t i = 0; i < kChunkCount; ++i) {
+      chunks_.push_back(std::make_unique<Chunk>());
+      chunks_.back()->reserve(kChunkSize);
+    }
+  }
+  for (auto& chunk : chunks_) {
+    chunk->clear();
+    if (chunk.get() != chunks_.front().get()) {
+      free_chunks_.Push(chunk.get());
+    }
+  }
+  current_chunk_ = chunks_.front().get();
+
+  writer_running_ = true;
+  xe::threading::Thread::CreationParameters params;
+  params.stack_size = 1 * 1024 * 1024;
+  writer_thread_ =
+      xe::threading::Thread::Create(params, [this]() { WriterThreadMain(); });
+  writer_thread_->set_name("GPU Trace Writer");
   return true;
 }
 
 void TraceWriter::Flush() {
-  if (file_) {
-    fflush(file_);
+  if (!file_) {
+    return;
+  }
+  if (!current_chunk_->empty()) {
+    SubmitChunk();
   }
 }
 
 void TraceWriter::Close() {
-  if (file_) {
-    cached_memory_reads_.clear();
+  if (!file_) {
+    return;
+  }
 
-    fflush(file_);
-    fclose(file_);
-    file_ = nullptr;
+  // Hand off whatever is left and wait for the writer thread to drain.
+  if (!current_chunk_->empty()) {
+    SubmitChunk();
   }
+  writer_running_ = false;
+  chunk_pending_event_->Set();
+  xe::threading::Wait(writer_thread_.get(), false);
+  writer_thread_.reset();
+
+  // Return all chunks to the pool for the next trace.
+  while (free_chunks_.Pop()) {
+  }
+  current_chunk_ = nullptr;
+  cached_memory_reads_.clear();
+
+  if (!current_frame_empty_) {
+    EndFrame();
+  }
+  WriteIndex();
+  memory_blocks_.clear();
+  index_frames_.clear();
+  index_blocks_.clear();
+
+  fflush(file_);
+  fclose(file_);
+  file_ = nullptr;
+}
+
+void TraceWriter::Append(const void* data, size_t length) {
+  current_chunk_->insert(current_chunk_->end(),
+                         reinterpret_cast<const uint8_t*>(data),
+                         reinterpret_cast<const uint8_t*>(data) + length);
+}
+
+void TraceWriter::SubmitChunk() {
+  pending_chunks_.Push(current_chunk_);
+  chunk_pending_event_->Set();
+
+  // Grab a new chunk, waiting for the writer thread if it has them all.
+  Chunk* chunk = nullptr;
+  while (!(chunk = free_chunks_.Pop())) {
+    xe::threading::Wait(chunk_free_event_.get(), false);
+  }
+  chunk->clear();
+  current_chunk_ = chunk;
 }
 
 void TraceWriter::WritePrimaryBufferStart(uint32_t base_ptr, uint32_t count) {
@@ -74,7 +154,7 @@ void TraceWriter::WritePrimaryBufferStart(uint32_t base_ptr, uint32_t count) {
   PrimaryBufferStartCommand cmd = {
       TraceCommandType::kPrimaryBufferStart, base_ptr, 0,
   };
-  fwrite(&cmd, 1, sizeof(cmd), file_);
+  Append(&cmd, sizeof(cmd));
 }
 
 void TraceWriter::WritePrimaryBufferEnd() {
@@ -84,7 +164,7 @@ void TraceWriter::WritePrimaryBufferEnd() {
   PrimaryBufferEndCommand cmd = {
       TraceCommandType::kPrimaryBufferEnd,
   };
-  fwrite(&cmd, 1, sizeof(cmd), file_);
+  Append(&cmd, sizeof(cmd));
 }
 
 void TraceWriter::WriteIndirectBufferStart(uint32_t base_ptr, uint32_t count) {
@@ -94,7 +174,7 @@ void TraceWriter::WriteIndirectBufferStart(uint32_t base_ptr, uint32_t count) {
   IndirectBufferStartCommand cmd = {
       TraceCommandType::kIndirectBufferStart, base_ptr, 0,
   };
-  fwrite(&cmd, 1, sizeof(cmd), file_);
+  Append(&cmd, sizeof(cmd));
 }
 
 void TraceWriter::WriteIndirectBufferEnd() {
@@ -104,7 +184,7 @@ void TraceWriter::WriteIndirectBufferEnd() {
   IndirectBufferEndCommand cmd = {
       TraceCommandType::kIndirectBufferEnd,
   };
-  fwrite(&cmd, 1, sizeof(cmd), file_);
+  Append(&cmd, sizeof(cmd));
 }
 
 void TraceWriter::WritePacketStart(uint32_t base_ptr, uint32_t count) {
@@ -114,8 +194,8 @@ void TraceWriter::WritePacketStart(uint32_t base_ptr, uint32_t count) {
   PacketStartCommand cmd = {
       TraceCommandType::kPacketStart, base_ptr, count,
   };
-  fwrite(&cmd, 1, sizeof(cmd), file_);
-  fwrite(membase_ + base_ptr, 4, count, file_);
+  Append(&cmd, sizeof(cmd));
+  Append(membase_ + base_ptr, count * 4);
 }
 
 void TraceWriter::WritePacketEnd() {
@@ -125,14 +205,17 @@ void TraceWriter::WritePacketEnd() {
   PacketEndCommand cmd = {
       TraceCommandType::kPacketEnd,
   };
-  fwrite(&cmd, 1, sizeof(cmd), file_);
+  Append(&cmd, sizeof(cmd));
+  if (current_chunk_->size() >= kChunkSize) {
+    SubmitChunk();
+  }
 }
 
 void TraceWriter::WriteMemoryRead(uint32_t base_ptr, size_t length) {
   if (!file_) {
     return;
   }
-  WriteMemoryCommand(TraceCommandType::kMemoryRead, base_ptr, length);
+  AppendMemoryCommand(TraceCommandType::kMemoryRead, base_ptr, length);
 }
 
 void TraceWriter::WriteMemoryReadCached(uint32_t base_ptr, size_t length) {
@@ -143,7 +226,7 @@ void TraceWriter::WriteMemoryReadCached(uint32_t base_ptr, size_t length) {
   // HACK: length is guaranteed to be within 32-bits (guest memory)
   uint64_t key = uint64_t(base_ptr) << 32 | uint64_t(length);
   if (cached_memory_reads_.find(key) == cached_memory_reads_.end()) {
-    WriteMemoryCommand(TraceCommandType::kMemoryRead, base_ptr, length);
+    AppendMemoryCommand(TraceCommandType::kMemoryRead, base_ptr, length);
     cached_memory_reads_.insert(key);
   }
 }
@@ -164,55 +247,19 @@ void TraceWriter::WriteMemoryWrite(uint32_t base_ptr, size_t length) {
   if (!file_) {
     return;
   }
-  WriteMemoryCommand(TraceCommandType::kMemoryWrite, base_ptr, length);
+  AppendMemoryCommand(TraceCommandType::kMemoryWrite, base_ptr, length);
 }
 
-class SnappySink : public snappy::Sink {
- public:
-  SnappySink(FILE* file) : file_(file) {}
-
-  void Append(const char* bytes, size_t n) override {
-    fwrite(bytes, 1, n, file_);
-  }
-
- private:
-  FILE* file_ = nullptr;
-};
-
-void TraceWriter::WriteMemoryCommand(TraceCommandType type, uint32_t base_ptr,
-                                     size_t length) {
+void TraceWriter::AppendMemoryCommand(TraceCommandType type, uint32_t base_ptr,
+                                      size_t length) {
+  // Captured raw - the writer thread decides how to encode it.
   MemoryCommand cmd;
   cmd.type = type;
   cmd.base_ptr = base_ptr;
   cmd.encoding_format = MemoryEncodingFormat::kNone;
   cmd.encoded_length = cmd.decoded_length = static_cast<uint32_t>(length);
-
-  bool compress = compress_output_ && length > compression_threshold_;
-  if (compress) {
-    // Write the header now so we reserve space in the buffer.
-    long header_position = std::ftell(file_);
-    cmd.encoding_format = MemoryEncodingFormat::kSnappy;
-    fwrite(&cmd, 1, sizeof(cmd), file_);
-
-    // Stream the content right to the buffer.
-    snappy::ByteArraySource snappy_source(
-        reinterpret_cast<const char*>(membase_ + cmd.base_ptr),
-        cmd.decoded_length);
-    SnappySink snappy_sink(file_);
-    cmd.encoded_length =
-        static_cast<uint32_t>(snappy::Compress(&snappy_source, &snappy_sink));
-
-    // Seek back and overwrite the header with our final size.
-    std::fseek(file_, header_position, SEEK_SET);
-    fwrite(&cmd, 1, sizeof(cmd), file_);
-    std::fseek(file_, header_position + sizeof(cmd) + cmd.encoded_length,
-               SEEK_SET);
-  } else {
-    // Uncompressed - write buffer directly to the file.
-    cmd.encoding_format = MemoryEncodingFormat::kNone;
-    fwrite(&cmd, 1, sizeof(cmd), file_);
-    fwrite(membase_ + cmd.base_ptr, 1, cmd.decoded_length, file_);
-  }
+  Append(&cmd, sizeof(cmd));
+  Append(membase_ + base_ptr, length);
 }
 
 void TraceWriter::WriteEvent(EventCommand::Type event_type) {
@@ -222,7 +269,227 @@ void TraceWriter::WriteEvent(EventCommand::Type event_type) {
   EventCommand cmd = {
       TraceCommandType::kEvent, event_type,
   };
-  fwrite(&cmd, 1, sizeof(cmd), file_);
+  Append(&cmd, sizeof(cmd));
+}
+
+void TraceWriter::WriterThreadMain() {
+  while (true) {
+    Chunk* chunk = pending_chunks_.Pop();
+    if (!chunk) {
+      if (!writer_running_) {
+        // Check again, as a chunk may have been pushed before we stopped.
+        chunk = pending_chunks_.Pop();
+        if (!chunk) {
+          break;
+        }
+      } else {
+        // Idle - get what we have to disk while we wait.
+        fflush(file_);
+        xe::threading::Wait(chunk_pending_event_.get(), false);
+        continue;
+      }
+    }
+    ProcessChunk(*chunk);
+    free_chunks_.Push(chunk);
+    chunk_free_event_->Set();
+  }
+}
+
+void TraceWriter::ProcessChunk(const Chunk& chunk) {
+  const uint8_t* ptr = chunk.data();
+  const uint8_t* end = ptr + chunk.size();
+  while (ptr < end) {
+    auto type = static_cast<TraceCommandType>(xe::load<uint32_t>(ptr));
+    switch (type) {
+      case TraceCommandType::kPrimaryBufferStart: {
+        auto cmd = reinterpret_cast<const PrimaryBufferStartCommand*>(ptr);
+        size_t length = sizeof(*cmd) + cmd->count * 4;
+        WriteBytes(ptr, length);
+        ptr += length;
+        break;
+      }
+      case TraceCommandType::kPrimaryBufferEnd: {
+        WriteBytes(ptr, sizeof(PrimaryBufferEndCommand));
+        ptr += sizeof(PrimaryBufferEndCommand);
+        break;
+      }
+      case TraceCommandType::kIndirectBufferStart: {
+        auto cmd = reinterpret_cast<const IndirectBufferStartCommand*>(ptr);
+        size_t length = sizeof(*cmd) + cmd->count * 4;
+        WriteBytes(ptr, length);
+        ptr += length;
+        break;
+      }
+      case TraceCommandType::kIndirectBufferEnd: {
+        WriteBytes(ptr, sizeof(IndirectBufferEndCommand));
+        ptr += sizeof(IndirectBufferEndCommand);
+        // The packet end wrapping the indirect buffer packet never ends a
+        // frame.
+        skip_next_packet_end_ = true;
+        break;
+      }
+      case TraceCommandType::kPacketStart: {
+        auto cmd = reinterpret_cast<const PacketStartCommand*>(ptr);
+        size_t length = sizeof(*cmd) + cmd->count * 4;
+        WriteBytes(ptr, length);
+        if (cmd->count && PacketDisassembler::GetPacketCategory(
+                              ptr + sizeof(*cmd)) == PacketCategory::kDraw) {
+          ++current_frame_.draw_count;
+        }
+        ptr += length;
+        break;
+      }
+      case TraceCommandType::kPacketEnd: {
+        WriteBytes(ptr, sizeof(PacketEndCommand));
+        ptr += sizeof(PacketEndCommand);
+        // Frames end on the first packet following a swap.
+        if (skip_next_packet_end_) {
+          skip_next_packet_end_ = false;
+        } else if (pending_frame_end_) {
+          pending_frame_end_ = false;
+          EndFrame();
+        }
+        break;
+      }
+      case TraceCommandType::kMemoryRead:
+      case TraceCommandType::kMemoryWrite: {
+        auto cmd = reinterpret_cast<const MemoryCommand*>(ptr);
+        WriteMemoryCommand(type, cmd->base_ptr, ptr + sizeof(*cmd),
+                           cmd->decoded_length);
+        ptr += sizeof(*cmd) + cmd->decoded_length;
+        break;
+      }
+      case TraceCommandType::kEvent: {
+        auto cmd = reinterpret_cast<const EventCommand*>(ptr);
+        WriteBytes(ptr, sizeof(*cmd));
+        if (cmd->event_type == EventCommand::Type::kSwap) {
+          pending_frame_end_ = true;
+        }
+        ptr += sizeof(*cmd);
+        break;
+      }
+      default:
+        // Block commands are only generated here.
+        assert_unhandled_case(type);
+        return;
+    }
+  }
+}
+
+void TraceWriter::WriteBytes(const void* data, size_t length) {
+  fwrite(data, 1, length, file_);
+  file_offset_ += length;
+  current_frame_empty_ = false;
+}
+
+void TraceWriter::EndFrame() {
+  current_frame_.end_offset = file_offset_;
+  index_frames_.push_back(current_frame_);
+  current_frame_ = {0};
+  current_frame_.start_offset = file_offset_;
+  current_frame_empty_ = true;
+}
+
+void TraceWriter::WriteIndex() {
+  TraceFooter footer;
+  footer.index_offset = file_offset_;
+  footer.frame_count = static_cast<uint32_t>(index_frames_.size());
+  footer.block_count = static_cast<uint32_t>(index_blocks_.size());
+  footer.version = kTraceFormatVersion;
+  footer.magic = kTraceFooterMagic;
+  if (!index_frames_.empty()) {
+    WriteBytes(index_frames_.data(),
+               index_frames_.size() * sizeof(TraceIndexFrame));
+  }
+  if (!index_blocks_.empty()) {
+    WriteBytes(index_blocks_.data(),
+               index_blocks_.size() * sizeof(TraceIndexBlock));
+  }
+  WriteBytes(&footer, sizeof(footer));
+}
+
+MemoryEncodingFormat TraceWriter::EncodeMemory(const uint8_t* data,
+                                              size_t length,
+                                              const uint8_t** out_data,
+                                              size_t* out_length) {
+  *out_data = data;
+  *out_length = length;
+  if (!compress_output_ || length <= compression_threshold_) {
+    return MemoryEncodingFormat::kNone;
+  }
+
+  compression_buffer_.resize(snappy::MaxCompressedLength(length));
+  size_t compressed_length = 0;
+  snappy::RawCompress(reinterpret_cast<const char*>(data), length,
+                      reinterpret_cast<char*>(compression_buffer_.data()),
+                      &compressed_length);
+  if (compressed_length >= length) {
+    // Incompressible; not worth decoding.
+    return MemoryEncodingFormat::kNone;
+  }
+  *out_data = compression_buffer_.data();
+  *out_length = compressed_length;
+  return MemoryEncodingFormat::kSnappy;
+}
+
+void TraceWriter::WriteMemoryCommand(TraceCommandType type, uint32_t base_ptr,
+                                     const uint8_t* data, size_t length) {
+  if (type == TraceCommandType::kMemoryRead && length >= block_threshold_) {
+    WriteMemoryReadBlock(base_ptr, data, length);
+    return;
+  }
+
+  const uint8_t* encoded_data = nullptr;
+  size_t encoded_length = 0;
+  MemoryCommand cmd;
+  cmd.type = type;
+  cmd.base_ptr = base_ptr;
+  cmd.encoding_format =
+      EncodeMemory(data, length, &encoded_data, &encoded_length);
+  cmd.encoded_length = static_cast<uint32_t>(encoded_length);
+  cmd.decoded_length = static_cast<uint32_t>(length);
+  WriteBytes(&cmd, sizeof(cmd));
+  WriteBytes(encoded_data, encoded_length);
+}
+
+void TraceWriter::WriteMemoryReadBlock(uint32_t base_ptr, const uint8_t* data,
+                                       size_t length) {
+  // Blocks are only reused when the length and two differently seeded hashes
+  // all match, which for different data is too unlikely to matter.
+  MemoryBlockKey key;
+  key.length = length;
+  key.hash = XXH64(data, length, length);
+  key.check_hash = XXH64(data, length, ~uint64_t(length));
+
+  uint32_t block_index;
+  auto it = memory_blocks_.find(key);
+  if (it != memory_blocks_.end()) {
+    block_index = it->second;
+  } else {
+    // First time we've seen this data - write the block itself.
+    block_index = static_cast<uint32_t>(index_blocks_.size());
+    memory_blocks_.emplace(key, block_index);
+    index_blocks_.push_back({file_offset_});
+
+    const uint8_t* encoded_data = nullptr;
+    size_t encoded_length = 0;
+    MemoryBlockCommand block_cmd;
+    block_cmd.type = TraceCommandType::kMemoryBlock;
+    block_cmd.block_index = block_index;
+    block_cmd.encoding_format =
+        EncodeMemory(data, length, &encoded_data, &encoded_length);
+    block_cmd.encoded_length = static_cast<uint32_t>(encoded_length);
+    block_cmd.decoded_length = static_cast<uint32_t>(length);
+    block_cmd.reserved = 0;
+    block_cmd.hash = key.hash;
+    WriteBytes(&block_cmd, sizeof(block_cmd));
+    WriteBytes(encoded_data, encoded_length);
+  }
+
+  MemoryReadBlockCommand cmd = {
+      TraceCommandType::kMemoryReadBlock, base_ptr, block_index,
+  };
+  WriteBytes(&cmd, sizeof(cmd));
 }
 
 }  //  namespace gpu
@@ -10,15 +10,25 @@
 #ifndef XENIA_GPU_TRACE_WRITER_H_
 #define XENIA_GPU_TRACE_WRITER_H_
 
+#include <atomic>
+#include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "xenia/base/filesystem.h"
+#include "xenia/base/threading.h"
 #include "xenia/gpu/trace_protocol.h"
 
 namespace xe {
 namespace gpu {
 
+// Writes GPU traces.
+// Commands and the memory they reference are captured on the calling (command
+// processor) thread into fixed-size chunks, which are handed off to a
+// background thread that deduplicates, compresses and writes them to disk.
+// Chunks are recycled so that steady-state tracing does not allocate.
 class TraceWriter {
  public:
   explicit TraceWriter(uint8_t* membase);
@@ -27,7 +37,10 @@ class TraceWriter {
   bool is_open() const { return file_ != nullptr; }
 
   bool Open(const std::wstring& path, uint32_t title_id);
+  // Hands off all captured commands to the writer thread. Does not wait for
+  // them to reach disk.
   void Flush();
+  // Waits for all captured commands to be written and closes the file.
   void Close();
 
   void WritePrimaryBufferStart(uint32_t base_ptr, uint32_t count);
@@ -43,15 +56,109 @@ class TraceWriter {
   void WriteEvent(EventCommand::Type event_type);
 
  private:
+  // Chunks are filled until they reach this size, though a single command
+  // (such as a large memory read) may grow one past it.
+  static const size_t kChunkSize = 1 * 1024 * 1024;
+  // Maximum number of chunks in flight. The capturing thread will block if
+  // the writer thread falls this far behind.
+  static const size_t kChunkCount = 32;
+
+  typedef std::vector<uint8_t> Chunk;
+
+  // Single-producer single-consumer bounded queue of chunks.
+  class ChunkQueue {
+   public:
+    // Never fails, as there are never more than kChunkCount chunks.
+    void Push(Chunk* chunk) {
+      size_t tail = tail_.load(std::memory_order_relaxed);
+      slots_[tail % kCapacity] = chunk;
+      tail_.store(tail + 1, std::memory_order_release);
+    }
+    Chunk* Pop() {
+      size_t head = head_.load(std::memory_order_relaxed);
+      if (head == tail_.load(std::memory_order_acquire)) {
+        return nullptr;
+      }
+      Chunk* chunk = slots_[head % kCapacity];
+      head_.store(head + 1, std::memory_order_release);
+      return chunk;
+    }
+
+   private:
+    static const size_t kCapacity = kChunkCount;
+    Chunk* slots_[kCapacity] = {nullptr};
+    std::atomic<size_t> head_ = {0};
+    std::atomic<size_t> tail_ = {0};
+  };
+
+  // Capturing thread.
+  void Append(const void* data, size_t length);
+  void AppendMemoryCommand(TraceCommandType type, uint32_t base_ptr,
+                           size_t length);
+  void SubmitChunk();
+
+  // Writer thread.
+  void WriterThreadMain();
+  void ProcessChunk(const Chunk& chunk);
+  void WriteBytes(const void* data, size_t length);
   void WriteMemoryCommand(TraceCommandType type, uint32_t base_ptr,
-                          size_t length);
+                          const uint8_t* data, size_t length);
+  void WriteMemoryReadBlock(uint32_t base_ptr, const uint8_t* data,
+                            size_t length);
+  // Encodes the given data into compression_buffer_ if worthwhile.
+  // Returns the encoding format used and the encoded data.
+  MemoryEncodingFormat EncodeMemory(const uint8_t* data, size_t length,
+                                    const uint8_t** out_data,
+                                    size_t* out_length);
+  void EndFrame();
+  void WriteIndex();
 
   std::set<uint64_t> cached_memory_reads_;
   uint8_t* membase_;
   FILE* file_;
 
+  std::vector<std::unique_ptr<Chunk>> chunks_;
+  Chunk* current_chunk_ = nullptr;
+  ChunkQueue pending_chunks_;
+  ChunkQueue free_chunks_;
+  std::unique_ptr<xe::threading::Event> chunk_pending_event_;
+  std::unique_ptr<xe::threading::Event> chunk_free_event_;
+  std::unique_ptr<xe::threading::Thread> writer_thread_;
+  std::atomic<bool> writer_running_ = {false};
+
+  // State below is only touched by the writer thread while it is running.
+  uint64_t file_offset_ = 0;
+
   bool compress_output_ = true;
   size_t compression_threshold_ = 1024;  // Min. number of bytes to compress.
+  size_t block_threshold_ = 64;  // Min. number of bytes to store as a block.
+  std::vector<uint8_t> compression_buffer_;
+
+  // Memory blocks written so far, by length and data hashes.
+  struct MemoryBlockKey {
+    size_t length;
+    uint64_t hash;
+    uint64_t check_hash;
+    bool operator==(const MemoryBlockKey& other) const {
+      return length == other.length && hash == other.hash &&
+             check_hash == other.check_hash;
+    }
+  };
+  struct MemoryBlockKeyHasher {
+    size_t operator()(const MemoryBlockKey& key) const {
+      return size_t(key.hash);
+    }
+  };
+  std::unordered_map<MemoryBlockKey, uint32_t, MemoryBlockKeyHasher>
+      memory_blocks_;
+
+  // Index written to the file footer on close.
+  std::vector<TraceIndexFrame> index_frames_;
+  std::vector<TraceIndexBlock> index_blocks_;
+  TraceIndexFrame current_frame_ = {0};
+  bool current_frame_empty_ = true;
+  bool pending_frame_end_ = false;
+  bool skip_next_packet_end_ = false;
 };
 
 }  // namespace gpu
@@ -158,12 +158,33 @@ std::pair<VkDeviceSize, VkDeviceSize> BufferCache::UploadConstantRegisters(
   //   uint bool[8];
   //   uint loop[32];
   // };
+  // Bool and loop constants are adjacent so they're checked as one range.
+  const uint32_t kFloatConstantCount = 512 * 4;
+  const uint32_t kBoolLoopConstantCount = 8 + 32;
+  bool dirty = register_file_->IsRangeDirty(XE_GPU_REG_SHADER_CONSTANT_000_X,
+                                            kFloatConstantCount) ||
+               register_file_->IsRangeDirty(
+                   XE_GPU_REG_SHADER_CONSTANT_BOOL_000_031,
+                   kBoolLoopConstantCount);
+  if (!dirty && constant_upload_offset_ != VK_WHOLE_SIZE &&
+      constant_upload_fence_ == fence) {
+    // Nothing changed since the last draw - its upload is still live.
+    return {constant_upload_offset_, constant_upload_offset_};
+  }
+
   auto offset = AllocateTransientData(kConstantRegisterUniformRange, fence);
   if (offset == VK_WHOLE_SIZE) {
     // OOM.
     return {VK_WHOLE_SIZE, VK_WHOLE_SIZE};
   }
 
+  // Cleared before copying, so that anything written meanwhile is uploaded
+  // again next time.
+  register_file_->ClearRangeDirty(XE_GPU_REG_SHADER_CONSTANT_000_X,
+                                  kFloatConstantCount);
+  register_file_->ClearRangeDirty(XE_GPU_REG_SHADER_CONSTANT_BOOL_000_031,
+                                  kBoolLoopConstantCount);
+
   // Copy over all the registers.
   const auto& values = register_file_->values;
   uint8_t* dest_ptr = transient_buffer_->host_base() + offset;
@@ -195,6 +216,8 @@ std::pair<VkDeviceSize, VkDeviceSize> BufferCache::UploadConstantRegisters(
                        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 1,
                        &barrier, 0, nullptr);
 
+  constant_upload_offset_ = offset;
+  constant_upload_fence_ = fence;
   return {offset, offset};
 
 // Packed upload code.
@@ -363,6 +386,7 @@ VkDeviceSize BufferCache::AllocateTransientData(VkDeviceSize length,
   // Ran out of easy allocations.
   // Try consuming fences before we panic.
   transient_buffer_->Scavenge();
+  constant_upload_offset_ = VK_WHOLE_SIZE;
 
   // Try again. It may still fail if we didn't get enough space back.
   offset = TryAllocateTransientData(length, fence);
@@ -419,11 +443,19 @@ void BufferCache::Flush(VkCommandBuffer command_buffer) {
   vkFlushMappedMemoryRanges(device_, 1, &dirty_range);
 }
 
-void BufferCache::InvalidateCache() { transient_cache_.clear(); }
-void BufferCache::ClearCache() { transient_cache_.clear(); }
+void BufferCache::InvalidateCache() {
+  transient_cache_.clear();
+  constant_upload_offset_ = VK_WHOLE_SIZE;
+}
+
+void BufferCache::ClearCache() {
+  transient_cache_.clear();
+  constant_upload_offset_ = VK_WHOLE_SIZE;
+}
 
 void BufferCache::Scavenge() {
   transient_cache_.clear();
+  constant_upload_offset_ = VK_WHOLE_SIZE;
   transient_buffer_->Scavenge();
 }
 
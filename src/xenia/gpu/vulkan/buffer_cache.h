@@ -51,7 +51,8 @@ class BufferCache {
   // The registers are tightly packed in order as [floats, ints, bools].
   // Returns an offset that can be used with the transient_descriptor_set or
   // VK_WHOLE_SIZE if the constants could not be uploaded (OOM).
-  // The returned offsets may alias.
+  // The returned offsets may alias. If no constant registers have been written
+  // since the last upload in the same batch that upload is reused.
   std::pair<VkDeviceSize, VkDeviceSize> UploadConstantRegisters(
       VkCommandBuffer command_buffer,
       const Shader::ConstantRegisterMap& vertex_constant_register_map,
@@ -118,6 +119,10 @@ class BufferCache {
   std::unique_ptr<ui::vulkan::CircularBuffer> transient_buffer_ = nullptr;
   std::map<uint64_t, VkDeviceSize> transient_cache_;
 
+  // Last constant register upload and the batch it was made in.
+  VkDeviceSize constant_upload_offset_ = VK_WHOLE_SIZE;
+  VkFence constant_upload_fence_ = nullptr;
+
   VkDescriptorPool descriptor_pool_ = nullptr;
   VkDescriptorSetLayout descriptor_set_layout_ = nullptr;
   VkDescriptorSet transient_descriptor_set_ = nullptr;
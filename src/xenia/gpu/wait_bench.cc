@@ -0,0 +1,183 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#include "xenia/gpu/wait_bench.h"
+
+#include <gflags/gflags.h>
+
+#include <algorithm>
+
+#include "xenia/base/clock.h"
+#include "xenia/base/logging.h"
+#include "xenia/base/memory.h"
+#include "xenia/base/profiling.h"
+#include "xenia/base/threading.h"
+#include "xenia/gpu/register_file.h"
+#include "xenia/gpu/xenos.h"
+
+DEFINE_int32(wait_bench_iterations, 1000,
+             "Number of waits to measure for each wait type.");
+DEFINE_int32(wait_bench_delay_us, 1000,
+             "Time to give the command processor to park before each wake.");
+
+namespace xe {
+namespace gpu {
+
+using namespace xe::gpu::xenos;
+
+// Ring buffer size, as log2 of the size in bytes.
+const uint32_t kRingBufferSizeLog2 = 16;
+
+// GPU registers are mapped here for the CPU.
+const uint32_t kRegisterMmioBase = 0x7FC80000;
+const uint32_t kRegisterCpRbWptr = 0x01C5;
+
+WaitBench::WaitBench() = default;
+
+WaitBench::~WaitBench() = default;
+
+int WaitBench::Main(const std::vector<std::wstring>& args) {
+  if (!Setup()) {
+    XELOGE("Unable to setup wait bench");
+    return 1;
+  }
+
+  int iterations = std::max(1, FLAGS_wait_bench_iterations);
+  Run("Memory", true, iterations);
+  Run("Register", false, iterations);
+
+  Profiler::Shutdown();
+  emulator_.reset();
+  return 0;
+}
+
+bool WaitBench::Setup() {
+  // No window: the graphics system must be able to run headless.
+  emulator_ = std::make_unique<Emulator>(L"");
+  X_STATUS result = emulator_->Setup(
+      nullptr, nullptr, [this]() { return CreateGraphicsSystem(); }, nullptr);
+  if (XFAILED(result)) {
+    XELOGE("Failed to setup emulator: %.8X", result);
+    return false;
+  }
+  graphics_system_ = emulator_->graphics_system();
+  auto memory = emulator_->memory();
+
+  ring_buffer_ptr_ = memory->SystemHeapAlloc(
+      1 << kRingBufferSizeLog2, 4096, kSystemHeapPhysical);
+  ring_buffer_dword_count_ = (1 << kRingBufferSizeLog2) / 4;
+  // Kept on its own page so the access watch doesn't cover the ring buffer.
+  data_ptr_ = memory->SystemHeapAlloc(4096, 4096, kSystemHeapPhysical);
+  if (!ring_buffer_ptr_ || !data_ptr_) {
+    XELOGE("Unable to allocate wait bench memory");
+    return false;
+  }
+  // Size is encoded as the guest passes it to VdInitializeRingBuffer; the
+  // command processor uses 2^((log2_size | 2) + 1) bytes.
+  graphics_system_->InitializeRingBuffer(CpuToGpu(ring_buffer_ptr_),
+                                         kRingBufferSizeLog2 - 1);
+  write_index_ = 0;
+  return true;
+}
+
+void WaitBench::Run(const char* name, bool poll_memory, int iterations) {
+  auto memory = emulator_->memory();
+  uint32_t flag_ptr = data_ptr_;
+  uint32_t ack_ptr = data_ptr_ + 4;
+  auto flag = memory->TranslateVirtual(flag_ptr);
+  auto ack = memory->TranslateVirtual(ack_ptr);
+  const uint32_t endian = static_cast<uint32_t>(Endian::k8in32);
+
+  std::vector<uint64_t> latencies;
+  latencies.reserve(iterations);
+  uint32_t timeout_count = 0;
+  for (int i = 0; i < iterations; ++i) {
+    uint32_t value = ++sequence_;
+
+    // WAIT_REG_MEM until the flag equals value, with a long poll interval so
+    // missed wakes stand out.
+    WriteRingDword((0x3u << 30) | (4 << 16) | (PM4_WAIT_REG_MEM << 8));
+    if (poll_memory) {
+      WriteRingDword(0x10 | 0x3);
+      WriteRingDword(CpuToGpu(flag_ptr) | endian);
+    } else {
+      WriteRingDword(0x3);
+      WriteRingDword(XE_GPU_REG_SCRATCH_REG7);
+    }
+    WriteRingDword(value);
+    WriteRingDword(0xFFFFFFFF);
+    WriteRingDword(0x100 * 100);
+    // MEM_WRITE the value to the ack location once the wait is satisfied.
+    WriteRingDword((0x3u << 30) | (1 << 16) | (PM4_MEM_WRITE << 8));
+    WriteRingDword(CpuToGpu(ack_ptr) | endian);
+    WriteRingDword(value);
+    WriteRegister(kRegisterCpRbWptr, write_index_);
+
+    // Let the command processor get through its spin and park.
+    xe::threading::Sleep(std::chrono::microseconds(FLAGS_wait_bench_delay_us));
+
+    uint64_t start_ticks = Clock::QueryHostTickCount();
+    if (poll_memory) {
+      xe::store_and_swap<uint32_t>(flag, value);
+    } else {
+      WriteRegister(XE_GPU_REG_SCRATCH_REG7, value);
+    }
+    uint64_t timeout_ticks = start_ticks + Clock::host_tick_frequency();
+    uint64_t end_ticks;
+    do {
+      xe::threading::SyncMemory();
+      end_ticks = Clock::QueryHostTickCount();
+    } while (xe::load_and_swap<uint32_t>(ack) != value &&
+             end_ticks < timeout_ticks);
+    if (end_ticks >= timeout_ticks) {
+      ++timeout_count;
+      continue;
+    }
+    latencies.push_back(end_ticks - start_ticks);
+  }
+
+  std::sort(latencies.begin(), latencies.end());
+  const double tick_frequency = double(Clock::host_tick_frequency());
+  auto ticks_to_us = [&](uint64_t ticks) {
+    return double(ticks) * 1000000.0 / tick_frequency;
+  };
+  uint64_t total_ticks = 0;
+  for (uint64_t ticks : latencies) {
+    total_ticks += ticks;
+  }
+
+  XELOGI("%s wait wake latency (%d waits):", name, iterations);
+  if (timeout_count) {
+    XELOGE("  %u waits timed out", timeout_count);
+  }
+  if (latencies.empty()) {
+    return;
+  }
+  XELOGI("  Min: %.1fus", ticks_to_us(latencies.front()));
+  XELOGI("  Avg: %.1fus", ticks_to_us(total_ticks) / double(latencies.size()));
+  XELOGI("  P50: %.1fus", ticks_to_us(latencies[latencies.size() / 2]));
+  XELOGI("  P99: %.1fus", ticks_to_us(latencies[latencies.size() * 99 / 100]));
+  XELOGI("  Max: %.1fus", ticks_to_us(latencies.back()));
+}
+
+void WaitBench::WriteRingDword(uint32_t value) {
+  auto ring = emulator_->memory()->TranslateVirtual(ring_buffer_ptr_);
+  xe::store_and_swap<uint32_t>(ring + write_index_ * 4, value);
+  write_index_ = (write_index_ + 1) % ring_buffer_dword_count_;
+}
+
+void WaitBench::WriteRegister(uint32_t index, uint32_t value) {
+  // Go through MMIO the same way guest code does.
+  uint32_t address = kRegisterMmioBase + index * 4;
+  auto range = emulator_->memory()->LookupVirtualMappedRange(address);
+  range->write(nullptr, range->callback_context, address, value);
+}
+
+}  //  namespace gpu
+}  //  namespace xe
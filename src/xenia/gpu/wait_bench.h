@@ -0,0 +1,61 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#ifndef XENIA_GPU_WAIT_BENCH_H_
+#define XENIA_GPU_WAIT_BENCH_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "xenia/emulator.h"
+#include "xenia/gpu/graphics_system.h"
+
+namespace xe {
+namespace gpu {
+
+// WAIT_REG_MEM wake latency benchmark.
+// Submits WAIT_REG_MEM packets through a real ring buffer, lets the command
+// processor park on them and then satisfies them from the CPU side (a guest
+// memory store or an MMIO register write), measuring the time until the
+// command processor acknowledges with a MEM_WRITE.
+class WaitBench {
+ public:
+  virtual ~WaitBench();
+
+  int Main(const std::vector<std::wstring>& args);
+
+ protected:
+  WaitBench();
+
+  virtual std::unique_ptr<gpu::GraphicsSystem> CreateGraphicsSystem() = 0;
+
+  std::unique_ptr<Emulator> emulator_;
+  GraphicsSystem* graphics_system_ = nullptr;
+
+ private:
+  bool Setup();
+  // Runs the given number of waits and logs the latency distribution.
+  // Waits on guest memory if poll_memory is set, otherwise on a register.
+  void Run(const char* name, bool poll_memory, int iterations);
+
+  void WriteRingDword(uint32_t value);
+  void WriteRegister(uint32_t index, uint32_t value);
+
+  uint32_t ring_buffer_ptr_ = 0;
+  uint32_t ring_buffer_dword_count_ = 0;
+  uint32_t write_index_ = 0;
+  uint32_t data_ptr_ = 0;
+  uint32_t sequence_ = 0;
+};
+
+}  // namespace gpu
+}  // namespace xe
+
+#endif  // XENIA_GPU_WAIT_BENCH_H_
@@ -11,6 +11,7 @@
 
 #include <gflags/gflags.h>
 
+#include <cinttypes>
 #include <string>
 
 #include "xenia/base/assert.h"
@@ -33,6 +34,12 @@ DEFINE_bool(headless, false,
             "Don't display any UI, using defaults for prompts as needed.");
 DEFINE_string(content_root, "content",
               "Root path for content (save/etc) storage.");
+DEFINE_int32(io_worker_count, 4,
+             "Host threads servicing overlapped guest file reads and writes. "
+             "0 services them on the calling guest thread.");
+DEFINE_int32(thread_memory_pool_size, 16,
+             "Number of exited guest threads whose stacks, TLS and PCR blocks "
+             "are kept for reuse by new threads. 0 to disable.");
 
 namespace xe {
 namespace kernel {
@@ -67,16 +74,38 @@ KernelState::KernelState(Emulator* emulator)
   // Hardcoded maximum of 2048 TLS slots.
   tls_bitmap_.Resize(2048);
 
+  if (FLAGS_io_worker_count > 0) {
+    io_worker_pool_ =
+        std::make_unique<util::IOWorkerPool>(size_t(FLAGS_io_worker_count));
+  }
+  timer_wheel_ = std::make_unique<util::TimerWheel>();
+  if (FLAGS_thread_memory_pool_size > 0) {
+    thread_memory_pool_ = std::make_unique<util::ThreadMemoryPool>(
+        memory_, size_t(FLAGS_thread_memory_pool_size));
+  }
+
   xam::AppManager::RegisterApps(this, app_manager_.get());
 }
 
 KernelState::~KernelState() {
+  // Pending I/O completes into guest memory and kernel objects.
+  io_worker_pool_.reset();
+  // Timer callbacks queue APCs to threads that are about to go away.
+  timer_wheel_.reset();
+
   SetExecutableModule(nullptr);
 
   if (dispatch_thread_running_) {
     dispatch_thread_running_ = false;
-    dispatch_cond_.notify_all();
+    dispatch_queue_.Shutdown();
     dispatch_thread_->Wait(0, 0, 0, nullptr);
+
+    auto stats = dispatch_queue_.stats();
+    XELOGI("Kernel dispatch queue: %" PRIu64 " tasks, max depth %u, "
+           "latency avg %" PRIu64 "us max %" PRIu64 "us",
+           stats.dispatched, stats.max_depth,
+           stats.dispatched ? stats.total_latency_us / stats.dispatched : 0,
+           stats.max_latency_us);
   }
 
   executable_module_.reset();
@@ -333,17 +362,11 @@ void KernelState::SetExecutableModule(object_ref<UserModule> module) {
           // As we run guest callbacks the debugger must be able to suspend us.
           dispatch_thread_->set_can_debugger_suspend(true);
 
-          while (dispatch_thread_running_) {
-            auto global_lock = global_critical_region_.Acquire();
-            if (dispatch_queue_.empty()) {
-              dispatch_cond_.wait(global_lock);
-              if (!dispatch_thread_running_) {
-                break;
-              }
-            }
-            auto fn = std::move(dispatch_queue_.front());
-            dispatch_queue_.pop_front();
+          // Tasks take whatever locks they need themselves.
+          std::function<void()> fn;
+          while (dispatch_queue_.Dequeue(&fn)) {
             fn();
+            fn = nullptr;
           }
           return 0;
         }));
@@ -678,21 +701,24 @@ void KernelState::CompleteOverlappedDeferredEx(
   auto ptr = memory()->TranslateVirtual(overlapped_ptr);
   XOverlappedSetResult(ptr, X_ERROR_IO_PENDING);
   XOverlappedSetContext(ptr, XThread::GetCurrentThreadHandle());
-  auto global_lock = global_critical_region_.Acquire();
-  dispatch_queue_.push_back([this, completion_callback, overlapped_ptr, result,
-                             extended_error, length]() {
+  dispatch_queue_.Enqueue([this, completion_callback, overlapped_ptr, result,
+                           extended_error, length]() {
     xe::threading::Sleep(
         std::chrono::milliseconds(kDeferredOverlappedDelayMillis));
     completion_callback();
     CompleteOverlappedEx(overlapped_ptr, result, extended_error, length);
   });
-  dispatch_cond_.notify_all();
 }
 
 bool KernelState::Save(ByteStream* stream) {
   XELOGD("Serializing the kernel...");
   stream->Write('KRNL');
 
+  // Outstanding I/O would complete into memory that has already been saved.
+  if (io_worker_pool_) {
+    io_worker_pool_->Drain();
+  }
+
   // Save the object table
   object_table_.Save(stream);
 
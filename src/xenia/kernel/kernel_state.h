@@ -22,8 +22,12 @@
 #include "xenia/base/bit_map.h"
 #include "xenia/base/mutex.h"
 #include "xenia/cpu/export_resolver.h"
+#include "xenia/kernel/util/dispatch_queue.h"
+#include "xenia/kernel/util/io_worker_pool.h"
 #include "xenia/kernel/util/native_list.h"
 #include "xenia/kernel/util/object_table.h"
+#include "xenia/kernel/util/thread_memory_pool.h"
+#include "xenia/kernel/util/timer_wheel.h"
 #include "xenia/kernel/xam/app_manager.h"
 #include "xenia/kernel/xam/content_manager.h"
 #include "xenia/kernel/xam/user_profile.h"
@@ -164,6 +168,20 @@ class KernelState {
 
   util::NativeList* dpc_list() { return &dpc_list_; }
 
+  // Work run on the kernel dispatch thread.
+  util::DispatchQueue* dispatch_queue() { return &dispatch_queue_; }
+
+  // Services overlapped file I/O, if enabled.
+  util::IOWorkerPool* io_worker_pool() const { return io_worker_pool_.get(); }
+
+  // Guest memory of exited threads kept for new ones, or nullptr if disabled.
+  util::ThreadMemoryPool* thread_memory_pool() const {
+    return thread_memory_pool_.get();
+  }
+
+  // Runs the host side of all guest timers and delays.
+  util::TimerWheel* timer_wheel() const { return timer_wheel_.get(); }
+
   void CompleteOverlapped(uint32_t overlapped_ptr, X_RESULT result);
   void CompleteOverlappedEx(uint32_t overlapped_ptr, X_RESULT result,
                             uint32_t extended_error, uint32_t length);
@@ -193,6 +211,10 @@ class KernelState {
 
   xe::global_critical_region global_critical_region_;
 
+  // Declared ahead of everything that may hold threads, so that it outlives
+  // them.
+  std::unique_ptr<util::ThreadMemoryPool> thread_memory_pool_;
+
   // Must be guarded by the global critical region.
   util::ObjectTable object_table_;
   std::unordered_map<uint32_t, XThread*> threads_by_id_;
@@ -211,8 +233,10 @@ class KernelState {
   object_ref<XHostThread> dispatch_thread_;
   // Must be guarded by the global critical region.
   util::NativeList dpc_list_;
-  std::condition_variable_any dispatch_cond_;
-  std::list<std::function<void()>> dispatch_queue_;
+  util::DispatchQueue dispatch_queue_;
+
+  std::unique_ptr<util::IOWorkerPool> io_worker_pool_;
+  std::unique_ptr<util::TimerWheel> timer_wheel_;
 
   BitMap tls_bitmap_;
 
@@ -22,3 +22,77 @@ project("xenia-kernel")
   files({
     "debug_visualizers.natvis",
   })
+
+test_suite("xenia-kernel-tests", project_root, ".", {
+  includedirs = {
+    project_root.."/third_party/gflags/src",
+  },
+  links = {
+    "xenia-kernel",
+    "xenia-base",
+  },
+})
+
+project("xenia-kernel-object-table-bench")
+  uuid("b7e3f0a2-5c1d-4e8b-9a64-2f0d8c3e71b5")
+  kind("ConsoleApp")
+  language("C++")
+  links({
+    "xenia-kernel",
+    "xenia-apu",
+    "xenia-core",
+    "xenia-cpu",
+    "xenia-hid",
+    "xenia-vfs",
+    "xenia-base",
+    "gflags",
+  })
+  files({
+    "util/object_table_bench_main.cc",
+    "../base/main_"..platform_suffix..".cc",
+  })
+  includedirs({
+    project_root.."/third_party/gflags/src",
+  })
+  filter("platforms:Windows")
+    debugdir(project_root)
+    debugargs({
+      "--flagfile=scratch/flags.txt",
+      "2>&1",
+      "1>scratch/stdout-object-table-bench.txt",
+    })
+
+    -- xenia-base needs this
+    links({"xenia-ui"})
+
+project("xenia-kernel-timer-wheel-bench")
+  uuid("4d2a9c61-8e3f-4b07-a5d2-6c1e9f0b3a48")
+  kind("ConsoleApp")
+  language("C++")
+  links({
+    "xenia-kernel",
+    "xenia-apu",
+    "xenia-core",
+    "xenia-cpu",
+    "xenia-hid",
+    "xenia-vfs",
+    "xenia-base",
+    "gflags",
+  })
+  files({
+    "util/timer_wheel_bench_main.cc",
+    "../base/main_"..platform_suffix..".cc",
+  })
+  includedirs({
+    project_root.."/third_party/gflags/src",
+  })
+  filter("platforms:Windows")
+    debugdir(project_root)
+    debugargs({
+      "--flagfile=scratch/flags.txt",
+      "2>&1",
+      "1>scratch/stdout-timer-wheel-bench.txt",
+    })
+
+    -- xenia-base needs this
+    links({"xenia-ui"})
@@ -0,0 +1,207 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#include "xenia/kernel/util/dispatch_queue.h"
+
+#include "xenia/base/assert.h"
+#include "xenia/base/clock.h"
+
+namespace xe {
+namespace kernel {
+namespace util {
+
+namespace {
+uint64_t TicksToMicroseconds(uint64_t ticks) {
+  return ticks * 1000000 / Clock::host_tick_frequency();
+}
+
+template <typename T>
+void AtomicMax(std::atomic<T>* value, T new_value) {
+  T old_value = value->load(std::memory_order_relaxed);
+  while (new_value > old_value &&
+         !value->compare_exchange_weak(old_value, new_value,
+                                       std::memory_order_relaxed)) {
+  }
+}
+}  // namespace
+
+DispatchQueue::DispatchQueue() : head_(&stub_), tail_(&stub_) {
+  for (auto& chunk : chunks_) {
+    chunk.store(nullptr, std::memory_order_relaxed);
+  }
+  wake_event_ = xe::threading::Event::CreateAutoResetEvent(false);
+}
+
+DispatchQueue::~DispatchQueue() {
+  // Drop anything not dispatched; pooled tasks go away with their chunks.
+  while (Task* task = Pop()) {
+    if (task->index == kUnpooledIndex) {
+      delete task;
+    }
+  }
+  for (uint32_t i = 0; i < chunk_count_; ++i) {
+    delete[] chunks_[i].load(std::memory_order_relaxed);
+  }
+}
+
+void DispatchQueue::Enqueue(std::function<void()> fn) {
+  Task* task = AllocateTask();
+  task->fn = std::move(fn);
+  task->enqueue_ticks = Clock::QueryHostTickCount();
+  task->next.store(nullptr, std::memory_order_relaxed);
+
+  AtomicMax(&max_depth_, uint32_t(++depth_));
+  enqueued_count_.fetch_add(1, std::memory_order_relaxed);
+
+  // Until the previous head points at the task the consumer can't see it (or
+  // anything queued after it), which Dequeue spins out.
+  Task* prev_head = head_.exchange(task, std::memory_order_acq_rel);
+  prev_head->next.store(task, std::memory_order_release);
+
+  if (consumer_waiting_.load() && consumer_waiting_.exchange(false)) {
+    wake_event_->Set();
+  }
+}
+
+bool DispatchQueue::Dequeue(std::function<void()>* out_fn) {
+  while (!shutting_down_.load(std::memory_order_acquire)) {
+    Task* task = Pop();
+    if (task) {
+      --depth_;
+      uint64_t latency_ticks =
+          Clock::QueryHostTickCount() - task->enqueue_ticks;
+      total_latency_ticks_.fetch_add(latency_ticks, std::memory_order_relaxed);
+      AtomicMax(&max_latency_ticks_, latency_ticks);
+      dispatched_count_.fetch_add(1, std::memory_order_relaxed);
+      *out_fn = std::move(task->fn);
+      task->fn = nullptr;
+      ReleaseTask(task);
+      return true;
+    }
+    if (depth_.load() > 0) {
+      // A producer is between counting its task and linking it in.
+      xe::threading::MaybeYield();
+      continue;
+    }
+    // Either a producer sees the flag and wakes us, or we see its task.
+    consumer_waiting_.store(true);
+    if (depth_.load() > 0 || shutting_down_.load()) {
+      consumer_waiting_.store(false);
+      continue;
+    }
+    xe::threading::Wait(wake_event_.get(), false);
+  }
+  return false;
+}
+
+void DispatchQueue::Shutdown() {
+  shutting_down_.store(true, std::memory_order_release);
+  wake_event_->Set();
+}
+
+DispatchQueue::Stats DispatchQueue::stats() const {
+  Stats stats;
+  stats.enqueued = enqueued_count_.load(std::memory_order_relaxed);
+  stats.dispatched = dispatched_count_.load(std::memory_order_relaxed);
+  stats.depth = depth();
+  stats.max_depth = max_depth_.load(std::memory_order_relaxed);
+  stats.total_latency_us = TicksToMicroseconds(
+      total_latency_ticks_.load(std::memory_order_relaxed));
+  stats.max_latency_us =
+      TicksToMicroseconds(max_latency_ticks_.load(std::memory_order_relaxed));
+  return stats;
+}
+
+DispatchQueue::Task* DispatchQueue::TaskAt(uint32_t index) const {
+  Task* chunk = chunks_[index >> kChunkShift].load(std::memory_order_acquire);
+  return &chunk[index & (kChunkSize - 1)];
+}
+
+DispatchQueue::Task* DispatchQueue::AllocateTask() {
+  uint64_t free_head = free_head_.load(std::memory_order_acquire);
+  while (uint32_t(free_head)) {
+    Task* task = TaskAt(uint32_t(free_head) - 1);
+    uint64_t new_free_head =
+        (((free_head >> 32) + 1) << 32) |
+        task->next_free.load(std::memory_order_relaxed);
+    if (free_head_.compare_exchange_weak(free_head, new_free_head,
+                                         std::memory_order_acquire)) {
+      return task;
+    }
+  }
+
+  // Out of free tasks, grow the pool by a chunk.
+  std::lock_guard<std::mutex> lock(chunk_mutex_);
+  if (chunk_count_ == kMaxChunkCount) {
+    // An absurd backlog; just stop pooling.
+    return new Task();
+  }
+  uint32_t base_index = chunk_count_ << kChunkShift;
+  Task* chunk = new Task[kChunkSize];
+  for (uint32_t i = 0; i < kChunkSize; ++i) {
+    chunk[i].index = base_index + i;
+  }
+  chunks_[chunk_count_++].store(chunk, std::memory_order_release);
+  for (uint32_t i = 1; i < kChunkSize; ++i) {
+    PushFree(&chunk[i]);
+  }
+  return &chunk[0];
+}
+
+void DispatchQueue::ReleaseTask(Task* task) {
+  if (task->index == kUnpooledIndex) {
+    delete task;
+  } else {
+    PushFree(task);
+  }
+}
+
+void DispatchQueue::PushFree(Task* task) {
+  uint64_t free_head = free_head_.load(std::memory_order_relaxed);
+  do {
+    task->next_free.store(uint32_t(free_head), std::memory_order_relaxed);
+  } while (!free_head_.compare_exchange_weak(
+      free_head, (((free_head >> 32) + 1) << 32) | (task->index + 1),
+      std::memory_order_release, std::memory_order_relaxed));
+}
+
+DispatchQueue::Task* DispatchQueue::Pop() {
+  Task* tail = tail_;
+  Task* next = tail->next.load(std::memory_order_acquire);
+  if (tail == &stub_) {
+    if (!next) {
+      return nullptr;
+    }
+    tail_ = next;
+    tail = next;
+    next = next->next.load(std::memory_order_acquire);
+  }
+  if (next) {
+    tail_ = next;
+    return tail;
+  }
+  if (tail != head_.load(std::memory_order_acquire)) {
+    // The next task has been swapped in but not linked yet.
+    return nullptr;
+  }
+  // tail is the last task; put the stub back behind it so it can be taken.
+  stub_.next.store(nullptr, std::memory_order_relaxed);
+  Task* prev_head = head_.exchange(&stub_, std::memory_order_acq_rel);
+  prev_head->next.store(&stub_, std::memory_order_release);
+  next = tail->next.load(std::memory_order_acquire);
+  if (next) {
+    tail_ = next;
+    return tail;
+  }
+  return nullptr;
+}
+
+}  // namespace util
+}  // namespace kernel
+}  // namespace xe
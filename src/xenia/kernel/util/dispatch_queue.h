@@ -0,0 +1,120 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#ifndef XENIA_KERNEL_UTIL_DISPATCH_QUEUE_H_
+#define XENIA_KERNEL_UTIL_DISPATCH_QUEUE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "xenia/base/threading.h"
+
+namespace xe {
+namespace kernel {
+namespace util {
+
+// Queue of work for a single consumer thread that any number of threads can
+// add to without taking a lock.
+// Tasks are intrusive nodes recycled through a lock-free free list, so once
+// the pool has grown to the largest backlog seen, queuing only allocates if
+// the function object itself doesn't fit in std::function.
+// The consumer spins briefly while a task is being linked in and otherwise
+// sleeps on a host event that producers only signal when it is asleep.
+class DispatchQueue {
+ public:
+  struct Stats {
+    uint64_t enqueued;
+    uint64_t dispatched;
+    // Tasks queued but not yet dequeued, and the most there have been.
+    uint32_t depth;
+    uint32_t max_depth;
+    // Time from being queued to being dequeued.
+    uint64_t total_latency_us;
+    uint64_t max_latency_us;
+  };
+
+  DispatchQueue();
+  ~DispatchQueue();
+
+  // Queues the function to be run by the consumer. Safe from any thread.
+  void Enqueue(std::function<void()> fn);
+
+  // Consumer only. Waits for the next task, returning false once Shutdown has
+  // been called. Tasks still queued then are dropped.
+  bool Dequeue(std::function<void()>* out_fn);
+
+  // Wakes the consumer and makes it stop dequeuing.
+  void Shutdown();
+
+  uint32_t depth() const { return uint32_t(std::max(0, depth_.load())); }
+  Stats stats() const;
+
+ private:
+  struct Task {
+    // Link in the queue.
+    std::atomic<Task*> next = {nullptr};
+    // Link in the free list, as the index of the next free task plus 1.
+    std::atomic<uint32_t> next_free = {0};
+    uint32_t index = kUnpooledIndex;
+    uint64_t enqueue_ticks = 0;
+    std::function<void()> fn;
+  };
+
+  static const uint32_t kUnpooledIndex = UINT32_MAX;
+  // Tasks are allocated in chunks that never move or get freed until the
+  // queue is destroyed, so free list entries can be read at any time.
+  static const uint32_t kChunkShift = 6;
+  static const uint32_t kChunkSize = 1 << kChunkShift;
+  static const uint32_t kMaxChunkCount = 1024;
+
+  Task* TaskAt(uint32_t index) const;
+  Task* AllocateTask();
+  void ReleaseTask(Task* task);
+  void PushFree(Task* task);
+  // Unlinks the oldest task, or returns nullptr if the queue is empty or the
+  // producer of the next task is still linking it in.
+  Task* Pop();
+
+  // Producers swap themselves in at the head, the consumer takes from the
+  // tail. The stub keeps the list from ever being empty.
+  std::atomic<Task*> head_;
+  Task* tail_;
+  Task stub_;
+
+  // Free task index plus 1 in the low 32 bits, and a count of updates in the
+  // high 32 bits so that a task popped and pushed back in the meantime can't
+  // be mistaken for an unchanged list.
+  std::atomic<uint64_t> free_head_ = {0};
+  std::mutex chunk_mutex_;
+  std::atomic<Task*> chunks_[kMaxChunkCount];
+  uint32_t chunk_count_ = 0;
+
+  // Counted before a task is linked in, so nonzero while Pop may still come
+  // up empty.
+  std::atomic<int32_t> depth_ = {0};
+  std::atomic<bool> consumer_waiting_ = {false};
+  std::atomic<bool> shutting_down_ = {false};
+  std::unique_ptr<xe::threading::Event> wake_event_;
+
+  std::atomic<uint64_t> enqueued_count_ = {0};
+  std::atomic<uint64_t> dispatched_count_ = {0};
+  std::atomic<uint32_t> max_depth_ = {0};
+  std::atomic<uint64_t> total_latency_ticks_ = {0};
+  std::atomic<uint64_t> max_latency_ticks_ = {0};
+};
+
+}  // namespace util
+}  // namespace kernel
+}  // namespace xe
+
+#endif  // XENIA_KERNEL_UTIL_DISPATCH_QUEUE_H_
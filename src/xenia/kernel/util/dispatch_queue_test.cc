@@ -0,0 +1,152 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#include "xenia/kernel/util/dispatch_queue.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "third_party/catch/include/catch.hpp"
+
+namespace xe {
+namespace kernel {
+namespace util {
+namespace test {
+
+using std::chrono::microseconds;
+using std::chrono::seconds;
+
+// Runs everything dequeued until the queue is shut down, returning how many
+// tasks that was.
+uint64_t RunConsumer(DispatchQueue* queue) {
+  uint64_t run_count = 0;
+  std::function<void()> fn;
+  while (queue->Dequeue(&fn)) {
+    fn();
+    ++run_count;
+  }
+  return run_count;
+}
+
+TEST_CASE("dispatch_queue_multi_producer", "DispatchQueue") {
+  const uint32_t kProducerCount = 4;
+  const uint32_t kTasksPerProducer = 50000;
+  const uint32_t kTaskCount = kProducerCount * kTasksPerProducer;
+
+  DispatchQueue queue;
+  // Only touched by the consumer.
+  std::vector<uint32_t> run_counts(kTaskCount, 0);
+  std::atomic<uint32_t> completed_count = {0};
+  auto consumer_result =
+      std::async(std::launch::async, RunConsumer, &queue);
+
+  std::vector<std::thread> producers;
+  for (uint32_t producer = 0; producer < kProducerCount; ++producer) {
+    producers.emplace_back([&, producer]() {
+      for (uint32_t i = 0; i < kTasksPerProducer; ++i) {
+        uint32_t id = producer * kTasksPerProducer + i;
+        queue.Enqueue([&, id]() {
+          ++run_counts[id];
+          ++completed_count;
+        });
+        // Let the queue drain now and then, so that the consumer parks and
+        // has to be woken while the other producers keep going.
+        if (i % 1024 == 0) {
+          std::this_thread::sleep_for(microseconds(100));
+        }
+      }
+    });
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+
+  // If a wake were lost the consumer would stay parked with work queued.
+  auto deadline = std::chrono::steady_clock::now() + seconds(30);
+  while (completed_count.load() < kTaskCount &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(microseconds(100));
+  }
+  REQUIRE(completed_count.load() == kTaskCount);
+
+  queue.Shutdown();
+  REQUIRE(consumer_result.get() == kTaskCount);
+  for (uint32_t id = 0; id < kTaskCount; ++id) {
+    if (run_counts[id] != 1) {
+      INFO("Task " << id);
+      REQUIRE(run_counts[id] == 1);
+    }
+  }
+
+  auto stats = queue.stats();
+  REQUIRE(stats.enqueued == kTaskCount);
+  REQUIRE(stats.dispatched == kTaskCount);
+  REQUIRE(stats.depth == 0);
+  REQUIRE(queue.depth() == 0);
+}
+
+TEST_CASE("dispatch_queue_wakes_parked_consumer", "DispatchQueue") {
+  DispatchQueue queue;
+  auto consumer_result =
+      std::async(std::launch::async, RunConsumer, &queue);
+
+  // Each task is queued once the consumer has had time to run dry and park.
+  const uint32_t kRoundCount = 500;
+  for (uint32_t i = 0; i < kRoundCount; ++i) {
+    std::this_thread::sleep_for(microseconds(200));
+    std::promise<void> ran;
+    queue.Enqueue([&ran]() { ran.set_value(); });
+    INFO("Round " << i);
+    REQUIRE(ran.get_future().wait_for(seconds(10)) ==
+            std::future_status::ready);
+  }
+
+  queue.Shutdown();
+  REQUIRE(consumer_result.get() == kRoundCount);
+}
+
+TEST_CASE("dispatch_queue_shutdown", "DispatchQueue") {
+  SECTION("Wakes a parked consumer") {
+    DispatchQueue queue;
+    auto consumer_result =
+        std::async(std::launch::async, RunConsumer, &queue);
+    std::this_thread::sleep_for(microseconds(1000));
+    queue.Shutdown();
+    REQUIRE(consumer_result.wait_for(seconds(10)) ==
+            std::future_status::ready);
+    REQUIRE(consumer_result.get() == 0);
+  }
+
+  SECTION("Stops dequeuing and drops queued tasks") {
+    auto owned = std::make_shared<int>(0);
+    {
+      DispatchQueue queue;
+      for (int i = 0; i < 100; ++i) {
+        queue.Enqueue([owned]() { ++*owned; });
+      }
+      REQUIRE(queue.depth() == 100);
+      queue.Shutdown();
+      std::function<void()> fn;
+      REQUIRE_FALSE(queue.Dequeue(&fn));
+      REQUIRE_FALSE(fn);
+    }
+    // Dropped tasks were never run, and released what they captured.
+    REQUIRE(*owned == 0);
+    REQUIRE(owned.use_count() == 1);
+  }
+}
+
+}  // namespace test
+}  // namespace util
+}  // namespace kernel
+}  // namespace xe
@@ -0,0 +1,82 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#include "xenia/kernel/util/io_worker_pool.h"
+
+#include <string>
+
+#include "xenia/base/assert.h"
+
+namespace xe {
+namespace kernel {
+namespace util {
+
+IOWorkerPool::IOWorkerPool(size_t worker_count) {
+  for (size_t i = 0; i < worker_count; ++i) {
+    xe::threading::Thread::CreationParameters params;
+    // Requests only call into the file system, not guest code.
+    params.stack_size = 256 * 1024;
+    auto worker = xe::threading::Thread::Create(params, [this]() {
+      WorkerMain();
+    });
+    assert_not_null(worker);
+    worker->set_name("IO Worker " + std::to_string(i));
+    workers_.push_back(std::move(worker));
+  }
+}
+
+IOWorkerPool::~IOWorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutting_down_ = true;
+  }
+  request_cond_.notify_all();
+  for (auto& worker : workers_) {
+    xe::threading::Wait(worker.get(), false);
+  }
+}
+
+void IOWorkerPool::Submit(std::function<void()> request) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    requests_.push_back(std::move(request));
+  }
+  request_cond_.notify_one();
+}
+
+void IOWorkerPool::Drain() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  idle_cond_.wait(lock,
+                  [this]() { return requests_.empty() && !active_count_; });
+}
+
+void IOWorkerPool::WorkerMain() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    request_cond_.wait(
+        lock, [this]() { return !requests_.empty() || shutting_down_; });
+    if (requests_.empty()) {
+      // Only exit once everything submitted has been serviced.
+      break;
+    }
+    auto request = std::move(requests_.front());
+    requests_.pop_front();
+    ++active_count_;
+    lock.unlock();
+    request();
+    lock.lock();
+    if (!--active_count_ && requests_.empty()) {
+      idle_cond_.notify_all();
+    }
+  }
+}
+
+}  // namespace util
+}  // namespace kernel
+}  // namespace xe
@@ -0,0 +1,59 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#ifndef XENIA_KERNEL_UTIL_IO_WORKER_POOL_H_
+#define XENIA_KERNEL_UTIL_IO_WORKER_POOL_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "xenia/base/threading.h"
+
+namespace xe {
+namespace kernel {
+namespace util {
+
+// Host threads servicing asynchronous guest file I/O, so that guest threads
+// issuing overlapped reads and writes keep running while the host file system
+// (or the page faults of a mapped disc image) does the work.
+// Requests start in submission order but may complete in any order.
+class IOWorkerPool {
+ public:
+  explicit IOWorkerPool(size_t worker_count);
+  // Finishes all submitted requests before returning.
+  ~IOWorkerPool();
+
+  void Submit(std::function<void()> request);
+
+  // Waits until all requests submitted so far have completed.
+  void Drain();
+
+ private:
+  void WorkerMain();
+
+  std::mutex mutex_;
+  std::condition_variable request_cond_;
+  std::condition_variable idle_cond_;
+  std::deque<std::function<void()>> requests_;
+  // Requests being run by workers.
+  size_t active_count_ = 0;
+  bool shutting_down_ = false;
+
+  std::vector<std::unique_ptr<xe::threading::Thread>> workers_;
+};
+
+}  // namespace util
+}  // namespace kernel
+}  // namespace xe
+
+#endif  // XENIA_KERNEL_UTIL_IO_WORKER_POOL_H_
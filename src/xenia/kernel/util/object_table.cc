@@ -10,9 +10,9 @@
 #include "xenia/kernel/util/object_table.h"
 
 #include <algorithm>
-#include <cstring>
 
 #include "xenia/base/byte_stream.h"
+#include "xenia/base/threading.h"
 #include "xenia/kernel/xobject.h"
 #include "xenia/kernel/xthread.h"
 
@@ -22,23 +22,114 @@ namespace util {
 
 ObjectTable::ObjectTable() {}
 
-ObjectTable::~ObjectTable() { Reset(); }
+ObjectTable::~ObjectTable() {
+  Reset();
+
+  // No lookups can be running on a table being destroyed, so anything still
+  // waiting for readers to leave can go.
+  auto global_lock = global_critical_region_.Acquire();
+  for (auto& retired : retired_) {
+    if (retired.object) {
+      retired.object->Release();
+    } else {
+      delete[] retired.segment;
+    }
+  }
+  retired_.clear();
+}
 
 void ObjectTable::Reset() {
   auto global_lock = global_critical_region_.Acquire();
 
-  // Release all objects.
-  for (uint32_t n = 0; n < table_capacity_; n++) {
-    ObjectTableEntry& entry = table_[n];
-    if (entry.object) {
-      entry.object->Release();
+  // Unpublish all segments, and retire them along with what they hold.
+  for (auto& segment : segments_) {
+    auto entries = segment.exchange(nullptr);
+    if (!entries) {
+      continue;
     }
+    for (uint32_t n = 0; n < kSegmentSize; n++) {
+      auto object = entries[n].object.exchange(nullptr);
+      if (object) {
+        Retire(object);
+      }
+    }
+    Retire(entries);
   }
+  ReclaimRetired();
 
   table_capacity_ = 0;
   last_free_entry_ = 0;
-  free(table_);
-  table_ = nullptr;
+}
+
+ObjectTable::ObjectTableEntry* ObjectTable::EntryForSlot(uint32_t slot) const {
+  uint32_t segment_index = slot >> kSegmentShift;
+  if (segment_index >= kMaxSegmentCount) {
+    return nullptr;
+  }
+  auto entries = segments_[segment_index].load(std::memory_order_acquire);
+  if (!entries) {
+    return nullptr;
+  }
+  return &entries[slot & (kSegmentSize - 1)];
+}
+
+uint32_t ObjectTable::BeginRead() {
+  while (true) {
+    uint32_t epoch = epoch_.load();
+    reader_counts_[epoch & 1].fetch_add(1);
+    if (epoch_.load() == epoch) {
+      return epoch;
+    }
+    // Raced with ReclaimRetired, which may have already checked this count.
+    reader_counts_[epoch & 1].fetch_sub(1);
+  }
+}
+
+void ObjectTable::EndRead(uint32_t epoch) {
+  reader_counts_[epoch & 1].fetch_sub(1, std::memory_order_release);
+}
+
+void ObjectTable::Retire(XObject* object) {
+  retired_.push_back({epoch_.load(), object, nullptr});
+}
+
+void ObjectTable::Retire(ObjectTableEntry* segment) {
+  retired_.push_back({epoch_.load(), nullptr, segment});
+}
+
+void ObjectTable::ReclaimRetired() {
+  // The epoch can only move on once the readers of the one before the current
+  // one have left, as those share a counter with the next. Readers of the
+  // current epoch can only have seen what was retired during it or before.
+  for (int i = 0; i < 2; ++i) {
+    uint32_t epoch = epoch_.load();
+    if (reader_counts_[(epoch + 1) & 1].load(std::memory_order_acquire)) {
+      break;
+    }
+    epoch_.store(epoch + 1);
+  }
+  if (retired_.empty()) {
+    return;
+  }
+
+  // Anything retired two or more epochs ago has no readers left. Releasing
+  // may destroy objects that close handles of their own and retire more, so
+  // take the ones that are due out of the list first.
+  uint32_t epoch = epoch_.load();
+  std::vector<RetiredEntry> reclaimed;
+  auto it = std::stable_partition(
+      retired_.begin(), retired_.end(), [epoch](const RetiredEntry& retired) {
+        return epoch - retired.epoch < 2;
+      });
+  reclaimed.assign(it, retired_.end());
+  retired_.erase(it, retired_.end());
+  for (auto& retired : reclaimed) {
+    if (retired.object) {
+      retired.object->Release();
+    } else {
+      delete[] retired.segment;
+    }
+  }
 }
 
 X_STATUS ObjectTable::FindFreeSlot(uint32_t* out_slot) {
@@ -46,8 +137,8 @@ X_STATUS ObjectTable::FindFreeSlot(uint32_t* out_slot) {
   uint32_t slot = last_free_entry_;
   uint32_t scan_count = 0;
   while (scan_count < table_capacity_) {
-    ObjectTableEntry& entry = table_[slot];
-    if (!entry.object) {
+    ObjectTableEntry& entry = *EntryForSlot(slot);
+    if (!entry.object.load(std::memory_order_relaxed)) {
       *out_slot = slot;
       return X_STATUS_SUCCESS;
     }
@@ -74,23 +165,22 @@ X_STATUS ObjectTable::FindFreeSlot(uint32_t* out_slot) {
 }
 
 bool ObjectTable::Resize(uint32_t new_capacity) {
-  uint32_t new_size = new_capacity * sizeof(ObjectTableEntry);
-  uint32_t old_size = table_capacity_ * sizeof(ObjectTableEntry);
-  auto new_table =
-      reinterpret_cast<ObjectTableEntry*>(realloc(table_, new_size));
-  if (!new_table) {
+  uint32_t old_segment_count = table_capacity_ >> kSegmentShift;
+  uint32_t new_segment_count =
+      (new_capacity + kSegmentSize - 1) >> kSegmentShift;
+  if (new_segment_count > kMaxSegmentCount) {
     return false;
   }
 
-  // Zero out new entries.
-  if (new_size > old_size) {
-    std::memset(reinterpret_cast<uint8_t*>(new_table) + old_size, 0,
-                new_size - old_size);
+  // Existing entries stay where they are; only new segments are added.
+  for (uint32_t i = old_segment_count; i < new_segment_count; i++) {
+    segments_[i].store(new ObjectTableEntry[kSegmentSize],
+                       std::memory_order_release);
   }
 
   last_free_entry_ = table_capacity_;
-  table_capacity_ = new_capacity;
-  table_ = new_table;
+  table_capacity_ =
+      std::max(table_capacity_, new_segment_count << kSegmentShift);
 
   return true;
 }
@@ -108,8 +198,7 @@ X_STATUS ObjectTable::AddHandle(XObject* object, X_HANDLE* out_handle) {
 
     // Stash.
     if (XSUCCEEDED(result)) {
-      ObjectTableEntry& entry = table_[slot];
-      entry.object = object;
+      ObjectTableEntry& entry = *EntryForSlot(slot);
       entry.handle_ref_count = 1;
 
       handle = slot << 2;
@@ -117,6 +206,7 @@ X_STATUS ObjectTable::AddHandle(XObject* object, X_HANDLE* out_handle) {
 
       // Retain so long as the object is in the table.
       object->Retain();
+      entry.object.store(object, std::memory_order_release);
     }
   }
 
@@ -133,7 +223,7 @@ X_STATUS ObjectTable::DuplicateHandle(X_HANDLE handle, X_HANDLE* out_handle) {
   X_STATUS result = X_STATUS_SUCCESS;
   handle = TranslateHandle(handle);
 
-  XObject* object = LookupObject(handle, false);
+  XObject* object = LookupObjectInternal(handle);
   if (object) {
     result = AddHandle(object, out_handle);
     object->Release();  // Release the ref that LookupObject took
@@ -182,15 +272,14 @@ X_STATUS ObjectTable::RemoveHandle(X_HANDLE handle) {
     return X_STATUS_INVALID_HANDLE;
   }
 
+  auto global_lock = global_critical_region_.Acquire();
   ObjectTableEntry* entry = LookupTable(handle);
   if (!entry) {
     return X_STATUS_INVALID_HANDLE;
   }
 
-  auto global_lock = global_critical_region_.Acquire();
-  if (entry->object) {
-    auto object = entry->object;
-    entry->object = nullptr;
+  auto object = entry->object.exchange(nullptr);
+  if (object) {
     entry->handle_ref_count = 0;
 
     // Walk the object's handles and remove this one.
@@ -200,9 +289,10 @@ X_STATUS ObjectTable::RemoveHandle(X_HANDLE handle) {
       object->handles().erase(handle_entry);
     }
 
-    // Release now that the object has been removed from the table.
-    object->Release();
+    // Released once no lookup can still be about to retain it.
+    Retire(object);
   }
+  ReclaimRetired();
 
   return X_STATUS_SUCCESS;
 }
@@ -212,12 +302,11 @@ std::vector<object_ref<XObject>> ObjectTable::GetAllObjects() {
   std::vector<object_ref<XObject>> results;
 
   for (uint32_t slot = 0; slot < table_capacity_; slot++) {
-    auto& entry = table_[slot];
-    if (entry.object &&
-        std::find(results.begin(), results.end(), entry.object) ==
-            results.end()) {
-      entry.object->Retain();
-      results.push_back(object_ref<XObject>(entry.object));
+    auto object = EntryForSlot(slot)->object.load();
+    if (object &&
+        std::find(results.begin(), results.end(), object) == results.end()) {
+      object->Retain();
+      results.push_back(object_ref<XObject>(object));
     }
   }
 
@@ -227,14 +316,15 @@ std::vector<object_ref<XObject>> ObjectTable::GetAllObjects() {
 void ObjectTable::PurgeAllObjects() {
   auto lock = global_critical_region_.Acquire();
   for (uint32_t slot = 0; slot < table_capacity_; slot++) {
-    auto& entry = table_[slot];
-    if (entry.object && !entry.object->is_host_object()) {
+    auto& entry = *EntryForSlot(slot);
+    auto object = entry.object.load();
+    if (object && !object->is_host_object()) {
       entry.handle_ref_count = 0;
-      entry.object->Release();
-
       entry.object = nullptr;
+      Retire(object);
     }
   }
+  ReclaimRetired();
 }
 
 ObjectTable::ObjectTableEntry* ObjectTable::LookupTable(X_HANDLE handle) {
@@ -247,8 +337,8 @@ ObjectTable::ObjectTableEntry* ObjectTable::LookupTable(X_HANDLE handle) {
 
   // Lower 2 bits are ignored.
   uint32_t slot = handle >> 2;
-  if (slot <= table_capacity_) {
-    return &table_[slot];
+  if (slot < table_capacity_) {
+    return EntryForSlot(slot);
   }
 
   return nullptr;
@@ -257,31 +347,29 @@ ObjectTable::ObjectTableEntry* ObjectTable::LookupTable(X_HANDLE handle) {
 // Generic lookup
 template <>
 object_ref<XObject> ObjectTable::LookupObject<XObject>(X_HANDLE handle) {
-  auto object = ObjectTable::LookupObject(handle, false);
+  auto object = ObjectTable::LookupObjectInternal(handle);
   auto result = object_ref<XObject>(reinterpret_cast<XObject*>(object));
   return result;
 }
 
-XObject* ObjectTable::LookupObject(X_HANDLE handle, bool already_locked) {
+XObject* ObjectTable::LookupObjectInternal(X_HANDLE handle) {
   handle = TranslateHandle(handle);
   if (!handle) {
     return nullptr;
   }
 
-  XObject* object = nullptr;
-  if (!already_locked) {
-    global_critical_region_.mutex().lock();
-  }
+  // Lookups are too frequent to serialize on the global lock, so they only
+  // keep the table from releasing objects while they take their reference.
+  uint32_t epoch = BeginRead();
 
   // Lower 2 bits are ignored.
   uint32_t slot = handle >> 2;
 
   // Verify slot.
-  if (slot < table_capacity_) {
-    ObjectTableEntry& entry = table_[slot];
-    if (entry.object) {
-      object = entry.object;
-    }
+  XObject* object = nullptr;
+  auto entry = EntryForSlot(slot);
+  if (entry) {
+    object = entry->object.load(std::memory_order_acquire);
   }
 
   // Retain the object pointer.
@@ -289,9 +377,7 @@ XObject* ObjectTable::LookupObject(X_HANDLE handle, bool already_locked) {
     object->Retain();
   }
 
-  if (!already_locked) {
-    global_critical_region_.mutex().unlock();
-  }
+  EndRead(epoch);
 
   return object;
 }
@@ -300,11 +386,11 @@ void ObjectTable::GetObjectsByType(XObject::Type type,
                                    std::vector<object_ref<XObject>>* results) {
   auto global_lock = global_critical_region_.Acquire();
   for (uint32_t slot = 0; slot < table_capacity_; ++slot) {
-    auto& entry = table_[slot];
-    if (entry.object) {
-      if (entry.object->type() == type) {
-        entry.object->Retain();
-        results->push_back(object_ref<XObject>(entry.object));
+    auto object = EntryForSlot(slot)->object.load();
+    if (object) {
+      if (object->type() == type) {
+        object->Retain();
+        results->push_back(object_ref<XObject>(object));
       }
     }
   }
@@ -366,7 +452,7 @@ X_STATUS ObjectTable::GetObjectByName(const std::string& name,
   *out_handle = it->second;
 
   // We need to ref the handle. I think.
-  auto obj = LookupObject(it->second, true);
+  auto obj = LookupObjectInternal(it->second);
   if (obj) {
     obj->RetainHandle();
     obj->Release();
@@ -378,7 +464,7 @@ X_STATUS ObjectTable::GetObjectByName(const std::string& name,
 bool ObjectTable::Save(ByteStream* stream) {
   stream->Write<uint32_t>(table_capacity_);
   for (uint32_t i = 0; i < table_capacity_; i++) {
-    auto& entry = table_[i];
+    auto& entry = *EntryForSlot(i);
     stream->Write<int32_t>(entry.handle_ref_count);
   }
 
@@ -388,7 +474,7 @@ bool ObjectTable::Save(ByteStream* stream) {
 bool ObjectTable::Restore(ByteStream* stream) {
   Resize(stream->Read<uint32_t>());
   for (uint32_t i = 0; i < table_capacity_; i++) {
-    auto& entry = table_[i];
+    auto& entry = *EntryForSlot(i);
     // entry.object = nullptr;
     entry.handle_ref_count = stream->Read<int32_t>();
   }
@@ -398,12 +484,12 @@ bool ObjectTable::Restore(ByteStream* stream) {
 
 X_STATUS ObjectTable::RestoreHandle(X_HANDLE handle, XObject* object) {
   uint32_t slot = handle >> 2;
-  assert_true(table_capacity_ >= slot);
+  assert_true(table_capacity_ > slot);
 
-  if (table_capacity_ >= slot) {
-    auto& entry = table_[slot];
-    entry.object = object;
+  if (table_capacity_ > slot) {
+    auto& entry = *EntryForSlot(slot);
     object->Retain();
+    entry.object = object;
   }
 
   return X_STATUS_SUCCESS;
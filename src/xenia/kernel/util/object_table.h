@@ -10,6 +10,7 @@
 #ifndef XENIA_KERNEL_UTIL_OBJECT_TABLE_H_
 #define XENIA_KERNEL_UTIL_OBJECT_TABLE_H_
 
+#include <atomic>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -48,7 +49,7 @@ class ObjectTable {
 
   template <typename T>
   object_ref<T> LookupObject(X_HANDLE handle) {
-    auto object = LookupObject(handle, false);
+    auto object = LookupObjectInternal(handle);
     if (object) {
       assert_true(object->type() == T::kType);
     }
@@ -81,24 +82,56 @@ class ObjectTable {
   void PurgeAllObjects();  // Purges the object table of all guest objects
 
  private:
-  typedef struct {
+  struct ObjectTableEntry {
+    // Only accessed with the global lock held.
     int handle_ref_count = 0;
-    XObject* object = nullptr;
-  } ObjectTableEntry;
+    // Written with the global lock held, but read by lookups without it.
+    std::atomic<XObject*> object = {nullptr};
+  };
+
+  // Entries live in fixed-size segments that never move once published, so
+  // that lookups can index them while the table grows.
+  static const uint32_t kSegmentShift = 10;
+  static const uint32_t kSegmentSize = 1u << kSegmentShift;
+  static const uint32_t kMaxSegmentCount = 4096;
 
   ObjectTableEntry* LookupTable(X_HANDLE handle);
-  XObject* LookupObject(X_HANDLE handle, bool already_locked);
+  XObject* LookupObjectInternal(X_HANDLE handle);
   void GetObjectsByType(XObject::Type type,
                         std::vector<object_ref<XObject>>* results);
 
   X_HANDLE TranslateHandle(X_HANDLE handle);
+  ObjectTableEntry* EntryForSlot(uint32_t slot) const;
   X_STATUS FindFreeSlot(uint32_t* out_slot);
   bool Resize(uint32_t new_capacity);
 
+  // Lookups don't take the global lock. Instead they count themselves as
+  // readers of the current epoch, and references the table drops are put on
+  // a retire list and only released once all readers that could still see
+  // the object have left. Nothing ever waits for readers, as a reader may be
+  // a guest thread that is suspended in the middle of a lookup.
+  uint32_t BeginRead();
+  void EndRead(uint32_t epoch);
+  // Must be called with the global lock held.
+  void Retire(XObject* object);
+  void Retire(ObjectTableEntry* segment);
+  // Advances the epoch as far as the readers allow and releases whatever was
+  // retired before the oldest epoch that may still have readers.
+  // Must be called with the global lock held.
+  void ReclaimRetired();
+
   xe::global_critical_region global_critical_region_;
   uint32_t table_capacity_ = 0;
-  ObjectTableEntry* table_ = nullptr;
+  std::atomic<ObjectTableEntry*> segments_[kMaxSegmentCount] = {};
   uint32_t last_free_entry_ = 0;
+  std::atomic<uint32_t> epoch_ = {0};
+  std::atomic<uint32_t> reader_counts_[2] = {};
+  struct RetiredEntry {
+    uint32_t epoch;
+    XObject* object;
+    ObjectTableEntry* segment;
+  };
+  std::vector<RetiredEntry> retired_;
   std::unordered_map<std::string, X_HANDLE> name_table_;
 };
 
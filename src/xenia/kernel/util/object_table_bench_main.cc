@@ -0,0 +1,125 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#include <gflags/gflags.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "xenia/base/clock.h"
+#include "xenia/base/logging.h"
+#include "xenia/base/main.h"
+#include "xenia/base/threading.h"
+#include "xenia/kernel/util/object_table.h"
+#include "xenia/kernel/xobject.h"
+
+DEFINE_int32(object_table_bench_threads, 16,
+             "Number of threads looking up handles concurrently.");
+DEFINE_int32(object_table_bench_handles, 1024,
+             "Number of handles in the table.");
+DEFINE_int32(object_table_bench_lookups, 1000000,
+             "Number of lookups done by each thread.");
+DEFINE_bool(object_table_bench_churn, true,
+            "Keep adding and removing handles while the lookups run.");
+
+namespace xe {
+namespace kernel {
+namespace bench {
+
+using util::ObjectTable;
+
+// Threads hammer the table like guest threads waiting on and signaling
+// objects, while another opens and closes handles like guest code creating
+// short-lived events.
+int main(const std::vector<std::wstring>& args) {
+  int thread_count = std::max(1, FLAGS_object_table_bench_threads);
+  int handle_count = std::max(1, FLAGS_object_table_bench_handles);
+  int lookup_count = std::max(1, FLAGS_object_table_bench_lookups);
+
+  ObjectTable object_table;
+  std::vector<X_HANDLE> handles(handle_count);
+  for (auto& handle : handles) {
+    auto object = new XObject(XObject::kTypeEvent);
+    object_table.AddHandle(object, &handle);
+    object->Release();
+  }
+
+  std::atomic<bool> stop_churn = {false};
+  std::atomic<uint64_t> churn_count = {0};
+  std::unique_ptr<xe::threading::Thread> churn_thread;
+  if (FLAGS_object_table_bench_churn) {
+    churn_thread = xe::threading::Thread::Create({}, [&]() {
+      while (!stop_churn) {
+        auto object = new XObject(XObject::kTypeEvent);
+        X_HANDLE handle = 0;
+        object_table.AddHandle(object, &handle);
+        object->Release();
+        object_table.RemoveHandle(handle);
+        ++churn_count;
+      }
+    });
+  }
+
+  auto start_fence = xe::threading::Event::CreateManualResetEvent(false);
+  std::atomic<uint64_t> found_count = {0};
+  std::vector<std::unique_ptr<xe::threading::Thread>> threads;
+  for (int i = 0; i < thread_count; ++i) {
+    threads.push_back(xe::threading::Thread::Create({}, [&, i]() {
+      xe::threading::Wait(start_fence.get(), false);
+      uint64_t found = 0;
+      uint32_t n = uint32_t(i) * 7919;
+      for (int j = 0; j < lookup_count; ++j) {
+        auto object =
+            object_table.LookupObject<XObject>(handles[n++ % handles.size()]);
+        found += object ? 1 : 0;
+      }
+      found_count += found;
+    }));
+  }
+
+  uint64_t start_ticks = Clock::QueryHostTickCount();
+  start_fence->Set();
+  for (auto& thread : threads) {
+    xe::threading::Wait(thread.get(), false);
+  }
+  uint64_t end_ticks = Clock::QueryHostTickCount();
+  stop_churn = true;
+  if (churn_thread) {
+    xe::threading::Wait(churn_thread.get(), false);
+  }
+
+  double seconds =
+      double(end_ticks - start_ticks) / double(Clock::host_tick_frequency());
+  uint64_t total_lookups = uint64_t(thread_count) * lookup_count;
+  XELOGI("Object table bench results:");
+  XELOGI("  %d threads, %d handles, %d lookups each", thread_count,
+         handle_count, lookup_count);
+  XELOGI("  %.3fms, %.2fns/lookup, %.1fM lookups/s", seconds * 1000.0,
+         seconds * 1000000000.0 / total_lookups,
+         seconds > 0.0 ? total_lookups / seconds / 1000000.0 : 0.0);
+  XELOGI("  %" PRIu64 " handles opened and closed concurrently",
+         churn_count.load());
+  if (found_count != total_lookups) {
+    XELOGE("  %" PRIu64 " lookups failed", total_lookups - found_count);
+    return 1;
+  }
+  return 0;
+}
+
+}  // namespace bench
+}  // namespace kernel
+}  // namespace xe
+
+DEFINE_ENTRY_POINT(L"xenia-kernel-object-table-bench",
+                   L"xenia-kernel-object-table-bench",
+                   xe::kernel::bench::main);
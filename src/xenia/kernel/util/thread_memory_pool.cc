@@ -0,0 +1,75 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#include "xenia/kernel/util/thread_memory_pool.h"
+
+#include <iterator>
+
+namespace xe {
+namespace kernel {
+namespace util {
+
+// Each thread has a TLS, a PCR and a scratch block.
+const size_t kSystemBlocksPerThread = 3;
+
+ThreadMemoryPool::ThreadMemoryPool(Memory* memory, size_t max_stack_count)
+    : memory_(memory), max_stack_count_(max_stack_count) {}
+
+ThreadMemoryPool::~ThreadMemoryPool() {
+  for (auto& block : stacks_) {
+    Free(Kind::kStack, block.address);
+  }
+  for (auto& block : system_blocks_) {
+    Free(Kind::kSystemHeap, block.address);
+  }
+}
+
+uint32_t ThreadMemoryPool::Acquire(Kind kind, uint32_t size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& pool = blocks(kind);
+  // Most recently released first, as it is the most likely to be resident.
+  for (auto it = pool.rbegin(); it != pool.rend(); ++it) {
+    if (it->size == size) {
+      uint32_t address = it->address;
+      pool.erase(std::next(it).base());
+      return address;
+    }
+  }
+  return 0;
+}
+
+void ThreadMemoryPool::Release(Kind kind, uint32_t address, uint32_t size) {
+  if (!address) {
+    return;
+  }
+  size_t max_count = kind == Kind::kStack
+                         ? max_stack_count_
+                         : max_stack_count_ * kSystemBlocksPerThread;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& pool = blocks(kind);
+    if (pool.size() < max_count) {
+      pool.push_back({address, size});
+      return;
+    }
+  }
+  Free(kind, address);
+}
+
+void ThreadMemoryPool::Free(Kind kind, uint32_t address) {
+  if (kind == Kind::kStack) {
+    memory_->LookupHeap(address)->Release(address);
+  } else {
+    memory_->SystemHeapFree(address);
+  }
+}
+
+}  // namespace util
+}  // namespace kernel
+}  // namespace xe
@@ -0,0 +1,71 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#ifndef XENIA_KERNEL_UTIL_THREAD_MEMORY_POOL_H_
+#define XENIA_KERNEL_UTIL_THREAD_MEMORY_POOL_H_
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "xenia/memory.h"
+
+namespace xe {
+namespace kernel {
+namespace util {
+
+// Guest memory of destroyed threads (stacks and the TLS, PCR and scratch
+// blocks from the system heap), kept so that threads created afterwards can
+// skip allocating, filling and protecting their own.
+// Titles that start a short-lived thread per job otherwise pay for a fresh
+// stack reservation and a full stack fill every time.
+class ThreadMemoryPool {
+ public:
+  enum class Kind {
+    // Stack allocations in the 0x40000000 heap, guard pages included.
+    kStack,
+    // Blocks from Memory::SystemHeapAlloc.
+    kSystemHeap,
+  };
+
+  ThreadMemoryPool(Memory* memory, size_t max_stack_count);
+  // Frees everything still pooled.
+  ~ThreadMemoryPool();
+
+  // Takes a pooled block of exactly the given size, or returns 0 if there is
+  // none. Contents are whatever the last thread left in them.
+  uint32_t Acquire(Kind kind, uint32_t size);
+
+  // Keeps the block for reuse, or frees it if the pool is full.
+  void Release(Kind kind, uint32_t address, uint32_t size);
+
+ private:
+  struct Block {
+    uint32_t address;
+    uint32_t size;
+  };
+
+  void Free(Kind kind, uint32_t address);
+  std::vector<Block>& blocks(Kind kind) {
+    return kind == Kind::kStack ? stacks_ : system_blocks_;
+  }
+
+  Memory* memory_;
+  size_t max_stack_count_;
+
+  std::mutex mutex_;
+  std::vector<Block> stacks_;
+  std::vector<Block> system_blocks_;
+};
+
+}  // namespace util
+}  // namespace kernel
+}  // namespace xe
+
+#endif  // XENIA_KERNEL_UTIL_THREAD_MEMORY_POOL_H_
@@ -0,0 +1,296 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#include "xenia/kernel/util/timer_wheel.h"
+
+#include <algorithm>
+
+#include "xenia/base/assert.h"
+#include "xenia/base/clock.h"
+#include "xenia/base/math.h"
+
+namespace xe {
+namespace kernel {
+namespace util {
+
+TimerWheel::Timer::~Timer() {
+  auto wheel = wheel_.load();
+  if (wheel) {
+    wheel->Cancel(this);
+  }
+}
+
+TimerWheel::Duration TimerWheel::GuestDueTimeToDuration(
+    int64_t guest_due_time) {
+  int64_t relative_time;
+  if (guest_due_time < 0) {
+    relative_time = -guest_due_time;
+  } else if (guest_due_time > 0) {
+    // Absolute time, based on January 1, 1601.
+    relative_time = std::max(
+        int64_t(0),
+        guest_due_time - int64_t(xe::Clock::QueryGuestSystemTime()));
+  } else {
+    relative_time = 0;
+  }
+  return Duration(int64_t(relative_time * xe::Clock::guest_time_scalar()));
+}
+
+TimerWheel::TimerWheel() {
+  current_tick_ = NowTick();
+  wake_tick_ = UINT64_MAX;
+
+  xe::threading::Thread::CreationParameters params;
+  params.stack_size = 256 * 1024;
+  wheel_thread_ =
+      xe::threading::Thread::Create(params, [this]() { WheelMain(); });
+  assert_not_null(wheel_thread_);
+  wheel_thread_->set_name("Timer Wheel");
+}
+
+TimerWheel::TimerWheel(uint64_t start_tick) {
+  current_tick_ = start_tick;
+  wake_tick_ = UINT64_MAX;
+  manual_ = true;
+  manual_tick_ = start_tick;
+}
+
+TimerWheel::~TimerWheel() {
+  if (wheel_thread_) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      shutting_down_ = true;
+    }
+    wake_cond_.notify_all();
+    xe::threading::Wait(wheel_thread_.get(), false);
+  }
+
+  // Forget any timers still pending so that they don't try to cancel
+  // themselves later on.
+  for (auto& level_slots : slots_) {
+    for (auto timer : level_slots) {
+      for (; timer; timer = timer->next_) {
+        timer->wheel_ = nullptr;
+        timer->level_ = -1;
+      }
+    }
+  }
+}
+
+uint64_t TimerWheel::NowTick() {
+  return uint64_t(std::chrono::duration_cast<Duration>(
+                      std::chrono::steady_clock::now().time_since_epoch())
+                      .count());
+}
+
+void TimerWheel::Set(Timer* timer, Duration due_time, Duration period,
+                     std::function<void()> callback) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  uint64_t due_tick = (manual_ ? manual_tick_ : NowTick()) +
+                      uint64_t(std::max(int64_t(0), due_time.count()));
+  if (timer->is_pending()) {
+    Unlink(timer);
+  }
+  timer->due_tick_ = due_tick;
+  timer->period_ticks_ = uint64_t(std::max(int64_t(0), period.count()));
+  timer->callback_ = std::move(callback);
+  Link(timer);
+  if (timer->due_tick_ < wake_tick_) {
+    wake_cond_.notify_one();
+  }
+}
+
+bool TimerWheel::Cancel(Timer* timer) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!timer->is_pending()) {
+    return false;
+  }
+  Unlink(timer);
+  return true;
+}
+
+void TimerWheel::AdvanceTo(uint64_t now_tick) {
+  assert_true(manual_);
+  std::vector<std::function<void()>> fired;
+  std::unique_lock<std::mutex> lock(mutex_);
+  manual_tick_ = std::max(manual_tick_, now_tick);
+  while (true) {
+    // Timers set by the callbacks may already be due too.
+    Advance(manual_tick_, &fired);
+    if (fired.empty()) {
+      break;
+    }
+    RunFired(&lock, &fired);
+  }
+}
+
+void TimerWheel::Link(Timer* timer) {
+  // Anything already due goes in the current slot, which is still checked.
+  timer->due_tick_ = std::max(timer->due_tick_, current_tick_);
+
+  // File the timer at the level of the highest bit it differs from the
+  // current tick in: all higher bits match, so it will be cascaded down (or
+  // fired, on level 0) when the current tick reaches its slot.
+  uint64_t differing_bits = timer->due_tick_ ^ current_tick_;
+  int level = 0;
+  if (differing_bits) {
+    level = (63 - xe::lzcnt(differing_bits)) / kBitsPerLevel;
+  }
+  int slot =
+      int((timer->due_tick_ >> (level * kBitsPerLevel)) & (kSlotCount - 1));
+
+  Timer*& head = slots_[level][slot];
+  timer->wheel_ = this;
+  timer->level_ = level;
+  timer->slot_ = slot;
+  timer->prev_ = nullptr;
+  timer->next_ = head;
+  if (head) {
+    head->prev_ = timer;
+  }
+  head = timer;
+  occupied_slots_[level] |= uint64_t(1) << slot;
+}
+
+void TimerWheel::Unlink(Timer* timer) {
+  if (timer->prev_) {
+    timer->prev_->next_ = timer->next_;
+  } else {
+    slots_[timer->level_][timer->slot_] = timer->next_;
+    if (!timer->next_) {
+      occupied_slots_[timer->level_] &= ~(uint64_t(1) << timer->slot_);
+    }
+  }
+  if (timer->next_) {
+    timer->next_->prev_ = timer->prev_;
+  }
+  timer->wheel_ = nullptr;
+  timer->prev_ = nullptr;
+  timer->next_ = nullptr;
+  timer->level_ = -1;
+  timer->slot_ = -1;
+}
+
+uint64_t TimerWheel::NextEventTick() const {
+  uint64_t next_tick = UINT64_MAX;
+  for (int level = 0; level < kLevelCount; ++level) {
+    if (!occupied_slots_[level]) {
+      continue;
+    }
+    // Timers are always filed at or after the current slot of their level.
+    int shift = level * kBitsPerLevel;
+    int current_slot = int((current_tick_ >> shift) & (kSlotCount - 1));
+    uint64_t slots = occupied_slots_[level] & (UINT64_MAX << current_slot);
+    assert_not_zero(slots);
+    uint64_t slot = xe::tzcnt(slots);
+    int next_shift = shift + kBitsPerLevel;
+    uint64_t base_tick =
+        next_shift < 64 ? (current_tick_ >> next_shift) << next_shift : 0;
+    next_tick = std::min(next_tick, base_tick | (slot << shift));
+  }
+  return next_tick;
+}
+
+void TimerWheel::Advance(uint64_t now,
+                         std::vector<std::function<void()>>* out_fired) {
+  while (true) {
+    // Jump straight to the next slot with timers in it; the slots in between
+    // are empty.
+    uint64_t next_tick = NextEventTick();
+    if (next_tick > now) {
+      current_tick_ = std::max(current_tick_, now);
+      return;
+    }
+    current_tick_ = next_tick;
+
+    // Cascade the slots starting at this tick, highest level first so that
+    // timers can drop several levels at once.
+    for (int level = kLevelCount - 1; level > 0; --level) {
+      int shift = level * kBitsPerLevel;
+      if (current_tick_ & ((uint64_t(1) << shift) - 1)) {
+        continue;
+      }
+      int slot = int((current_tick_ >> shift) & (kSlotCount - 1));
+      Timer* timer = slots_[level][slot];
+      slots_[level][slot] = nullptr;
+      occupied_slots_[level] &= ~(uint64_t(1) << slot);
+      while (timer) {
+        Timer* next_timer = timer->next_;
+        Link(timer);
+        timer = next_timer;
+      }
+    }
+
+    // Fire everything due now.
+    int slot = int(current_tick_ & (kSlotCount - 1));
+    Timer* timer = slots_[0][slot];
+    slots_[0][slot] = nullptr;
+    occupied_slots_[0] &= ~(uint64_t(1) << slot);
+    while (timer) {
+      Timer* next_timer = timer->next_;
+      out_fired->push_back(timer->callback_);
+      if (timer->period_ticks_) {
+        // Periods missed while behind are dropped rather than fired in a
+        // burst, so the next one is the first still ahead of now.
+        timer->due_tick_ +=
+            timer->period_ticks_ *
+            ((now - timer->due_tick_) / timer->period_ticks_ + 1);
+        Link(timer);
+      } else {
+        timer->wheel_ = nullptr;
+        timer->prev_ = nullptr;
+        timer->next_ = nullptr;
+        timer->level_ = -1;
+        timer->slot_ = -1;
+      }
+      timer = next_timer;
+    }
+  }
+}
+
+void TimerWheel::RunFired(std::unique_lock<std::mutex>* lock,
+                          std::vector<std::function<void()>>* fired) {
+  lock->unlock();
+  for (auto& callback : *fired) {
+    if (callback) {
+      callback();
+    }
+  }
+  fired->clear();
+  lock->lock();
+}
+
+void TimerWheel::WheelMain() {
+  std::vector<std::function<void()>> fired;
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!shutting_down_) {
+    Advance(NowTick(), &fired);
+    if (!fired.empty()) {
+      // Timers set by the callbacks are picked up on the next pass.
+      wake_tick_ = 0;
+      RunFired(&lock, &fired);
+      continue;
+    }
+
+    wake_tick_ = NextEventTick();
+    if (wake_tick_ == UINT64_MAX) {
+      wake_cond_.wait(lock);
+    } else {
+      wake_cond_.wait_until(
+          lock, std::chrono::steady_clock::time_point(
+                    std::chrono::duration_cast<
+                        std::chrono::steady_clock::duration>(
+                        Duration(int64_t(wake_tick_)))));
+    }
+  }
+}
+
+}  // namespace util
+}  // namespace kernel
+}  // namespace xe
@@ -0,0 +1,128 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#ifndef XENIA_KERNEL_UTIL_TIMER_WHEEL_H_
+#define XENIA_KERNEL_UTIL_TIMER_WHEEL_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ratio>
+#include <vector>
+
+#include "xenia/base/threading.h"
+
+namespace xe {
+namespace kernel {
+namespace util {
+
+// Runs the callbacks of any number of timers from a single host thread, rather
+// than giving each guest timer a host timer object of its own.
+// Timers are kept in a hierarchical wheel of 64 slots per level, with a tick
+// of 100ns (the unit of guest due times), so arming and canceling are O(1)
+// and the thread only wakes when the next timer is due.
+// Callbacks run on the wheel thread without any lock held; they must be
+// short, and must only reference things they own, as a callback that was
+// already on its way out may still run once after its timer is canceled or
+// destroyed.
+class TimerWheel {
+ public:
+  // 100ns ticks, as in guest FILETIMEs.
+  using Duration = std::chrono::duration<int64_t, std::ratio<1, 10000000>>;
+
+  class Timer {
+   public:
+    Timer() = default;
+    ~Timer();
+
+    bool is_pending() const { return level_ >= 0; }
+
+   private:
+    friend class TimerWheel;
+
+    // Set while pending, so that destroying the timer can cancel it.
+    std::atomic<TimerWheel*> wheel_ = {nullptr};
+    Timer* prev_ = nullptr;
+    Timer* next_ = nullptr;
+    // Level and slot the timer is linked into, or -1 if not pending.
+    int level_ = -1;
+    int slot_ = -1;
+    uint64_t due_tick_ = 0;
+    uint64_t period_ticks_ = 0;
+    std::function<void()> callback_;
+  };
+
+  // Converts a guest due time (negative for relative 100ns intervals,
+  // positive for an absolute guest system time) to a scaled host duration from
+  // now.
+  static Duration GuestDueTimeToDuration(int64_t guest_due_time);
+
+  TimerWheel();
+  // Creates a wheel with no thread of its own, whose clock starts at
+  // start_tick and only moves when AdvanceTo is called. For tests.
+  explicit TimerWheel(uint64_t start_tick);
+  ~TimerWheel();
+
+  // Arms the timer to run the callback once due_time from now has passed,
+  // and then every period if it is nonzero. Rearms it if already pending.
+  void Set(Timer* timer, Duration due_time, Duration period,
+           std::function<void()> callback);
+  // Disarms the timer. Returns false if it wasn't pending.
+  bool Cancel(Timer* timer);
+
+  // Moves the clock of a wheel created with a start tick up to now_tick,
+  // running the callbacks of the timers due by then on the calling thread.
+  void AdvanceTo(uint64_t now_tick);
+
+ private:
+  static const int kBitsPerLevel = 6;
+  static const int kSlotCount = 1 << kBitsPerLevel;
+  // Enough levels for any 64-bit tick, so there is no overflow list.
+  static const int kLevelCount = (64 + kBitsPerLevel - 1) / kBitsPerLevel;
+
+  static uint64_t NowTick();
+
+  void Link(Timer* timer);
+  void Unlink(Timer* timer);
+  // Tick at which the earliest slot with timers in it starts, or UINT64_MAX.
+  uint64_t NextEventTick() const;
+  // Moves current_tick_ up to now, collecting the callbacks of the timers that
+  // are due and rearming periodic ones.
+  void Advance(uint64_t now, std::vector<std::function<void()>>* out_fired);
+  // Runs and clears the collected callbacks with the lock released.
+  void RunFired(std::unique_lock<std::mutex>* lock,
+                std::vector<std::function<void()>>* fired);
+  void WheelMain();
+
+  std::mutex mutex_;
+  std::condition_variable wake_cond_;
+  // All timers due at or before this tick have been fired.
+  uint64_t current_tick_ = 0;
+  // When the wheel thread will next wake up by itself.
+  uint64_t wake_tick_ = 0;
+  bool shutting_down_ = false;
+  // Set for wheels driven by AdvanceTo, whose clock is manual_tick_.
+  bool manual_ = false;
+  uint64_t manual_tick_ = 0;
+  Timer* slots_[kLevelCount][kSlotCount] = {};
+  // Bit per slot that has timers in it.
+  uint64_t occupied_slots_[kLevelCount] = {};
+
+  std::unique_ptr<xe::threading::Thread> wheel_thread_;
+};
+
+}  // namespace util
+}  // namespace kernel
+}  // namespace xe
+
+#endif  // XENIA_KERNEL_UTIL_TIMER_WHEEL_H_
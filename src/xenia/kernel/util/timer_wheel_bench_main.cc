@@ -0,0 +1,113 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#include <gflags/gflags.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "xenia/base/clock.h"
+#include "xenia/base/logging.h"
+#include "xenia/base/main.h"
+#include "xenia/base/threading.h"
+#include "xenia/kernel/util/timer_wheel.h"
+
+DEFINE_int32(timer_wheel_bench_timers, 4096, "Number of timers armed at once.");
+DEFINE_int32(timer_wheel_bench_max_due_ms, 50,
+             "Timers are due at random times up to this many ms from now.");
+
+namespace xe {
+namespace kernel {
+namespace bench {
+
+using util::TimerWheel;
+
+double ElapsedMs(uint64_t start_ticks) {
+  return double(Clock::QueryHostTickCount() - start_ticks) * 1000.0 /
+         double(Clock::host_tick_frequency());
+}
+
+// Arms many timers like a title full of timed waits and delays, measuring the
+// cost of arming and canceling them and how late the ones left fire.
+int main(const std::vector<std::wstring>& args) {
+  int timer_count = std::max(2, FLAGS_timer_wheel_bench_timers);
+  int64_t max_due_ticks =
+      std::max(1, FLAGS_timer_wheel_bench_max_due_ms) * int64_t(10000);
+
+  TimerWheel timer_wheel;
+  std::vector<std::unique_ptr<TimerWheel::Timer>> timers(timer_count);
+  for (auto& timer : timers) {
+    timer = std::make_unique<TimerWheel::Timer>();
+  }
+
+  std::atomic<int> fired_count = {0};
+  std::atomic<int64_t> total_lateness_ticks = {0};
+  std::atomic<int64_t> max_lateness_ticks = {0};
+  auto on_fired = [&](std::chrono::steady_clock::time_point due_point) {
+    int64_t lateness_ticks = std::chrono::duration_cast<TimerWheel::Duration>(
+                                 std::chrono::steady_clock::now() - due_point)
+                                 .count();
+    total_lateness_ticks += lateness_ticks;
+    int64_t max_ticks = max_lateness_ticks;
+    while (lateness_ticks > max_ticks &&
+           !max_lateness_ticks.compare_exchange_weak(max_ticks,
+                                                     lateness_ticks)) {
+    }
+    ++fired_count;
+  };
+
+  uint32_t seed = 0x12345678;
+  uint64_t start_ticks = Clock::QueryHostTickCount();
+  for (auto& timer : timers) {
+    seed = seed * 1103515245 + 12345;
+    TimerWheel::Duration due_time(int64_t(seed >> 8) % max_due_ticks);
+    auto due_point = std::chrono::steady_clock::now() + due_time;
+    timer_wheel.Set(timer.get(), due_time, TimerWheel::Duration::zero(),
+                    [&on_fired, due_point]() { on_fired(due_point); });
+  }
+  double set_ms = ElapsedMs(start_ticks);
+
+  // Cancel every other timer, as most guest waits are satisfied before they
+  // time out.
+  start_ticks = Clock::QueryHostTickCount();
+  int canceled_count = 0;
+  for (int i = 0; i < timer_count; i += 2) {
+    canceled_count += timer_wheel.Cancel(timers[i].get()) ? 1 : 0;
+  }
+  double cancel_ms = ElapsedMs(start_ticks);
+
+  // Timers that fired before they could be canceled count as fired.
+  while (fired_count < timer_count - canceled_count) {
+    xe::threading::Sleep(std::chrono::milliseconds(1));
+  }
+
+  int fired = fired_count;
+  XELOGI("Timer wheel bench results:");
+  XELOGI("  %d timers due within %dms", timer_count,
+         FLAGS_timer_wheel_bench_max_due_ms);
+  XELOGI("  set: %.3fms, %.1fns/timer", set_ms,
+         set_ms * 1000000.0 / timer_count);
+  XELOGI("  cancel: %.3fms, %.1fns/timer (%d canceled)", cancel_ms,
+         cancel_ms * 1000000.0 / (timer_count / 2), canceled_count);
+  XELOGI("  fired: %d, lateness avg %.1fus, max %.1fus", fired,
+         fired ? total_lateness_ticks / 10.0 / fired : 0.0,
+         max_lateness_ticks / 10.0);
+  return 0;
+}
+
+}  // namespace bench
+}  // namespace kernel
+}  // namespace xe
+
+DEFINE_ENTRY_POINT(L"xenia-kernel-timer-wheel-bench",
+                   L"xenia-kernel-timer-wheel-bench", xe::kernel::bench::main);
@@ -0,0 +1,183 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#include "xenia/kernel/util/timer_wheel.h"
+
+#include <vector>
+
+#include "xenia/base/math.h"
+
+#include "third_party/catch/include/catch.hpp"
+
+namespace xe {
+namespace kernel {
+namespace util {
+namespace test {
+
+using Duration = TimerWheel::Duration;
+
+// Not aligned to any level, so that timers are filed above level 0 and have
+// to be cascaded down.
+const uint64_t kStartTick = 0x123456789;
+
+TEST_CASE("timer_wheel_one_shot", "TimerWheel") {
+  std::vector<uint64_t> fire_ticks;
+  uint64_t now_tick = kStartTick;
+  TimerWheel timer_wheel(kStartTick);
+  TimerWheel::Timer timer;
+  timer_wheel.Set(&timer, Duration(20), Duration::zero(),
+                  [&]() { fire_ticks.push_back(now_tick); });
+  REQUIRE(timer.is_pending());
+
+  now_tick = kStartTick + 19;
+  timer_wheel.AdvanceTo(now_tick);
+  REQUIRE(fire_ticks.empty());
+  REQUIRE(timer.is_pending());
+
+  now_tick = kStartTick + 20;
+  timer_wheel.AdvanceTo(now_tick);
+  REQUIRE(fire_ticks == std::vector<uint64_t>{kStartTick + 20});
+  REQUIRE_FALSE(timer.is_pending());
+
+  timer_wheel.AdvanceTo(kStartTick + 100000);
+  REQUIRE(fire_ticks.size() == 1);
+}
+
+TEST_CASE("timer_wheel_zero_due_time", "TimerWheel") {
+  int fired_count = 0;
+  TimerWheel timer_wheel(kStartTick);
+  TimerWheel::Timer timer;
+  timer_wheel.Set(&timer, Duration::zero(), Duration::zero(),
+                  [&]() { ++fired_count; });
+  timer_wheel.AdvanceTo(kStartTick);
+  REQUIRE(fired_count == 1);
+}
+
+TEST_CASE("timer_wheel_cancel", "TimerWheel") {
+  int fired_count = 0;
+  TimerWheel timer_wheel(kStartTick);
+  TimerWheel::Timer timer;
+  timer_wheel.Set(&timer, Duration(20), Duration::zero(),
+                  [&]() { ++fired_count; });
+  timer_wheel.AdvanceTo(kStartTick + 10);
+  REQUIRE(timer_wheel.Cancel(&timer));
+  REQUIRE_FALSE(timer_wheel.Cancel(&timer));
+  REQUIRE_FALSE(timer.is_pending());
+  timer_wheel.AdvanceTo(kStartTick + 100);
+  REQUIRE(fired_count == 0);
+}
+
+TEST_CASE("timer_wheel_rearm", "TimerWheel") {
+  std::vector<int> fired;
+  TimerWheel timer_wheel(kStartTick);
+  TimerWheel::Timer timer;
+  timer_wheel.Set(&timer, Duration(20), Duration::zero(),
+                  [&]() { fired.push_back(1); });
+  timer_wheel.AdvanceTo(kStartTick + 10);
+  // Due 50 ticks from the rearm, not from the first set.
+  timer_wheel.Set(&timer, Duration(50), Duration::zero(),
+                  [&]() { fired.push_back(2); });
+  timer_wheel.AdvanceTo(kStartTick + 59);
+  REQUIRE(fired.empty());
+  timer_wheel.AdvanceTo(kStartTick + 60);
+  REQUIRE(fired == std::vector<int>{2});
+}
+
+TEST_CASE("timer_wheel_fires_in_due_order", "TimerWheel") {
+  // Due times spread over several levels, set out of order.
+  const uint64_t due_ticks[] = {
+      70000, 3, 64, 4096 + 5, 63, 1, 5000000, 65, 262144,
+  };
+  std::vector<uint64_t> fired_due_ticks;
+  uint64_t now_tick = kStartTick;
+  TimerWheel timer_wheel(kStartTick);
+  TimerWheel::Timer timers[xe::countof(due_ticks)];
+  for (size_t i = 0; i < xe::countof(due_ticks); ++i) {
+    uint64_t due_tick = due_ticks[i];
+    timer_wheel.Set(&timers[i], Duration(int64_t(due_tick)), Duration::zero(),
+                    [&, due_tick]() { fired_due_ticks.push_back(due_tick); });
+  }
+
+  // Stepping one tick at a time fires each timer exactly on its due tick.
+  std::vector<uint64_t> expected;
+  for (uint64_t tick = 1; tick <= 70000; ++tick) {
+    now_tick = kStartTick + tick;
+    timer_wheel.AdvanceTo(now_tick);
+    for (auto due_tick : due_ticks) {
+      if (due_tick == tick) {
+        expected.push_back(due_tick);
+      }
+    }
+    REQUIRE(fired_due_ticks == expected);
+  }
+
+  // A single big jump fires the rest in due order.
+  timer_wheel.AdvanceTo(kStartTick + 10000000);
+  expected.push_back(262144);
+  expected.push_back(5000000);
+  REQUIRE(fired_due_ticks == expected);
+  for (auto& timer : timers) {
+    REQUIRE_FALSE(timer.is_pending());
+  }
+}
+
+TEST_CASE("timer_wheel_periodic_drops_missed_periods", "TimerWheel") {
+  std::vector<uint64_t> fire_ticks;
+  uint64_t now_tick = kStartTick;
+  TimerWheel timer_wheel(kStartTick);
+  TimerWheel::Timer timer;
+  timer_wheel.Set(&timer, Duration(10), Duration(10),
+                  [&]() { fire_ticks.push_back(now_tick); });
+
+  for (int i = 0; i < 3; ++i) {
+    now_tick += 10;
+    timer_wheel.AdvanceTo(now_tick);
+  }
+  REQUIRE(fire_ticks == std::vector<uint64_t>{
+                            kStartTick + 10, kStartTick + 20, kStartTick + 30,
+                        });
+
+  // Falling behind by several periods fires once, not once per missed
+  // period, and the next fire stays on the original phase.
+  now_tick = kStartTick + 95;
+  timer_wheel.AdvanceTo(now_tick);
+  REQUIRE(fire_ticks.size() == 4);
+  REQUIRE(fire_ticks.back() == kStartTick + 95);
+  now_tick = kStartTick + 99;
+  timer_wheel.AdvanceTo(now_tick);
+  REQUIRE(fire_ticks.size() == 4);
+  now_tick = kStartTick + 100;
+  timer_wheel.AdvanceTo(now_tick);
+  REQUIRE(fire_ticks.size() == 5);
+  REQUIRE(fire_ticks.back() == kStartTick + 100);
+
+  REQUIRE(timer_wheel.Cancel(&timer));
+  timer_wheel.AdvanceTo(kStartTick + 1000);
+  REQUIRE(fire_ticks.size() == 5);
+}
+
+TEST_CASE("timer_wheel_set_from_callback", "TimerWheel") {
+  std::vector<int> fired;
+  TimerWheel timer_wheel(kStartTick);
+  TimerWheel::Timer first_timer;
+  TimerWheel::Timer second_timer;
+  timer_wheel.Set(&first_timer, Duration(10), Duration::zero(), [&]() {
+    fired.push_back(1);
+    // Due immediately, so picked up by the same advance.
+    timer_wheel.Set(&second_timer, Duration::zero(), Duration::zero(),
+                    [&]() { fired.push_back(2); });
+  });
+  timer_wheel.AdvanceTo(kStartTick + 10);
+  REQUIRE(fired == std::vector<int>{1, 2});
+}
+
+}  // namespace test
+}  // namespace util
+}  // namespace kernel
+}  // namespace xe
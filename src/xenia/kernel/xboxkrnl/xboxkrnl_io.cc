@@ -146,6 +146,50 @@ dword_result_t NtOpenFile(lpdword_t handle_out, dword_t desired_access,
 }
 DECLARE_XBOXKRNL_EXPORT(NtOpenFile, ExportTag::kImplemented);
 
+// Finishes a read or write like the I/O manager does once the request is
+// done: fills in the status block, signals the event and queues the APC to
+// the thread that issued it. I/O completion ports are notified by XFile.
+void CompleteFileIo(X_STATUS result, size_t length,
+                    uint32_t io_status_block_ptr, XEvent* ev, XThread* thread,
+                    uint32_t apc_routine, uint32_t apc_context) {
+  if (io_status_block_ptr) {
+    auto io_status_block =
+        kernel_memory()->TranslateVirtual<X_IO_STATUS_BLOCK*>(
+            io_status_block_ptr);
+    io_status_block->status = result;
+    io_status_block->information = static_cast<uint32_t>(length);
+  }
+
+  // Signal the event only once the status block is written.
+  if (ev) {
+    ev->Set(0, false);
+  }
+
+  // The APC must be delivered via the APC mechanism even when completing
+  // immediately.
+  // Low bit probably means do not queue to IO ports.
+  if ((apc_routine & ~1u) && apc_context && thread) {
+    thread->EnqueueApc(apc_routine & ~1u, apc_context, io_status_block_ptr, 0);
+  }
+}
+
+// Whether a request on the file is serviced by the I/O workers. The guest
+// thread only waits for it when it opened the file for synchronous I/O.
+bool IsAsyncFileIo(XFile* file) {
+  return !file->is_synchronous() && kernel_state()->io_worker_pool();
+}
+
+// Lets watches on physical memory (such as the GPU's texture cache) know that a
+// read is overwriting the buffer.
+void InvalidateReadBuffer(uint32_t buffer_ptr, uint32_t length) {
+  // TODO(rick): better checking of physical address
+  if (buffer_ptr >= 0xA0000000) {
+    auto heap = kernel_memory()->LookupHeap(buffer_ptr);
+    cpu::MMIOHandler::global_handler()->InvalidateRange(
+        heap->GetPhysicalAddress(buffer_ptr), length);
+  }
+}
+
 dword_result_t NtReadFile(dword_t file_handle, dword_t event_handle,
                           lpvoid_t apc_routine_ptr, lpvoid_t apc_context,
                           pointer_t<X_IO_STATUS_BLOCK> io_status_block,
@@ -153,7 +197,6 @@ dword_result_t NtReadFile(dword_t file_handle, dword_t event_handle,
                           lpqword_t byte_offset_ptr) {
   X_STATUS result = X_STATUS_SUCCESS;
 
-  bool signal_event = false;
   auto ev = kernel_state()->object_table()->LookupObject<XEvent>(event_handle);
   if (event_handle && !ev) {
     result = X_STATUS_INVALID_HANDLE;
@@ -164,76 +207,64 @@ dword_result_t NtReadFile(dword_t file_handle, dword_t event_handle,
     result = X_STATUS_INVALID_HANDLE;
   }
 
-  if (XSUCCEEDED(result)) {
-    if (true || file->is_synchronous()) {
-      // some games NtReadFile() directly into texture memory
-      // TODO(rick): better checking of physical address
-      if (buffer.guest_address() >= 0xA0000000) {
-        auto heap = kernel_memory()->LookupHeap(buffer.guest_address());
-        cpu::MMIOHandler::global_handler()->InvalidateRange(
-            heap->GetPhysicalAddress(buffer.guest_address()), buffer_length);
-      }
-
-      // Synchronous.
-      size_t bytes_read = 0;
-      result = file->Read(
-          buffer, buffer_length,
-          byte_offset_ptr ? static_cast<uint64_t>(*byte_offset_ptr) : -1,
-          &bytes_read, apc_context);
-      if (io_status_block) {
-        io_status_block->status = result;
-        io_status_block->information = static_cast<uint32_t>(bytes_read);
-      }
-
-      // Queue the APC callback. It must be delivered via the APC mechanism even
-      // though were are completing immediately.
-      // Low bit probably means do not queue to IO ports.
-      if ((uint32_t)apc_routine_ptr & ~1) {
-        if (apc_context) {
-          auto thread = XThread::GetCurrentThread();
-          thread->EnqueueApc(static_cast<uint32_t>(apc_routine_ptr) & ~1u,
-                             apc_context, io_status_block, 0);
-        }
-      }
-
-      if (!file->is_synchronous()) {
-        result = X_STATUS_PENDING;
-      }
-
-      // Mark that we should signal the event now. We do this after
-      // we have written the info out.
-      signal_event = true;
-    } else {
-      // TODO(benvanik): async.
-
-      // X_STATUS_PENDING if not returning immediately.
-      // XFile is waitable and signalled after each async req completes.
-      // reset the input event (->Reset())
-      /*xeNtReadFileState* call_state = new xeNtReadFileState();
-      XAsyncRequest* request = new XAsyncRequest(
-      state, file,
-      (XAsyncRequest::CompletionCallback)xeNtReadFileCompleted,
-      call_state);*/
-      // result = file->Read(buffer, buffer_length, byte_offset, request);
-      if (io_status_block) {
-        io_status_block->status = X_STATUS_PENDING;
-        io_status_block->information = 0;
-      }
-
+  if (XFAILED(result)) {
+    if (io_status_block) {
+      io_status_block->status = result;
+      io_status_block->information = 0;
+    }
+    return result;
+  }
+
+  // some games NtReadFile() directly into texture memory
+  InvalidateReadBuffer(buffer.guest_address(), buffer_length);
+
+  size_t byte_offset =
+      byte_offset_ptr ? static_cast<uint64_t>(*byte_offset_ptr) : -1;
+  if (!IsAsyncFileIo(file.get())) {
+    // Synchronous.
+    size_t bytes_read = 0;
+    result = file->Read(buffer, buffer_length, byte_offset, &bytes_read,
+                        apc_context);
+    CompleteFileIo(result, bytes_read, io_status_block.guest_address(),
+                   ev.get(), XThread::GetCurrentThread(), apc_routine_ptr,
+                   apc_context);
+    if (XSUCCEEDED(result) && !file->is_synchronous()) {
       result = X_STATUS_PENDING;
     }
+    return result;
   }
 
-  if (XFAILED(result) && io_status_block) {
-    io_status_block->status = result;
+  // Asynchronous: XFile::Read runs on an I/O worker and the request is
+  // completed from there.
+  if (io_status_block) {
+    io_status_block->status = X_STATUS_PENDING;
     io_status_block->information = 0;
   }
-
-  if (ev && signal_event) {
-    ev->Set(0, false);
-  }
-
-  return result;
+  if (ev) {
+    ev->Reset();
+  }
+  bool at_position = byte_offset == -1;
+  byte_offset = file->BeginAsyncIo(byte_offset, buffer_length);
+  uint32_t buffer_ptr = buffer.guest_address();
+  uint32_t length = buffer_length;
+  uint32_t io_status_block_ptr = io_status_block.guest_address();
+  uint32_t apc_routine = apc_routine_ptr.guest_address();
+  uint32_t context = apc_context.guest_address();
+  auto thread = retain_object(XThread::GetCurrentThread());
+  kernel_state()->io_worker_pool()->Submit(
+      [file, ev, thread, buffer_ptr, length, byte_offset, at_position,
+       io_status_block_ptr, apc_routine, context]() {
+        size_t bytes_read = 0;
+        X_STATUS read_result =
+            file->Read(kernel_memory()->TranslateVirtual(buffer_ptr), length,
+                       byte_offset, &bytes_read, context, at_position);
+        // The data only landed now, after anything that cached the buffer
+        // since the request was made.
+        InvalidateReadBuffer(buffer_ptr, length);
+        CompleteFileIo(read_result, bytes_read, io_status_block_ptr, ev.get(),
+                       thread.get(), apc_routine, context);
+      });
+  return X_STATUS_PENDING;
 }
 DECLARE_XBOXKRNL_EXPORT(NtReadFile,
                         ExportTag::kImplemented | ExportTag::kHighFrequency);
@@ -243,14 +274,9 @@ dword_result_t NtWriteFile(dword_t file_handle, dword_t event_handle,
                            pointer_t<X_IO_STATUS_BLOCK> io_status_block,
                            lpvoid_t buffer, dword_t buffer_length,
                            lpqword_t byte_offset_ptr) {
-  // Async not supported yet.
-  assert_zero(apc_routine);
-
   X_STATUS result = X_STATUS_SUCCESS;
-  uint32_t info = 0;
 
   // Grab event to signal.
-  bool signal_event = false;
   auto ev = kernel_state()->object_table()->LookupObject<XEvent>(event_handle);
   if (event_handle && !ev) {
     result = X_STATUS_INVALID_HANDLE;
@@ -262,54 +288,58 @@ dword_result_t NtWriteFile(dword_t file_handle, dword_t event_handle,
     result = X_STATUS_INVALID_HANDLE;
   }
 
-  // Execute write.
-  if (XSUCCEEDED(result)) {
-    // TODO(benvanik): async path.
-    if (true || file->is_synchronous()) {
-      // Synchronous request.
-      size_t bytes_written = 0;
-      result = file->Write(
-          buffer, buffer_length,
-          byte_offset_ptr ? static_cast<uint64_t>(*byte_offset_ptr) : -1,
-          &bytes_written, apc_context);
-      if (XSUCCEEDED(result)) {
-        info = (int32_t)bytes_written;
-      }
-
-      if (!file->is_synchronous()) {
-        result = X_STATUS_PENDING;
-      }
-
-      if (io_status_block) {
-        io_status_block->status = X_STATUS_SUCCESS;
-        io_status_block->information = info;
-      }
-
-      // Mark that we should signal the event now. We do this after
-      // we have written the info out.
-      signal_event = true;
-    } else {
-      // X_STATUS_PENDING if not returning immediately.
+  if (XFAILED(result)) {
+    if (io_status_block) {
+      io_status_block->status = result;
+      io_status_block->information = 0;
+    }
+    return result;
+  }
+
+  size_t byte_offset =
+      byte_offset_ptr ? static_cast<uint64_t>(*byte_offset_ptr) : -1;
+  if (!IsAsyncFileIo(file.get())) {
+    // Synchronous request.
+    size_t bytes_written = 0;
+    result = file->Write(buffer, buffer_length, byte_offset, &bytes_written,
+                         apc_context);
+    CompleteFileIo(result, bytes_written, io_status_block.guest_address(),
+                   ev.get(), XThread::GetCurrentThread(), apc_routine,
+                   apc_context);
+    if (XSUCCEEDED(result) && !file->is_synchronous()) {
       result = X_STATUS_PENDING;
-      info = 0;
-
-      if (io_status_block) {
-        io_status_block->status = X_STATUS_SUCCESS;
-        io_status_block->information = info;
-      }
     }
+    return result;
   }
 
-  if (XFAILED(result) && io_status_block) {
-    io_status_block->status = result;
+  // Asynchronous: XFile::Write runs on an I/O worker and the request is
+  // completed from there.
+  if (io_status_block) {
+    io_status_block->status = X_STATUS_PENDING;
     io_status_block->information = 0;
   }
-
-  if (ev && signal_event) {
-    ev->Set(0, false);
-  }
-
-  return result;
+  if (ev) {
+    ev->Reset();
+  }
+  bool at_position = byte_offset == -1;
+  byte_offset = file->BeginAsyncIo(byte_offset, buffer_length);
+  uint32_t buffer_ptr = buffer.guest_address();
+  uint32_t length = buffer_length;
+  uint32_t io_status_block_ptr = io_status_block.guest_address();
+  uint32_t routine = apc_routine;
+  uint32_t context = apc_context.guest_address();
+  auto thread = retain_object(XThread::GetCurrentThread());
+  kernel_state()->io_worker_pool()->Submit(
+      [file, ev, thread, buffer_ptr, length, byte_offset, at_position,
+       io_status_block_ptr, routine, context]() {
+        size_t bytes_written = 0;
+        X_STATUS write_result =
+            file->Write(kernel_memory()->TranslateVirtual(buffer_ptr), length,
+                        byte_offset, &bytes_written, context, at_position);
+        CompleteFileIo(write_result, bytes_written, io_status_block_ptr,
+                       ev.get(), thread.get(), routine, context);
+      });
+  return X_STATUS_PENDING;
 }
 DECLARE_XBOXKRNL_EXPORT(NtWriteFile, ExportTag::kImplemented);
 
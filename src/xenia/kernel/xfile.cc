@@ -89,7 +89,8 @@ X_STATUS XFile::QueryDirectory(X_FILE_DIRECTORY_INFORMATION* out_info,
 }
 
 X_STATUS XFile::Read(void* buffer, size_t buffer_length, size_t byte_offset,
-                     size_t* out_bytes_read, uint32_t apc_context) {
+                     size_t* out_bytes_read, uint32_t apc_context,
+                     bool position_reserved) {
   if (byte_offset == -1) {
     // Read from current position.
     byte_offset = position_;
@@ -98,9 +99,8 @@ X_STATUS XFile::Read(void* buffer, size_t buffer_length, size_t byte_offset,
   size_t bytes_read = 0;
   X_STATUS result =
       file_->ReadSync(buffer, buffer_length, byte_offset, &bytes_read);
-  if (XSUCCEEDED(result)) {
-    position_ += bytes_read;
-  }
+  UpdatePosition(byte_offset, buffer_length,
+                 XSUCCEEDED(result) ? bytes_read : 0, position_reserved);
 
   XIOCompletion::IONotification notify;
   notify.apc_context = apc_context;
@@ -119,7 +119,7 @@ X_STATUS XFile::Read(void* buffer, size_t buffer_length, size_t byte_offset,
 
 X_STATUS XFile::Write(const void* buffer, size_t buffer_length,
                       size_t byte_offset, size_t* out_bytes_written,
-                      uint32_t apc_context) {
+                      uint32_t apc_context, bool position_reserved) {
   if (byte_offset == -1) {
     // Write from current position.
     byte_offset = position_;
@@ -128,9 +128,8 @@ X_STATUS XFile::Write(const void* buffer, size_t buffer_length,
   size_t bytes_written = 0;
   X_STATUS result =
       file_->WriteSync(buffer, buffer_length, byte_offset, &bytes_written);
-  if (XSUCCEEDED(result)) {
-    position_ += bytes_written;
-  }
+  UpdatePosition(byte_offset, buffer_length,
+                 XSUCCEEDED(result) ? bytes_written : 0, position_reserved);
 
   XIOCompletion::IONotification notify;
   notify.apc_context = apc_context;
@@ -147,6 +146,31 @@ X_STATUS XFile::Write(const void* buffer, size_t buffer_length,
   return result;
 }
 
+size_t XFile::BeginAsyncIo(size_t byte_offset, size_t length) {
+  // The event is auto-reset, so it may still be signaled from an earlier
+  // request.
+  async_event_->Reset();
+  if (byte_offset == -1) {
+    byte_offset = position_.fetch_add(length);
+  }
+  return byte_offset;
+}
+
+void XFile::UpdatePosition(size_t byte_offset, size_t length,
+                           size_t bytes_transferred, bool position_reserved) {
+  if (!position_reserved) {
+    position_ += bytes_transferred;
+    return;
+  }
+  // The whole length was reserved. Give back what wasn't transferred, unless
+  // something else has moved the position since.
+  if (bytes_transferred < length) {
+    size_t expected = byte_offset + length;
+    position_.compare_exchange_strong(expected,
+                                      byte_offset + bytes_transferred);
+  }
+}
+
 void XFile::RegisterIOCompletionPort(uint32_t key,
                                      object_ref<XIOCompletion> port) {
   std::lock_guard<std::mutex> lock(completion_port_lock_);
@@ -174,7 +198,7 @@ bool XFile::Save(ByteStream* stream) {
   }
 
   stream->Write(file_->entry()->absolute_path());
-  stream->Write<uint64_t>(position_);
+  stream->Write<uint64_t>(position_.load());
   stream->Write(file_access());
   stream->Write<bool>(is_synchronous_);
 
@@ -10,6 +10,7 @@
 #ifndef XENIA_KERNEL_XFILE_H_
 #define XENIA_KERNEL_XFILE_H_
 
+#include <atomic>
 #include <string>
 
 #include "xenia/base/filesystem.h"
@@ -98,11 +99,24 @@ class XFile : public XObject {
   X_STATUS QueryDirectory(X_FILE_DIRECTORY_INFORMATION* out_info, size_t length,
                           const char* file_name, bool restart);
 
+  // A byte_offset of -1 reads or writes at the current position.
+  // position_reserved is set for requests whose range BeginAsyncIo already
+  // moved the position past.
   X_STATUS Read(void* buffer, size_t buffer_length, size_t byte_offset,
-                size_t* out_bytes_read, uint32_t apc_context);
+                size_t* out_bytes_read, uint32_t apc_context,
+                bool position_reserved = false);
 
   X_STATUS Write(const void* buffer, size_t buffer_length, size_t byte_offset,
-                 size_t* out_bytes_written, uint32_t apc_context);
+                 size_t* out_bytes_written, uint32_t apc_context,
+                 bool position_reserved = false);
+
+  // Asynchronous requests are run by an I/O worker after the call that made
+  // them has returned. One without an offset of its own is placed at the
+  // current position when made, and the position is moved past it right
+  // away, so that requests made back to back don't overlap.
+  // Also unsignals the file until the request completes.
+  // Returns the offset to run the request at.
+  size_t BeginAsyncIo(size_t byte_offset, size_t length);
 
   void RegisterIOCompletionPort(uint32_t key, object_ref<XIOCompletion> port);
   void RemoveIOCompletionPort(uint32_t key);
@@ -115,6 +129,8 @@ class XFile : public XObject {
 
  protected:
   void NotifyIOCompletionPorts(XIOCompletion::IONotification& notification);
+  void UpdatePosition(size_t byte_offset, size_t length,
+                      size_t bytes_transferred, bool position_reserved);
 
   xe::threading::WaitHandle* GetWaitHandle() override {
     return async_event_.get();
@@ -131,7 +147,8 @@ class XFile : public XObject {
 
   // TODO(benvanik): create flags, open state, etc.
 
-  size_t position_ = 0;
+  // Advanced by I/O workers as well as by the guest.
+  std::atomic<size_t> position_ = {0};
 
   xe::filesystem::WildcardEngine find_engine_;
   size_t find_index_ = 0;
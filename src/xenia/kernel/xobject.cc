@@ -366,23 +366,30 @@ object_ref<XObject> XObject::GetNativeObject(KernelState* kernel_state,
   // each time.
   // We identify this by setting wait_list_flink to a magic value. When set,
   // wait_list_blink will hold a handle to our object.
-
-  auto global_lock = xe::global_critical_region::AcquireDirect();
+  // Dispatcher calls are hot, so objects that already exist are looked up
+  // without the global lock: the handle is stashed before the magic is set,
+  // and object table lookups are lock-free.
 
   auto header = reinterpret_cast<X_DISPATCH_HEADER*>(native_ptr);
 
+  uint32_t handle = GetStashedHandle(header);
+  if (handle) {
+    // TODO: assert if the type of the object != as_type
+    // TODO(benvanik): assert nothing has been changed in the struct.
+    return kernel_state->object_table()->LookupObject<XObject>(handle);
+  }
+
+  // Another thread may be creating the object for the same struct, so check
+  // again under the lock before creating it.
+  auto global_lock = xe::global_critical_region::AcquireDirect();
+
   if (as_type == -1) {
     as_type = header->type;
   }
 
-  if (header->wait_list_flink == 'XEN\0') {
-    // Already initialized.
-    // TODO: assert if the type of the object != as_type
-    uint32_t handle = header->wait_list_blink;
-    auto object = kernel_state->object_table()->LookupObject<XObject>(handle);
-
-    // TODO(benvanik): assert nothing has been changed in the struct.
-    return object;
+  handle = GetStashedHandle(header);
+  if (handle) {
+    return kernel_state->object_table()->LookupObject<XObject>(handle);
   } else {
     // First use, create new.
     // http://www.nirsoft.net/kernel_struct/vista/KOBJECTS.html
@@ -205,9 +205,20 @@ class XObject {
   }
 
   // Stash native pointer into X_DISPATCH_HEADER
+  // The handle is written before the magic so that GetNativeObject can check
+  // the magic without holding the global lock.
   static void StashHandle(X_DISPATCH_HEADER* header, uint32_t handle) {
-    header->wait_list_flink = 'XEN\0';
     header->wait_list_blink = handle;
+    std::atomic_thread_fence(std::memory_order_release);
+    header->wait_list_flink = 'XEN\0';
+  }
+  // Returns the handle stashed by StashHandle, or 0 if there is none.
+  static uint32_t GetStashedHandle(const X_DISPATCH_HEADER* header) {
+    if (header->wait_list_flink != 'XEN\0') {
+      return 0;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return header->wait_list_blink;
   }
 
   static uint32_t TimeoutTicksToMs(int64_t timeout_ticks);
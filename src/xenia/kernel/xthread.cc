@@ -30,8 +30,14 @@
 
 DEFINE_bool(ignore_thread_priorities, true,
             "Ignores game-specified thread priorities.");
-DEFINE_bool(ignore_thread_affinities, true,
-            "Ignores game-specified thread affinities.");
+DEFINE_bool(ignore_thread_affinities, false,
+            "Ignores game-specified thread affinities, which are otherwise "
+            "mapped onto host processors (see --guest_processor_map). "
+            "Defaulted to true before. Guest threads still keep off host "
+            "processors reserved for the emulator.");
+DEFINE_bool(refill_reused_stacks, false,
+            "Fill guest stacks reused from exited threads with junk again, "
+            "as new stacks are, instead of leaving the old thread's data.");
 
 namespace xe {
 namespace kernel {
@@ -41,6 +47,9 @@ const uint32_t XAPC::kDummyKernelRoutine;
 const uint32_t XAPC::kDummyRundownRoutine;
 
 using xe::cpu::ppc::PPCOpcode;
+using util::ThreadMemoryPool;
+
+const uint32_t kPcrSize = 0x2D8;
 
 uint32_t next_xthread_id_ = 0;
 
@@ -90,9 +99,9 @@ XThread::~XThread() {
   if (thread_state_) {
     delete thread_state_;
   }
-  kernel_state()->memory()->SystemHeapFree(scratch_address_);
-  kernel_state()->memory()->SystemHeapFree(tls_static_address_);
-  kernel_state()->memory()->SystemHeapFree(pcr_address_);
+  FreeSystemBlock(scratch_address_, scratch_size_);
+  FreeSystemBlock(tls_static_address_, tls_total_size_);
+  FreeSystemBlock(pcr_address_, kPcrSize);
   FreeStack();
 
   if (thread_) {
@@ -223,8 +232,13 @@ bool XThread::AllocateStack(uint32_t size) {
   size = xe::round_up(size, alignment);
   auto actual_size = size + padding;
 
-  uint32_t address = 0;
-  if (!heap->AllocRange(0x40000000, 0x7F000000, actual_size, alignment,
+  // Stacks of exited threads come with their guard pages already set up.
+  auto pool = kernel_state()->thread_memory_pool();
+  uint32_t address =
+      pool ? pool->Acquire(ThreadMemoryPool::Kind::kStack, actual_size) : 0;
+  bool reused = address != 0;
+  if (!reused &&
+      !heap->AllocRange(0x40000000, 0x7F000000, actual_size, alignment,
                         kMemoryAllocationReserve | kMemoryAllocationCommit,
                         kMemoryProtectRead | kMemoryProtectWrite, false,
                         &address)) {
@@ -236,6 +250,13 @@ bool XThread::AllocateStack(uint32_t size) {
   stack_limit_ = address + (padding / 2);
   stack_base_ = stack_limit_ + size;
 
+  if (reused) {
+    if (FLAGS_refill_reused_stacks) {
+      memory()->Fill(stack_limit_, size, 0xBE);
+    }
+    return true;
+  }
+
   // Initialize the stack with junk
   memory()->Fill(stack_alloc_base_, actual_size, 0xBE);
 
@@ -248,8 +269,14 @@ bool XThread::AllocateStack(uint32_t size) {
 
 void XThread::FreeStack() {
   if (stack_alloc_base_) {
-    auto heap = memory()->LookupHeap(0x40000000);
-    heap->Release(stack_alloc_base_);
+    auto pool = kernel_state()->thread_memory_pool();
+    if (pool) {
+      pool->Release(ThreadMemoryPool::Kind::kStack, stack_alloc_base_,
+                    stack_alloc_size_);
+    } else {
+      auto heap = memory()->LookupHeap(0x40000000);
+      heap->Release(stack_alloc_base_);
+    }
 
     stack_alloc_base_ = 0;
     stack_alloc_size_ = 0;
@@ -258,6 +285,30 @@ void XThread::FreeStack() {
   }
 }
 
+uint32_t XThread::AllocateSystemBlock(uint32_t size) {
+  auto pool = kernel_state()->thread_memory_pool();
+  uint32_t address =
+      pool ? pool->Acquire(ThreadMemoryPool::Kind::kSystemHeap, size) : 0;
+  if (address) {
+    // Zeroed, as fresh system heap blocks are.
+    memory()->Zero(address, size);
+    return address;
+  }
+  return memory()->SystemHeapAlloc(size);
+}
+
+void XThread::FreeSystemBlock(uint32_t address, uint32_t size) {
+  if (!address) {
+    return;
+  }
+  auto pool = kernel_state()->thread_memory_pool();
+  if (pool) {
+    pool->Release(ThreadMemoryPool::Kind::kSystemHeap, address, size);
+  } else {
+    memory()->SystemHeapFree(address);
+  }
+}
+
 X_STATUS XThread::Create() {
   // Thread kernel object.
   if (!CreateNative<X_KTHREAD>()) {
@@ -273,7 +324,7 @@ X_STATUS XThread::Create() {
   // Allocate thread scratch.
   // This is used by interrupts/APCs/etc so we can round-trip pointers through.
   scratch_size_ = 4 * 16;
-  scratch_address_ = memory()->SystemHeapAlloc(scratch_size_);
+  scratch_address_ = AllocateSystemBlock(scratch_size_);
 
   // Allocate TLS block.
   // Games will specify a certain number of 4b slots that each thread will get.
@@ -296,7 +347,7 @@ X_STATUS XThread::Create() {
   // will directly access those through 0(r13).
   uint32_t tls_slot_size = tls_slots * 4;
   tls_total_size_ = tls_slot_size + tls_extended_size;
-  tls_static_address_ = memory()->SystemHeapAlloc(tls_total_size_);
+  tls_static_address_ = AllocateSystemBlock(tls_total_size_);
   tls_dynamic_address_ = tls_static_address_ + tls_extended_size;
   if (!tls_static_address_) {
     XELOGW("Unable to allocate thread local storage block");
@@ -327,7 +378,7 @@ X_STATUS XThread::Create() {
   // 0x160: last error
   // So, at offset 0x100 we have a 4b pointer to offset 200, then have the
   // structure.
-  pcr_address_ = memory()->SystemHeapAlloc(0x2D8);
+  pcr_address_ = AllocateSystemBlock(kPcrSize);
   if (!pcr_address_) {
     XELOGW("Unable to allocate thread state block");
     return X_STATUS_NO_MEMORY;
@@ -376,6 +427,7 @@ X_STATUS XThread::Create() {
 
     // Profiler needs to know about the thread.
     xe::Profiler::ThreadEnter(thread_name_.c_str());
+    emulator()->processor()->OnThreadEnter(thread_id_, thread_name_);
 
     // Execute user code.
     current_xthread_tls_ = this;
@@ -398,8 +450,15 @@ X_STATUS XThread::Create() {
     return X_STATUS_NO_MEMORY;
   }
 
-  if (!FLAGS_ignore_thread_affinities) {
-    thread_->set_affinity_mask(proc_mask);
+  // Guest threads go on the host processors of the guest hardware threads
+  // they ask for, and stay off any set aside for the emulator's own threads,
+  // which host threads keep to.
+  uint64_t host_affinity_mask =
+      guest_thread_ ? xe::threading::GuestAffinityToHostMask(
+                          FLAGS_ignore_thread_affinities ? 0 : proc_mask)
+                    : xe::threading::reserved_host_processor_mask();
+  if (host_affinity_mask) {
+    thread_->set_affinity_mask(host_affinity_mask);
   }
 
   // Set the thread name based on host ID (for easier debugging).
@@ -694,15 +753,17 @@ void XThread::SetAffinity(uint32_t affinity) {
   // 3 - core 1, thread 1 - user
   // 4 - core 2, thread 0 - xaudio
   // 5 - core 2, thread 1 - user
-  // TODO(benvanik): implement better thread distribution.
   // NOTE: these are logical processors, not physical processors or cores.
-  if (xe::threading::logical_processor_count() < 6) {
-    XELOGW("Too few processors - scheduling will be wonky");
-  }
+  // Mapped to host processors by GuestAffinityToHostMask, which shares them
+  // out as well as it can if there are fewer than 6.
   SetActiveCpu(GetFakeCpuNumber(affinity));
   affinity_ = affinity;
-  if (!FLAGS_ignore_thread_affinities) {
-    thread_->set_affinity_mask(affinity);
+  if (!FLAGS_ignore_thread_affinities && guest_thread_) {
+    uint64_t host_affinity_mask =
+        xe::threading::GuestAffinityToHostMask(affinity);
+    if (host_affinity_mask) {
+      thread_->set_affinity_mask(host_affinity_mask);
+    }
   }
 }
 
@@ -752,12 +813,23 @@ X_STATUS XThread::Resume(uint32_t* out_suspend_count) {
 }
 
 X_STATUS XThread::Suspend(uint32_t* out_suspend_count) {
+  bool is_current_thread =
+      XThread::IsInThread() && XThread::GetCurrentThread() == this;
+
+  // Other threads are not suspended while they have interrupts disabled, as
+  // every thread taking the guest lock would wait on them. The guest lock is
+  // always taken before the global critical region.
+  std::unique_lock<cpu::GuestGlobalLock> guest_lock;
+  if (!is_current_thread) {
+    guest_lock = std::unique_lock<cpu::GuestGlobalLock>(
+        *kernel_state()->processor()->frontend()->global_lock());
+  }
   auto global_lock = global_critical_region_.Acquire();
 
   ++guest_object<X_KTHREAD>()->suspend_count;
 
   // If we are suspending ourselves, we can't hold the lock.
-  if (XThread::IsInThread() && XThread::GetCurrentThread() == this) {
+  if (is_current_thread) {
     global_lock.unlock();
   }
 
@@ -771,33 +843,38 @@ X_STATUS XThread::Suspend(uint32_t* out_suspend_count) {
 X_STATUS XThread::Delay(uint32_t processor_mode, uint32_t alertable,
                         uint64_t interval) {
   int64_t timeout_ticks = interval;
-  uint32_t timeout_ms;
-  if (timeout_ticks > 0) {
-    // Absolute time, based on January 1, 1601.
-    // TODO(benvanik): convert time to relative time.
-    assert_always();
-    timeout_ms = 0;
-  } else if (timeout_ticks < 0) {
-    // Relative time.
-    timeout_ms = uint32_t(-timeout_ticks / 10000);  // Ticks -> MS
-  } else {
-    timeout_ms = 0;
-  }
-  timeout_ms = Clock::ScaleGuestDurationMillis(timeout_ms);
-  if (alertable) {
-    auto result =
-        xe::threading::AlertableSleep(std::chrono::milliseconds(timeout_ms));
-    switch (result) {
-      default:
-      case xe::threading::SleepResult::kSuccess:
-        return X_STATUS_SUCCESS;
-      case xe::threading::SleepResult::kAlerted:
+  if (!timeout_ticks) {
+    // Just a yield, not worth a trip through the timer wheel.
+    if (alertable) {
+      auto result = xe::threading::AlertableSleep(std::chrono::milliseconds(0));
+      if (result == xe::threading::SleepResult::kAlerted) {
         return X_STATUS_USER_APC;
+      }
+    } else {
+      xe::threading::Sleep(std::chrono::milliseconds(0));
     }
-  } else {
-    xe::threading::Sleep(std::chrono::milliseconds(timeout_ms));
     return X_STATUS_SUCCESS;
   }
+
+  // Delays are kept in 100ns units all the way to the timer wheel rather than
+  // being rounded to host milliseconds.
+  if (!delay_event_) {
+    delay_event_ = xe::threading::Event::CreateAutoResetEvent(false);
+  }
+  delay_event_->Reset();
+  auto event = delay_event_;
+  auto timer_wheel = kernel_state()->timer_wheel();
+  timer_wheel->Set(&delay_timer_,
+                   util::TimerWheel::GuestDueTimeToDuration(timeout_ticks),
+                   util::TimerWheel::Duration::zero(),
+                   [event]() { event->Set(); });
+  auto result =
+      xe::threading::Wait(delay_event_.get(), alertable ? true : false);
+  if (result == xe::threading::WaitResult::kUserCallback) {
+    timer_wheel->Cancel(&delay_timer_);
+    return X_STATUS_USER_APC;
+  }
+  return X_STATUS_SUCCESS;
 }
 
 struct ThreadSavedState {
@@ -989,6 +1066,8 @@ object_ref<XThread> XThread::Restore(KernelState* kernel_state,
 
       // Profiler needs to know about the thread.
       xe::Profiler::ThreadEnter(thread->name().c_str());
+      thread->emulator()->processor()->OnThreadEnter(thread->thread_id(),
+                                                     thread->name());
 
       // Setup the time now that we're in the thread.
       Clock::SetGuestTickCount(state.tick_count_);
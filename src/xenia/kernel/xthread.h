@@ -18,6 +18,7 @@
 #include "xenia/cpu/thread.h"
 #include "xenia/cpu/thread_state.h"
 #include "xenia/kernel/util/native_list.h"
+#include "xenia/kernel/util/timer_wheel.h"
 #include "xenia/kernel/xmutant.h"
 #include "xenia/kernel/xobject.h"
 #include "xenia/xbox.h"
@@ -193,6 +194,9 @@ class XThread : public XObject, public cpu::Thread {
  protected:
   bool AllocateStack(uint32_t size);
   void FreeStack();
+  // TLS, PCR and scratch blocks, reused from exited threads when possible.
+  uint32_t AllocateSystemBlock(uint32_t size);
+  void FreeSystemBlock(uint32_t address, uint32_t size);
   void InitializeGuestObject();
 
   void DeliverAPCs();
@@ -225,6 +229,10 @@ class XThread : public XObject, public cpu::Thread {
   xe::global_critical_region global_critical_region_;
   std::atomic<uint32_t> irql_ = {0};
   util::NativeList apc_list_;
+
+  // Woken by the timer wheel at the end of a Delay.
+  std::shared_ptr<xe::threading::Event> delay_event_;
+  util::TimerWheel::Timer delay_timer_;
 };
 
 class XHostThread : public XThread {
@@ -12,6 +12,7 @@
 #include "xenia/base/clock.h"
 #include "xenia/base/logging.h"
 #include "xenia/cpu/processor.h"
+#include "xenia/kernel/kernel_state.h"
 #include "xenia/kernel/xthread.h"
 
 namespace xe {
@@ -22,13 +23,13 @@ XTimer::XTimer(KernelState* kernel_state) : XObject(kernel_state, kTypeTimer) {}
 XTimer::~XTimer() = default;
 
 void XTimer::Initialize(uint32_t timer_type) {
-  assert_false(timer_);
+  assert_false(event_);
   switch (timer_type) {
     case 0:  // NotificationTimer
-      timer_ = xe::threading::Timer::CreateManualResetTimer();
+      event_ = xe::threading::Event::CreateManualResetEvent(false);
       break;
     case 1:  // SynchronizationTimer
-      timer_ = xe::threading::Timer::CreateSynchronizationTimer();
+      event_ = xe::threading::Event::CreateAutoResetEvent(false);
       break;
     default:
       assert_always();
@@ -43,45 +44,46 @@ X_STATUS XTimer::SetTimer(int64_t due_time, uint32_t period_ms,
     return X_STATUS_TIMER_RESUME_IGNORED;
   }
 
-  due_time = Clock::ScaleGuestDurationFileTime(due_time);
+  auto due_duration = util::TimerWheel::GuestDueTimeToDuration(due_time);
   period_ms = Clock::ScaleGuestDurationMillis(period_ms);
 
-  // Stash routine for callback.
-  callback_thread_ = XThread::GetCurrentThread();
-  callback_routine_ = routine;
-  callback_routine_arg_ = routine_arg;
+  // Setting a timer resets it, like on the host.
+  event_->Reset();
 
-  // This callback will only be issued when the timer is fired.
-  std::function<void()> callback = nullptr;
-  if (callback_routine_) {
-    callback = [this]() {
-      // Queue APC to call back routine with (arg, low, high).
-      // It'll be executed on the thread that requested the timer.
-      uint64_t time = xe::Clock::QueryGuestSystemTime();
-      uint32_t time_low = static_cast<uint32_t>(time);
-      uint32_t time_high = static_cast<uint32_t>(time >> 32);
-      XELOGI("XTimer enqueuing timer callback to %.8X(%.8X, %.8X, %.8X)",
-             callback_routine_, callback_routine_arg_, time_low, time_high);
-      callback_thread_->EnqueueApc(callback_routine_, callback_routine_arg_,
-                                   time_low, time_high);
-    };
+  // The callback holds everything it uses, as the timer may be destroyed
+  // while it runs.
+  auto event = event_;
+  object_ref<XThread> callback_thread;
+  if (routine) {
+    callback_thread = retain_object(XThread::GetCurrentThread());
   }
+  auto callback = [event, callback_thread, routine, routine_arg]() {
+    event->Set();
+    if (!callback_thread) {
+      return;
+    }
+    // Queue APC to call back routine with (arg, low, high).
+    // It'll be executed on the thread that requested the timer.
+    uint64_t time = xe::Clock::QueryGuestSystemTime();
+    uint32_t time_low = static_cast<uint32_t>(time);
+    uint32_t time_high = static_cast<uint32_t>(time >> 32);
+    XELOGI("XTimer enqueuing timer callback to %.8X(%.8X, %.8X, %.8X)",
+           routine, routine_arg, time_low, time_high);
+    callback_thread->EnqueueApc(routine, routine_arg, time_low, time_high);
+  };
 
-  bool result;
-  if (!period_ms) {
-    result = timer_->SetOnce(std::chrono::nanoseconds(due_time * 100),
-                             std::move(callback));
-  } else {
-    result = timer_->SetRepeating(std::chrono::nanoseconds(due_time * 100),
-                                  std::chrono::milliseconds(period_ms),
-                                  std::move(callback));
-  }
-
-  return result ? X_STATUS_SUCCESS : X_STATUS_UNSUCCESSFUL;
+  kernel_state()->timer_wheel()->Set(
+      &wheel_timer_, due_duration,
+      std::chrono::duration_cast<util::TimerWheel::Duration>(
+          std::chrono::milliseconds(period_ms)),
+      std::move(callback));
+  return X_STATUS_SUCCESS;
 }
 
 X_STATUS XTimer::Cancel() {
-  return timer_->Cancel() ? X_STATUS_SUCCESS : X_STATUS_UNSUCCESSFUL;
+  // Canceling a timer that isn't pending is not an error.
+  kernel_state()->timer_wheel()->Cancel(&wheel_timer_);
+  return X_STATUS_SUCCESS;
 }
 
 }  // namespace kernel
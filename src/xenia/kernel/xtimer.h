@@ -10,7 +10,10 @@
 #ifndef XENIA_KERNEL_XTIMER_H_
 #define XENIA_KERNEL_XTIMER_H_
 
+#include <memory>
+
 #include "xenia/base/threading.h"
+#include "xenia/kernel/util/timer_wheel.h"
 #include "xenia/kernel/xobject.h"
 #include "xenia/xbox.h"
 
@@ -33,14 +36,13 @@ class XTimer : public XObject {
   X_STATUS Cancel();
 
  protected:
-  xe::threading::WaitHandle* GetWaitHandle() override { return timer_.get(); }
+  xe::threading::WaitHandle* GetWaitHandle() override { return event_.get(); }
 
  private:
-  std::unique_ptr<xe::threading::Timer> timer_;
-
-  XThread* callback_thread_ = nullptr;
-  uint32_t callback_routine_ = 0;
-  uint32_t callback_routine_arg_ = 0;
+  // Signaled by the timer wheel when the timer fires. Shared with the wheel
+  // callback, which may still run once after the timer is gone.
+  std::shared_ptr<xe::threading::Event> event_;
+  util::TimerWheel::Timer wheel_timer_;
 };
 
 }  // namespace kernel
@@ -0,0 +1,229 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#include "xenia/vfs/block_cache.h"
+
+#include <gflags/gflags.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+
+#include "xenia/base/assert.h"
+#include "xenia/base/logging.h"
+
+DEFINE_int32(vfs_block_cache_size_mb, 64,
+             "Size of the cache of host file blocks read ahead of sequential "
+             "reads, in megabytes. 0 to disable.");
+DEFINE_int32(vfs_read_ahead_blocks, 4,
+             "Number of 64KB blocks read ahead of sequential host file reads.");
+
+namespace xe {
+namespace vfs {
+
+namespace {
+std::mutex shared_cache_mutex_;
+std::shared_ptr<BlockCache> shared_cache_;
+}  // namespace
+
+std::shared_ptr<BlockCache> BlockCache::shared() {
+  if (FLAGS_vfs_block_cache_size_mb <= 0) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(shared_cache_mutex_);
+  if (!shared_cache_) {
+    shared_cache_ = std::make_shared<BlockCache>(
+        size_t(FLAGS_vfs_block_cache_size_mb) * 1024 * 1024);
+  }
+  return shared_cache_;
+}
+
+void BlockCache::ShutdownShared() {
+  // Released outside of the lock, as destroying the cache waits for its
+  // read-ahead thread.
+  std::shared_ptr<BlockCache> cache;
+  {
+    std::lock_guard<std::mutex> lock(shared_cache_mutex_);
+    cache = std::move(shared_cache_);
+  }
+}
+
+BlockCache::BlockCache(size_t max_size)
+    : max_size_(max_size),
+      read_ahead_block_count_(
+          size_t(std::max(0, FLAGS_vfs_read_ahead_blocks))) {
+  xe::threading::Thread::CreationParameters params;
+  params.stack_size = 256 * 1024;
+  read_ahead_thread_ =
+      xe::threading::Thread::Create(params, [this]() { ReadAheadMain(); });
+  assert_not_null(read_ahead_thread_);
+  read_ahead_thread_->set_name("VFS Read-ahead");
+}
+
+BlockCache::~BlockCache() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutting_down_ = true;
+    read_ahead_queue_.clear();
+  }
+  read_ahead_cond_.notify_all();
+  xe::threading::Wait(read_ahead_thread_.get(), false);
+
+  uint64_t lookups = stats_.hits + stats_.misses;
+  XELOGI("VFS block cache: %" PRIu64 " hits, %" PRIu64
+         " misses (%.1f%% hit), %" PRIu64 " blocks read ahead, %" PRIu64
+         " evicted",
+         stats_.hits, stats_.misses,
+         lookups ? stats_.hits * 100.0 / lookups : 0.0,
+         stats_.read_ahead_blocks, stats_.evictions);
+}
+
+bool BlockCache::Read(const std::wstring& path, size_t offset, void* buffer,
+                      size_t length, size_t* out_bytes_read) {
+  *out_bytes_read = 0;
+  uint64_t first_index = offset / kBlockSize;
+  uint64_t last_index =
+      (offset + std::max(length, size_t(1)) - 1) / kBlockSize;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  Key key = {path, first_index};
+  for (; key.index <= last_index; ++key.index) {
+    auto it = block_map_.find(key);
+    if (it == block_map_.end()) {
+      ++stats_.misses;
+      return false;
+    }
+    if (it->second->data.size() < kBlockSize) {
+      // End of the file, nothing further to look up.
+      break;
+    }
+  }
+
+  auto dest = reinterpret_cast<uint8_t*>(buffer);
+  size_t bytes_read = 0;
+  for (key.index = first_index; key.index <= last_index; ++key.index) {
+    auto it = block_map_.find(key);
+    blocks_.splice(blocks_.begin(), blocks_, it->second);
+    const auto& data = it->second->data;
+    size_t block_offset = (offset + bytes_read) % kBlockSize;
+    if (block_offset >= data.size()) {
+      break;
+    }
+    size_t copy_length =
+        std::min(data.size() - block_offset, length - bytes_read);
+    std::memcpy(dest + bytes_read, data.data() + block_offset, copy_length);
+    bytes_read += copy_length;
+    if (data.size() < kBlockSize) {
+      break;
+    }
+  }
+  ++stats_.hits;
+  *out_bytes_read = bytes_read;
+  return true;
+}
+
+void BlockCache::ReadAhead(
+    std::shared_ptr<xe::filesystem::FileHandle> file_handle, size_t offset,
+    size_t length) {
+  if (!length) {
+    return;
+  }
+  uint64_t first_index = offset / kBlockSize;
+  uint64_t last_index = (offset + length - 1) / kBlockSize;
+  bool queued = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Key key = {file_handle->path(), first_index};
+    for (; key.index <= last_index; ++key.index) {
+      if (block_map_.count(key) || !read_ahead_pending_.insert(key).second) {
+        continue;
+      }
+      read_ahead_queue_.push_back({file_handle, key.index, generation_});
+      queued = true;
+    }
+  }
+  if (queued) {
+    read_ahead_cond_.notify_one();
+  }
+}
+
+void BlockCache::Invalidate(const std::wstring& path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++generation_;
+  for (auto it = blocks_.begin(); it != blocks_.end();) {
+    const auto& block_path = it->key.path;
+    bool matches = block_path.compare(0, path.size(), path) == 0 &&
+                   (block_path.size() == path.size() ||
+                    block_path[path.size()] == xe::kWPathSeparator);
+    if (matches) {
+      size_ -= it->data.size();
+      block_map_.erase(it->key);
+      it = blocks_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+BlockCache::Stats BlockCache::stats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+void BlockCache::Insert(Block block) {
+  if (block_map_.count(block.key)) {
+    return;
+  }
+  size_ += block.data.size();
+  blocks_.push_front(std::move(block));
+  block_map_.emplace(blocks_.front().key, blocks_.begin());
+  while (size_ > max_size_ && blocks_.size() > 1) {
+    auto& victim = blocks_.back();
+    size_ -= victim.data.size();
+    block_map_.erase(victim.key);
+    blocks_.pop_back();
+    ++stats_.evictions;
+  }
+}
+
+void BlockCache::ReadAheadMain() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    read_ahead_cond_.wait(lock, [this]() {
+      return !read_ahead_queue_.empty() || shutting_down_;
+    });
+    if (shutting_down_) {
+      break;
+    }
+    auto request = std::move(read_ahead_queue_.front());
+    read_ahead_queue_.pop_front();
+    lock.unlock();
+
+    Block block;
+    block.key = {request.file_handle->path(), request.index};
+    block.data.resize(kBlockSize);
+    size_t bytes_read = 0;
+    bool read = request.file_handle->Read(request.index * kBlockSize,
+                                          block.data.data(), kBlockSize,
+                                          &bytes_read);
+    block.data.resize(bytes_read);
+
+    lock.lock();
+    read_ahead_pending_.erase(block.key);
+    // Nothing is cached past the end of the file, or if the file changed
+    // while it was being read.
+    if (read && bytes_read && request.generation == generation_) {
+      Insert(std::move(block));
+      ++stats_.read_ahead_blocks;
+    }
+  }
+}
+
+}  // namespace vfs
+}  // namespace xe
@@ -0,0 +1,126 @@
+/**
+ ******************************************************************************
+ * Xenia : Xbox 360 Emulator Research Project                                 *
+ ******************************************************************************
+ * Copyright 2017 Ben Vanik. All rights reserved.                             *
+ * Released under the BSD license - see LICENSE in the root for more details. *
+ ******************************************************************************
+ */
+
+#ifndef XENIA_VFS_BLOCK_CACHE_H_
+#define XENIA_VFS_BLOCK_CACHE_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "xenia/base/filesystem.h"
+#include "xenia/base/threading.h"
+
+namespace xe {
+namespace vfs {
+
+// Fixed-size blocks of host files read ahead of sequential guest reads, shared
+// by all open files and evicted least recently used first once the cache is
+// over budget.
+// Reads are only served when every block they touch is cached; anything else
+// goes straight to the file, so random access is never amplified to blocks.
+class BlockCache {
+ public:
+  static const size_t kBlockSize = 64 * 1024;
+
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t read_ahead_blocks = 0;
+    uint64_t evictions = 0;
+  };
+
+  // The cache shared by all host files, created on first use. Files hold on to
+  // it, so it outlives ShutdownShared for as long as any are still open.
+  // Returns nullptr if disabled with --vfs_block_cache_size_mb=0.
+  static std::shared_ptr<BlockCache> shared();
+  // Drops the shared cache. Read-ahead stops and statistics are logged once
+  // the last open file using it has been closed.
+  static void ShutdownShared();
+
+  explicit BlockCache(size_t max_size);
+  ~BlockCache();
+
+  // Number of blocks read ahead of a sequential read.
+  size_t read_ahead_block_count() const { return read_ahead_block_count_; }
+
+  // Copies the range out of the cache if all of it is present, returning
+  // false on a miss. out_bytes_read is short if the range runs past the end of
+  // the file.
+  bool Read(const std::wstring& path, size_t offset, void* buffer,
+            size_t length, size_t* out_bytes_read);
+
+  // Queues the blocks covering the range to be read in the background, unless
+  // they are already cached or queued.
+  void ReadAhead(std::shared_ptr<xe::filesystem::FileHandle> file_handle,
+                 size_t offset, size_t length);
+
+  // Drops all blocks of the file or of anything under the directory, as after
+  // it was written to or deleted.
+  void Invalidate(const std::wstring& path);
+
+  Stats stats();
+
+ private:
+  struct Key {
+    std::wstring path;
+    uint64_t index;
+    bool operator==(const Key& other) const {
+      return index == other.index && path == other.path;
+    }
+  };
+  struct KeyHash {
+    size_t operator()(const Key& key) const {
+      return std::hash<std::wstring>()(key.path) ^ size_t(key.index);
+    }
+  };
+  struct Block {
+    Key key;
+    std::vector<uint8_t> data;
+  };
+  struct ReadAheadRequest {
+    std::shared_ptr<xe::filesystem::FileHandle> file_handle;
+    uint64_t index;
+    uint64_t generation;
+  };
+
+  void Insert(Block block);
+  void ReadAheadMain();
+
+  size_t max_size_;
+  size_t read_ahead_block_count_;
+
+  std::mutex mutex_;
+  // Most recently used first.
+  std::list<Block> blocks_;
+  std::unordered_map<Key, std::list<Block>::iterator, KeyHash> block_map_;
+  size_t size_ = 0;
+  // Bumped on every invalidation so that read-ahead started before it doesn't
+  // insert stale data.
+  uint64_t generation_ = 0;
+  Stats stats_;
+
+  std::condition_variable read_ahead_cond_;
+  std::deque<ReadAheadRequest> read_ahead_queue_;
+  std::unordered_set<Key, KeyHash> read_ahead_pending_;
+  bool shutting_down_ = false;
+  std::unique_ptr<xe::threading::Thread> read_ahead_thread_;
+};
+
+}  // namespace vfs
+}  // namespace xe
+
+#endif  // XENIA_VFS_BLOCK_CACHE_H_
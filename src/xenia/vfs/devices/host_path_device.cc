@@ -50,7 +50,7 @@ void HostPathDevice::PopulateEntry(HostPathEntry* parent_entry) {
         this, parent_entry,
         xe::join_paths(parent_entry->local_path(), child_info.name),
         child_info);
-    parent_entry->children_.push_back(std::unique_ptr<Entry>(child));
+    parent_entry->AddChild(std::unique_ptr<Entry>(child));
 
     if (child_info.type == xe::filesystem::FileInfo::Type::kDirectory) {
       PopulateEntry(child);
@@ -14,6 +14,7 @@
 #include "xenia/base/mapped_memory.h"
 #include "xenia/base/math.h"
 #include "xenia/base/string.h"
+#include "xenia/vfs/block_cache.h"
 #include "xenia/vfs/device.h"
 #include "xenia/vfs/devices/host_path_file.h"
 
@@ -95,6 +96,9 @@ std::unique_ptr<Entry> HostPathEntry::CreateEntryInternal(std::string name,
 
 bool HostPathEntry::DeleteEntryInternal(Entry* entry) {
   auto full_path = xe::join_paths(local_path_, xe::to_wstring(entry->name()));
+  if (auto block_cache = BlockCache::shared()) {
+    block_cache->Invalidate(full_path);
+  }
   if (entry->attributes() & kFileAttributeDirectory) {
     // Delete entire directory and contents.
     return xe::filesystem::DeleteFolder(full_path);
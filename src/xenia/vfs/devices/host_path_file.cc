@@ -9,6 +9,7 @@
 
 #include "xenia/vfs/devices/host_path_file.h"
 
+#include "xenia/vfs/block_cache.h"
 #include "xenia/vfs/devices/host_path_entry.h"
 
 namespace xe {
@@ -17,7 +18,9 @@ namespace vfs {
 HostPathFile::HostPathFile(
     uint32_t file_access, HostPathEntry* entry,
     std::unique_ptr<xe::filesystem::FileHandle> file_handle)
-    : File(file_access, entry), file_handle_(std::move(file_handle)) {}
+    : File(file_access, entry),
+      file_handle_(std::move(file_handle)),
+      block_cache_(BlockCache::shared()) {}
 
 HostPathFile::~HostPathFile() = default;
 
@@ -29,6 +32,33 @@ X_STATUS HostPathFile::ReadSync(void* buffer, size_t buffer_length,
     return X_STATUS_ACCESS_DENIED;
   }
 
+  if (!block_cache_) {
+    if (file_handle_->Read(byte_offset, buffer, buffer_length,
+                           out_bytes_read)) {
+      return X_STATUS_SUCCESS;
+    } else {
+      return X_STATUS_END_OF_FILE;
+    }
+  }
+
+  // Titles tend to stream files in small pieces; once a few reads in a row
+  // pick up where the last one ended, keep the blocks after them coming in.
+  size_t read_ahead_length =
+      block_cache_->read_ahead_block_count() * BlockCache::kBlockSize;
+  size_t end_offset = byte_offset + buffer_length;
+  bool sequential = next_sequential_offset_.exchange(end_offset) == byte_offset;
+  uint32_t sequential_count = sequential ? ++sequential_read_count_ : 0;
+  if (!sequential) {
+    sequential_read_count_ = 0;
+  }
+  if (sequential_count >= 2 && buffer_length < read_ahead_length) {
+    block_cache_->ReadAhead(file_handle_, end_offset, read_ahead_length);
+  }
+
+  if (block_cache_->Read(file_handle_->path(), byte_offset, buffer,
+                         buffer_length, out_bytes_read)) {
+    return X_STATUS_SUCCESS;
+  }
   if (file_handle_->Read(byte_offset, buffer, buffer_length, out_bytes_read)) {
     return X_STATUS_SUCCESS;
   } else {
@@ -44,8 +74,13 @@ X_STATUS HostPathFile::WriteSync(const void* buffer, size_t buffer_length,
     return X_STATUS_ACCESS_DENIED;
   }
 
-  if (file_handle_->Write(byte_offset, buffer, buffer_length,
-                          out_bytes_written)) {
+  bool wrote = file_handle_->Write(byte_offset, buffer, buffer_length,
+                                   out_bytes_written);
+  if (block_cache_) {
+    // After the write, so that read-ahead racing it can't cache old data.
+    block_cache_->Invalidate(file_handle_->path());
+  }
+  if (wrote) {
     return X_STATUS_SUCCESS;
   } else {
     return X_STATUS_END_OF_FILE;
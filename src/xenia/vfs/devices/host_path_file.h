@@ -10,6 +10,8 @@
 #ifndef XENIA_VFS_DEVICES_HOST_PATH_FILE_H_
 #define XENIA_VFS_DEVICES_HOST_PATH_FILE_H_
 
+#include <atomic>
+#include <memory>
 #include <string>
 
 #include "xenia/base/filesystem.h"
@@ -18,6 +20,7 @@
 namespace xe {
 namespace vfs {
 
+class BlockCache;
 class HostPathEntry;
 
 class HostPathFile : public File {
@@ -34,7 +37,14 @@ class HostPathFile : public File {
                      size_t byte_offset, size_t* out_bytes_written) override;
 
  private:
-  std::unique_ptr<xe::filesystem::FileHandle> file_handle_;
+  // Shared with read-ahead that may still be running once the file is closed.
+  std::shared_ptr<xe::filesystem::FileHandle> file_handle_;
+  // Held so that the cache stays alive until the file is closed.
+  std::shared_ptr<BlockCache> block_cache_;
+  // End of the previous read and the number of reads in a row that started
+  // where the one before them ended.
+  std::atomic<size_t> next_sequential_offset_ = {0};
+  std::atomic<uint32_t> sequential_read_count_ = {0};
 };
 
 }  // namespace vfs
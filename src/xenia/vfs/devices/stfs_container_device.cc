@@ -219,11 +219,13 @@ StfsContainerDevice::Error StfsContainerDevice::ReadAllEntries(
 
       all_entries.push_back(entry.get());
 
-      // Fill in all block records.
+      // Fill in all block runs.
       // It's easier to do this now and just look them up later, at the cost
-      // of some memory. Nasty chain walk.
+      // of some memory. Nasty chain walk. Blocks that follow each other in the
+      // package are merged so that reads only copy once per run.
       // TODO(benvanik): optimize if flag 0x40 (consecutive) is set.
       if (entry->attributes() & X_FILE_ATTRIBUTE_NORMAL) {
+        auto& block_runs = entry->block_runs_;
         uint32_t block_index = start_block_index;
         size_t remaining_size = file_size;
         uint32_t info = 0x80;
@@ -231,7 +233,13 @@ StfsContainerDevice::Error StfsContainerDevice::ReadAllEntries(
           size_t block_size =
               std::min(static_cast<size_t>(0x1000), remaining_size);
           size_t offset = BlockToOffset(ComputeBlockNumber(block_index));
-          entry->block_list_.push_back({offset, block_size});
+          if (!block_runs.empty() &&
+              block_runs.back().offset + block_runs.back().length == offset) {
+            block_runs.back().length += block_size;
+          } else {
+            block_runs.push_back({file_size - remaining_size, offset,
+                                  block_size});
+          }
           remaining_size -= block_size;
           auto block_hash = GetBlockHash(map_ptr, block_index, 0);
           if (table_size_shift_ && block_hash.info < 0x80) {
@@ -242,7 +250,7 @@ StfsContainerDevice::Error StfsContainerDevice::ReadAllEntries(
         }
       }
 
-      parent_entry->children_.emplace_back(std::move(entry));
+      parent_entry->AddChild(std::move(entry));
     }
 
     auto block_hash = GetBlockHash(map_ptr, table_block_index, 0);
@@ -9,6 +9,8 @@
 
 #include "xenia/vfs/devices/stfs_container_entry.h"
 
+#include <algorithm>
+
 #include "xenia/base/math.h"
 #include "xenia/vfs/devices/stfs_container_file.h"
 
@@ -37,5 +39,21 @@ X_STATUS StfsContainerEntry::Open(uint32_t desired_access, File** out_file) {
   return X_STATUS_SUCCESS;
 }
 
+std::unique_ptr<MappedMemory> StfsContainerEntry::OpenMapped(
+    MappedMemory::Mode mode, size_t offset, size_t length) {
+  if (mode != MappedMemory::Mode::kRead || !can_map()) {
+    // Only allow reads.
+    return nullptr;
+  }
+
+  auto& run = block_runs_.front();
+  if (offset >= run.length) {
+    return nullptr;
+  }
+  size_t real_length =
+      length ? std::min(length, run.length - offset) : run.length - offset;
+  return mmap_->Slice(mode, run.offset + offset, real_length);
+}
+
 }  // namespace vfs
 }  // namespace xe
@@ -40,11 +40,21 @@ class StfsContainerEntry : public Entry {
 
   X_STATUS Open(uint32_t desired_access, File** out_file) override;
 
-  struct BlockRecord {
+  // Files stored in a single run of blocks can be used in place.
+  bool can_map() const override { return block_runs_.size() == 1; }
+  std::unique_ptr<MappedMemory> OpenMapped(MappedMemory::Mode mode,
+                                           size_t offset = 0,
+                                           size_t length = 0) override;
+
+  // Physically contiguous blocks of the file, in file order.
+  struct BlockRun {
+    // Offset of the run within the file.
+    size_t file_offset;
+    // Offset of the run within the package.
     size_t offset;
     size_t length;
   };
-  const std::vector<BlockRecord>& block_list() const { return block_list_; }
+  const std::vector<BlockRun>& block_runs() const { return block_runs_; }
 
  private:
   friend class StfsContainerDevice;
@@ -52,7 +62,7 @@ class StfsContainerEntry : public Entry {
   MappedMemory* mmap_;
   size_t data_offset_;
   size_t data_size_;
-  std::vector<BlockRecord> block_list_;
+  std::vector<BlockRun> block_runs_;
 };
 
 }  // namespace vfs
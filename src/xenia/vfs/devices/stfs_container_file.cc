@@ -10,7 +10,7 @@
 #include "xenia/vfs/devices/stfs_container_file.h"
 
 #include <algorithm>
-#include <cmath>
+#include <cstring>
 
 #include "xenia/vfs/devices/stfs_container_entry.h"
 
@@ -32,29 +32,37 @@ X_STATUS StfsContainerFile::ReadSync(void* buffer, size_t buffer_length,
     return X_STATUS_END_OF_FILE;
   }
 
-  // Each block is 4096.
-  // Blocks may not be sequential, so we need to read by blocks and handle the
-  // offsets.
+  // Blocks may not be sequential, but the device has merged the ones that are
+  // into runs, so copy a run at a time.
+  auto& block_runs = entry_->block_runs();
+  auto run_it = std::upper_bound(
+      block_runs.begin(), block_runs.end(), byte_offset,
+      [](size_t offset, const StfsContainerEntry::BlockRun& run) {
+        return offset < run.file_offset;
+      });
+  if (run_it == block_runs.begin()) {
+    return X_STATUS_END_OF_FILE;
+  }
+  --run_it;
+
   size_t real_length = std::min(buffer_length, entry_->size() - byte_offset);
-  size_t start_block = byte_offset / 4096;
-  size_t end_block =
-      std::min(entry_->block_list().size(),
-               (size_t)ceil((byte_offset + real_length) / 4096.0));
   uint8_t* dest_ptr = reinterpret_cast<uint8_t*>(buffer);
+  size_t run_offset = byte_offset - run_it->file_offset;
   size_t remaining_length = real_length;
-  for (size_t n = start_block; n < end_block; n++) {
-    auto& record = entry_->block_list()[n];
-    size_t offset = record.offset;
-    size_t read_length = std::min(remaining_length, record.length);
-    if (n == start_block) {
-      offset += byte_offset % 4096;
-      read_length = std::min(read_length, record.length - (byte_offset % 4096));
+  for (; remaining_length && run_it != block_runs.end(); ++run_it) {
+    if (run_offset >= run_it->length) {
+      // Chain ended early; the rest of the file isn't in the package.
+      break;
     }
-    memcpy(dest_ptr, entry_->mmap()->data() + offset, read_length);
+    size_t read_length =
+        std::min(remaining_length, run_it->length - run_offset);
+    std::memcpy(dest_ptr, entry_->mmap()->data() + run_it->offset + run_offset,
+                read_length);
     dest_ptr += read_length;
     remaining_length -= read_length;
+    run_offset = 0;
   }
-  *out_bytes_read = real_length;
+  *out_bytes_read = real_length - remaining_length;
   return X_STATUS_SUCCESS;
 }
 
@@ -48,13 +48,8 @@ bool Entry::is_read_only() const { return device_->is_read_only(); }
 
 Entry* Entry::GetChild(std::string name) {
   auto global_lock = global_critical_region_.Acquire();
-  // TODO(benvanik): a faster search
-  for (auto& child : children_) {
-    if (strcasecmp(child->name().c_str(), name.c_str()) == 0) {
-      return child.get();
-    }
-  }
-  return nullptr;
+  auto it = children_by_name_.find(xe::to_lower_ascii(name));
+  return it != children_by_name_.end() ? it->second : nullptr;
 }
 
 Entry* Entry::IterateChildren(const xe::filesystem::WildcardEngine& engine,
@@ -83,10 +78,10 @@ Entry* Entry::CreateEntry(std::string name, uint32_t attributes) {
   if (!entry) {
     return nullptr;
   }
-  children_.push_back(std::move(entry));
+  auto child = AddChild(std::move(entry));
   // TODO(benvanik): resort? would break iteration?
   Touch();
-  return children_.back().get();
+  return child;
 }
 
 bool Entry::Delete(Entry* entry) {
@@ -100,12 +95,28 @@ bool Entry::Delete(Entry* entry) {
   if (!DeleteEntryInternal(entry)) {
     return false;
   }
+  auto folded_name = xe::to_lower_ascii(entry->name());
+  auto name_it = children_by_name_.find(folded_name);
+  bool was_indexed =
+      name_it != children_by_name_.end() && name_it->second == entry;
+  if (was_indexed) {
+    children_by_name_.erase(name_it);
+  }
   for (auto it = children_.begin(); it != children_.end(); ++it) {
     if (it->get() == entry) {
       children_.erase(it);
       break;
     }
   }
+  if (was_indexed) {
+    // Fall back to another child differing only in case, if any.
+    for (auto& child : children_) {
+      if (xe::to_lower_ascii(child->name()) == folded_name) {
+        children_by_name_.emplace(folded_name, child.get());
+        break;
+      }
+    }
+  }
   Touch();
   return true;
 }
@@ -115,6 +126,16 @@ bool Entry::Delete() {
   return parent_->Delete(this);
 }
 
+Entry* Entry::AddChild(std::unique_ptr<Entry> child) {
+  auto global_lock = global_critical_region_.Acquire();
+  auto child_ptr = child.get();
+  // Keep the first of any names differing only in case, as the linear search
+  // used to.
+  children_by_name_.emplace(xe::to_lower_ascii(child->name()), child_ptr);
+  children_.push_back(std::move(child));
+  return child_ptr;
+}
+
 void Entry::Touch() {
   // TODO(benvanik): update timestamps.
 }
@@ -12,6 +12,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "xenia/base/filesystem.h"
@@ -127,6 +128,9 @@ class Entry {
   }
   virtual bool DeleteEntryInternal(Entry* entry) { return false; }
 
+  // Takes ownership of the child and indexes it by name.
+  Entry* AddChild(std::unique_ptr<Entry> child);
+
   xe::global_critical_region global_critical_region_;
   Device* device_;
   Entry* parent_;
@@ -140,6 +144,9 @@ class Entry {
   uint64_t access_timestamp_;
   uint64_t write_timestamp_;
   std::vector<std::unique_ptr<Entry>> children_;
+  // children_ keyed by case-folded name, as directories can hold thousands of
+  // entries and are searched on every path resolution.
+  std::unordered_map<std::string, Entry*> children_by_name_;
 };
 
 }  // namespace vfs
@@ -13,10 +13,15 @@
 #include "xenia/base/logging.h"
 #include "xenia/base/string.h"
 #include "xenia/kernel/xfile.h"
+#include "xenia/vfs/block_cache.h"
 
 namespace xe {
 namespace vfs {
 
+// Paths cached per shard before the shard is flushed, bounding memory when
+// titles probe many files that do not exist.
+const size_t kMaxPathCacheShardSize = 4096;
+
 VirtualFileSystem::VirtualFileSystem() {}
 
 VirtualFileSystem::~VirtualFileSystem() {
@@ -24,11 +29,14 @@ VirtualFileSystem::~VirtualFileSystem() {
   // This will explode if anyone is still using data from them.
   devices_.clear();
   symlinks_.clear();
+
+  BlockCache::ShutdownShared();
 }
 
 bool VirtualFileSystem::RegisterDevice(std::unique_ptr<Device> device) {
   auto global_lock = global_critical_region_.Acquire();
   devices_.emplace_back(std::move(device));
+  InvalidatePathCache(true);
   return true;
 }
 
@@ -36,6 +44,7 @@ bool VirtualFileSystem::RegisterSymbolicLink(std::string path,
                                              std::string target) {
   auto global_lock = global_critical_region_.Acquire();
   symlinks_.insert({path, target});
+  InvalidatePathCache(false);
   XELOGD("Registered symbolic link: %s => %s", path.c_str(), target.c_str());
 
   return true;
@@ -51,6 +60,7 @@ bool VirtualFileSystem::UnregisterSymbolicLink(std::string path) {
          it->second.c_str());
 
   symlinks_.erase(it);
+  InvalidatePathCache(false);
   return true;
 }
 
@@ -64,8 +74,28 @@ bool VirtualFileSystem::IsSymbolicLink(const std::string& path) {
 }
 
 Entry* VirtualFileSystem::ResolvePath(std::string path) {
+  auto key = xe::to_lower_ascii(path);
+  auto& shard =
+      path_cache_[std::hash<std::string>()(key) % kPathCacheShardCount];
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.entries.find(key);
+    if (it != shard.entries.end()) {
+      return it->second;
+    }
+  }
+
   auto global_lock = global_critical_region_.Acquire();
+  auto entry = ResolvePathUncached(path);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  if (shard.entries.size() >= kMaxPathCacheShardSize) {
+    shard.entries.clear();
+  }
+  shard.entries.emplace(std::move(key), entry);
+  return entry;
+}
 
+Entry* VirtualFileSystem::ResolvePathUncached(const std::string& path) {
   // Resolve relative paths
   std::string normalized_path(xe::filesystem::CanonicalizePath(path));
 
@@ -126,6 +156,8 @@ Entry* VirtualFileSystem::ResolveBasePath(std::string path) {
 }
 
 Entry* VirtualFileSystem::CreatePath(std::string path, uint32_t attributes) {
+  auto global_lock = global_critical_region_.Acquire();
+
   // Create all required directories recursively.
   auto path_parts = xe::split_path(path);
   if (path_parts.empty()) {
@@ -143,14 +175,17 @@ Entry* VirtualFileSystem::CreatePath(std::string path, uint32_t attributes) {
     if (!child_entry) {
       child_entry =
           parent_entry->CreateEntry(path_parts[i], kFileAttributeDirectory);
+      InvalidatePathCache(true);
     }
     if (!child_entry) {
       return nullptr;
     }
     parent_entry = child_entry;
   }
-  return parent_entry->CreateEntry(path_parts[path_parts.size() - 1],
-                                   attributes);
+  auto entry = parent_entry->CreateEntry(path_parts[path_parts.size() - 1],
+                                         attributes);
+  InvalidatePathCache(true);
+  return entry;
 }
 
 bool VirtualFileSystem::DeletePath(std::string path) {
@@ -158,14 +193,38 @@ bool VirtualFileSystem::DeletePath(std::string path) {
   if (!entry) {
     return false;
   }
+  return DeleteEntry(entry);
+}
+
+bool VirtualFileSystem::DeleteEntry(Entry* entry) {
+  auto global_lock = global_critical_region_.Acquire();
   auto parent = entry->parent();
   if (!parent) {
     // Can't delete root.
     return false;
   }
+  // Drop cached paths to the entry and its children before they are freed.
+  InvalidatePathCache(false);
   return parent->Delete(entry);
 }
 
+void VirtualFileSystem::InvalidatePathCache(bool misses_only) {
+  for (auto& shard : path_cache_) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (!misses_only) {
+      shard.entries.clear();
+      continue;
+    }
+    for (auto it = shard.entries.begin(); it != shard.entries.end();) {
+      if (!it->second) {
+        it = shard.entries.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+}
+
 X_STATUS VirtualFileSystem::OpenFile(std::string path,
                                      FileDisposition creation_disposition,
                                      uint32_t desired_access, File** out_file,
@@ -248,7 +307,7 @@ X_STATUS VirtualFileSystem::OpenFile(std::string path,
         return X_STATUS_ACCESS_DENIED;
       case FileDisposition::kSuperscede:
         // Replace (by delete + recreate).
-        if (!entry->Delete()) {
+        if (!DeleteEntry(entry)) {
           return X_STATUS_ACCESS_DENIED;
         }
         entry = nullptr;
@@ -262,7 +321,7 @@ X_STATUS VirtualFileSystem::OpenFile(std::string path,
       case FileDisposition::kOverwrite:
       case FileDisposition::kOverwriteIf:
         // Overwrite (we do by delete + recreate).
-        if (!entry->Delete()) {
+        if (!DeleteEntry(entry)) {
           return X_STATUS_ACCESS_DENIED;
         }
         entry = nullptr;
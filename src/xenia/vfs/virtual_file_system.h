@@ -11,6 +11,7 @@
 #define XENIA_VFS_VIRTUAL_FILE_SYSTEM_H_
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -45,9 +46,28 @@ class VirtualFileSystem {
                     FileAction* out_action);
 
  private:
+  Entry* ResolvePathUncached(const std::string& path);
+  bool DeleteEntry(Entry* entry);
+
+  // Drops cached resolutions that may have changed. Only misses are dropped
+  // when entries were added, everything when entries or links were removed.
+  // Must be called with the global lock held.
+  void InvalidatePathCache(bool misses_only);
+
   xe::global_critical_region global_critical_region_;
   std::vector<std::unique_ptr<Device>> devices_;
   std::unordered_map<std::string, std::string> symlinks_;
+
+  // Resolved entries (nullptr for paths that do not exist) keyed by the
+  // case-folded path as given, split into shards so that concurrent lookups
+  // don't serialize on the global lock. Entries are only added and invalidated
+  // with the global lock held so a result can't outlive the entry it names.
+  struct PathCacheShard {
+    std::mutex mutex;
+    std::unordered_map<std::string, Entry*> entries;
+  };
+  static const size_t kPathCacheShardCount = 16;
+  PathCacheShard path_cache_[kPathCacheShardCount];
 };
 
 }  // namespace vfs